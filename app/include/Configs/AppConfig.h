@@ -10,8 +10,11 @@ namespace AppConfig {
 constexpr uint32_t WIDTH = 1200;
 // Default window height.
 constexpr uint32_t HEIGHT = 800;
-// Frames in flight (CPU/GPU pacing).
-constexpr int MAX_FRAMES_IN_FLIGHT = 2;
+// Frames in flight (CPU/GPU pacing): capacity of every per-frame resource (command buffers, UBOs, descriptor sets,
+// query slots). The active count is RuntimeConfig::framesInFlight, 1..MAX_FRAMES_IN_FLIGHT.
+constexpr int MAX_FRAMES_IN_FLIGHT = 3;
+// 默认同时在飞的帧数：1 = 最低延迟（CPU 等 GPU 做完上一帧），越大吞吐越高、输入延迟越大；可被 --frames-in-flight=N 与 ImGui 覆盖
+constexpr uint32_t FRAMES_IN_FLIGHT = 2u;
 // Asset root path (relative to executable working directory).
 inline const std::string ASSETS_PATH = "assets/";
 // HDR 环境贴图（等距柱状）路径：用于天空盒与 IBL 预计算输入
@@ -19,12 +22,37 @@ inline const std::string ENV_HDR_PATH = ASSETS_PATH + "textures/hdr/qwantani_dus
 // Global scene scale for large glTF scenes (e.g. bistro).
 constexpr float SCENE_MODEL_SCALE = 1.0f;
 
+// 无头模式（命令行 --headless）：不创建窗口/surface/swapchain，渲染到离屏图像，不 present（CI / 无 GPU 机器 + 软件 ICD）
+// 默认分辨率与帧数，可被 --size=WxH / --frames=N 覆盖；每 HEADLESS_CAPTURE_INTERVAL 帧（0 = 仅最后一帧）回读为 PPM 写入
+// HEADLESS_OUTPUT_DIR（--output=DIR）
+constexpr uint32_t HEADLESS_WIDTH = 1280;
+constexpr uint32_t HEADLESS_HEIGHT = 720;
+constexpr uint32_t HEADLESS_FRAME_COUNT = 60u;
+constexpr uint32_t HEADLESS_CAPTURE_INTERVAL = 0u;
+inline const std::string HEADLESS_OUTPUT_DIR = "headless_frames";
+
+// 基准测试（--benchmark=相机路径文件）：固定步长驱动动画与相机路径（关键帧 position/yaw/pitch，Catmull-Rom 插值），
+// 先 BENCHMARK_WARMUP_FRAMES 帧预热（停在路径起点），再测量 BENCHMARK_FRAMES 帧（0 = 走完一遍路径），JSON 报告写入
+// BENCHMARK_REPORT_PATH；--compare=base.json,current.json 对比两份报告，ms/MB 指标 avg 增幅超过阈值（且超过
+// BENCHMARK_COMPARE_MIN_DELTA 噪声下限）记为回归。F5 把当前相机追加为关键帧到 CAMERA_PATH_RECORD_PATH
+constexpr float BENCHMARK_TIMESTEP = 1.0f / 60.0f;
+constexpr uint32_t BENCHMARK_WARMUP_FRAMES = 120u;
+constexpr uint32_t BENCHMARK_FRAMES = 0u;
+inline const std::string BENCHMARK_REPORT_PATH = "benchmark_report.json";
+constexpr double BENCHMARK_REGRESSION_THRESHOLD_PERCENT = 5.0;
+constexpr double BENCHMARK_COMPARE_MIN_DELTA = 0.05;
+inline const std::string CAMERA_PATH_RECORD_PATH = "camera_path.txt";
+
 // Camera initial position Z (distance from origin, Y-up).
 constexpr float CAMERA_INITIAL_Z = 30.0f;
 // Camera movement speed (WASD/QE units per second).
 constexpr float CAMERA_MOVEMENT_SPEED = 15.0f;
 // Camera mouse sensitivity (rotation speed).
 constexpr float CAMERA_MOUSE_SENSITIVITY = 0.1f;
+// Render projection near/far planes. Shared by the frame UBO and every culling frustum so they always agree;
+// the far plane is large so common glTF scenes (e.g. Sponza, Bistro) are not clipped away.
+constexpr float CAMERA_NEAR_PLANE = 0.1f;
+constexpr float CAMERA_FAR_PLANE = 1000.0f;
 
 // ========== 性能调试 [Perf] ==========
 // 总开关：是否打印性能统计
@@ -38,6 +66,61 @@ constexpr bool PERF_PRINT_BLOOM = true;
 constexpr bool PERF_PRINT_FORWARD_DETAIL = true;
 // 是否打印帧管线主阶段（acquire/record/ubo/submit/present/total）
 constexpr bool PERF_PRINT_FRAME_STAGES = true;
+// GPU 计时（GpuProfiler）：每个 Rendergraph pass 及 RTAO 子 dispatch 前后写 timestamp query，framesInFlight 帧后非阻塞回读
+// 按 pass 名称统计滚动窗口（GPU_PROFILER_WINDOW 个样本）内的 min/avg/p99，显示在 ImGui 统计面板与 [Perf] 日志
+constexpr bool ENABLE_GPU_PROFILER = true;
+constexpr uint32_t GPU_PROFILER_MAX_SCOPES = 64u;
+constexpr uint32_t GPU_PROFILER_WINDOW = 240u;
+// 时间线追踪（Engine/Profiling/Trace）：TRACE_SCOPE 标记写入每线程环形缓冲（每线程 TRACE_EVENTS_PER_THREAD 个事件），
+// 捕获 N 帧后导出 Chrome trace JSON（chrome://tracing 或 ui.perfetto.dev 打开），GPU pass 计时作为单独的 GPU 轨道
+// 运行时：ImGui 面板按钮或 F4 捕获 TRACE_CAPTURE_FRAMES 帧；TRACE_STARTUP_CAPTURE_FRAMES > 0 时从启动开始捕获（含资源加载）
+constexpr uint32_t TRACE_EVENTS_PER_THREAD = 65536u;
+constexpr uint32_t TRACE_CAPTURE_FRAMES = 120u;
+constexpr uint32_t TRACE_STARTUP_CAPTURE_FRAMES = 0u;
+inline const std::string TRACE_OUTPUT_PATH = "frame_trace.json";
+
+// CPU 层级视锥剔除：基于 Node::subtreeBounds，剔除结果压缩进 shared opaque indirect 流（Depth/Forward 共用）
+constexpr bool ENABLE_FRUSTUM_CULLING = true;
+// GPU 剔除（GpuCullingPass）：compute 逐 draw 视锥 + Hi-Z 遮挡测试，压缩 indirect 命令并用 drawIndexedIndirectCount 绘制
+// 需要设备支持 drawIndirectCount；Hi-Z 使用上一帧的 depth resolve（仅 MSAA 开启时存在）
+constexpr bool ENABLE_GPU_CULLING = true;
+constexpr bool ENABLE_HIZ_OCCLUSION_CULLING = true;
+// 遮挡查询剔除（OcclusionCullingPass）：每个带 mesh 的节点一个 occlusion query，结果延迟 framesInFlight 帧非阻塞读取
+// 语义为"未证明被遮挡即可见"，因此新露出的物体最多晚 framesInFlight 帧出现
+constexpr bool ENABLE_OCCLUSION_CULLING = false;
+// CPU 软件遮挡剔除（SoftwareOcclusionCuller）：低分辨率 8x4 分块深度 + 覆盖掩码，SIMD 光栅化大遮挡体后测试节点 subtreeBounds
+// 不依赖 GPU query，当帧生效（无延迟）；在 worker 线程上投影/光栅化/测试
+constexpr bool ENABLE_SOFTWARE_OCCLUSION_CULLING = false;
+constexpr uint32_t SOFTWARE_OCCLUSION_WIDTH = 320;
+constexpr uint32_t SOFTWARE_OCCLUSION_HEIGHT = 192;
+// 遮挡体选择：按世界包围盒尺寸从大到小挑选不透明 mesh（单 mesh 三角形上限 / 总三角形预算）
+constexpr uint32_t SOFTWARE_OCCLUSION_MAX_OCCLUDER_TRIANGLES = 4096u;
+constexpr uint32_t SOFTWARE_OCCLUSION_TRIANGLE_BUDGET = 65536u;
+
+// GPU 内存子分配（GpuMemoryAllocator）：按 memory type 分池，每块 BLOCK_SIZE，块内 TLSF 分配
+// 大于半块的请求、以及不小于 DEDICATED_THRESHOLD 的 color/depth attachment 使用独立分配
+constexpr uint64_t GPU_MEMORY_BLOCK_SIZE = 64ull * 1024ull * 1024ull;
+constexpr uint64_t GPU_MEMORY_DEDICATED_THRESHOLD = 4ull * 1024ull * 1024ull;
+// Rendergraph 内部 attachment 显存别名：按 executionOrder 求生命周期，互不重叠的资源共享同一块显存（首次写入前插入 aliasing barrier）
+// TransientAttachment 用途且设备提供 LAZILY_ALLOCATED 内存类型时改用惰性分配（tile-based GPU 上通常不占实际显存），不参与别名
+constexpr bool ENABLE_RENDERGRAPH_ALIASING = true;
+// Rendergraph 拆分屏障：写入与下一次使用之间隔着其他 pass 时，用 VkEvent 在生产者后 set、消费者前 wait，中间的 pass 可与转换重叠
+// 关闭时该转换并入消费者 pass 前的批量屏障
+constexpr bool ENABLE_SPLIT_BARRIERS = true;
+
+// 异步上传（UploadManager）：常驻映射的 staging 环形缓冲大小；有独立 transfer 队列时在其上拷贝，用 timeline semaphore 票据等待
+// 超过环大小的单次上传使用临时 staging buffer
+constexpr uint64_t UPLOAD_STAGING_RING_SIZE = 64ull * 1024ull * 1024ull;
+
+// 模型烘焙缓存（MeshCache）：glTF 首次加载后在源文件旁写入 <source>.vkmesh，之后启动直接 mmap 读取、跳过 tinygltf
+// 源文件/外部依赖内容哈希或加载器版本变化时自动重建
+constexpr bool ENABLE_MESH_CACHE = true;
+
+// 管线缓存（PipelineCache）：启动时从该文件加载 VkPipelineCache（按 vendor/device/driver/UUID 校验），退出时写回
+inline const std::string PIPELINE_CACHE_PATH = "pipeline_cache.bin";
+// 并行管线编译（PipelineBuilder）：启动与 resize 时各管线变体在 JobSystem worker 上并发编译，首次使用前 join
+// 关闭则在调用线程上依次编译（用于对比耗时）
+constexpr bool ENABLE_PARALLEL_PIPELINE_BUILD = true;
 
 // 光追反射：开发时是否启用（关闭可加快调试迭代）
 constexpr bool ENABLE_RAY_TRACED_REFLECTION = false;
@@ -95,6 +178,14 @@ constexpr float RTAO_DISOCCLUSION_THRESHOLD = 0.35f;  // 当前值与历史值
 constexpr bool ENABLE_RTAO_SPATIAL_DENOISE = true;
 constexpr uint32_t RTAO_ATROUS_ITERATIONS = 5; // 推荐 3（速度优先）
 
+// TLAS 增量更新：只重写变化节点对应的 instance；refit 会逐渐降低 BVH 质量，满足任一条件时改为完整 rebuild
+constexpr float TLAS_REBUILD_DIRTY_FRACTION = 0.25f;     // 本帧变化 instance 占比 >= 该值时 rebuild
+constexpr uint32_t TLAS_MAX_REFITS_BEFORE_REBUILD = 64;  // 连续 refit 次数上限
+
+// BLAS 加载期构建：多个 BLAS 共享一块 scratch arena，按 arena 容量分批提交；构建后压缩（compaction）释放冗余内存
+constexpr uint64_t BLAS_BUILD_SCRATCH_BUDGET = 64ull * 1024ull * 1024ull;  // 每批 scratch 上限（单个更大的 BLAS 会扩大 arena）
+constexpr bool ENABLE_BLAS_COMPACTION = true;
+
 // 点光源开关：关闭后 pointLightCount=0，仅方向光生效
 constexpr bool ENABLE_POINT_LIGHTS = false;
 
@@ -30,6 +30,17 @@ inline float bloomBlurRadius = AppConfig::BLOOM_BLUR_RADIUS;
 // --- Tonemap params ---
 inline float tonemapExposure = AppConfig::TONEMAP_EXPOSURE;
 
+// --- Culling ---
+inline bool enableFrustumCulling = AppConfig::ENABLE_FRUSTUM_CULLING;
+inline bool enableGpuCulling = AppConfig::ENABLE_GPU_CULLING;
+inline bool enableHizOcclusionCulling = AppConfig::ENABLE_HIZ_OCCLUSION_CULLING;
+inline bool enableOcclusionCulling = AppConfig::ENABLE_OCCLUSION_CULLING;
+inline bool enableSoftwareOcclusionCulling = AppConfig::ENABLE_SOFTWARE_OCCLUSION_CULLING;
+
+// --- Frame pacing (applied by Renderer at the next frame boundary, after draining the GPU) ---
+// Not part of resetToDefaults: it is a launch option (--frames-in-flight) that benchmark runs must keep.
+inline uint32_t framesInFlight = AppConfig::FRAMES_IN_FLIGHT;
+
 inline void resetToDefaults()
 {
     debugViewMode = AppConfig::DEBUG_VIEW_MODE;
@@ -44,6 +55,11 @@ inline void resetToDefaults()
     bloomIntensity = AppConfig::BLOOM_INTENSITY;
     bloomBlurRadius = AppConfig::BLOOM_BLUR_RADIUS;
     tonemapExposure = AppConfig::TONEMAP_EXPOSURE;
+    enableFrustumCulling = AppConfig::ENABLE_FRUSTUM_CULLING;
+    enableGpuCulling = AppConfig::ENABLE_GPU_CULLING;
+    enableHizOcclusionCulling = AppConfig::ENABLE_HIZ_OCCLUSION_CULLING;
+    enableOcclusionCulling = AppConfig::ENABLE_OCCLUSION_CULLING;
+    enableSoftwareOcclusionCulling = AppConfig::ENABLE_SOFTWARE_OCCLUSION_CULLING;
 }
 
 }  // namespace RuntimeConfig
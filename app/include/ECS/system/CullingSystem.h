@@ -5,7 +5,9 @@
 #include "ECS/component/TransformComponent.h"
 #include "Engine/Camera/Camera.h"
 #include "Engine/Math/Frustum.h"
+#include "Engine/Math/FrustumCulling.h"
 
+#include <cstdint>
 #include <vector>
 
 class CullingSystem {
@@ -27,4 +29,12 @@ public:
 private:
     Camera* camera = nullptr;
     std::vector<Entity*> visibleEntities;
+
+    // Entities per gather job.
+    static constexpr uint32_t CULL_GATHER_GRAIN = 256;
+
+    // Scratch for the batch SIMD test (kept across frames to avoid reallocations).
+    AabbSoA candidateBounds;
+    std::vector<uint8_t> candidateValid;
+    std::vector<uint32_t> visibilityMask;
 };
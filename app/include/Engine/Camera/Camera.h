@@ -34,11 +34,15 @@ public:
     glm::vec3 getPosition() const { return position; }
     glm::vec3 getFront() const { return front; }
     glm::vec3 getUp() const { return up; }
+    float getYaw() const { return yaw; }
+    float getPitch() const { return pitch; }
 
     void setPosition(const glm::vec3& pos) { position = pos; }
     void setMovementSpeed(float speed) { movementSpeed = speed; }
     void setMouseSensitivity(float sensitivity) { mouseSensitivity = sensitivity; }
     void setZoom(float z) { zoom = z; }
+    // Degrees, same convention as mouse look (yaw -90 looks down -Z); pitch is clamped to +-89.
+    void setOrientation(float newYaw, float newPitch);
 
 private:
     void updateCameraVectors();
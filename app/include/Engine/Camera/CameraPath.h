@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Engine/Math/GlmConfig.h"
+
+#include <string>
+#include <vector>
+
+class Camera;
+
+// Keyframed camera path for reproducible benchmark runs.
+// Text file, one keyframe per line: "time px py pz yaw pitch" (seconds, world units, degrees); '#' starts a comment.
+// Keyframes must be in increasing time order. Positions and angles are Catmull-Rom splined (end keyframes repeated),
+// and the path holds its first/last pose outside [0, duration].
+class CameraPath {
+public:
+    struct Keyframe {
+        float time = 0.0f;
+        glm::vec3 position{0.0f};
+        float yaw = -90.0f;
+        float pitch = 0.0f;
+    };
+
+    // Throws std::runtime_error on a missing file, a malformed line or non-increasing times.
+    static CameraPath loadFromFile(const std::string& path);
+    // Appends one keyframe line (creates the file), used to record a path from the live camera.
+    static bool appendKeyframe(const std::string& path, const Keyframe& keyframe);
+
+    Keyframe sample(float time) const;
+    void apply(Camera& camera, float time) const;
+
+    float getDuration() const { return keyframes.empty() ? 0.0f : keyframes.back().time; }
+    const std::vector<Keyframe>& getKeyframes() const { return keyframes; }
+
+private:
+    std::vector<Keyframe> keyframes;
+};
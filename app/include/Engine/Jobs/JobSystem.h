@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Completion counter for a group of jobs: submit() increments, job completion decrements,
+// JobSystem::wait() returns once it reaches zero.
+struct JobCounter {
+    std::atomic<uint32_t> pending{0};
+
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+// Work-stealing job system:
+// - each worker owns a deque; it pops its own work LIFO (cache-warm) and steals FIFO from others when empty
+// - jobs submitted from non-worker threads (e.g. the main thread) are distributed round-robin
+// - wait() never just blocks: the waiting thread executes pending jobs until the counter drains
+//
+// Notes:
+// - Deques are mutex-protected (short critical sections); contention is low at our job granularity.
+// - Jobs must not throw.
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+    using RangeJob = std::function<void(uint32_t begin, uint32_t end)>;
+
+    // Process-wide instance with hardware_concurrency() - 1 workers (created on first use).
+    static JobSystem& get();
+
+    explicit JobSystem(uint32_t workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void submit(Job job, JobCounter* counter = nullptr);
+    void wait(JobCounter& counter);
+
+    // Splits [0, count) into chunks of at least grainSize and runs fn(begin, end) on the workers and
+    // the calling thread. Returns when every chunk has finished. Small ranges run inline.
+    void parallelFor(uint32_t count, uint32_t grainSize, const RangeJob& fn);
+
+    uint32_t getWorkerCount() const { return static_cast<uint32_t>(workers.size()); }
+
+private:
+    struct WorkItem {
+        Job job;
+        JobCounter* counter = nullptr;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<WorkItem> items;
+    };
+
+    void workerLoop(uint32_t workerIndex);
+    bool tryRunOne(uint32_t preferredQueue);
+    bool popLocal(uint32_t queueIndex, WorkItem& out);
+    bool steal(uint32_t thiefIndex, WorkItem& out);
+    static void run(WorkItem& item);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<uint32_t> nextQueue{0};
+    std::atomic<uint32_t> queuedCount{0};
+    std::atomic<bool> stopping{false};
+
+    std::mutex sleepMutex;
+    std::condition_variable sleepCv;
+};
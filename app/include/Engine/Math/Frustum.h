@@ -4,10 +4,14 @@
 #include "Engine/Math/GlmConfig.h"
 
 #include <array>
+#include <cstdint>
 
 // Camera frustum (6 planes). Stub implementation; extend with proper plane extraction later.
 class Frustum {
 public:
+    // One bit per plane (L, R, B, T, N, F); used by hierarchical culling to skip planes a parent is fully inside.
+    static constexpr uint32_t ALL_PLANES_MASK = 0x3Fu;
+
     Frustum() = default;
 
     // Build frustum from view-projection matrix (extracts 6 planes)
@@ -41,6 +45,33 @@ public:
         return true;
     }
 
+    // Plane-masked AABB test. Only planes whose bit is set in `mask` are tested; returns false if the box
+    // is outside one of them, otherwise clears the bits of planes the box lies fully inside.
+    bool IntersectsMasked(const BoundingBox& box, uint32_t& mask) const {
+        for (uint32_t i = 0; i < 6; ++i) {
+            const uint32_t bit = 1u << i;
+            if ((mask & bit) == 0u) continue;
+
+            const glm::vec4& plane = planes[i];
+            const glm::vec3 positiveVertex(plane.x >= 0.0f ? box.max.x : box.min.x,
+                                           plane.y >= 0.0f ? box.max.y : box.min.y,
+                                           plane.z >= 0.0f ? box.max.z : box.min.z);
+            const glm::vec3 negativeVertex(plane.x >= 0.0f ? box.min.x : box.max.x,
+                                           plane.y >= 0.0f ? box.min.y : box.max.y,
+                                           plane.z >= 0.0f ? box.min.z : box.max.z);
+
+            if (glm::dot(glm::vec3(plane), positiveVertex) + plane.w < 0.0f) {
+                return false;
+            }
+            if (glm::dot(glm::vec3(plane), negativeVertex) + plane.w >= 0.0f) {
+                mask &= ~bit;
+            }
+        }
+        return true;
+    }
+
+    const std::array<glm::vec4, 6>& GetPlanes() const { return planes; }
+
 private:
     void extractPlanes(const glm::mat4& m) {
         // Left, Right, Bottom, Top, Near, Far
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Engine/Math/BoundingBox.h"
+#include "Engine/Math/Frustum.h"
+
+#include <cstdint>
+#include <vector>
+
+// Structure-of-arrays AABB list for batch frustum tests.
+struct AabbSoA {
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+
+    void Clear() {
+        for (auto* v : {&minX, &minY, &minZ, &maxX, &maxY, &maxZ}) v->clear();
+    }
+    void Reserve(size_t count) {
+        for (auto* v : {&minX, &minY, &minZ, &maxX, &maxY, &maxZ}) v->reserve(count);
+    }
+    void Resize(size_t count) {
+        for (auto* v : {&minX, &minY, &minZ, &maxX, &maxY, &maxZ}) v->resize(count);
+    }
+    void Set(size_t i, const BoundingBox& box) {
+        minX[i] = box.min.x; minY[i] = box.min.y; minZ[i] = box.min.z;
+        maxX[i] = box.max.x; maxY[i] = box.max.y; maxZ[i] = box.max.z;
+    }
+    void PushBack(const BoundingBox& box) {
+        minX.push_back(box.min.x); minY.push_back(box.min.y); minZ.push_back(box.min.z);
+        maxX.push_back(box.max.x); maxY.push_back(box.max.y); maxZ.push_back(box.max.z);
+    }
+    uint32_t Size() const { return static_cast<uint32_t>(minX.size()); }
+};
+
+// Batch AABB-vs-frustum kernel. Same p-vertex test (and float operation order) as Frustum::Intersects,
+// so every SIMD level produces bit-identical results to the scalar path.
+namespace FrustumCulling {
+
+enum class SimdLevel {
+    Scalar,
+    Sse41,
+    Avx2,
+};
+
+// Best level supported by the running CPU (cpuid; AVX2 also requires OS YMM state support).
+SimdLevel DetectSimdLevel();
+const char* GetSimdLevelName(SimdLevel level);
+
+// Number of uint32_t words needed for `count` result bits.
+inline uint32_t MaskWordCount(uint32_t count) { return (count + 31u) / 32u; }
+
+// Tests boxes[0..Size()) against the planes selected by planeMask (Frustum::ALL_PLANES_MASK for all six).
+// Bit i of outMask (word i / 32, bit i % 32) is set when box i is not rejected. outMask must hold
+// MaskWordCount(Size()) words; unused tail bits are cleared. Returns the number of set bits.
+uint32_t CullAabbBatch(const Frustum& frustum, const AabbSoA& boxes, uint32_t* outMask,
+                       uint32_t planeMask = Frustum::ALL_PLANES_MASK);
+// Explicit level (levels above DetectSimdLevel() fall back to the best supported one).
+uint32_t CullAabbBatch(const Frustum& frustum, const AabbSoA& boxes, uint32_t* outMask,
+                       uint32_t planeMask, SimdLevel level);
+
+}  // namespace FrustumCulling
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Nearest-rank percentile (p in 1..100) of non-empty samples sorted ascending. GpuProfiler summaries and benchmark
+// reports both use it, so their p50/p95/p99 agree.
+inline double nearestRankPercentile(const std::vector<double>& sorted, uint32_t p)
+{
+    const size_t rank = std::max<size_t>(1, (sorted.size() * p + 99) / 100);
+    return sorted[std::min(sorted.size(), rank) - 1];
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Timeline trace markers exported as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+// TRACE_SCOPE records one complete event (name, begin, end) into a ring buffer owned by the calling thread; a
+// capture writes every buffered event inside its time window to a file, so frame-pacing hitches can be inspected
+// offline instead of being averaged away.
+//
+// Notes:
+// - Recording is off unless enabled at runtime (setEnabled / requestCapture); a disabled TRACE_SCOPE costs one
+//   relaxed atomic load.
+// - Names must outlive the capture: string literals, RenderPass names, or intern() for names built at runtime.
+// - Each ring holds AppConfig::TRACE_EVENTS_PER_THREAD events; older events are overwritten.
+// - Non-CPU timelines (the GPU) are virtual tracks written by whichever thread harvests them.
+class Trace {
+public:
+    static Trace& get();
+
+    static uint64_t nowNs();
+
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+
+    // Names the calling thread's track ("Main", "Worker 3").
+    void setThreadName(const std::string& name);
+    // Adds a track that is not a CPU thread; returns its id for record().
+    uint32_t registerTrack(const std::string& name);
+    // Stable name pointer for strings built at runtime.
+    const char* intern(const std::string& name);
+
+    // Records a complete event on the calling thread's track.
+    void record(const char* name, uint64_t beginNs, uint64_t endNs);
+    // Records a complete event on a track from registerTrack().
+    void recordOnTrack(uint32_t track, const char* name, uint64_t beginNs, uint64_t endNs);
+
+    // Enables recording for the next frameCount frames, then writes them to path and restores the previous state.
+    void requestCapture(uint32_t frameCount, const std::string& path);
+    bool isCapturing() const;
+    // Frame boundary (main thread): counts captured frames and writes the file when the capture completes.
+    void onFrameEnd();
+
+    // Writes every buffered event overlapping [fromNs, toNs]; returns false if the file cannot be written.
+    bool writeChromeTrace(const std::string& path, uint64_t fromNs, uint64_t toNs) const;
+
+private:
+    struct Event {
+        const char* name = nullptr;
+        uint64_t beginNs = 0;
+        uint64_t endNs = 0;
+    };
+
+    // One ring per thread (or virtual track). The mutex is only contended while a capture is being written.
+    struct Track {
+        uint32_t id = 0;
+        std::string name;
+        mutable std::mutex mutex;
+        std::vector<Event> events;
+        uint64_t writeCount = 0;
+    };
+
+    Trace() = default;
+    Track& createTrack(const std::string& name);
+    Track& threadTrack();
+    static void push(Track& track, const Event& event);
+
+    std::atomic<bool> enabled{false};
+
+    mutable std::mutex registryMutex;
+    std::vector<std::unique_ptr<Track>> tracks;
+    std::unordered_set<std::string> internedNames;
+
+    mutable std::mutex captureMutex;
+    uint32_t captureFramesLeft = 0;
+    uint64_t captureStartNs = 0;
+    std::string capturePath;
+    bool enabledBeforeCapture = false;
+};
+
+// Records the enclosing scope on the calling thread's track when tracing is enabled.
+class TraceScope {
+public:
+    explicit TraceScope(const char* inName)
+        : name(Trace::get().isEnabled() ? inName : nullptr)
+        , beginNs(name ? Trace::nowNs() : 0)
+    {
+    }
+    ~TraceScope()
+    {
+        if (name) {
+            Trace::get().record(name, beginNs, Trace::nowNs());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t beginNs;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
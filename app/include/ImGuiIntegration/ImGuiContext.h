@@ -20,6 +20,14 @@ class VulkanResourceCreator;
 /// 注意：类名避免与 ImGui 内部 ImGuiContext 冲突
 class ImGuiIntegration {
 public:
+    /// GPU 计时（一个 timestamp scope：pass 或 pass 内子 dispatch），滚动窗口统计
+    struct GpuScopeStats {
+        std::string name;
+        double minMs = 0.0;
+        double avgMs = 0.0;
+        double p99Ms = 0.0;
+    };
+
     struct UiStats {
         double acquireMs = 0.0;
         double recordMs = 0.0;
@@ -29,6 +37,7 @@ public:
         double totalMs = 0.0;
         uint64_t swapchainRecreateCount = 0;
         uint64_t frameCounter = 0;
+        std::vector<GpuScopeStats> gpuScopes;
     };
 
     ImGuiIntegration() = default;
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include <cstdint>
+#include <memory>
+
+struct GpuMemoryState;
+struct GpuMemoryBlock;
+
+// Device memory backing one buffer or image: a range inside a shared block, or a dedicated vkAllocateMemory.
+// Move-only; the range goes back to the allocator on destruction. Host-visible blocks are mapped once for their
+// whole lifetime, so mapMemory() is a pointer offset and unmapMemory() is a no-op (same call shape as
+// vk::raii::DeviceMemory, which the resource structs held before).
+class GpuAllocation {
+public:
+    GpuAllocation() = default;
+    GpuAllocation(GpuAllocation&& other) noexcept;
+    GpuAllocation& operator=(GpuAllocation&& other) noexcept;
+    GpuAllocation(const GpuAllocation&) = delete;
+    GpuAllocation& operator=(const GpuAllocation&) = delete;
+    ~GpuAllocation() { release(); }
+
+    // Offset is relative to this allocation. Throws if the memory type is not host-visible.
+    void* mapMemory(vk::DeviceSize offset, vk::DeviceSize size) const;
+    void unmapMemory() const {}
+
+    vk::DeviceMemory getMemory() const { return memory; }
+    vk::DeviceSize getOffset() const { return offset; }
+    vk::DeviceSize getSize() const { return size; }
+    bool isDedicated() const { return region == UINT32_MAX; }
+
+private:
+    friend class GpuMemoryAllocator;
+    void release();
+
+    std::shared_ptr<GpuMemoryState> state;
+    GpuMemoryBlock* block = nullptr;
+    uint32_t region = UINT32_MAX;  // range inside block; UINT32_MAX = dedicated
+    vk::DeviceMemory memory{};
+    vk::DeviceSize offset = 0;
+    vk::DeviceSize size = 0;
+    void* mapped = nullptr;        // block mapping + offset (host-visible only)
+};
+
+// Block sub-allocator behind VulkanResourceCreator::createBuffer/createImage.
+// - One pool per (memory type, linear/optimal resource, device-address flag); optimal-tiling images never share a
+//   block with buffers, so bufferImageGranularity needs no extra padding.
+// - Blocks are AppConfig::GPU_MEMORY_BLOCK_SIZE; ranges inside a block are managed with TLSF (two-level
+//   segregated fit: O(1) allocate/free, free neighbours coalesced).
+// - Requests larger than half a block, or flagged dedicated (big render targets), get their own allocation.
+// - Thread-safe. The state is shared with live allocations, so cleanup() may run before every resource is freed;
+//   the device must still outlive them, exactly as with per-resource vk::raii::DeviceMemory.
+class GpuMemoryAllocator {
+public:
+    struct Request {
+        vk::MemoryRequirements requirements{};
+        vk::MemoryPropertyFlags properties{};
+        bool optimalImage = false;   // optimal-tiling image (kept apart from linear resources)
+        bool deviceAddress = false;  // needs VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT
+        bool dedicated = false;
+        vk::Image dedicatedImage{};  // chained as VkMemoryDedicatedAllocateInfo when dedicated
+        vk::Buffer dedicatedBuffer{};
+    };
+
+    struct Stats {
+        uint64_t usedBytes = 0;        // sum of live allocation sizes
+        uint64_t reservedBytes = 0;    // device memory held (blocks + dedicated)
+        uint64_t fragmentedBytes = 0;  // free block bytes outside each block's largest free range
+        uint32_t blockCount = 0;
+        uint32_t dedicatedCount = 0;
+        uint32_t allocationCount = 0;
+    };
+
+    void init(vk::raii::Device& device, const vk::raii::PhysicalDevice& physicalDevice);
+    void cleanup();
+
+    GpuAllocation allocate(const Request& request);
+    Stats getStats() const;
+
+private:
+    std::shared_ptr<GpuMemoryState> state;
+};
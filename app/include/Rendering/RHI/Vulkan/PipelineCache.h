@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+
+// Shared VkPipelineCache, persisted across runs.
+// The blob on disk is prefixed with our own header (vendor/device ID, driver version, pipelineCacheUUID, size and
+// checksum); a file written by another GPU or driver, or a torn/corrupted one, is ignored and the cache starts empty.
+// Every pipeline in the renderer is created through createGraphicsPipeline()/createComputePipeline(), which also
+// time the creation and, when VK_EXT_pipeline_creation_feedback is enabled, count application cache hits.
+//
+// Notes:
+// - vkCreate*Pipelines may be called concurrently with the same cache; stats are guarded by a mutex.
+// - save() writes to a temp file and renames it over the old one.
+class PipelineCache {
+public:
+    struct Stats {
+        uint32_t pipelines = 0;
+        uint32_t cacheHits = 0;          // only counted with creation feedback
+        uint32_t feedbackPipelines = 0;  // pipelines that reported creation feedback
+        double createMs = 0.0;           // wall time spent inside vkCreate*Pipelines
+    };
+
+    void init(vk::raii::Device& device, const vk::raii::PhysicalDevice& physicalDevice, const std::string& path,
+              bool creationFeedback);
+    // save() + destroy; call before the device goes away.
+    void cleanup();
+    bool save();
+
+    vk::raii::Pipeline createGraphicsPipeline(const vk::GraphicsPipelineCreateInfo& info);
+    vk::raii::Pipeline createComputePipeline(const vk::ComputePipelineCreateInfo& info);
+
+    vk::PipelineCache get() const { return cache ? static_cast<vk::PipelineCache>(*cache) : vk::PipelineCache{}; }
+    // Bytes of driver cache data accepted from disk at init (0 = cold start).
+    size_t getLoadedBytes() const { return loadedBytes; }
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    void recordCreation(double ms, const vk::PipelineCreationFeedback& feedback);
+
+    vk::raii::Device* device = nullptr;
+    std::optional<vk::raii::PipelineCache> cache;
+    std::string path;
+    bool creationFeedback = false;
+    size_t loadedBytes = 0;
+
+    uint32_t vendorID = 0;
+    uint32_t deviceID = 0;
+    uint32_t driverVersion = 0;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE] = {};
+
+    mutable std::mutex statsMutex;
+    Stats stats;
+};
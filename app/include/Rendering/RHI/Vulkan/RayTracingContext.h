@@ -12,6 +12,12 @@ struct RayTracingInstanceDesc {
     glm::mat4 transform{1.0f};
 };
 
+// Contiguous run of instances [begin, begin + count) whose transform changed.
+struct RayTracingInstanceRange {
+    uint32_t begin = 0;
+    uint32_t count = 0;
+};
+
 class RayTracingContext {
 public:
     RayTracingContext() = default;
@@ -22,8 +28,22 @@ public:
               const std::vector<uint8_t>& meshOpaqueFlags,
               const std::vector<RayTracingInstanceDesc>& instances);
     void cleanup();
+    struct UpdateStats {
+        uint32_t writtenInstances = 0;
+        bool rebuilt = false;            // full eBuild instead of an eUpdate refit
+        uint32_t refitsSinceRebuild = 0;
+    };
+
+    // Rewrites every instance and rebuilds the TLAS.
     void updateTopLevelAS(vk::raii::CommandBuffer& commandBuffer,
                           const std::vector<RayTracingInstanceDesc>& instances);
+    // Rewrites only the instances in dirtyRanges (sorted, non-overlapping). Refits the TLAS unless the dirty
+    // fraction reaches AppConfig::TLAS_REBUILD_DIRTY_FRACTION or AppConfig::TLAS_MAX_REFITS_BEFORE_REBUILD
+    // refits have accumulated since the last full build.
+    void updateTopLevelAS(vk::raii::CommandBuffer& commandBuffer,
+                          const std::vector<RayTracingInstanceDesc>& instances,
+                          const std::vector<RayTracingInstanceRange>& dirtyRanges);
+    const UpdateStats& getLastUpdateStats() const { return lastUpdateStats; }
 
     vk::AccelerationStructureKHR getTopLevelAS() const {
         return topLevelAS ? static_cast<vk::AccelerationStructureKHR>(*topLevelAS) : VK_NULL_HANDLE;
@@ -34,36 +54,45 @@ private:
     vk::DeviceAddress getBufferDeviceAddress(vk::Buffer buffer) const;
     vk::DeviceAddress getAccelerationStructureAddress(vk::AccelerationStructureKHR accelerationStructure) const;
     vk::TransformMatrixKHR toVkTransformMatrix(const glm::mat4& matrix) const;
-    void writeInstances(const std::vector<RayTracingInstanceDesc>& instances) const;
+    void writeInstances(const std::vector<RayTracingInstanceDesc>& instances, uint32_t begin, uint32_t end) const;
+    void recordTopLevelASUpdate(vk::raii::CommandBuffer& commandBuffer, vk::BuildAccelerationStructureModeKHR mode);
     void recordTopLevelASBuild(vk::raii::CommandBuffer& commandBuffer, vk::BuildAccelerationStructureModeKHR mode);
     void buildOrUpdateTopLevelAS(vk::BuildAccelerationStructureModeKHR mode);
 
+    // Load-time BLAS builds: batched into a few submits sharing one scratch arena, then compacted.
     void buildBottomLevelASes(const std::vector<GpuMesh>& meshes, const std::vector<uint8_t>& meshOpaqueFlags);
     void buildTopLevelAS(uint32_t instanceCount);
 
     VulkanResourceCreator* resourceCreator = nullptr;
     vk::raii::Device* device = nullptr;
+    vk::DeviceSize scratchAlignment = 1;  // minAccelerationStructureScratchOffsetAlignment
 
     struct BlasEntry {
         std::optional<vk::raii::AccelerationStructureKHR> as;
         std::optional<vk::raii::Buffer> buffer;
-        std::optional<vk::raii::DeviceMemory> memory;
+        std::optional<GpuAllocation> memory;
     };
+    void createBlasStorage(BlasEntry& entry, vk::DeviceSize size) const;
+
     std::vector<BlasEntry> bottomLevelASes;
+    std::vector<vk::DeviceAddress> blasAddresses;  // per mesh, 0 for meshes without a BLAS
 
     std::optional<vk::raii::AccelerationStructureKHR> topLevelAS;
     std::optional<vk::raii::Buffer> topLevelASBuffer;
-    std::optional<vk::raii::DeviceMemory> topLevelASMemory;
+    std::optional<GpuAllocation> topLevelASMemory;
 
     std::optional<vk::raii::Buffer> instanceBuffer;
-    std::optional<vk::raii::DeviceMemory> instanceMemory;
+    std::optional<GpuAllocation> instanceMemory;
     void* instanceMapped = nullptr;
     uint32_t instanceCapacity = 0;
 
     std::optional<vk::raii::Buffer> topLevelScratchBuffer;
-    std::optional<vk::raii::DeviceMemory> topLevelScratchMemory;
+    std::optional<GpuAllocation> topLevelScratchMemory;
+    vk::DeviceAddress topLevelScratchAddress = 0;  // buffer address rounded up to scratchAlignment
 
     vk::BuildAccelerationStructureFlagsKHR topLevelBuildFlags{};
     vk::DeviceSize topLevelBuildScratchSize = 0;
     vk::DeviceSize topLevelUpdateScratchSize = 0;
+    uint32_t refitsSinceRebuild = 0;
+    UpdateStats lastUpdateStats{};
 };
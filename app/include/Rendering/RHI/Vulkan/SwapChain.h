@@ -5,18 +5,31 @@
 
 #include "Rendering/RHI/Vulkan/VulkanTypes.h"
 #include "Rendering/RHI/Vulkan/VulkanContext.h"
+#include "Rendering/RHI/Vulkan/VulkanResourceCreator.h"
 
+#include <string>
 #include <vector>
 #include <optional>
 
+// Presentable images for the frame loop. In headless mode the images are plain offscreen render targets
+// (color attachment + transfer src): acquire hands them out round-robin, nothing is presented, and the rendergraph
+// leaves them in eTransferSrcOptimal so saveImage() can read them back.
 class SwapChain {
 public:
     SwapChain() = default;
 
     void init(VulkanContext& context, GLFWwindow* window);
+    void initHeadless(VulkanContext& context, VulkanResourceCreator& resourceCreator, vk::Extent2D extent);
     void recreate(VulkanContext& context, GLFWwindow* window);
     void cleanup();
 
+    bool isHeadless() const { return headless; }
+    // Layout the rendergraph hands the image over in at the end of the frame.
+    vk::ImageLayout getFinalLayout() const { return headless ? vk::ImageLayout::eTransferSrcOptimal : vk::ImageLayout::ePresentSrcKHR; }
+    // Headless only: copies image imageIndex (in its final layout, last frame finished rendering) to a binary PPM.
+    // Blocks on the graphics queue. Returns false if the file cannot be written.
+    bool saveImage(VulkanResourceCreator& resourceCreator, uint32_t imageIndex, const std::string& path) const;
+
     vk::SwapchainKHR getSwapChain() const { return static_cast<vk::SwapchainKHR>(*swapChain); }
     vk::ResultValue<uint32_t> acquireNextImage(uint64_t timeout, vk::Semaphore semaphore, vk::Fence fence) const;
     const std::vector<vk::Image>& getImages() const { return swapChainImages; }
@@ -40,6 +53,11 @@ private:
     vk::Extent2D swapChainExtent{};
     std::vector<vk::raii::ImageView> swapChainImageViews;
 
+    bool headless = false;
+    std::vector<ImageAllocation> offscreenImages;
+    std::optional<vk::raii::Queue> headlessQueue;  // signals the acquire fence
+    mutable uint32_t nextHeadlessImage = 0;
+
     GLFWwindow* window = nullptr;
 };
 
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Rendering/RHI/Vulkan/GpuMemoryAllocator.h"
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+class VulkanContext;
+class VulkanResourceCreator;
+
+// Timeline semaphore value that is reached once an upload has landed; 0 = nothing to wait for.
+using UploadTicket = uint64_t;
+
+// Asynchronous uploads through a persistently mapped staging ring.
+// Copies are recorded into the current batch and submitted on flush() (or when the ring runs out of space), on the
+// dedicated transfer queue when the device has one. Every call returns the ticket of the batch it landed in, so a
+// loader can enqueue hundreds of uploads and wait once.
+//
+// Notes:
+// - Source data is copied into the ring before the call returns; the caller may free it immediately.
+// - With a transfer-only queue family, buffers and images are released on the transfer queue and acquired on the
+//   graphics queue (VK_SHARING_MODE_EXCLUSIVE ownership transfer); mip generation also runs on the graphics side.
+// - Uploads larger than the ring get a one-off staging buffer that lives until their batch retires.
+// - Destinations must stay alive until their ticket is reached.
+// - Thread-safe among uploaders, but submits also go to the graphics queue: do not flush while another thread
+//   submits to it (the frame loop).
+class UploadManager {
+public:
+    struct Stats {
+        uint64_t bytes = 0;
+        uint64_t copies = 0;
+        uint64_t batches = 0;
+        uint64_t ringWaits = 0;          // times an upload had to wait for an older batch to free ring space
+        uint64_t oversizeStagings = 0;   // uploads that did not fit the ring
+    };
+
+    void init(VulkanContext& context, VulkanResourceCreator& resourceCreator);
+    // Waits for every pending upload, then releases the ring and queues.
+    void cleanup();
+
+    UploadTicket uploadBuffer(vk::Buffer dst, vk::DeviceSize dstOffset, const void* data, vk::DeviceSize size);
+    // regions[i].bufferOffset is relative to `data`. The image goes from eUndefined to eShaderReadOnlyOptimal; with
+    // generateMips only level 0 is expected in `regions` and the remaining levels are blitted from it.
+    UploadTicket uploadImage(vk::Image dst, vk::Format format, const void* data, vk::DeviceSize size,
+                             const std::vector<vk::BufferImageCopy>& regions, uint32_t mipLevels,
+                             uint32_t layerCount = 1, bool generateMips = false, vk::Extent2D baseExtent = {});
+
+    // Submits the current batch; returns its ticket (or the last submitted one if nothing was pending).
+    UploadTicket flush();
+    void wait(UploadTicket ticket);
+    bool isComplete(UploadTicket ticket) const;
+    // flush() + wait().
+    void waitIdle();
+
+    bool usesTransferQueue() const { return dedicatedTransfer; }
+    Stats getStats() const;
+
+private:
+    struct Batch {
+        std::optional<vk::raii::CommandBuffers> transferCommands;  // transfer queue (dedicated transfer only)
+        std::optional<vk::raii::CommandBuffers> graphicsCommands;  // graphics queue: acquires, mips, final barrier
+        std::vector<vk::raii::Buffer> oversizeBuffers;
+        std::vector<GpuAllocation> oversizeMemory;
+        vk::DeviceSize ringEnd = 0;
+        UploadTicket ticket = 0;
+        bool hasRingData = false;
+        bool hasBufferCopies = false;  // graphics-only path: needs a closing transfer -> read barrier
+    };
+
+    // Staging space for one upload: a range of the ring or a one-off buffer owned by the current batch.
+    struct StagingSlice {
+        vk::Buffer buffer{};
+        vk::DeviceSize offset = 0;
+        void* mapped = nullptr;
+    };
+
+    StagingSlice allocateStaging(vk::DeviceSize size, vk::DeviceSize alignment);
+    bool tryAllocateRing(vk::DeviceSize size, vk::DeviceSize alignment, vk::DeviceSize& offset);
+    vk::raii::CommandBuffer& transferCommands();
+    vk::raii::CommandBuffer& graphicsCommands();
+    UploadTicket flushLocked();
+    void retireCompleted(bool waitForOldest);
+    uint64_t completedValue() const;
+
+    vk::raii::Device* device = nullptr;
+    VulkanResourceCreator* resourceCreator = nullptr;
+    vk::raii::Queue transferQueue{nullptr};
+    vk::raii::Queue graphicsQueue{nullptr};
+    uint32_t transferFamily = 0;
+    uint32_t graphicsFamily = 0;
+    bool dedicatedTransfer = false;
+    std::optional<vk::raii::CommandPool> transferPool;
+    std::optional<vk::raii::CommandPool> graphicsPool;
+    std::optional<vk::raii::Semaphore> timeline;
+
+    std::optional<vk::raii::Buffer> ringBuffer;
+    GpuAllocation ringMemory;
+    uint8_t* ringMapped = nullptr;
+    vk::DeviceSize ringSize = 0;
+    vk::DeviceSize ringHead = 0;  // next write position
+    vk::DeviceSize ringTail = 0;  // start of the oldest in-flight data
+
+    Batch pending;
+    std::deque<Batch> inFlight;
+    UploadTicket nextTicket = 2;  // ticket of the batch being recorded; ticket - 1 is its transfer-queue value
+    UploadTicket lastSubmitted = 0;
+    Stats stats{};
+    mutable std::mutex mutex;
+};
@@ -3,6 +3,7 @@
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 
+#include "Rendering/RHI/Vulkan/PipelineCache.h"
 #include "Rendering/RHI/Vulkan/VulkanTypes.h"
 
 #include <vector>
@@ -12,6 +13,7 @@ class VulkanContext {
 public:
     VulkanContext() = default;
 
+    // A null window creates a headless context: no surface, no VK_KHR_swapchain, present queue = graphics queue.
     void init(GLFWwindow* window);
     void cleanup();
 
@@ -23,13 +25,28 @@ public:
     const vk::raii::Device& getDevice() const { return *device; }
     vk::raii::Queue getGraphicsQueue() const { return device->getQueue(graphicsQueueFamilyIndex, 0); }
     bool hasDevice() const { return device.has_value(); }
+    bool isHeadless() const { return headless; }
     vk::raii::Queue getPresentQueue() const { return device->getQueue(presentQueueFamilyIndex, 0); }
+    uint32_t getGraphicsQueueFamilyIndex() const { return graphicsQueueFamilyIndex; }
+    // Dedicated transfer queue (transfer-only family) when the device has one; otherwise the graphics queue.
+    bool hasDedicatedTransferQueue() const { return transferQueueFamilyIndex != graphicsQueueFamilyIndex; }
+    uint32_t getTransferQueueFamilyIndex() const { return transferQueueFamilyIndex; }
+    vk::raii::Queue getTransferQueue() const { return device->getQueue(transferQueueFamilyIndex, 0); }
     vk::raii::SurfaceKHR& getSurface() { return *surface; }
     const vk::raii::SurfaceKHR& getSurface() const { return *surface; }
     vk::SampleCountFlagBits getMsaaSamples() const { return msaaSamples; }
+    // vkCmdDrawIndexedIndirectCount (Vulkan 1.2 drawIndirectCount); optional, enabled when supported.
+    bool supportsDrawIndirectCount() const { return drawIndirectCountEnabled; }
+    // rayTracingDeviceExtensions + rayQuery/accelerationStructure/bufferDeviceAddress; optional, enabled when supported.
+    // Without it there is no TLAS/BLAS, no RTAO pass and pbr.frag is the pbr_noraytrace variant.
+    bool supportsRayQuery() const { return rayQueryEnabled; }
+    // Shared pipeline cache (loaded from / saved to AppConfig::PIPELINE_CACHE_PATH); every pipeline is created through it.
+    PipelineCache& getPipelineCache() { return pipelineCache; }
 
     QueueFamilyIndices findQueueFamilies(const vk::raii::PhysicalDevice& dev) const;
     SwapChainSupportDetails querySwapChainSupport(const vk::raii::PhysicalDevice& dev) const;
+    // deviceExtensions minus the presentation ones when headless.
+    std::vector<const char*> getRequiredDeviceExtensions() const;
 
 private:
     void createInstance();
@@ -40,9 +57,9 @@ private:
     void createSurface(GLFWwindow* window);
     void pickPhysicalDevice();
     bool isDeviceSuitable(const vk::raii::PhysicalDevice& dev) const;
-    bool hasRequiredRayTracingFeatures(const vk::raii::PhysicalDevice& dev) const;
+    bool hasRayTracingSupport(const vk::raii::PhysicalDevice& dev) const;
     void createLogicalDevice();
-    bool checkDeviceExtensionSupport(const vk::raii::PhysicalDevice& dev) const;
+    bool checkDeviceExtensionSupport(const vk::raii::PhysicalDevice& dev, const std::vector<const char*>& required) const;
     vk::SampleCountFlagBits getMaxUsableSampleCount() const;
 
     static VKAPI_ATTR vk::Bool32 VKAPI_CALL debugCallback(
@@ -59,6 +76,12 @@ private:
     std::optional<vk::raii::Device> device;
     uint32_t graphicsQueueFamilyIndex = 0;
     uint32_t presentQueueFamilyIndex = 0;
+    uint32_t transferQueueFamilyIndex = 0;
     vk::SampleCountFlagBits msaaSamples = vk::SampleCountFlagBits::e1;
+    bool drawIndirectCountEnabled = false;
+    bool pipelineCreationFeedbackEnabled = false;
+    bool rayQueryEnabled = false;
+    bool headless = false;
+    PipelineCache pipelineCache;
 };
 
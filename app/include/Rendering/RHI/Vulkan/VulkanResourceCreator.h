@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Rendering/RHI/Vulkan/GpuMemoryAllocator.h"
+#include "Rendering/RHI/Vulkan/UploadManager.h"
 #include "Rendering/RHI/Vulkan/VulkanTypes.h"
 #include "Rendering/RHI/Vulkan/VulkanContext.h"
 
@@ -7,14 +9,15 @@
 #include <optional>
 #include <functional>
 
+// Memory is sub-allocated from GpuMemoryAllocator blocks (see GpuMemoryAllocator.h).
 struct BufferAllocation {
     vk::raii::Buffer buffer;
-    vk::raii::DeviceMemory memory;
+    GpuAllocation memory;
 };
 
 struct ImageAllocation {
     vk::raii::Image image;
-    vk::raii::DeviceMemory memory;
+    GpuAllocation memory;
 };
 
 class VulkanResourceCreator {
@@ -28,6 +31,15 @@ public:
     ImageAllocation createImage(uint32_t width, uint32_t height, uint32_t mipLevels, vk::SampleCountFlagBits samples,
                                vk::Format format, vk::ImageTiling tiling, vk::ImageUsageFlags usage, vk::MemoryPropertyFlags properties,
                                uint32_t arrayLayers = 1, vk::ImageCreateFlags flags = {});
+    // createImage in two steps, for callers that decide the backing memory themselves (Rendergraph aliasing).
+    vk::raii::Image createUnboundImage(uint32_t width, uint32_t height, uint32_t mipLevels, vk::SampleCountFlagBits samples,
+                                       vk::Format format, vk::ImageTiling tiling, vk::ImageUsageFlags usage,
+                                       uint32_t arrayLayers = 1, vk::ImageCreateFlags flags = {});
+    GpuAllocation bindImageMemory(vk::raii::Image& image, vk::ImageTiling tiling, vk::ImageUsageFlags usage,
+                                  vk::MemoryPropertyFlags properties);
+    // Standalone allocation (never sub-allocated, no dedicated-image chain) that several images are bound to at offset 0.
+    GpuAllocation allocateSharedImageMemory(const vk::MemoryRequirements& requirements, vk::MemoryPropertyFlags properties);
+    bool hasMemoryType(uint32_t memoryTypeBits, vk::MemoryPropertyFlags properties) const;
     vk::raii::ImageView createImageView(vk::Image image, vk::Format format, vk::ImageAspectFlags aspectFlags, uint32_t mipLevels,
                                         vk::ImageViewType viewType = vk::ImageViewType::e2D, uint32_t baseArrayLayer = 0, uint32_t layerCount = 1,
                                         uint32_t baseMipLevel = 0, uint32_t mipLevelCount = 0);
@@ -36,11 +48,17 @@ public:
     void copyBufferToImage(vk::Buffer buffer, vk::Image image, const std::vector<vk::BufferImageCopy>& regions);
     void transitionImageLayout(vk::Image image, vk::Format format, vk::ImageLayout oldLayout, vk::ImageLayout newLayout, uint32_t mipLevels, uint32_t layerCount = 1);
     void generateMipmaps(vk::Image image, vk::Format format, uint32_t texWidth, uint32_t texHeight, uint32_t mipLevels);
+    // Records the blit chain into cb: expects every level in eTransferDstOptimal, leaves them eShaderReadOnlyOptimal.
+    void recordGenerateMipmaps(vk::raii::CommandBuffer& cb, vk::Image image, vk::Format format, uint32_t texWidth,
+                               uint32_t texHeight, uint32_t mipLevels);
 
     template<typename Func>
     void executeSingleTimeCommands(Func&& func);
 
     vk::Format findDepthFormat();
+    GpuMemoryAllocator::Stats getMemoryStats() const { return memoryAllocator.getStats(); }
+    UploadManager& getUploader() { return uploader; }
+    PipelineCache& getPipelineCache() { return *pipelineCache; }
     vk::raii::CommandPool& getCommandPool() { return *commandPool; }
     const vk::raii::CommandPool& getCommandPool() const { return *commandPool; }
     vk::raii::Device& getDevice() { return *device; }
@@ -49,15 +67,17 @@ public:
     const vk::raii::PhysicalDevice& getPhysicalDevice() const { return *physicalDevice; }
 
 private:
-    uint32_t findMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags properties);
     vk::Format findSupportedFormat(const std::vector<vk::Format>& candidates, vk::ImageTiling tiling, vk::FormatFeatureFlags features);
     static bool hasStencilComponent(vk::Format format);
 
     vk::raii::Device* device = nullptr;
     vk::raii::PhysicalDevice* physicalDevice = nullptr;
+    PipelineCache* pipelineCache = nullptr;
     vk::raii::Queue graphicsQueue{nullptr};
     std::optional<vk::raii::CommandPool> commandPool;
     std::optional<vk::raii::Fence> singleTimeFence;
+    GpuMemoryAllocator memoryAllocator;
+    UploadManager uploader;
 };
 
 template<typename Func>
@@ -17,6 +17,12 @@ const std::vector<const char*> validationLayers = {
 const std::vector<const char*> deviceExtensions = {
     VK_KHR_SWAPCHAIN_EXTENSION_NAME,
     VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
+    VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME
+};
+
+// Ray-query shadows/reflections and RTAO. Optional: enabled only when the device supports all of them
+// (VulkanContext::supportsRayQuery()), otherwise the renderer runs without TLAS/BLAS and with constant AO.
+const std::vector<const char*> rayTracingDeviceExtensions = {
     VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME,
     VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME,
     VK_KHR_RAY_QUERY_EXTENSION_NAME,
@@ -32,6 +38,8 @@ struct UniformBufferObject {
 struct QueueFamilyIndices {
     std::optional<uint32_t> graphicsFamily;
     std::optional<uint32_t> presentFamily;
+    // Transfer-only family (DMA engine), optional; uploads fall back to the graphics queue without it.
+    std::optional<uint32_t> transferFamily;
 
     bool isComplete() const {
         return graphicsFamily.has_value() && presentFamily.has_value();
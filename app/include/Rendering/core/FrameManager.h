@@ -26,6 +26,14 @@ public:
         uint32_t firstCommand = 0;
         uint32_t drawCount = 0;
     };
+    // One opaque mesh draw of a node; slots are sorted by (doubleSided, matIndex, meshIndex), so every bucket is a
+    // contiguous slot range.
+    struct SharedOpaqueDrawSlot {
+        uint32_t nodeLinearIndex = 0;
+        uint32_t meshIndex = 0;
+        uint32_t matIndex = 0;
+        bool doubleSided = false;
+    };
 
     enum class PostProcessSetSlot : uint32_t {
         Extract = 0,
@@ -38,9 +46,10 @@ public:
     void init(VulkanContext& context, SwapChain& swapChain, GraphicsPipeline& pipeline,
               Rendergraph& rendergraph, VulkanResourceCreator& resourceCreator,
               Model& model, RayTracingContext& rayTracingContext, uint32_t maxDraws);
-    void recreate(VulkanContext& context, SwapChain& swapChain, GraphicsPipeline& pipeline,
-                  Rendergraph& rendergraph, VulkanResourceCreator& resourceCreator, Model& model,
-                  RayTracingContext& rayTracingContext, uint32_t maxDraws);
+    // Swapchain resize: reallocates only the extent-sized textures (depth/normal/linear-depth resolves, RTAO)
+    // and repoints the material sets at the new RTAO target. Buffers, descriptor pools/sets (material, skybox,
+    // post), samplers, command buffers and frame pacing survive; render-finished semaphores follow the image count.
+    void onSwapchainRecreated(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator);
     void cleanup(vk::raii::Device& device);
 
     void updateUniformBuffer(uint32_t currentImage, vk::Extent2D swapChainExtent, const Camera& camera,
@@ -58,21 +67,52 @@ public:
     vk::Extent2D getSwapChainExtent() const { return swapChainExtent; }
     vk::Buffer getUniformBuffer(uint32_t frameIndex) const;
     uint32_t getCurrentFrame() const { return currentFrame; }
-    void advanceFrame() { currentFrame = (currentFrame + 1) % AppConfig::MAX_FRAMES_IN_FLIGHT; }
+    void advanceFrame()
+    {
+        currentFrame = (currentFrame + 1) % framesInFlight;
+        ++frameSerial;
+    }
 
+    // Frame pacing: every submit signals the next value of one timeline semaphore, and a frame slot is reused once
+    // the value of its previous submit has been reached. Per-frame resources are allocated for
+    // AppConfig::MAX_FRAMES_IN_FLIGHT slots; only the first getFramesInFlight() are cycled.
+    uint32_t getFramesInFlight() const { return framesInFlight; }
+    // Drains the GPU, then cycles `count` slots (clamped to [1, MAX_FRAMES_IN_FLIGHT]) starting at slot 0.
+    void setFramesInFlight(vk::raii::Device& device, uint32_t count);
+    // Blocks until the last submit that used the current slot has finished on the GPU.
+    void waitForCurrentFrameSlot(vk::raii::Device& device) const;
+    void waitForAllFrames(vk::raii::Device& device) const;
+    // Timeline value the current frame's submit must signal; records it as the slot's pending value.
+    uint64_t claimFrameTimelineValue() { return slotTimelineValues[currentFrame] = ++lastTimelineValue; }
+    vk::Semaphore getFrameTimeline() const { return **frameTimeline; }
+    // Signalled by the acquire of the current slot, waited on by its submit (one binary semaphore per slot).
+    vk::Semaphore getImageAvailableSemaphore() const { return *imageAvailableSemaphores[currentFrame]; }
     vk::Semaphore getRenderFinishedSemaphore(uint32_t imageIndex) const { return *renderFinishedSemaphores[imageIndex]; }
-    vk::Fence getInFlightFence() const { return *inFlightFences[currentFrame]; }
-    vk::Fence getImageAvailableFence() const { return *imageAvailableFence; }
 
     void* getDrawDataMapped(uint32_t frameIndex) const;
     vk::Buffer getDrawDataBuffer(uint32_t frameIndex) const;
     void* getIndirectCommandsMapped(uint32_t frameIndex) const;
     vk::Buffer getIndirectCommandsBuffer(uint32_t frameIndex) const;
     uint32_t getMaxDraws() const { return maxDraws; }
-    void prepareSharedOpaqueIndirect(const Model& model, const GlobalMeshBuffer& globalMeshBuffer, const glm::mat4& modelMatrix);
-    const std::vector<glm::mat4>& getSharedNodeWorldMatrices() const { return sharedNodeWorldMatrices; }
+    // Reads Model::getWorldMatrices(); call Model::updateWorldMatrices() first.
+    // nodeVisibility (by linearIndex, may be empty = all visible) compacts culled draws out of the bucket spans.
+    void prepareSharedOpaqueIndirect(const Model& model, const GlobalMeshBuffer& globalMeshBuffer,
+                                     const std::vector<uint8_t>& nodeVisibility);
+    // GPU-driven variant (GpuCullingPass builds the commands): draw data is indexed by slot, so only the world
+    // matrices of nodes changed since this frame slot last synced are rewritten, and the spans cover every slot.
+    // nodeVisibility only filters the transparent queue here.
+    void prepareSharedOpaqueGpuDriven(const Model& model, const std::vector<uint8_t>& nodeVisibility);
+    bool isSharedOpaqueGpuDriven() const { return sharedOpaqueGpuDriven; }
+    bool isSharedNodeVisible(uint32_t linearIndex) const
+    {
+        return sharedNodeVisibility.empty()
+            || (linearIndex < sharedNodeVisibility.size() && sharedNodeVisibility[linearIndex] != 0u);
+    }
     const std::vector<SharedOpaqueBucketSpan>& getSharedOpaqueBucketSpans() const { return sharedOpaqueBucketSpans; }
     uint32_t getSharedOpaqueDrawCount() const { return sharedOpaqueDrawCount; }
+    // Static layout used by the GPU-driven path: slot i is draw id i, spans are bucket ranges over all slots.
+    const std::vector<SharedOpaqueDrawSlot>& getSharedOpaqueSlots() const { return sharedOpaqueSlots; }
+    const std::vector<SharedOpaqueBucketSpan>& getSharedOpaqueSlotSpans() const { return sharedOpaqueSlotSpans; }
 
     void createSkyboxResources(VulkanResourceCreator& resourceCreator, vk::DescriptorSetLayout skyboxLayout,
                                vk::ImageView envCubeView, vk::Sampler envCubeSampler);
@@ -87,6 +127,9 @@ public:
     vk::Format getRtaoFormat() const { return rtaoFormat; }
     vk::ImageView getDepthResolveImageView() const;
     vk::Image getDepthResolveImage() const;
+    // Bumped whenever the extent-sized targets (depth/normal/linear-depth resolves, RTAO) are reallocated. Compare
+    // this rather than image handles: a freed handle value may be reused for the new image.
+    uint64_t getExtentTargetsGeneration() const { return extentTargetsGeneration; }
     vk::Sampler getDepthResolveSampler() const;
     vk::Format getDepthResolveFormat() const { return depthResolveFormat; }
     vk::ImageView getNormalPrepassImageView() const;
@@ -99,8 +142,9 @@ public:
     vk::Image getLinearDepthResolveImage() const;
     vk::Sampler getLinearDepthResolveSampler() const;
     vk::Format getLinearDepthFormat() const { return linearDepthFormat; }
-    vk::ImageView getRtaoHalfHistoryImageViewForFrame(uint32_t frameIndex, bool previous) const;
-    vk::Image getRtaoHalfHistoryImageForFrame(uint32_t frameIndex, bool previous) const;
+    // RTAO temporal history ping-pong, alternating every frame (independent of the frames-in-flight slot count).
+    vk::ImageView getRtaoHalfHistoryImageView(bool previous) const;
+    vk::Image getRtaoHalfHistoryImage(bool previous) const;
     vk::Sampler getRtaoHalfHistorySampler() const;
     vk::ImageView getRtaoAtrousImageView(uint32_t pingPongIndex) const;
     vk::Image getRtaoAtrousImage(uint32_t pingPongIndex) const;
@@ -118,13 +162,14 @@ public:
 private:
     struct GpuTexture {
         std::optional<vk::raii::Image> image;
-        std::optional<vk::raii::DeviceMemory> memory;
+        std::optional<GpuAllocation> memory;
         std::optional<vk::raii::ImageView> view;
         std::optional<vk::raii::Sampler> sampler;
     };
 
-    void createCommandBuffers(vk::raii::Device& device, VulkanResourceCreator& resourceCreator, SwapChain& swapChain);
-    void createSyncObjects(vk::raii::Device& device, SwapChain& swapChain);
+    void createCommandBuffers(vk::raii::Device& device, VulkanResourceCreator& resourceCreator);
+    void createFrameSyncObjects(vk::raii::Device& device);
+    void createRenderFinishedSemaphores(vk::raii::Device& device, SwapChain& swapChain);
     void createUniformBuffers(vk::raii::Device& device, VulkanResourceCreator& resourceCreator);
     void createDrawDataBuffers(vk::raii::Device& device, VulkanResourceCreator& resourceCreator);
     void createIndirectCommandBuffers(vk::raii::Device& device, VulkanResourceCreator& resourceCreator);
@@ -141,6 +186,8 @@ private:
     void createSkyboxVertexBuffer(VulkanResourceCreator& resourceCreator);
     void buildSharedDrawSlots(const Model& model);
 
+    void updateExtentDependentDescriptors(vk::raii::Device& device);
+    void releaseExtentDependentTextures();
     void cleanupSwapChainResources(vk::raii::Device& device);
     void setPbrLights(PBRUniformBufferObject& ubo);
 
@@ -152,7 +199,7 @@ private:
     std::optional<vk::raii::DescriptorSets> descriptorSets;
 
     std::vector<vk::raii::Buffer> uniformBuffers;
-    std::vector<vk::raii::DeviceMemory> uniformBuffersMemory;
+    std::vector<GpuAllocation> uniformBuffersMemory;
     std::vector<void*> uniformBuffersMapped;
 
     GpuTexture defaultBaseColor;
@@ -176,42 +223,48 @@ private:
     GpuTexture rtaoFull;
     vk::Format rtaoFormat = vk::Format::eUndefined;
 
-    std::optional<vk::raii::Fence> imageAvailableFence;
+    std::optional<vk::raii::Semaphore> frameTimeline;
+    std::vector<vk::raii::Semaphore> imageAvailableSemaphores;
     std::vector<vk::raii::Semaphore> renderFinishedSemaphores;
-    std::vector<vk::raii::Fence> inFlightFences;
+    std::array<uint64_t, AppConfig::MAX_FRAMES_IN_FLIGHT> slotTimelineValues{};
+    uint64_t lastTimelineValue = 0;
 
     uint32_t currentFrame = 0;
+    uint64_t frameSerial = 0;  // frames recorded so far, drives the RTAO history ping-pong
+    uint64_t extentTargetsGeneration = 0;
+    uint32_t framesInFlight = AppConfig::FRAMES_IN_FLIGHT;
     bool framebufferResized = false;
+    bool rayTracingEnabled = false;  // VulkanContext::supportsRayQuery(): TLAS binding and RTAO, else constant AO
     uint32_t materialCount = 1;
     uint32_t maxDraws = 1;
 
     std::vector<vk::raii::Buffer> drawDataBuffers;
-    std::vector<vk::raii::DeviceMemory> drawDataBuffersMemory;
+    std::vector<GpuAllocation> drawDataBuffersMemory;
     std::vector<void*> drawDataBuffersMapped;
 
     std::vector<vk::raii::Buffer> indirectCommandBuffers;
-    std::vector<vk::raii::DeviceMemory> indirectCommandBuffersMemory;
+    std::vector<GpuAllocation> indirectCommandBuffersMemory;
     std::vector<void*> indirectCommandBuffersMapped;
-    struct SharedOpaqueDrawSlot {
-        uint32_t nodeLinearIndex = 0;
-        uint32_t meshIndex = 0;
-        uint32_t matIndex = 0;
-        bool doubleSided = false;
-    };
     std::vector<SharedOpaqueDrawSlot> sharedOpaqueSlots;
-    std::vector<glm::mat4> sharedNodeWorldMatrices;
+    std::vector<SharedOpaqueBucketSpan> sharedOpaqueSlotSpans;
     std::vector<SharedOpaqueBucketSpan> sharedOpaqueBucketSpans;
     uint32_t sharedOpaqueDrawCount = 0;
+    std::vector<uint8_t> sharedNodeVisibility;
+    bool sharedOpaqueGpuDriven = false;
+    // Per frame slot: draw data holds the slot-indexed layout synced up to Model::getTransformVersion() == version.
+    // The CPU path writes a compacted layout and clears the flag.
+    std::array<bool, AppConfig::MAX_FRAMES_IN_FLIGHT> drawDataSlotLayout{};
+    std::array<uint64_t, AppConfig::MAX_FRAMES_IN_FLIGHT> drawDataSyncedVersion{};
 
     // 光追反射：Instance LUT + 合并 index/UV buffer（教程 Task 9/10/11）
     std::optional<vk::raii::Buffer> instanceLUTBuffer;
-    std::optional<vk::raii::DeviceMemory> instanceLUTMemory;
+    std::optional<GpuAllocation> instanceLUTMemory;
     std::optional<vk::raii::Buffer> reflectionIndexBuffer;
-    std::optional<vk::raii::DeviceMemory> reflectionIndexMemory;
+    std::optional<GpuAllocation> reflectionIndexMemory;
     std::optional<vk::raii::Buffer> reflectionUVBuffer;
-    std::optional<vk::raii::DeviceMemory> reflectionUVMemory;
+    std::optional<GpuAllocation> reflectionUVMemory;
     std::optional<vk::raii::Buffer> reflectionMaterialParamsBuffer;
-    std::optional<vk::raii::DeviceMemory> reflectionMaterialParamsMemory;
+    std::optional<GpuAllocation> reflectionMaterialParamsMemory;
     std::array<vk::DescriptorImageInfo, AppConfig::MAX_REFLECTION_MATERIAL_COUNT> reflectionBaseColorArrayInfos{};
     uint32_t reflectionMeshCount = 0;
 
@@ -224,7 +277,7 @@ private:
     std::optional<vk::raii::DescriptorSets> postDescriptorSets;
     std::optional<vk::raii::Sampler> postSampler;
     std::optional<vk::raii::Buffer> skyboxVertexBuffer;
-    std::optional<vk::raii::DeviceMemory> skyboxVertexBufferMemory;
+    std::optional<GpuAllocation> skyboxVertexBufferMemory;
 
     glm::mat4 lastViewProj{1.0f};
     uint32_t uniformFrameIndex = 0;
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Configs/AppConfig.h"
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class VulkanContext;
+
+// GPU timings from timestamp queries: one pair of timestamps per named scope (every Rendergraph pass, plus the
+// sub-dispatches passes choose to mark). Each frame slot owns its own query pool; the timestamps recorded in slot N
+// are harvested the next time slot N is recorded (after its frame timeline wait), i.e. frames-in-flight frames later,
+// without VK_QUERY_RESULT_WAIT_BIT.
+//
+// Notes:
+// - Statistics are over a rolling window of the last GPU_PROFILER_WINDOW harvested samples per scope name.
+// - Frames are numbered in recording order (getRecordedFrames); getLastHarvest holds the scopes of the frame harvested
+//   by the latest beginFrame, so consumers can take exactly one sample per frame and skip frames recorded too early.
+// - Scopes whose timestamps are not available yet are dropped (counted as late), never waited on.
+// - Scopes beyond GPU_PROFILER_MAX_SCOPES in a frame are not timed.
+// - Inactive (all calls no-ops) when the graphics queue has no timestamp support or the profiler is disabled.
+// - While Trace is enabled, harvested scopes are also recorded on the trace's "GPU" track. Without calibrated
+//   timestamps the track is anchored at the frame's CPU submit time, so it shows GPU durations and ordering, not
+//   exact CPU/GPU alignment.
+class GpuProfiler {
+public:
+    struct ScopeSummary {
+        std::string name;
+        double lastMs = 0.0;
+        double minMs = 0.0;
+        double avgMs = 0.0;
+        double p99Ms = 0.0;
+        uint32_t samples = 0;
+    };
+
+    struct ScopeTiming {
+        uint32_t nameIndex = 0;  // see getScopeName
+        double ms = 0.0;
+    };
+
+    // Scopes of one harvested frame; late scopes are missing.
+    struct HarvestedFrame {
+        uint64_t frameNumber = 0;  // 1-based recording order, 0 = nothing harvested yet
+        std::vector<ScopeTiming> scopes;
+    };
+
+    void init(VulkanContext& context);
+    void cleanup();
+
+    // Harvests slot frameIndex and resets its queries; record at the start of the slot's command buffer, outside
+    // any rendering. Requires the slot's timeline value to be reached.
+    void beginFrame(vk::raii::CommandBuffer& commandBuffer, uint32_t frameIndex);
+    // Returns a scope id for endScope (UINT32_MAX when not timed).
+    uint32_t beginScope(vk::raii::CommandBuffer& commandBuffer, const std::string& name);
+    void endScope(vk::raii::CommandBuffer& commandBuffer, uint32_t scope);
+    // Call right after submitting slot frameIndex; anchors its scopes on the trace GPU track.
+    void markSubmitted(uint32_t frameIndex);
+    // Drops pending results and the rolling windows (e.g. after a resize, when old timings are not comparable).
+    void reset();
+
+    bool isActive() const { return active; }
+    // Per scope name in first-recorded order; refreshed on every harvest.
+    const std::vector<ScopeSummary>& getSummaries() const { return summaries; }
+    uint64_t getLateScopes() const { return lateScopes; }
+    // Frames recorded so far (beginFrame while active); the frame being recorded has this number.
+    uint64_t getRecordedFrames() const { return recordedFrames; }
+    const HarvestedFrame& getLastHarvest() const { return lastHarvest; }
+    const std::string& getScopeName(uint32_t nameIndex) const { return names[nameIndex]; }
+
+private:
+    struct RecordedScope {
+        uint32_t nameIndex = 0;
+        bool closed = false;
+    };
+
+    struct FrameQueries {
+        std::optional<vk::raii::QueryPool> queryPool;
+        std::vector<RecordedScope> scopes;  // scope i uses queries 2i (begin) and 2i+1 (end)
+        uint64_t submitNs = 0;              // Trace::nowNs() at submit, 0 if not traced
+        uint64_t frameNumber = 0;           // recordedFrames when this slot was last recorded
+    };
+
+    struct ScopeHistory {
+        std::vector<double> samples;  // ring buffer, GPU_PROFILER_WINDOW entries
+        size_t next = 0;
+        double lastMs = 0.0;
+    };
+
+    void harvest(FrameQueries& frame);
+    void updateSummaries();
+    uint32_t internName(const std::string& name);
+
+    std::array<FrameQueries, AppConfig::MAX_FRAMES_IN_FLIGHT> frames{};
+    FrameQueries* recording = nullptr;
+    bool active = false;
+    double nsPerTick = 1.0;
+    uint64_t timestampMask = ~0ull;
+
+    uint32_t traceTrack = UINT32_MAX;
+
+    std::vector<std::string> names;
+    std::vector<const char*> traceNames;  // Trace::intern() of names
+    std::unordered_map<std::string, uint32_t> nameIndices;
+    std::vector<ScopeHistory> histories;  // indexed like names
+    std::vector<ScopeSummary> summaries;
+    HarvestedFrame lastHarvest;
+    uint64_t recordedFrames = 0;
+    uint64_t lateScopes = 0;
+};
+
+// Times the commands recorded during its lifetime; a null profiler makes it a no-op.
+class GpuProfileScope {
+public:
+    GpuProfileScope(GpuProfiler* inProfiler, vk::raii::CommandBuffer& inCommandBuffer, const std::string& name)
+        : profiler(inProfiler)
+        , commandBuffer(inCommandBuffer)
+        , scope(inProfiler ? inProfiler->beginScope(inCommandBuffer, name) : UINT32_MAX)
+    {
+    }
+    ~GpuProfileScope()
+    {
+        if (profiler) {
+            profiler->endScope(commandBuffer, scope);
+        }
+    }
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    GpuProfiler* profiler;
+    vk::raii::CommandBuffer& commandBuffer;
+    uint32_t scope;
+};
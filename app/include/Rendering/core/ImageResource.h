@@ -1,10 +1,19 @@
 #pragma once
 
+#include "Rendering/RHI/Vulkan/GpuMemoryAllocator.h"
 #include "Rendering/RHI/Vulkan/VulkanTypes.h"
 
 #include <optional>
 #include <string>
 
+// Last synchronization scope an image was used with: the layout it is in and the stages/accesses that touched it
+// since the last barrier (reads accumulate until a write or layout change forces a barrier).
+struct ImageSyncState {
+    vk::ImageLayout layout = vk::ImageLayout::eUndefined;
+    vk::PipelineStageFlags2KHR stages{};
+    vk::AccessFlags2KHR access{};
+};
+
 struct ImageResource {
     std::string name;
     vk::Format format;
@@ -18,11 +27,17 @@ struct ImageResource {
     bool isExternal = false;
 
     // Tracked by Rendergraph for barrier insertion.
-    // For external resources, the rendergraph tracks per-swapchain-image layout separately.
-    vk::ImageLayout currentLayout = vk::ImageLayout::eUndefined;
+    // For external resources, the rendergraph tracks state per VkImage handle separately (e.g. per swapchain image).
+    ImageSyncState state{};
+
+    // Lifetime over Rendergraph::executionOrder (positions, inclusive); firstUse == UINT32_MAX if no pass touches it.
+    uint32_t firstUse = UINT32_MAX;
+    uint32_t lastUse = 0;
+    bool firstUseWrites = false;  // first touching pass only writes it, so earlier contents may be discarded
+    int32_t aliasSlot = -1;       // index into Rendergraph alias slots when memory is shared with other resources
 
     std::optional<vk::raii::Image> image;
-    std::optional<vk::raii::DeviceMemory> memory;
+    std::optional<GpuAllocation> memory;  // empty when aliased (the slot owns the memory)
     std::optional<vk::raii::ImageView> view;
 };
 
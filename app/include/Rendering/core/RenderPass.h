@@ -8,6 +8,7 @@
 #include <glm/mat4x4.hpp>
 
 class Camera;
+class GpuProfiler;
 
 struct RenderStats {
     // Draw/管线统计
@@ -23,7 +24,43 @@ struct RenderStats {
     double forwardSortMs = 0.0;
     double forwardIssueMs = 0.0;
 
+    // CPU 层级视锥剔除（HierarchicalCuller + indirect 压缩）
+    uint64_t cullTestedNodes = 0;
+    uint64_t cullCulledNodes = 0;
+    double cullMs = 0.0;
+
+    // GPU 剔除（GpuCullingPass）：计数为 MAX_FRAMES_IN_FLIGHT 帧前的回读结果（非阻塞）
+    uint64_t gpuCullInputDraws = 0;
+    uint64_t gpuCullVisibleDraws = 0;
+    uint64_t gpuCullFrustumCulled = 0;
+    uint64_t gpuCullOcclusionCulled = 0;
+
+    // 遮挡查询（OcclusionCullingPass）：结果在 MAX_FRAMES_IN_FLIGHT 帧后非阻塞回读，未就绪的记为 late 并视为可见
+    uint64_t occlusionDrawCalls = 0;
+    uint64_t occlusionResolvedQueries = 0;
+    uint64_t occlusionLateQueries = 0;
+    uint64_t occlusionHiddenNodes = 0;
+
+    // CPU 软件遮挡剔除（SoftwareOcclusionCuller）：当帧结果
+    uint64_t swOcclusionOccluderTris = 0;
+    uint64_t swOcclusionTestedNodes = 0;
+    uint64_t swOcclusionCulledNodes = 0;
+    double swOcclusionRasterMs = 0.0;
+    double swOcclusionTestMs = 0.0;
+
+    // TLAS 增量更新（RayTracingContext）：本帧重写的 instance 数与 refit/rebuild 次数
+    uint64_t tlasWrittenInstances = 0;
+    uint64_t tlasRefits = 0;
+    uint64_t tlasRebuilds = 0;
+
+    // Rendergraph 屏障：每个 pass 前的转换合并为一次 vkCmdPipelineBarrier2（batches/images），
+    // 生产者与消费者相隔多个 pass 时改用 event 拆分屏障（split，生产者后 set、消费者前 wait）
+    uint64_t graphBarrierBatches = 0;
+    uint64_t graphImageBarriers = 0;
+    uint64_t graphSplitBarriers = 0;
+
     // Pass 级别 CPU 耗时（ms），由 Rendergraph 按 pass 名称写入
+    double gpuCullMs = 0.0;
     double depthPrepassMs = 0.0;
     double rtaoMs = 0.0;
     double skyboxMs = 0.0;
@@ -41,6 +78,7 @@ struct PassExecuteContext {
     glm::mat4 modelMatrix{1.0f};
     const Camera* camera = nullptr;
     RenderStats* stats = nullptr;
+    GpuProfiler* profiler = nullptr;  // optional: passes may time sub-dispatches with GpuProfileScope
 };
 
 class RenderPass {
@@ -53,6 +91,9 @@ public:
     const std::vector<std::string>& getOutputs() const { return outputs; }
     virtual std::optional<vk::ImageLayout> getRequiredInputLayout(const std::string& /*resource*/) const { return std::nullopt; }
     virtual std::optional<vk::ImageLayout> getRequiredOutputLayout(const std::string& /*resource*/) const { return std::nullopt; }
+    // Shader stages that read/write the pass's images outside of attachments (sampled/storage); used by the
+    // Rendergraph to derive barrier stage masks. Compute passes override this.
+    virtual vk::PipelineStageFlags2KHR getShaderStages() const { return vk::PipelineStageFlagBits2KHR::eFragmentShader; }
 
     void execute(const PassExecuteContext& ctx);
 
@@ -34,7 +34,7 @@ private:
     vk::SampleCountFlagBits samples{};
 
     std::optional<vk::raii::Image> image;
-    std::optional<vk::raii::DeviceMemory> memory;
+    std::optional<GpuAllocation> memory;
     std::optional<vk::raii::ImageView> view;
 };
 
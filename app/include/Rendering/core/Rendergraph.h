@@ -7,11 +7,13 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 class Camera;
+class GpuProfiler;
 
 struct ExternalResourceView {
     vk::Image image;
@@ -29,19 +31,24 @@ public:
                      uint32_t extentDivisor = 1);
 
     void AddExternalResource(const std::string& name, vk::Format format, vk::Extent2D extent,
-                             vk::ImageLayout initialLayout, vk::ImageLayout finalLayout);
+                             vk::ImageLayout initialLayout, vk::ImageLayout finalLayout,
+                             vk::ImageAspectFlags aspectFlags = vk::ImageAspectFlagBits::eColor);
 
     void AddPass(std::unique_ptr<RenderPass> pass);
 
     void Compile();
     void Recompile(vk::Extent2D newExtent);
+    // Swapchain resize: reallocates internal images at the new extent but keeps the compiled execution order
+    // (the pass set and their dependencies do not depend on the extent). No-op when the extent is unchanged.
+    void Resize(vk::Extent2D newExtent);
     void Cleanup();
 
     void Execute(vk::raii::CommandBuffer& commandBuffer, uint32_t imageIndex = 0,
                  const glm::mat4& modelMatrix = glm::mat4(1.0f),
                  const std::unordered_map<std::string, ExternalResourceView>& externalViews = {},
                  const Camera* camera = nullptr,
-                 RenderStats* stats = nullptr);
+                 RenderStats* stats = nullptr,
+                 GpuProfiler* profiler = nullptr);
 
     vk::ImageView GetImageView(const std::string& name) const;
     vk::Extent2D GetResourceExtent(const std::string& name) const;
@@ -49,7 +56,42 @@ public:
     bool IsCompiled() const { return compiled; }
 
 private:
+    // Memory shared by internal resources with disjoint lifetimes; members are ordered by first use, and each one
+    // takes over from the previous member (cyclically: the first follows the last one of the previous frame).
+    struct AliasSlot {
+        std::vector<std::string> members;
+        std::optional<GpuAllocation> memory;
+    };
+
+    // How one pass uses one resource (its inputs and outputs merged): the layout, stages and accesses the barrier
+    // in front of the pass must make the image available to.
+    struct PassResourceUsage {
+        std::string name;
+        ImageSyncState scope;
+        bool writes = false;
+    };
+
+    // A write whose next use is more than one pass later: the barrier is signalled with an event right after the
+    // producer and waited on right before the consumer, so the passes in between overlap with the transition.
+    struct SplitBarrier {
+        std::string resource;
+        uint32_t producerOrder = 0;
+        uint32_t consumerOrder = 0;
+        ImageSyncState consumerScope;
+        vk::ImageMemoryBarrier2KHR pending{};  // recorded with the set, replayed by the wait
+        bool signalled = false;
+    };
+
+    std::vector<PassResourceUsage> collectPassUsages(const RenderPass& pass) const;
+    void computeLifetimes();
+    void planSplitBarriers();
     void allocateInternalResources();
+    void releaseInternalResources();
+    // This frame's image and tracked state of a resource (per VkImage handle for externals); nullptr if unbound.
+    ImageSyncState* resolveSyncState(ImageResource& resource,
+                                     const std::unordered_map<std::string, ExternalResourceView>& externalViews,
+                                     vk::Image& image);
+    const ImageSyncState& previousAliasOccupant(const ImageResource& resource) const;
 
     vk::raii::Device& device;
     VulkanResourceCreator& resourceCreator;
@@ -57,9 +99,14 @@ private:
     std::unordered_map<std::string, ImageResource> resources;
     std::vector<std::unique_ptr<RenderPass>> passes;
     std::vector<size_t> executionOrder;
-
-    // Track layout per external VkImage handle (e.g. swapchain images).
-    std::unordered_map<std::string, std::unordered_map<uint64_t, vk::ImageLayout>> externalImageLayouts;
+    std::vector<AliasSlot> aliasSlots;
+    std::vector<SplitBarrier> splitBarriers;
+    // One event per split barrier per frame in flight ([frame slot][split index]).
+    std::vector<std::vector<vk::raii::Event>> splitEvents;
+    uint64_t executeCount = 0;
+
+    // Track sync state per external VkImage handle (e.g. swapchain images).
+    std::unordered_map<std::string, std::unordered_map<uint64_t, ImageSyncState>> externalImageStates;
 
     vk::Extent2D extent{};
     bool compiled = false;
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Engine/Math/GlmConfig.h"
+
+#include <array>
+#include <cstdint>
+
+// Host mirrors of the gpu_cull.comp interface, shared by GpuCullingPass and the headless culling test.
+// Descriptor set: 0 = Params (UBO), 1 = world matrix per draw id, 2 = DrawInstance[], 3 = generated commands,
+// 4 = per-bucket counts followed by the frustum/occlusion culled totals, 5 = Hi-Z pyramid (sampler).
+namespace GpuCull {
+
+constexpr uint32_t GROUP_SIZE = 64u;
+
+// std140 mirror of CullParams.
+struct Params {
+    glm::mat4 viewProj{1.0f};
+    glm::mat4 prevViewProj{1.0f};
+    std::array<glm::vec4, 6> frustumPlanes{};
+    glm::uvec4 counts{0u};      // x = instance count, y = bucket count, z = Hi-Z mip count (0 = off), w = frustum on
+    glm::vec4 hizParams{0.0f};  // xy = depth (full-res) size, zw = Hi-Z mip0 size
+};
+static_assert(sizeof(Params) == 256, "Params must match the std140 layout of CullParams");
+
+// std430 mirror of DrawInstance (one per opaque draw slot, uploaded once).
+struct DrawInstance {
+    glm::vec4 boundsMin{0.0f};  // w = 1 when bounds are valid
+    glm::vec4 boundsMax{0.0f};
+    uint32_t indexCount = 0;
+    uint32_t firstIndex = 0;
+    int32_t vertexOffset = 0;
+    uint32_t bucketIndex = 0;
+    uint32_t bucketFirstCommand = 0;
+    uint32_t pad0 = 0;
+    uint32_t pad1 = 0;
+    uint32_t pad2 = 0;
+};
+static_assert(sizeof(DrawInstance) == 64, "DrawInstance must match the std430 layout in gpu_cull.comp");
+
+}  // namespace GpuCull
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Engine/Math/Frustum.h"
+#include "Engine/Math/FrustumCulling.h"
+
+#include <cstdint>
+#include <vector>
+
+class Model;
+struct Node;
+
+// CPU frustum culler over the node hierarchy (Node::subtreeBounds + Model world matrices).
+// Walks the pre-order linear node list: a rejected node skips its whole [linearIndex, subtreeEnd) range,
+// and a node fully inside some planes passes a reduced plane mask to its children (fully inside all
+// planes accepts the subtree without further tests). Leaf children of a partially visible node are
+// tested together with the SIMD batch kernel (FrustumCulling::CullAabbBatch).
+// Large scenes are split into sibling-subtree ranges on the calling thread (subtrees bigger than
+// PARALLEL_CULL_GRAIN are opened up), the ranges are culled on the JobSystem, and the per-job visible
+// spans are merged into the node visibility array.
+class HierarchicalCuller {
+public:
+    struct Stats {
+        uint32_t testedNodes = 0;
+        uint32_t culledNodes = 0;
+        uint32_t acceptedSubtrees = 0;
+    };
+
+    // Requires Model::updateWorldMatrices() to have run for this frame.
+    void cull(const Model& model, const Frustum& frustum);
+    // Marks every node visible (culling disabled).
+    void setAllVisible(const Model& model);
+
+    // Indexed by Node::linearIndex; 1 = visible.
+    const std::vector<uint8_t>& getNodeVisibility() const { return nodeVisibility; }
+    bool isNodeVisible(uint32_t linearIndex) const
+    {
+        return linearIndex < nodeVisibility.size() && nodeVisibility[linearIndex] != 0u;
+    }
+    const Stats& getStats() const { return stats; }
+
+private:
+    // Partially visible nodes with at least this many children batch-test their leaf children.
+    static constexpr size_t BATCH_MIN_CHILDREN = 8;
+    // Below this many nodes cull() stays on the calling thread.
+    static constexpr uint32_t PARALLEL_CULL_MIN_NODES = 4096;
+    // Sibling subtrees are grouped into job ranges of up to this many nodes.
+    static constexpr uint32_t PARALLEL_CULL_GRAIN = 512;
+
+    enum LeafResult : uint8_t {
+        LEAF_UNTESTED = 0,
+        LEAF_VISIBLE = 1,
+        LEAF_CULLED = 2,
+    };
+
+    enum class NodeResult {
+        Culled,
+        Accepted,  // fully inside: whole subtree visible
+        Partial,   // visible, children need testing with the reduced mask
+    };
+
+    // Consecutive sibling subtrees [begin, end) that inherit the same plane mask.
+    struct CullRange {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        uint32_t planeMask = 0;
+    };
+
+    struct VisibleSpan {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+    };
+
+    struct StackEntry {
+        uint32_t subtreeEnd = 0;
+        uint32_t planeMask = 0;
+    };
+
+    // Per-job output and scratch; ranges never share nodes, so jobs only touch their own context
+    // and their own slice of leafResults.
+    struct JobContext {
+        std::vector<VisibleSpan> visible;
+        std::vector<StackEntry> stack;
+        std::vector<uint32_t> batchNodes;
+        AabbSoA batchBounds;
+        std::vector<uint32_t> batchMask;
+        Stats stats{};
+
+        void markVisible(uint32_t begin, uint32_t end);
+    };
+
+    NodeResult testNode(const Node& node, uint32_t index, const std::vector<glm::mat4>& worldMatrices,
+                        const Frustum& frustum, uint32_t& planeMask, Stats& outStats) const;
+    void splitRanges(const Model& model, const Frustum& frustum, JobContext& ctx);
+    void cullRange(const Model& model, const Frustum& frustum, const CullRange& range, JobContext& ctx);
+    void batchTestLeafChildren(const Node& node, const std::vector<glm::mat4>& worldMatrices,
+                               const Frustum& frustum, uint32_t planeMask, JobContext& ctx);
+
+    std::vector<uint8_t> nodeVisibility;
+    std::vector<uint8_t> leafResults;
+    std::vector<CullRange> pendingRanges;
+    std::vector<CullRange> jobRanges;
+    // [0] is the calling thread's context (split phase / serial path); one more per job range.
+    std::vector<JobContext> contexts;
+    Stats stats{};
+};
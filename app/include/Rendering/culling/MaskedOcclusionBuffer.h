@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Engine/Math/BoundingBox.h"
+#include "Engine/Math/FrustumCulling.h"
+#include "Engine/Math/GlmConfig.h"
+
+#include <cstdint>
+#include <vector>
+
+// CPU software occlusion buffer in the style of masked occlusion culling (Hasselgren et al. 2016).
+// The screen is split into 8x4-pixel tiles. Each tile keeps a conservative far depth for the whole tile (zMax0)
+// and a working layer (zMax1 + 32-bit coverage mask) that is folded into zMax0 once fully covered, so no
+// per-pixel depth is stored. Occluder triangles are rasterized with SIMD edge tests (one tile per call);
+// occludee AABBs are tested against zMax0 of every tile their screen rectangle touches.
+//
+// Notes:
+// - Depth is Vulkan NDC z in [0, 1] (smaller = closer); coverage samples pixel centers.
+// - Occluder triangles crossing the near plane (or far outside the guard band) are dropped, which is
+//   conservative: they simply occlude nothing.
+// - Rasterizing disjoint tile-row ranges touches disjoint tiles, so rows can be split across threads.
+// - No GPU dependency: usable from tools and benchmarks (see runMaskedOcclusionBenchmark).
+class MaskedOcclusionBuffer {
+public:
+    static constexpr uint32_t TILE_WIDTH = 8;
+    static constexpr uint32_t TILE_HEIGHT = 4;
+
+    // Projected occluder triangle (pixel coordinates + NDC depth) with its tile bounding box.
+    struct ScreenTriangle {
+        float x[3] = {};
+        float y[3] = {};
+        float z[3] = {};
+        int32_t tileMinX = 0;
+        int32_t tileMinY = 0;
+        int32_t tileMaxX = -1;  // inclusive; tileMaxX < tileMinX marks a dropped triangle
+        int32_t tileMaxY = -1;
+    };
+
+    // Rounds the resolution up to whole tiles. Clears the buffer.
+    void resize(uint32_t width, uint32_t height);
+    void clear();
+
+    uint32_t getWidth() const { return width; }
+    uint32_t getHeight() const { return height; }
+    uint32_t getTileCountX() const { return tilesX; }
+    uint32_t getTileCountY() const { return tilesY; }
+
+    // Projects one triangle given its clip-space vertices. Returns false (and marks `out` dropped) when it
+    // cannot occlude anything: near-plane crossing, degenerate, off-screen or outside the guard band.
+    bool projectTriangle(const glm::vec4& c0, const glm::vec4& c1, const glm::vec4& c2, ScreenTriangle& out) const;
+
+    // Rasterizes the part of each triangle inside tile rows [tileRowBegin, tileRowEnd).
+    void rasterize(const ScreenTriangle* triangles, size_t count, uint32_t tileRowBegin, uint32_t tileRowEnd,
+                   FrustumCulling::SimdLevel level = FrustumCulling::DetectSimdLevel());
+
+    // True when any part of the box may be visible (conservative: near-plane crossings and boxes leaving the
+    // screen count as visible).
+    bool testAabb(const glm::mat4& worldToClip, const BoundingBox& worldBounds) const;
+
+    // Whole-tile far depth (zMax0) per tile, row-major; for debugging and determinism checks.
+    const std::vector<float>& getTileDepths() const { return zMax0; }
+
+private:
+    void updateTile(uint32_t tile, uint32_t coverage, float triangleDepth);
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t tilesX = 0;
+    uint32_t tilesY = 0;
+    std::vector<float> zMax0;       // far depth valid for the whole tile
+    std::vector<float> zMax1;       // far depth of the working layer
+    std::vector<uint32_t> masks;    // working layer coverage, bit = row * TILE_WIDTH + column
+};
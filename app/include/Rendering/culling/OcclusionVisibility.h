@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Configs/AppConfig.h"
+#include "Engine/Math/GlmConfig.h"
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+class Model;
+
+// Latency-tolerant occlusion visibility built from hardware occlusion queries (one per mesh-carrying node).
+// Each frame slot owns its own query pool; the queries recorded in slot N are harvested the next time slot N is
+// recorded (after its frame timeline wait), i.e. frames-in-flight frames later, without VK_QUERY_RESULT_WAIT_BIT.
+//
+// Semantics are "visible until proven hidden":
+// - a node is hidden only while its latest harvested query reported zero samples
+// - results that are not available yet (late), nodes leaving the frustum and nodes whose bounds contain the
+//   camera fall back to visible
+// - a hidden node keeps being queried, so it reappears frames-in-flight frames after it becomes visible
+class OcclusionVisibilityBuffer {
+public:
+    struct QueryEntry {
+        uint32_t linearIndex = 0;
+        glm::vec3 center{0.0f};
+        glm::vec3 halfExtent{0.0f};
+    };
+
+    struct Stats {
+        uint32_t issuedQueries = 0;    // queries planned for this frame
+        uint32_t resolvedQueries = 0;  // harvested results (from frames-in-flight frames ago)
+        uint32_t lateQueries = 0;      // harvested slots whose result was not available yet (treated as visible)
+        uint32_t hiddenNodes = 0;      // nodes removed from this frame's visibility
+    };
+
+    void init(vk::raii::Device& device, uint32_t maxQueries);
+    void cleanup();
+
+    // Harvests slot frameIndex, then plans this frame's queries from the frustum visibility (indexed by
+    // Node::linearIndex) and builds the combined visibility. Requires the slot's timeline value to be reached
+    // and Model::updateWorldMatrices() for this frame.
+    void beginFrame(uint32_t frameIndex, const Model& model, const std::vector<uint8_t>& frustumVisibility,
+                    const glm::vec3& cameraPosition);
+    // Drops every pending result and forgets all hidden nodes (occlusion disabled, device idle after resize, ...).
+    void reset();
+    // Called by the pass when it did not record this frame's queries, so nothing is harvested from the slot.
+    void discardQueries(uint32_t frameIndex) { frames[frameIndex].issuedCount = 0; }
+
+    // Frustum visibility with proven-hidden subtrees cleared (valid after beginFrame).
+    const std::vector<uint8_t>& getNodeVisibility() const { return nodeVisibility; }
+    const std::vector<QueryEntry>& getQueries(uint32_t frameIndex) const { return frames[frameIndex].queries; }
+    vk::QueryPool getQueryPool(uint32_t frameIndex) const
+    {
+        return frames[frameIndex].queryPool ? static_cast<vk::QueryPool>(*frames[frameIndex].queryPool) : vk::QueryPool{};
+    }
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct FrameQueries {
+        std::optional<vk::raii::QueryPool> queryPool;
+        std::vector<QueryEntry> queries;  // query i covers queries[i].linearIndex
+        uint32_t issuedCount = 0;         // queries recorded into the slot's last command buffer
+    };
+
+    void harvest(FrameQueries& frame);
+
+    std::array<FrameQueries, AppConfig::MAX_FRAMES_IN_FLIGHT> frames{};
+    uint32_t maxQueries = 0;
+    std::vector<uint8_t> hiddenNodes;  // 1 = latest harvested query found no samples
+    std::vector<uint8_t> nodeVisibility;
+    Stats stats{};
+};
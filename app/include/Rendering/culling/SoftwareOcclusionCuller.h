@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Engine/Math/GlmConfig.h"
+#include "Rendering/culling/MaskedOcclusionBuffer.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Model;
+
+// CPU occlusion culling over the node hierarchy with a MaskedOcclusionBuffer (no GPU queries involved).
+// Occluders are the largest opaque meshes (Mesh::vertices/indices) within a triangle budget, picked once per
+// model. Each frame the frustum-visible occluders are rasterized front to back, then every frustum-visible
+// mesh node tests its Node::subtreeBounds; a rejected node drops its whole subtree before draws are emitted.
+//
+// Notes:
+// - Projection and rasterization (split by tile rows) and the node tests run on the JobSystem workers.
+// - Results are for the current frame only: no latency, no popping.
+// - Nodes whose bounds contain the camera are never tested.
+class SoftwareOcclusionCuller {
+public:
+    struct Stats {
+        uint32_t occluders = 0;          // occluder meshes rasterized this frame
+        uint32_t occluderTriangles = 0;  // triangles submitted (before near-plane/off-screen drops)
+        uint32_t testedNodes = 0;
+        uint32_t culledNodes = 0;        // nodes removed from the visibility (whole subtrees)
+        double rasterMs = 0.0;
+        double testMs = 0.0;
+    };
+
+    void setResolution(uint32_t width, uint32_t height) { buffer.resize(width, height); }
+    // Rasterizer path; defaults to the best level the CPU supports (benchmarks compare levels).
+    void setSimdLevel(FrustumCulling::SimdLevel level) { simdLevel = level; }
+    // Re-selects occluders on the next cull() (e.g. after the model changed).
+    void invalidateOccluders() { occludersSelected = false; }
+
+    // Requires Model::updateWorldMatrices() for this frame. frustumVisibility is indexed by Node::linearIndex.
+    void cull(const Model& model, const glm::mat4& viewProj, const glm::vec3& cameraPosition,
+              const std::vector<uint8_t>& frustumVisibility);
+
+    // Frustum visibility with occluded subtrees cleared (valid after cull).
+    const std::vector<uint8_t>& getNodeVisibility() const { return nodeVisibility; }
+    const Stats& getStats() const { return stats; }
+    const MaskedOcclusionBuffer& getBuffer() const { return buffer; }
+
+private:
+    struct Occluder {
+        uint32_t linearIndex = 0;
+        uint32_t meshIndex = 0;
+        uint32_t triangleCount = 0;
+        uint32_t firstTriangle = 0;  // offset into `triangles` for the current frame
+        glm::vec3 worldCenter{0.0f};
+    };
+
+    void selectOccluders(const Model& model);
+    void rasterizeOccluders(const Model& model, const glm::mat4& viewProj, const glm::vec3& cameraPosition);
+
+    MaskedOcclusionBuffer buffer;
+    std::vector<Occluder> occluders;
+    std::vector<Occluder> frameOccluders;
+    std::vector<MaskedOcclusionBuffer::ScreenTriangle> triangles;
+    std::vector<uint32_t> candidates;
+    std::vector<uint8_t> candidateVisible;
+    std::vector<uint8_t> nodeVisibility;
+    FrustumCulling::SimdLevel simdLevel = FrustumCulling::DetectSimdLevel();
+    bool occludersSelected = false;
+    Stats stats{};
+};
+
+// Benchmark on a loaded model along camera paths (CameraPath file format), one pose per
+// AppConfig::BENCHMARK_TIMESTEP. Each pose is frustum-culled (HierarchicalCuller) and then occlusion-culled at
+// every supported SIMD level. Prints one [Perf] line per path and level with raster/test time and the ratio of
+// frustum-visible nodes rejected, and checks that every level produces the scalar tile depths and visibility.
+// Requires Model::updateWorldMatrices(); throws std::runtime_error when a path cannot be loaded.
+void runMaskedOcclusionBenchmark(const Model& model, const std::vector<std::string>& cameraPathFiles, float aspectRatio);
@@ -7,7 +7,7 @@
 
 struct CubemapResult {
     std::optional<vk::raii::Image> image;
-    std::optional<vk::raii::DeviceMemory> memory;
+    std::optional<GpuAllocation> memory;
     std::optional<vk::raii::ImageView> cubeView;
     std::optional<vk::raii::Sampler> sampler;
 };
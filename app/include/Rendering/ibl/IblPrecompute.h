@@ -7,15 +7,15 @@
 
 struct IblResult {
     std::optional<vk::raii::Image> irradianceImage;
-    std::optional<vk::raii::DeviceMemory> irradianceMemory;
+    std::optional<GpuAllocation> irradianceMemory;
     std::optional<vk::raii::ImageView> irradianceView;
 
     std::optional<vk::raii::Image> prefilterImage;
-    std::optional<vk::raii::DeviceMemory> prefilterMemory;
+    std::optional<GpuAllocation> prefilterMemory;
     std::optional<vk::raii::ImageView> prefilterView;
 
     std::optional<vk::raii::Image> brdfLutImage;
-    std::optional<vk::raii::DeviceMemory> brdfLutMemory;
+    std::optional<GpuAllocation> brdfLutMemory;
     std::optional<vk::raii::ImageView> brdfLutView;
 
     std::optional<vk::raii::Sampler> sampler;
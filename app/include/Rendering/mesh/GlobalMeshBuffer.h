@@ -7,6 +7,7 @@
 #include <vector>
 
 class GpuMesh;
+struct CookedMeshStreams;
 
 /// Per-mesh metadata for indirect draw (VkDrawIndexedIndirectCommand fields).
 struct MeshDrawInfo {
@@ -20,7 +21,10 @@ class GlobalMeshBuffer {
 public:
     GlobalMeshBuffer() = default;
 
-    void init(VulkanResourceCreator& resourceCreator, const std::vector<GpuMesh>& meshes);
+    /// `cooked` (optional): the same meshes already laid out back to back in a mapped mesh cache; when its totals
+    /// match, each buffer is filled by a single upload straight from the mapping instead of one upload per mesh.
+    void init(VulkanResourceCreator& resourceCreator, const std::vector<GpuMesh>& meshes,
+              const CookedMeshStreams* cooked = nullptr);
     void cleanup();
 
     vk::Buffer getVertexBuffer() const;
@@ -30,8 +34,8 @@ public:
 
 private:
     std::optional<vk::raii::Buffer> vertexBuffer;
-    std::optional<vk::raii::DeviceMemory> vertexBufferMemory;
+    std::optional<GpuAllocation> vertexBufferMemory;
     std::optional<vk::raii::Buffer> indexBuffer;
-    std::optional<vk::raii::DeviceMemory> indexBufferMemory;
+    std::optional<GpuAllocation> indexBufferMemory;
     std::vector<MeshDrawInfo> meshInfos;
 };
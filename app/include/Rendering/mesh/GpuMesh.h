@@ -23,9 +23,11 @@ public:
 
     bool isUploaded() const { return vertexBuffer.has_value() && indexBuffer.has_value(); }
 
+    // accelerationStructureInput: the buffers also feed BLAS builds (only with VulkanContext::supportsRayQuery()).
     void upload(VulkanResourceCreator& resourceCreator,
                 const std::vector<Vertex>& inVertices,
-                const std::vector<uint32_t>& inIndices);
+                const std::vector<uint32_t>& inIndices,
+                bool accelerationStructureInput);
 
     void reset();
 
@@ -37,15 +39,17 @@ public:
     const std::vector<uint32_t>& getIndices() const { return indices; }
 
 private:
-    void createVertexBuffer(VulkanResourceCreator& resourceCreator, const std::vector<Vertex>& verts);
-    void createIndexBuffer(VulkanResourceCreator& resourceCreator, const std::vector<uint32_t>& idx);
+    void createVertexBuffer(VulkanResourceCreator& resourceCreator, const std::vector<Vertex>& verts,
+                            bool accelerationStructureInput);
+    void createIndexBuffer(VulkanResourceCreator& resourceCreator, const std::vector<uint32_t>& idx,
+                           bool accelerationStructureInput);
 
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
 
     std::optional<vk::raii::Buffer> vertexBuffer;
-    std::optional<vk::raii::DeviceMemory> vertexBufferMemory;
+    std::optional<GpuAllocation> vertexBufferMemory;
     std::optional<vk::raii::Buffer> indexBuffer;
-    std::optional<vk::raii::DeviceMemory> indexBufferMemory;
+    std::optional<GpuAllocation> indexBufferMemory;
 };
 
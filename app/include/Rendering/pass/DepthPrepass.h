@@ -10,12 +10,16 @@
 #include <vector>
 
 class FrameManager;
+class GpuCullingPass;
 
 class DepthPrepass : public RenderPass {
 public:
     DepthPrepass(DepthPrepassPipeline& pipeline, FrameManager& frameManager, Model& model, std::vector<GpuMesh>& meshes,
                  GlobalMeshBuffer& globalMeshBuffer, uint32_t maxDraws, Rendergraph& rendergraph, bool enableDepthResolve);
 
+    // Optional: when the culling pass is active this frame, draw its compacted commands with per-bucket counts.
+    void setGpuCullingPass(const GpuCullingPass* pass) { gpuCullingPass = pass; }
+
 protected:
     void beginPass(const PassExecuteContext& ctx) override;
     void render(const PassExecuteContext& ctx) override;
@@ -30,5 +34,6 @@ private:
     uint32_t maxDraws = 1;
     Rendergraph* rendergraph = nullptr;
     bool enableDepthResolve = false;
+    const GpuCullingPass* gpuCullingPass = nullptr;
 };
 
@@ -12,6 +12,8 @@
 #include <vector>
 #include <glm/mat4x4.hpp>
 
+class GpuCullingPass;
+
 /// Precomputed draw slot: (nodeLinearIndex, meshIndex). Material properties derived from mesh at init.
 struct DrawSlot {
     uint32_t nodeLinearIndex = 0;
@@ -37,6 +39,9 @@ public:
                 Rendergraph& rendergraph, bool clearDepth = false, bool clearColor = true);
     std::optional<vk::ImageLayout> getRequiredOutputLayout(const std::string& resource) const override;
 
+    // Optional: when the culling pass is active this frame, draw its compacted commands with per-bucket counts.
+    void setGpuCullingPass(const GpuCullingPass* pass) { gpuCullingPass = pass; }
+
 protected:
     void beginPass(const PassExecuteContext& ctx) override;
     void render(const PassExecuteContext& ctx) override;
@@ -52,6 +57,7 @@ private:
     Rendergraph* rendergraph = nullptr;
     bool clearDepth = false;
     bool clearColor = true;
+    const GpuCullingPass* gpuCullingPass = nullptr;
 
     // Reused per-frame render queues to avoid allocations.
     std::vector<ForwardDrawItem> transparentItems;
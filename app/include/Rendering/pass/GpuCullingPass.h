@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Engine/Math/GlmConfig.h"
+#include "Rendering/core/FrameManager.h"
+#include "Rendering/core/RenderPass.h"
+#include "Rendering/culling/GpuCullData.h"
+#include "Rendering/pipeline/GpuCullingPipeline.h"
+#include "Rendering/RHI/Vulkan/VulkanContext.h"
+#include "Rendering/RHI/Vulkan/VulkanResourceCreator.h"
+#include "Resource/model/Model.h"
+
+#include <array>
+#include <optional>
+#include <vector>
+
+class GlobalMeshBuffer;
+
+// GPU-driven culling for the shared opaque draws (runs before DepthPrepass).
+// Every opaque draw slot has a persistent device-local instance (MeshDrawInfo, mesh-space AABB, bucket) uploaded
+// once; world matrices live in FrameManager's draw data, indexed by slot and only rewritten when a node moves.
+// gpu_cull.comp tests every instance against the frustum and a Hi-Z pyramid built from the previous frame's depth
+// resolve, and writes the surviving indexed indirect commands compacted per bucket span plus a per-bucket count
+// buffer. DepthPrepass/ForwardPass then draw with vkCmdDrawIndexedIndirectCount; the CPU builds no commands.
+//
+// Notes:
+// - Occlusion uses last frame's depth: objects that become visible this frame appear one frame late.
+// - Hi-Z needs the depth resolve image (MSAA on); without it only the frustum test runs.
+// - CPU node visibility (frustum, software occlusion, queries) only filters the transparent queue on this path.
+// - Count readback is non-blocking: stats report the result of the last use of this frame slot.
+class GpuCullingPass : public RenderPass {
+public:
+    GpuCullingPass(VulkanContext& context, VulkanResourceCreator& resourceCreator, GpuCullingPipeline& pipeline,
+                   FrameManager& frameManager, Model& model, uint32_t maxDraws, bool enableDepthResolve);
+    ~GpuCullingPass() override = default;
+
+    std::optional<vk::ImageLayout> getRequiredInputLayout(const std::string& resource) const override;
+    vk::PipelineStageFlags2KHR getShaderStages() const override { return vk::PipelineStageFlagBits2KHR::eComputeShader; }
+
+    // Uploads the persistent draw instances from FrameManager's opaque slots; call after FrameManager::init().
+    // Waits for the upload, so the buffer is ready before the first frame records.
+    void uploadDrawInstances(const GlobalMeshBuffer& globalMeshBuffer);
+    // True when the pass can build this frame's commands; the Renderer then prepares the GPU-driven draw data
+    // (FrameManager::prepareSharedOpaqueGpuDriven) instead of the CPU indirect buffer.
+    bool canRun(const Camera* camera) const;
+    // True when this frame's culled commands/counts were recorded; draw passes fall back to the CPU buffer otherwise.
+    bool isActiveThisFrame() const { return activeThisFrame; }
+    vk::Buffer getCulledCommandBuffer(uint32_t frameIndex) const;
+    vk::Buffer getDrawCountBuffer(uint32_t frameIndex) const;
+
+protected:
+    void beginPass(const PassExecuteContext& ctx) override;
+    void render(const PassExecuteContext& ctx) override;
+    void endPass(const PassExecuteContext& ctx) override;
+
+private:
+    static constexpr uint32_t MAX_HIZ_MIPS = 16;
+
+    struct PushParams {
+        uint32_t srcWidth = 0;
+        uint32_t srcHeight = 0;
+        uint32_t dstWidth = 0;
+        uint32_t dstHeight = 0;
+    };
+
+    using CullParams = GpuCull::Params;
+    using DrawInstance = GpuCull::DrawInstance;
+
+    struct FrameResources {
+        std::optional<vk::raii::Buffer> paramsBuffer;
+        std::optional<GpuAllocation> paramsMemory;
+        void* paramsMapped = nullptr;
+        std::optional<vk::raii::Buffer> culledCommandBuffer;
+        std::optional<GpuAllocation> culledCommandMemory;
+        std::optional<vk::raii::Buffer> countBuffer;
+        std::optional<GpuAllocation> countMemory;
+        std::optional<vk::raii::Buffer> countReadbackBuffer;
+        std::optional<GpuAllocation> countReadbackMemory;
+        void* countReadbackMapped = nullptr;
+        uint32_t submittedBucketCount = 0;
+        uint32_t submittedInstanceCount = 0;
+        bool hasPendingReadback = false;
+    };
+
+    void createFrameResources();
+    void createDescriptorPool();
+    void createDescriptorSets();
+    void ensureHizResources();
+    void updateCullDescriptors(uint32_t frameIndex);
+    void readBackStats(FrameResources& frame, RenderStats* stats);
+    void buildHiz(vk::raii::CommandBuffer& cb);
+
+    vk::DeviceSize countBufferSize() const { return static_cast<vk::DeviceSize>(maxDraws + 2u) * sizeof(uint32_t); }
+
+    vk::raii::Device* device = nullptr;
+    VulkanResourceCreator* resourceCreator = nullptr;
+    GpuCullingPipeline* pipeline = nullptr;
+    FrameManager* frameManager = nullptr;
+    Model* model = nullptr;
+    uint32_t maxDraws = 1;
+    bool enableDepthResolve = false;
+    bool drawIndirectCountSupported = false;
+
+    std::array<FrameResources, AppConfig::MAX_FRAMES_IN_FLIGHT> frames{};
+    // Persistent per-slot instances; bucket layout matches FrameManager::getSharedOpaqueSlotSpans().
+    std::optional<vk::raii::Buffer> drawInstanceBuffer;
+    std::optional<GpuAllocation> drawInstanceMemory;
+    uint32_t drawInstanceCount = 0;
+    uint32_t drawBucketCount = 0;
+    std::optional<vk::raii::DescriptorPool> descriptorPool;
+    std::optional<vk::raii::DescriptorSets> cullDescriptorSets;
+
+    // Hi-Z pyramid (R32F, mip0 = half the depth resolve size), recreated whenever the depth resolve is reallocated.
+    std::optional<vk::raii::Image> hizImage;
+    std::optional<GpuAllocation> hizMemory;
+    std::optional<vk::raii::ImageView> hizView;
+    std::vector<vk::raii::ImageView> hizMipViews;
+    std::optional<vk::raii::Sampler> hizSampler;
+    std::optional<vk::raii::DescriptorPool> hizDescriptorPool;
+    std::optional<vk::raii::DescriptorSets> hizDescriptorSets;
+    uint64_t hizSourceGeneration = 0;  // FrameManager::getExtentTargetsGeneration() the pyramid sets point at
+    vk::Extent2D hizSourceExtent{};
+    vk::Extent2D hizExtent{};
+    uint32_t hizMipCount = 0;
+    bool hizNeedsLayoutInit = false;
+    // Frames recorded since the pyramid source was (re)created; the depth resolve holds valid history once > 0.
+    uint32_t hizHistoryFrames = 0;
+
+    glm::mat4 lastViewProj{1.0f};
+    bool hasLastViewProj = false;
+    bool activeThisFrame = false;
+    bool hizThisFrame = false;
+};
@@ -3,12 +3,15 @@
 #include "Rendering/core/FrameManager.h"
 #include "Rendering/core/RenderPass.h"
 #include "Rendering/core/Rendergraph.h"
+#include "Rendering/culling/OcclusionVisibility.h"
 #include "Rendering/pipeline/OcclusionPipeline.h"
-#include "Resource/model/Model.h"
 
+// Issues one occlusion query per node planned by OcclusionVisibilityBuffer (bounds box vs this frame's prepass depth).
+// Results are consumed frames-in-flight frames later on the CPU; this pass never waits on them.
 class OcclusionCullingPass : public RenderPass {
 public:
-    OcclusionCullingPass(OcclusionPipeline& pipeline, FrameManager& frameManager, Model& model, Rendergraph& rendergraph);
+    OcclusionCullingPass(OcclusionPipeline& pipeline, FrameManager& frameManager, OcclusionVisibilityBuffer& visibility,
+                         Rendergraph& rendergraph);
 
 protected:
     void beginPass(const PassExecuteContext& ctx) override;
@@ -18,7 +21,7 @@ protected:
 private:
     OcclusionPipeline* pipeline = nullptr;
     FrameManager* frameManager = nullptr;
-    Model* model = nullptr;
+    OcclusionVisibilityBuffer* visibility = nullptr;
     Rendergraph* rendergraph = nullptr;
+    bool activeThisFrame = false;
 };
-
@@ -12,6 +12,9 @@ public:
     RtaoComputePass(vk::raii::Device& device, RtaoComputePipeline& pipeline, FrameManager& frameManager, RayTracingContext& rayTracingContext);
     ~RtaoComputePass() override = default;
 
+    std::optional<vk::ImageLayout> getRequiredInputLayout(const std::string& resource) const override;
+    vk::PipelineStageFlags2KHR getShaderStages() const override { return vk::PipelineStageFlagBits2KHR::eComputeShader; }
+
 protected:
     void beginPass(const PassExecuteContext& ctx) override;
     void render(const PassExecuteContext& ctx) override;
@@ -29,7 +32,7 @@ private:
     void createDescriptorSets();
     void updateDescriptorsForFrame(uint32_t frameIndex);
     void dispatchTrace(vk::raii::CommandBuffer& cb, uint32_t frameIndex);
-    void dispatchAtrous(vk::raii::CommandBuffer& cb, uint32_t frameIndex);
+    void dispatchAtrous(vk::raii::CommandBuffer& cb, uint32_t frameIndex, GpuProfiler* profiler);
     void dispatchUpsample(vk::raii::CommandBuffer& cb, uint32_t frameIndex);
 
     vk::raii::Device* device = nullptr;
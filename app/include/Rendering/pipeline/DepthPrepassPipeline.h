@@ -1,9 +1,9 @@
 #pragma once
 
 #include "Rendering/RHI/Vulkan/VulkanContext.h"
-#include "Rendering/RHI/Vulkan/SwapChain.h"
 #include "Rendering/RHI/Vulkan/VulkanResourceCreator.h"
 #include "Rendering/pipeline/GraphicsPipeline.h"
+#include "Rendering/pipeline/PipelineBuilder.h"
 #include "Resource/shader/Shader.h"
 
 #include <optional>
@@ -13,11 +13,12 @@ class DepthPrepassPipeline {
 public:
     DepthPrepassPipeline() = default;
 
-    void init(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-              const GraphicsPipeline& basePipeline, Shader& vertShader, Shader& fragShader);
+    void init(VulkanContext& context, VulkanResourceCreator& resourceCreator, const GraphicsPipeline& basePipeline,
+              Shader& vertShader, Shader& fragShader, PipelineBuilder& builder);
     void cleanup();
-    void recreate(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                  const GraphicsPipeline& basePipeline, Shader& vertShader, Shader& fragShader);
+    // No-op unless the depth format or MSAA sample count changed.
+    void recreate(VulkanContext& context, VulkanResourceCreator& resourceCreator, const GraphicsPipeline& basePipeline,
+                  Shader& vertShader, Shader& fragShader, PipelineBuilder& builder);
 
     // 0 = backface cull (single-sided), 1 = no cull (double-sided)
     vk::Pipeline getPipeline(bool doubleSided) const
@@ -27,11 +28,12 @@ public:
     }
 
 private:
-    void createPipelines(vk::raii::Device& device, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                        vk::SampleCountFlagBits msaaSamples, vk::PipelineLayout pipelineLayout,
-                        Shader& vertShader, Shader& fragShader);
+    void enqueuePipelines(vk::PipelineLayout pipelineLayout, Shader& vertShader, Shader& fragShader, PipelineBuilder& builder);
+    void createPipeline(bool doubleSided, vk::PipelineLayout pipelineLayout, Shader& vertShader, Shader& fragShader);
 
     std::array<std::optional<vk::raii::Pipeline>, 2> pipelines{};
     vk::Format depthFormat = vk::Format::eUndefined;
+    vk::SampleCountFlagBits msaaSamples = vk::SampleCountFlagBits::e1;
+    PipelineCache* pipelineCache = nullptr;
 };
 
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include <optional>
+
+class PipelineBuilder;
+class PipelineCache;
+class Shader;
+class VulkanContext;
+
+// Compute pipelines for GPU-driven culling:
+// - Hi-Z build: max-reduces the previous frame's resolved depth into an R32F mip pyramid (one dispatch per mip)
+// - cull: per-draw frustum + Hi-Z test that compacts surviving indirect commands and writes per-bucket counts
+class GpuCullingPipeline {
+public:
+    GpuCullingPipeline() = default;
+
+    void init(VulkanContext& context, Shader& hizBuildShader, Shader& cullShader, PipelineBuilder& builder);
+    void cleanup();
+    void recreate(VulkanContext& context, Shader& hizBuildShader, Shader& cullShader, PipelineBuilder& builder);
+    // Descriptor set + pipeline layouts only (first half of init). Lives in GpuCullingPipelineLayouts.cpp, which needs
+    // nothing beyond Vulkan, so the headless GpuCullingTest binds gpu_cull.comp through the same layouts.
+    void initLayouts(vk::raii::Device& device);
+
+    vk::Pipeline getHizBuildPipeline() const { return hizBuildPipeline ? static_cast<vk::Pipeline>(*hizBuildPipeline) : vk::Pipeline{}; }
+    vk::Pipeline getCullPipeline() const { return cullPipeline ? static_cast<vk::Pipeline>(*cullPipeline) : vk::Pipeline{}; }
+    vk::PipelineLayout getHizPipelineLayout() const { return hizPipelineLayout ? static_cast<vk::PipelineLayout>(*hizPipelineLayout) : vk::PipelineLayout{}; }
+    vk::PipelineLayout getCullPipelineLayout() const { return cullPipelineLayout ? static_cast<vk::PipelineLayout>(*cullPipelineLayout) : vk::PipelineLayout{}; }
+    vk::DescriptorSetLayout getHizDescriptorSetLayout() const { return hizDescriptorSetLayout ? static_cast<vk::DescriptorSetLayout>(*hizDescriptorSetLayout) : vk::DescriptorSetLayout{}; }
+    vk::DescriptorSetLayout getCullDescriptorSetLayout() const { return cullDescriptorSetLayout ? static_cast<vk::DescriptorSetLayout>(*cullDescriptorSetLayout) : vk::DescriptorSetLayout{}; }
+
+private:
+    void createDescriptorSetLayouts(vk::raii::Device& device);
+    void createPipelineLayouts(vk::raii::Device& device);
+    void enqueuePipelines(PipelineCache& pipelineCache, Shader& hizBuildShader, Shader& cullShader, PipelineBuilder& builder);
+
+    std::optional<vk::raii::DescriptorSetLayout> hizDescriptorSetLayout;
+    std::optional<vk::raii::DescriptorSetLayout> cullDescriptorSetLayout;
+    std::optional<vk::raii::PipelineLayout> hizPipelineLayout;
+    std::optional<vk::raii::PipelineLayout> cullPipelineLayout;
+    std::optional<vk::raii::Pipeline> hizBuildPipeline;
+    std::optional<vk::raii::Pipeline> cullPipeline;
+};
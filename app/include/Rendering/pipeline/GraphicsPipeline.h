@@ -1,8 +1,8 @@
 #pragma once
 
 #include "Rendering/RHI/Vulkan/VulkanContext.h"
-#include "Rendering/RHI/Vulkan/SwapChain.h"
 #include "Rendering/RHI/Vulkan/VulkanResourceCreator.h"
+#include "Rendering/pipeline/PipelineBuilder.h"
 #include "Resource/shader/Shader.h"
 
 #include <optional>
@@ -13,11 +13,14 @@ class GraphicsPipeline {
 public:
     GraphicsPipeline() = default;
 
-    void init(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-              Shader& vertShader, Shader& fragShader, vk::Format targetColorFormat);
+    // Layouts are created immediately; the four variants are compiled through the builder.
+    void init(VulkanContext& context, VulkanResourceCreator& resourceCreator, Shader& vertShader, Shader& fragShader,
+              vk::Format targetColorFormat, PipelineBuilder& builder);
     void cleanup();
-    void recreate(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                  Shader& vertShader, Shader& fragShader, vk::Format targetColorFormat);
+    // Viewport/scissor are dynamic, so only a color/depth format or MSAA change requires new pipelines.
+    // Layouts are kept, so descriptor sets and dependent pipelines stay valid.
+    void recreate(VulkanContext& context, VulkanResourceCreator& resourceCreator, Shader& vertShader, Shader& fragShader,
+                  vk::Format targetColorFormat, PipelineBuilder& builder);
 
     vk::Format getColorFormat() const { return colorFormat; }
     vk::Format getDepthFormat() const { return depthFormat; }
@@ -27,10 +30,11 @@ public:
     vk::DescriptorSetLayout getDescriptorSetLayout() const { return *descriptorSetLayout; }
 
 private:
-    void createDescriptorSetLayout(vk::raii::Device& device);
-    void createGraphicsPipeline(vk::raii::Device& device, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                                vk::SampleCountFlagBits msaaSamples, Shader& vertShader, Shader& fragShader,
-                                vk::Format targetColorFormat);
+    // Binding 6 (TLAS) only exists with ray query; pbr_noraytrace.frag does not declare it.
+    void createDescriptorSetLayout(vk::raii::Device& device, bool withAccelerationStructure);
+    void createPipelineLayout(vk::raii::Device& device);
+    void enqueuePipelines(Shader& vertShader, Shader& fragShader, PipelineBuilder& builder);
+    void createGraphicsPipeline(uint32_t variantIndex, Shader& vertShader, Shader& fragShader);
 
     std::optional<vk::raii::PipelineLayout> pipelineLayout;
     std::optional<vk::raii::DescriptorSetLayout> descriptorSetLayout;
@@ -38,5 +42,7 @@ private:
     std::array<std::optional<vk::raii::Pipeline>, 4> pipelines{};
     vk::Format colorFormat = vk::Format::eUndefined;
     vk::Format depthFormat = vk::Format::eUndefined;
+    vk::SampleCountFlagBits msaaSamples = vk::SampleCountFlagBits::e1;
+    PipelineCache* pipelineCache = nullptr;
 };
 
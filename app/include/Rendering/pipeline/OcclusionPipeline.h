@@ -1,31 +1,34 @@
 #pragma once
 
 #include "Rendering/RHI/Vulkan/VulkanContext.h"
-#include "Rendering/RHI/Vulkan/SwapChain.h"
 #include "Rendering/RHI/Vulkan/VulkanResourceCreator.h"
 #include "Rendering/pipeline/GraphicsPipeline.h"
+#include "Rendering/pipeline/PipelineBuilder.h"
 #include "Resource/shader/Shader.h"
 
 #include <optional>
 
+// Depth-test-only bounds box pipeline for occlusion queries (vertex stage only, no depth writes, no color).
 class OcclusionPipeline {
 public:
     OcclusionPipeline() = default;
 
-    void init(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-              const GraphicsPipeline& basePipeline, Shader& vertShader, Shader& fragShader);
+    void init(VulkanContext& context, VulkanResourceCreator& resourceCreator, const GraphicsPipeline& basePipeline,
+              Shader& vertShader, PipelineBuilder& builder);
     void cleanup();
-    void recreate(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                  const GraphicsPipeline& basePipeline, Shader& vertShader, Shader& fragShader);
+    // No-op unless the depth format or MSAA sample count changed.
+    void recreate(VulkanContext& context, VulkanResourceCreator& resourceCreator, const GraphicsPipeline& basePipeline,
+                  Shader& vertShader, PipelineBuilder& builder);
 
     vk::Pipeline getPipeline() const { return pipeline ? static_cast<vk::Pipeline>(*pipeline) : vk::Pipeline{}; }
 
 private:
-    void createPipeline(vk::raii::Device& device, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                        vk::SampleCountFlagBits msaaSamples, vk::PipelineLayout pipelineLayout,
-                        Shader& vertShader, Shader& fragShader);
+    void enqueuePipeline(vk::PipelineLayout pipelineLayout, Shader& vertShader, PipelineBuilder& builder);
+    void createPipeline(vk::PipelineLayout pipelineLayout, Shader& vertShader);
 
     std::optional<vk::raii::Pipeline> pipeline;
     vk::Format depthFormat = vk::Format::eUndefined;
+    vk::SampleCountFlagBits msaaSamples = vk::SampleCountFlagBits::e1;
+    PipelineCache* pipelineCache = nullptr;
 };
 
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Engine/Jobs/JobSystem.h"
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+// Compiles pipelines concurrently on the job system.
+// Pipeline classes create their descriptor set / pipeline layouts on the calling thread and enqueue one build per
+// pipeline (or variant); vkCreate*Pipelines is thread-safe and every build goes through the shared PipelineCache.
+// The owner calls wait() before any of the pipelines is used.
+//
+// Notes:
+// - Everything a build references (shaders, layouts, the destination member) must stay alive until wait() returns.
+// - Builds may throw (vk::raii does); the first exception is rethrown from wait() on the calling thread.
+// - With AppConfig::ENABLE_PARALLEL_PIPELINE_BUILD off, builds run inline inside enqueue().
+class PipelineBuilder {
+public:
+    using Build = std::function<void()>;
+
+    PipelineBuilder() = default;
+    // Joins outstanding builds; their errors are dropped (call wait() to observe them).
+    ~PipelineBuilder();
+
+    PipelineBuilder(const PipelineBuilder&) = delete;
+    PipelineBuilder& operator=(const PipelineBuilder&) = delete;
+
+    void enqueue(Build build);
+    // Returns once every enqueued build has finished (the calling thread helps run them).
+    void wait();
+
+    uint32_t getBuildCount() const { return buildCount; }
+    // Time the last wait() blocked the caller (what a resize or startup actually stalls on).
+    double getWaitMs() const { return waitMs; }
+
+private:
+    void run(const Build& build);
+
+    JobCounter counter;
+    std::mutex errorMutex;
+    std::exception_ptr firstError;
+    uint32_t buildCount = 0;
+    double waitMs = 0.0;
+};
@@ -2,6 +2,7 @@
 
 #include "Rendering/RHI/Vulkan/VulkanContext.h"
 #include "Rendering/RHI/Vulkan/VulkanResourceCreator.h"
+#include "Rendering/pipeline/PipelineBuilder.h"
 #include "Resource/shader/Shader.h"
 
 #include <array>
@@ -26,10 +27,11 @@ public:
 
     void init(VulkanContext& context, VulkanResourceCreator& resourceCreator, vk::Format hdrColorFormat, vk::Format swapchainColorFormat,
               Shader& fullscreenVertShader, Shader& bloomExtractFragShader, Shader& bloomBlurFragShader,
-              Shader& tonemapBloomFragShader);
+              Shader& tonemapBloomFragShader, PipelineBuilder& builder);
+    // Keeps the layouts; only pipelines whose target format changed are rebuilt (normally just Tonemap, if at all).
     void recreate(VulkanContext& context, VulkanResourceCreator& resourceCreator, vk::Format hdrColorFormat, vk::Format swapchainColorFormat,
                   Shader& fullscreenVertShader, Shader& bloomExtractFragShader, Shader& bloomBlurFragShader,
-                  Shader& tonemapBloomFragShader);
+                  Shader& tonemapBloomFragShader, PipelineBuilder& builder);
     void cleanup();
 
     vk::Pipeline getPipeline(Mode mode) const;
@@ -38,11 +40,13 @@ public:
 
 private:
     void createDescriptorSetLayout(vk::raii::Device& device);
-    void createPipelines(vk::raii::Device& device, vk::Format hdrColorFormat, vk::Format swapchainColorFormat, Shader& fullscreenVertShader,
-                         Shader& bloomExtractFragShader, Shader& bloomBlurFragShader, Shader& tonemapBloomFragShader);
+    void enqueuePipeline(Mode mode, vk::Format colorFormat, Shader& vertShader, Shader& fragShader, PipelineBuilder& builder);
+    void createPipeline(Mode mode, vk::Format colorFormat, Shader& vertShader, Shader& fragShader);
 
     std::optional<vk::raii::DescriptorSetLayout> descriptorSetLayout;
     std::optional<vk::raii::PipelineLayout> pipelineLayout;
     std::array<std::optional<vk::raii::Pipeline>, static_cast<size_t>(Mode::Count)> pipelines{};
+    std::array<vk::Format, static_cast<size_t>(Mode::Count)> pipelineFormats{};
+    PipelineCache* pipelineCache = nullptr;
 };
 
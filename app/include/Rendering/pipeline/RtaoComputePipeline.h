@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Rendering/RHI/Vulkan/VulkanContext.h"
+#include "Rendering/pipeline/PipelineBuilder.h"
 #include "Resource/shader/Shader.h"
 
 #include <optional>
@@ -9,9 +10,9 @@ class RtaoComputePipeline {
 public:
     RtaoComputePipeline() = default;
 
-    void init(VulkanContext& context, Shader& traceShader, Shader& atrousShader, Shader& upsampleShader);
+    void init(VulkanContext& context, Shader& traceShader, Shader& atrousShader, Shader& upsampleShader, PipelineBuilder& builder);
     void cleanup();
-    void recreate(VulkanContext& context, Shader& traceShader, Shader& atrousShader, Shader& upsampleShader);
+    void recreate(VulkanContext& context, Shader& traceShader, Shader& atrousShader, Shader& upsampleShader, PipelineBuilder& builder);
 
     vk::Pipeline getTracePipeline() const { return tracePipeline ? static_cast<vk::Pipeline>(*tracePipeline) : vk::Pipeline{}; }
     vk::Pipeline getAtrousPipeline() const { return atrousPipeline ? static_cast<vk::Pipeline>(*atrousPipeline) : vk::Pipeline{}; }
@@ -22,7 +23,7 @@ public:
 private:
     void createDescriptorSetLayout(vk::raii::Device& device);
     void createPipelineLayout(vk::raii::Device& device);
-    void createPipelines(vk::raii::Device& device, Shader& traceShader, Shader& atrousShader, Shader& upsampleShader);
+    void enqueuePipelines(PipelineCache& pipelineCache, Shader& traceShader, Shader& atrousShader, Shader& upsampleShader, PipelineBuilder& builder);
 
     std::optional<vk::raii::DescriptorSetLayout> descriptorSetLayout;
     std::optional<vk::raii::PipelineLayout> pipelineLayout;
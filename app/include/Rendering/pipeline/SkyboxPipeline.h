@@ -3,6 +3,7 @@
 #include "Rendering/RHI/Vulkan/VulkanContext.h"
 #include "Rendering/RHI/Vulkan/SwapChain.h"
 #include "Rendering/RHI/Vulkan/VulkanResourceCreator.h"
+#include "Rendering/pipeline/PipelineBuilder.h"
 
 #include <optional>
 #include <vulkan/vulkan.hpp>
@@ -14,7 +15,7 @@ public:
     SkyboxPipeline() = default;
 
     void init(vk::raii::Device& device, VulkanResourceCreator& resourceCreator, vk::Format colorFormat, vk::Format depthFormat,
-              vk::SampleCountFlagBits msaaSamples, Shader& vertShader, Shader& fragShader);
+              vk::SampleCountFlagBits msaaSamples, Shader& vertShader, Shader& fragShader, PipelineBuilder& builder);
     void cleanup();
 
     vk::Pipeline getPipeline() const { return pipeline ? static_cast<vk::Pipeline>(*pipeline) : vk::Pipeline{}; }
@@ -23,7 +24,8 @@ public:
 
 private:
     void createDescriptorSetLayout(vk::raii::Device& device);
-    void createPipeline(vk::raii::Device& device, VulkanResourceCreator& resourceCreator, vk::Format colorFormat, vk::Format depthFormat,
+    void createPipelineLayout(vk::raii::Device& device);
+    void createPipeline(PipelineCache& pipelineCache, vk::Format colorFormat, vk::Format depthFormat,
                         vk::SampleCountFlagBits msaaSamples, Shader& vertShader, Shader& fragShader);
 
     std::optional<vk::raii::DescriptorSetLayout> descriptorSetLayout;
@@ -9,12 +9,19 @@
 #include "Rendering/RHI/Vulkan/RayTracingContext.h"
 #include "ECS/system/CullingSystem.h"
 #include "Rendering/core/FrameManager.h"
+#include "Rendering/core/GpuProfiler.h"
 #include "Rendering/core/Rendergraph.h"
+#include "Rendering/culling/HierarchicalCuller.h"
+#include "Rendering/culling/OcclusionVisibility.h"
+#include "Rendering/culling/SoftwareOcclusionCuller.h"
 #include "Rendering/pipeline/GraphicsPipeline.h"
 #include "Rendering/pipeline/DepthPrepassPipeline.h"
 #include "Rendering/pipeline/SkyboxPipeline.h"
 #include "Rendering/pipeline/RtaoComputePipeline.h"
+#include "Rendering/pipeline/GpuCullingPipeline.h"
+#include "Rendering/pipeline/OcclusionPipeline.h"
 #include "Rendering/pipeline/PostProcessPipeline.h"
+#include "Rendering/pipeline/PipelineBuilder.h"
 #include "Rendering/pass/SkyboxPass.h"
 #include "Rendering/ibl/EquirectToCubemap.h"
 #include "Rendering/ibl/IblPrecompute.h"
@@ -29,14 +36,29 @@
 
 #include <glm/glm.hpp>
 #include <optional>
+#include <string>
 #include <vector>
 
+class GpuCullingPass;
+
 class Renderer {
 public:
+    // CPU time of the main frame stages (drawFrame), in ms.
+    struct CpuTimings {
+        double acquireMs = 0.0;
+        double recordMs = 0.0;
+        double updateUboMs = 0.0;
+        double submitMs = 0.0;
+        double presentMs = 0.0;
+        double totalMs = 0.0;
+    };
+
     Renderer() = default;
     ~Renderer();
 
     void init(GLFWwindow* window);
+    // No window, surface or present: frames render into offscreen images of the given extent (see SwapChain).
+    void initHeadless(vk::Extent2D extent);
     void cleanup();
 
     void drawFrame();
@@ -49,13 +71,32 @@ public:
     bool getWantCaptureKeyboard() const { return imguiIntegration.getWantCaptureKeyboard(); }
     bool getWantTextInput() const { return imguiIntegration.getWantTextInput(); }
     void setCullingSystem(CullingSystem* sys) { cullingSystem = sys; }
-    /// Call when model transform changes (rotation, scale, etc.) so TLAS is rebuilt next frame.
+    // Last completed frame, for benchmark reports.
+    const CpuTimings& getLastCpuTimings() const { return lastCpuTimings; }
+    const RenderStats& getLastRenderStats() const { return lastRenderStats; }
+    const GpuProfiler& getGpuProfiler() const { return gpuProfiler; }
+    GpuMemoryAllocator::Stats getGpuMemoryStats() { return resourceManager.getResourceCreator()->getMemoryStats(); }
+    vk::Extent2D getExtent() const { return swapChain.getExtent(); }
+    bool isHeadless() const { return swapChain.isHeadless(); }
+    uint32_t getFramesInFlight() const { return frameManager.getFramesInFlight(); }
+    /// Headless only: writes the next drawn frame to path (PPM) once it has rendered. Blocks that frame on the GPU.
+    void requestFrameCapture(const std::string& path) { pendingCapturePath = path; }
+    /// Forces a full instance rewrite + TLAS rebuild next frame (transform changes are tracked per node already).
     void invalidateTlas() { tlasNeedsUpdate = true; }
+    /// Runs runMaskedOcclusionBenchmark on the loaded scene model (scene matrix applied) at the current aspect ratio.
+    void runOcclusionBenchmark(const std::vector<std::string>& cameraPathFiles);
 
 private:
     void recordCommandBuffer(vk::raii::CommandBuffer& commandBuffer, uint32_t imageIndex, const glm::mat4& modelMatrix);
     glm::mat4 computeSceneModelMatrix() const;
     void rebuildRayTracingInstances(const glm::mat4& modelMatrix);
+    void updateRayTracingInstances(vk::raii::CommandBuffer& commandBuffer, const glm::mat4& modelMatrix);
+    // Swapchain resize/out-of-date: reallocates extent-sized resources only.
+    void recreateSwapChain();
+    // Prints and resets the pipeline cache counters (created / cache hits / create time) for one stage,
+    // plus how many compiles went through the builder and how long the main thread blocked joining them.
+    void reportPipelineStats(const char* stage, const PipelineBuilder& builder);
+    bool isUiEnabled() const { return AppConfig::ENABLE_IMGUI && !swapChain.isHeadless(); }
 
     VulkanContext vulkanContext;
     SwapChain swapChain;
@@ -70,6 +111,9 @@ private:
     ResourceHandle<Shader> rtaoTraceCompShaderHandle;
     ResourceHandle<Shader> rtaoAtrousCompShaderHandle;
     ResourceHandle<Shader> rtaoUpsampleCompShaderHandle;
+    ResourceHandle<Shader> hizBuildCompShaderHandle;
+    ResourceHandle<Shader> gpuCullCompShaderHandle;
+    ResourceHandle<Shader> occlusionBoundsVertShaderHandle;
     ResourceHandle<Shader> fullscreenVertShaderHandle;
     ResourceHandle<Shader> bloomExtractFragShaderHandle;
     ResourceHandle<Shader> bloomBlurFragShaderHandle;
@@ -77,10 +121,13 @@ private:
     GraphicsPipeline graphicsPipeline;
     DepthPrepassPipeline depthPrepassPipeline;
     RtaoComputePipeline rtaoComputePipeline;
+    GpuCullingPipeline gpuCullingPipeline;
+    OcclusionPipeline occlusionPipeline;
     SkyboxPipeline skyboxPipeline;
     PostProcessPipeline postProcessPipeline;
     RayTracingContext rayTracingContext;
     std::optional<Rendergraph> rendergraph;
+    GpuCullingPass* gpuCullingPassPtr = nullptr;  // owned by the rendergraph
     FrameManager frameManager;
     std::vector<GpuMesh> modelMeshes;
     GlobalMeshBuffer globalMeshBuffer;
@@ -88,28 +135,29 @@ private:
     CubemapResult envCubemapResult;
     IblResult iblResult;
     std::vector<RayTracingInstanceDesc> rayTracingInstances;
+    std::vector<uint32_t> rayTracingInstanceNodes;  // Node::linearIndex per instance
+    std::vector<RayTracingInstanceRange> tlasDirtyRanges;
+    HierarchicalCuller nodeCuller;
+    OcclusionVisibilityBuffer occlusionVisibility;
+    GpuProfiler gpuProfiler;
+    SoftwareOcclusionCuller softwareOcclusionCuller;
     AnimationPlayer animationPlayer;
     ImGuiIntegration imguiIntegration;
 
-    bool tlasNeedsUpdate = true;  // true on init; set false after TLAS build; set true on animation/transform change
-    std::optional<glm::mat4> cachedModelMatrixForTlas;  // detect scene-level rotation/scale change
+    bool tlasNeedsUpdate = true;  // true on init / invalidateTlas(): full instance rewrite; otherwise only changed nodes
+    uint64_t tlasTransformVersion = 0;  // Model::getTransformVersion() the current TLAS instances were written from
 
     // Per-frame stats (for lightweight CPU-side validation / profiling output).
     RenderStats lastRenderStats{};
-    struct CpuTimings {
-        double acquireMs = 0.0;
-        double recordMs = 0.0;
-        double updateUboMs = 0.0;
-        double submitMs = 0.0;
-        double presentMs = 0.0;
-        double totalMs = 0.0;
-    };
     CpuTimings lastCpuTimings{};
     CpuTimings accumCpuTimings{};
     uint32_t accumFrames = 0;
     uint64_t swapchainRecreateCount = 0;
     uint64_t frameCounter = 0;
 
+    vk::Extent2D headlessExtent{};
+    std::string pendingCapturePath;
+
     GLFWwindow* window = nullptr;
     const Camera* camera = nullptr;
     CullingSystem* cullingSystem = nullptr;
@@ -0,0 +1,33 @@
+#pragma once
+
+// System
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Read-only memory mapping of a whole file (MapViewOfFile on Windows, mmap elsewhere).
+// Pages are faulted in on first touch and shared with the OS file cache, so opening a large file is cheap and
+// reading it is a plain memcpy. The mapping lives as long as the last shared_ptr to it.
+class MappedFile {
+public:
+    // nullptr if the file cannot be opened or mapped (empty files are not mappable).
+    static std::shared_ptr<const MappedFile> open(const std::string& path);
+
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    MappedFile() = default;
+
+    const uint8_t* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
@@ -11,6 +11,9 @@
 #include <vulkan/vulkan.hpp>
 #include <vulkan/vulkan_raii.hpp>
 
+// Project
+#include "Rendering/RHI/Vulkan/GpuMemoryAllocator.h"
+
 struct GltfSampler {
     // Keep raw glTF numeric enums (tinygltf uses GL constants).
     int magFilter = -1;
@@ -47,7 +50,7 @@ struct GltfTexture {
 
     // GPU-side resources (created during glTF load when Vulkan is available).
     std::optional<vk::raii::Image> image;
-    std::optional<vk::raii::DeviceMemory> memory;
+    std::optional<GpuAllocation> memory;
     std::optional<vk::raii::ImageView> imageView;
     std::optional<vk::raii::Sampler> vkSampler;
 };
@@ -0,0 +1,51 @@
+#pragma once
+
+// System
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Project
+#include "Resource/texture/KtxTextureLoader.h"
+
+class Model;
+
+/**
+ * 烘焙后的二进制模型缓存（<source>.vkmesh），与源资源放在一起。
+ *
+ * 文件布局：Header + SectionEntry[sectionCount] + 各 section（16 字节对齐）。
+ * 全部 mesh 的 Vertex 流与 index 流按 mesh 顺序连续存放（即 GlobalMeshBuffer 的布局），
+ * 可直接从映射内存拷贝进 staging；节点层级、材质、包围盒、蒙皮、动画与内嵌 KTX2 数据一并保存，热启动不再经过 tinygltf。
+ *
+ * 失效条件：formatVersion / loaderVersion / settingsHash 不符，Vertex/Material 大小变化，
+ * 或任一依赖文件（源文件及外部 .bin / 图片）的大小或内容哈希变化。
+ */
+class MeshCache {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    static std::string cachePathFor(const std::string& sourcePath);
+
+    /**
+     * 读取缓存并填充 model（含 CookedMeshStreams）；纹理只填元数据，KTX2 数据以 outTextures 指向映射内存返回
+     * @param reason 未命中时写入原因（missing / invalid: ... / stale: ...）
+     */
+    static bool read(const std::string& sourcePath, uint32_t loaderVersion, uint64_t settingsHash,
+                     Model& model, std::vector<KtxMemorySource>& outTextures, std::string* reason = nullptr);
+
+    /**
+     * 将已加载的 model 写入缓存（先写临时文件再 rename，不会留下半个文件）
+     * @param dependencies 源文件之外、影响结果的文件（.gltf 的外部 buffer / 图片）
+     * @param textures 与 model.getTextures() 一一对应的 KTX2 原始数据
+     */
+    static bool write(const std::string& sourcePath, uint32_t loaderVersion, uint64_t settingsHash,
+                      const Model& model, const std::vector<std::string>& dependencies,
+                      const std::vector<KtxMemorySource>& textures);
+
+    /** 校验缓存结构：header、section 表、内容哈希，以及所有记录中的范围/索引/节点树是否合法 */
+    static bool validate(const uint8_t* data, size_t size, std::string* error = nullptr);
+
+    /** 64 位内容哈希（XXH64 风格，大块数据在 JobSystem 上分块并行） */
+    static uint64_t hashBytes(const uint8_t* data, size_t size);
+};
@@ -1,6 +1,8 @@
 #pragma once
 
 // System
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -13,6 +15,19 @@
 #include "Resource/model/Mesh.h"
 #include "Resource/model/Node.h"
 #include "Resource/model/Skin.h"
+#include "Resource/model/TransformStore.h"
+
+class MappedFile;
+
+/// Whole-model vertex/index streams in GlobalMeshBuffer layout (meshes back to back, indices mesh-local),
+/// pointing into a memory-mapped mesh cache. Only present when the model came from MeshCache.
+struct CookedMeshStreams {
+    std::shared_ptr<const MappedFile> file;
+    const Vertex* vertices = nullptr;
+    size_t vertexCount = 0;
+    const uint32_t* indices = nullptr;
+    size_t indexCount = 0;
+};
 
 class Model : public Resource {
 public:
@@ -31,6 +46,25 @@ public:
     /// Updates animation, returns true if any node transform was modified (for TLAS invalidation).
     bool updateAnimation(uint32_t index, float deltaTime);
 
+    /// Flags a node whose TRS/matrix was edited outside updateAnimation().
+    void markTransformDirty(Node* node);
+    /// Re-propagates cached world matrices for dirty subtrees only (every node when sceneMatrix changed).
+    /// Returns the number of nodes whose world matrix was recomputed.
+    uint32_t updateWorldMatrices(const glm::mat4& sceneMatrix);
+    /// Cached matrices indexed by Node::linearIndex; valid after updateWorldMatrices().
+    const std::vector<glm::mat4>& getLocalMatrices() const { return localMatrices; }
+    const std::vector<glm::mat4>& getWorldMatrices() const { return worldMatrices; }
+    /// Bumped whenever any cached world matrix changes (lets consumers skip redundant work).
+    uint64_t getTransformVersion() const { return transformVersion; }
+    /// Per node (by linearIndex): the transform version that last changed its world matrix. A consumer synced
+    /// at version V only needs the nodes whose entry is greater than V.
+    const std::vector<uint64_t>& getNodeWorldVersions() const { return nodeWorldVersions; }
+
+    /// Mapped vertex/index streams when loaded from the mesh cache, else nullptr.
+    const CookedMeshStreams* getCookedMeshStreams() const { return cookedMeshStreams.file ? &cookedMeshStreams : nullptr; }
+    /// Drops the cache mapping once the streams have been uploaded.
+    void releaseCookedMeshStreams() { cookedMeshStreams = CookedMeshStreams{}; }
+
 protected:
     bool doLoad() override;
     void doUnload() override;
@@ -38,10 +72,24 @@ protected:
 private:
     friend class GltfModelLoader;
     friend class ObjModelLoader;
+    friend class MeshCache;
 
     void clear();
     void rebuildLinearNodes();
     void rebuildBounds();
+    // Re-derives Node::subtreeBounds of every ancestor of movedNodes (children first) from the cached locals.
+    void refitAncestorBounds();
+
+    // Contiguous pre-order node range whose world matrices are recomputed together.
+    struct TransformRange {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        bool composeLocals = false;
+    };
+    // Below this many dirty nodes updateWorldMatrices() stays on the calling thread.
+    static constexpr uint32_t PARALLEL_TRANSFORM_MIN_NODES = 4096;
+    // Subtrees up to this size become one job.
+    static constexpr uint32_t PARALLEL_TRANSFORM_GRAIN = 512;
 
     std::vector<std::unique_ptr<Node>> ownedNodes;
     std::vector<Node*> nodes;
@@ -51,5 +99,19 @@ private:
     std::vector<Mesh> meshes;
     std::vector<Skin> skins;
     std::vector<Animation> animations;
+    CookedMeshStreams cookedMeshStreams;
+
+    TransformStore transformStore;
+    std::vector<glm::mat4> localMatrices;
+    std::vector<glm::mat4> worldMatrices;
+    std::vector<uint64_t> nodeWorldVersions;
+    std::vector<TransformRange> dirtyRanges;
+    std::vector<TransformRange> parallelRanges;
+    std::vector<uint32_t> movedNodes;       // linear indices whose local matrix changed this update
+    std::vector<uint32_t> refitNodes;       // their ancestors, refit bottom-up
+    std::vector<uint8_t> refitMarks;        // per node: already queued in refitNodes
+    glm::mat4 cachedSceneMatrix = glm::mat4(1.0f);
+    bool hasCachedSceneMatrix = false;
+    uint64_t transformVersion = 0;
 };
 
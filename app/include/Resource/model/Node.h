@@ -27,12 +27,18 @@ struct Node {
     glm::mat4 matrix = glm::mat4(1.0f);
     bool hasMatrix = false;
 
-    // Local-space bounds of this node's subtree (node space). Built once after loading.
+    // Local-space bounds of this node's subtree (node space). Built after loading; Model::updateWorldMatrices() refits
+    // the ancestors of nodes whose local transform changed (animation).
     BoundingBox subtreeBounds{};
     bool hasSubtreeBounds = false;
 
     // Stable index inside Model::getLinearNodes(). Used for culling & query indexing.
     uint32_t linearIndex = UINT32_MAX;
+    // One past the last linear index of this node's subtree: [linearIndex, subtreeEnd) is the whole subtree (pre-order).
+    uint32_t subtreeEnd = UINT32_MAX;
+
+    // Set whenever TRS/matrix changes; Model::updateWorldMatrices() re-propagates the subtree and clears it.
+    bool transformDirty = true;
 
     glm::mat4 getLocalMatrix() const;
     glm::mat4 getGlobalMatrix() const;
@@ -0,0 +1,47 @@
+#pragma once
+
+// System
+#include <cstdint>
+#include <vector>
+
+// Project
+#include "Engine/Math/GlmConfig.h"
+
+struct Node;
+
+// Flat structure-of-arrays copy of a node hierarchy's local transforms.
+// Entries are parent-sorted (parent index < child index), which Model::getLinearNodes() pre-order
+// guarantees, so world matrices can be propagated in a single forward sweep.
+// composeLocal()/propagate() pick SSE4.1 (4 nodes) or AVX2 (8 nodes) at runtime via FrustumCulling::DetectSimdLevel(),
+// with a scalar fallback. propagate() multiplies a whole batch at once when no node in it parents another.
+class TransformStore {
+public:
+    static constexpr int32_t NO_PARENT = -1;
+
+    void build(const std::vector<Node*>& linearNodes);
+    void clear();
+
+    // Copies a node's TRS/matrix into slot `index` (call after the node was animated).
+    void setLocal(uint32_t index, const Node& node);
+
+    // local[i] = T * R * S (or the override matrix) for i in [begin, end).
+    void composeLocal(uint32_t begin, uint32_t end, glm::mat4* outLocal) const;
+    // world[i] = world[parent[i]] * local[i] (rootMatrix for roots) for i in [begin, end).
+    // Parents outside the range must already hold valid world matrices.
+    void propagate(uint32_t begin, uint32_t end, const glm::mat4& rootMatrix,
+                   const glm::mat4* local, glm::mat4* outWorld) const;
+
+    uint32_t size() const { return static_cast<uint32_t>(parents.size()); }
+    const std::vector<int32_t>& getParents() const { return parents; }
+
+    // Name of the SIMD path selected for this CPU ("avx2", "sse4.1" or "scalar"), for [Perf] output.
+    static const char* simdPathName();
+
+private:
+    std::vector<float> tx, ty, tz;
+    std::vector<float> rx, ry, rz, rw;
+    std::vector<float> sx, sy, sz;
+    std::vector<uint8_t> hasMatrix;
+    std::vector<glm::mat4> matrices;
+    std::vector<int32_t> parents;
+};
@@ -1,10 +1,16 @@
 #pragma once
 
+// System
+#include <cstdint>
+
 // Project
 #include "Resource/model/loaders/IModelLoader.h"
 
 class GltfModelLoader final : public IModelLoader {
 public:
+    // Baked into the mesh cache; bump whenever decoding changes what ends up in Model.
+    static constexpr uint32_t CACHE_LOADER_VERSION = 1;
+
     bool loadFromFile(const std::string& filePath, Model& outModel) override;
 };
 
@@ -18,7 +18,7 @@ struct HdrTextureResult {
     vk::Format format = vk::Format::eUndefined;
 
     std::optional<vk::raii::Image> image;
-    std::optional<vk::raii::DeviceMemory> memory;
+    std::optional<GpuAllocation> memory;
     std::optional<vk::raii::ImageView> imageView;
     std::optional<vk::raii::Sampler> sampler;
 };
@@ -67,11 +67,19 @@ struct KtxTextureResult {
     std::vector<KtxTextureLevel> levels;
 
     std::optional<vk::raii::Image> image;
-    std::optional<vk::raii::DeviceMemory> memory;
+    std::optional<GpuAllocation> memory;
     std::optional<vk::raii::ImageView> imageView;
     std::optional<vk::raii::Sampler> sampler;
 };
 
+/** 批量加载的单个输入（内存中的 KTX2 数据，需在加载期间保持有效） */
+struct KtxMemorySource {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::string name;
+    std::optional<bool> colorIsSrgb;
+};
+
 /**
  * 通用 KTX2 纹理加载器，支持：
  * - 从文件加载（天空盒、独立纹理等）
@@ -106,4 +114,15 @@ public:
         const KtxSamplerParams* samplerParams = nullptr,
         const std::string& name = {},
         std::optional<bool> colorIsSrgb = std::nullopt);
+
+    /**
+     * 批量从内存加载（glTF 全部内嵌纹理）：在 JobSystem 线程上并行解析/转码，转码完成即提交到 UploadManager
+     * 结果与 sources 一一对应，与逐个调用 loadFromMemory 等价；GPU 上传为异步，使用前需等待 uploader
+     * @param resourceCreator 非空时上传到 GPU
+     * @param samplerParams 非空时为每张纹理创建 Sampler
+     */
+    static std::vector<std::optional<KtxTextureResult>> loadBatchFromMemory(
+        const std::vector<KtxMemorySource>& sources,
+        VulkanResourceCreator* resourceCreator = nullptr,
+        const KtxSamplerParams* samplerParams = nullptr);
 };
@@ -23,7 +23,7 @@ private:
     void createVulkanImage(unsigned char* data, int width, int height, int channels);
 
     std::optional<vk::raii::Image> textureImage;
-    std::optional<vk::raii::DeviceMemory> textureImageMemory;
+    std::optional<GpuAllocation> textureImageMemory;
     std::optional<vk::raii::ImageView> textureImageView;
     std::optional<vk::raii::Sampler> textureSampler;
 
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Configs/AppConfig.h"
+#include "Engine/Camera/CameraPath.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Camera;
+class Renderer;
+
+// Benchmark run (--benchmark=PATH): see AppConfig::BENCHMARK_*.
+struct BenchmarkOptions {
+    std::string cameraPath;
+    uint32_t warmupFrames = AppConfig::BENCHMARK_WARMUP_FRAMES;
+    uint32_t measuredFrames = AppConfig::BENCHMARK_FRAMES;  // 0 = one pass over the camera path
+    std::string reportPath = AppConfig::BENCHMARK_REPORT_PATH;
+};
+
+// Deterministic benchmark: a fixed timestep drives animation and the camera path, so two builds render the same
+// frame sequence. Warmup frames hold the path's first pose (caches, pipeline compiles, upload and query latency
+// settle), then every measured frame samples the renderer's CPU stage times, per-pass stats, draw counts and GPU
+// scope timings. The JSON report holds avg/min/p50/p95/p99/max per metric plus GPU memory usage at the end.
+//
+// Notes:
+// - Windowed runs present with FIFO, so CPU stage times include vsync waits; use --headless for throughput numbers.
+// - GPU scope samples come from each harvested frame recorded after warmup (frames-in-flight frames behind), one per
+//   scope and frame; the last frames-in-flight measured frames are not harvested before the report is written.
+class BenchmarkRunner {
+public:
+    // Throws std::runtime_error when the camera path cannot be loaded.
+    explicit BenchmarkRunner(const BenchmarkOptions& inOptions);
+
+    float getTimestep() const { return AppConfig::BENCHMARK_TIMESTEP; }
+    // Poses the camera for the next frame.
+    void beginFrame(Camera& camera);
+    // Samples the frame just drawn; returns true once the run is complete and the report has been written.
+    bool endFrame(Renderer& renderer);
+
+private:
+    struct Metric {
+        std::string name;
+        std::string unit;
+        std::vector<double> samples;
+    };
+
+    void sample(const std::string& name, const char* unit, double value);
+    bool writeReport(Renderer& renderer) const;
+
+    BenchmarkOptions options;
+    CameraPath cameraPath;
+    uint32_t measuredFrames = 0;
+    uint32_t frame = 0;
+    uint64_t firstMeasuredGpuFrame = 1;  // GpuProfiler frame number of the first measured frame
+    uint64_t lastSampledGpuFrame = 0;
+    std::vector<Metric> metrics;  // first-sampled order
+};
+
+// Compares two benchmark reports metric by metric (avg). A time ("ms") or memory ("MB") metric that grew by more than
+// thresholdPercent, and by more than the noise floor (AppConfig::BENCHMARK_COMPARE_MIN_DELTA), is a regression;
+// count changes are listed but never flagged. Returns 0 when clean, 1 on regressions, 2 if a report cannot be read.
+int compareBenchmarkReports(const std::string& basePath, const std::string& currentPath, double thresholdPercent);
@@ -8,12 +8,33 @@
 #include "Engine/Camera/Camera.h"
 #include "ECS/core/Scene.h"
 #include "ECS/system/CullingSystem.h"
+#include "Configs/AppConfig.h"
+#include "Runtime/BenchmarkRunner.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+// Headless run (--headless): fixed frame count at a fixed resolution, no window; see AppConfig::HEADLESS_*.
+struct HeadlessOptions {
+    uint32_t width = AppConfig::HEADLESS_WIDTH;
+    uint32_t height = AppConfig::HEADLESS_HEIGHT;
+    uint32_t frameCount = AppConfig::HEADLESS_FRAME_COUNT;
+    uint32_t captureInterval = AppConfig::HEADLESS_CAPTURE_INTERVAL;  // 0 = last frame only
+    std::string outputDir = AppConfig::HEADLESS_OUTPUT_DIR;
+};
 
 class VulkanApplication {
 public:
     VulkanApplication() = default;
 
     void run();
+    void runHeadless(const HeadlessOptions& options);
+    // Loads the scene headless (options.width/height set the aspect ratio), runs the masked occlusion benchmark
+    // along each camera path and exits without rendering.
+    void runOcclusionBenchmark(const std::vector<std::string>& cameraPathFiles, const HeadlessOptions& options);
+    // Drives the next run() / runHeadless() from a camera path and ends it with a report (see BenchmarkRunner).
+    void setBenchmark(const BenchmarkOptions& options) { benchmark.emplace(options); }
 
     enum class InputMode {
         Auto,
@@ -28,6 +49,9 @@ private:
     void processInput(float deltaTime);
     void setInputMode(InputMode mode);
     void toggleInputMode();
+    void beginBenchmark();
+    // Appends the live camera pose to AppConfig::CAMERA_PATH_RECORD_PATH (time = seconds since the first keyframe).
+    void recordCameraKeyframe();
     bool canProcessCameraKeyboard() const;
     bool canProcessCameraMouse() const;
 
@@ -45,12 +69,16 @@ private:
     Camera camera;
     Scene scene;
     CullingSystem cullingSystem;
+    std::optional<BenchmarkRunner> benchmark;
+    double cameraPathRecordStart = -1.0;
 
     bool frustumCullingEnabled = false;
     bool occlusionCullingEnabled = false;
     bool prevF1 = false;
     bool prevF2 = false;
     bool prevF3 = false;
+    bool prevF4 = false;
+    bool prevF5 = false;
     InputMode inputMode = InputMode::Auto;
 };
 
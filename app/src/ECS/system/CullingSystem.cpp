@@ -1,5 +1,7 @@
 #include "ECS/system/CullingSystem.h"
 
+#include "Engine/Jobs/JobSystem.h"
+
 void CullingSystem::CullScene(const std::vector<Entity*>& allEntities,
                               float aspectRatio,
                               float nearPlane,
@@ -11,20 +13,38 @@ void CullingSystem::CullScene(const std::vector<Entity*>& allEntities,
 
     Frustum frustum = camera->GetFrustum(aspectRatio, nearPlane, farPlane);
 
-    for (Entity* entity : allEntities) {
-        if (!entity->IsActive()) continue;
-
-        auto* meshComponent = entity->GetComponent<MeshComponent>();
-        if (!meshComponent) continue;
-
-        auto* transformComponent = entity->GetComponent<TransformComponent>();
-        if (!transformComponent) continue;
-
-        BoundingBox boundingBox = meshComponent->GetBoundingBox();
-        boundingBox.Transform(transformComponent->GetTransformMatrix());
+    // Gather world bounds on the job system (component lookups + 8-corner transform dominate),
+    // then run the SIMD batch test once over all entities.
+    // Resolve component type IDs up front: first-time ID assignment bumps a non-atomic counter.
+    (void)Component::GetTypeID<MeshComponent>();
+    (void)Component::GetTypeID<TransformComponent>();
+
+    const uint32_t entityCount = static_cast<uint32_t>(allEntities.size());
+    candidateBounds.Resize(entityCount);
+    candidateValid.assign(entityCount, 0u);
+    JobSystem::get().parallelFor(entityCount, CULL_GATHER_GRAIN, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            Entity* entity = allEntities[i];
+            if (!entity->IsActive()) continue;
+
+            auto* meshComponent = entity->GetComponent<MeshComponent>();
+            if (!meshComponent) continue;
+
+            auto* transformComponent = entity->GetComponent<TransformComponent>();
+            if (!transformComponent) continue;
+
+            BoundingBox boundingBox = meshComponent->GetBoundingBox();
+            boundingBox.Transform(transformComponent->GetTransformMatrix());
+            candidateBounds.Set(i, boundingBox);
+            candidateValid[i] = 1u;
+        }
+    });
 
-        if (frustum.Intersects(boundingBox)) {
-            visibleEntities.push_back(entity);
+    visibilityMask.resize(FrustumCulling::MaskWordCount(entityCount));
+    FrustumCulling::CullAabbBatch(frustum, candidateBounds, visibilityMask.data());
+    for (uint32_t i = 0; i < entityCount; ++i) {
+        if (candidateValid[i] && ((visibilityMask[i >> 5] >> (i & 31u)) & 1u)) {
+            visibleEntities.push_back(allEntities[i]);
         }
     }
 }
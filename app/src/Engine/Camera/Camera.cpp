@@ -55,6 +55,13 @@ void Camera::processMouseMovement(float xoffset, float yoffset, bool constrainPi
     updateCameraVectors();
 }
 
+void Camera::setOrientation(float newYaw, float newPitch)
+{
+    yaw = newYaw;
+    pitch = std::clamp(newPitch, -89.0f, 89.0f);
+    updateCameraVectors();
+}
+
 void Camera::processMouseScroll(float yoffset)
 {
     zoom -= yoffset;
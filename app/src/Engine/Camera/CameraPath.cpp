@@ -0,0 +1,98 @@
+#include "Engine/Camera/CameraPath.h"
+
+#include "Engine/Camera/Camera.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+// Uniform Catmull-Rom through p1 (t = 0) and p2 (t = 1).
+template <typename T>
+T catmullRom(const T& p0, const T& p1, const T& p2, const T& p3, float t)
+{
+    const float t2 = t * t;
+    const float t3 = t2 * t;
+    return 0.5f * ((2.0f * p1) + (-p0 + p2) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2
+                   + (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t3);
+}
+}  // namespace
+
+CameraPath CameraPath::loadFromFile(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("CameraPath: failed to open " + path);
+    }
+
+    CameraPath result;
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.resize(comment);
+        }
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        std::istringstream fields(line);
+        Keyframe keyframe;
+        if (!(fields >> keyframe.time >> keyframe.position.x >> keyframe.position.y >> keyframe.position.z >> keyframe.yaw
+                     >> keyframe.pitch)) {
+            throw std::runtime_error("CameraPath: malformed keyframe at " + path + ":" + std::to_string(lineNumber));
+        }
+        if (!result.keyframes.empty() && keyframe.time <= result.keyframes.back().time) {
+            throw std::runtime_error("CameraPath: keyframe times must increase at " + path + ":" + std::to_string(lineNumber));
+        }
+        result.keyframes.push_back(keyframe);
+    }
+    if (result.keyframes.empty()) {
+        throw std::runtime_error("CameraPath: no keyframes in " + path);
+    }
+    return result;
+}
+
+bool CameraPath::appendKeyframe(const std::string& path, const Keyframe& keyframe)
+{
+    std::ofstream out(path, std::ios::app);
+    if (!out) {
+        return false;
+    }
+    out << keyframe.time << " " << keyframe.position.x << " " << keyframe.position.y << " " << keyframe.position.z << " "
+        << keyframe.yaw << " " << keyframe.pitch << "\n";
+    return static_cast<bool>(out);
+}
+
+CameraPath::Keyframe CameraPath::sample(float time) const
+{
+    if (keyframes.empty()) return Keyframe{};
+    if (keyframes.size() == 1 || time <= keyframes.front().time) return keyframes.front();
+    if (time >= keyframes.back().time) return keyframes.back();
+
+    // Segment [i, i + 1] containing time.
+    const auto next = std::upper_bound(keyframes.begin(), keyframes.end(), time,
+                                       [](float t, const Keyframe& k) { return t < k.time; });
+    const size_t i = static_cast<size_t>(next - keyframes.begin()) - 1;
+    const size_t last = keyframes.size() - 1;
+    const Keyframe& k0 = keyframes[i > 0 ? i - 1 : 0];
+    const Keyframe& k1 = keyframes[i];
+    const Keyframe& k2 = keyframes[i + 1];
+    const Keyframe& k3 = keyframes[std::min(i + 2, last)];
+    const float t = (time - k1.time) / (k2.time - k1.time);
+
+    Keyframe result;
+    result.time = time;
+    result.position = catmullRom(k0.position, k1.position, k2.position, k3.position, t);
+    result.yaw = catmullRom(k0.yaw, k1.yaw, k2.yaw, k3.yaw, t);
+    result.pitch = catmullRom(k0.pitch, k1.pitch, k2.pitch, k3.pitch, t);
+    return result;
+}
+
+void CameraPath::apply(Camera& camera, float time) const
+{
+    const Keyframe keyframe = sample(time);
+    camera.setPosition(keyframe.position);
+    camera.setOrientation(keyframe.yaw, keyframe.pitch);
+}
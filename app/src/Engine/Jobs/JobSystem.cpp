@@ -0,0 +1,167 @@
+#include "Engine/Jobs/JobSystem.h"
+
+#include "Engine/Profiling/Trace.h"
+
+#include <algorithm>
+#include <string>
+
+namespace {
+// Identifies the worker running on this thread (owner + index) so submit()/wait() can use the local deque.
+thread_local const JobSystem* tlsOwner = nullptr;
+thread_local uint32_t tlsWorkerIndex = 0;
+}  // namespace
+
+JobSystem& JobSystem::get()
+{
+    static JobSystem instance(std::max(1u, std::thread::hardware_concurrency()) - 1u);
+    return instance;
+}
+
+JobSystem::JobSystem(uint32_t workerCount)
+{
+    // Always keep at least one queue so submit() works without workers (jobs then run inside wait()).
+    const uint32_t queueCount = std::max(1u, workerCount);
+    queues.reserve(queueCount);
+    for (uint32_t i = 0; i < queueCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    sleepCv.notify_all();
+    for (std::thread& t : workers) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+}
+
+void JobSystem::submit(Job job, JobCounter* counter)
+{
+    if (counter) {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const uint32_t queueIndex = (tlsOwner == this)
+        ? tlsWorkerIndex
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % static_cast<uint32_t>(queues.size());
+    {
+        WorkerQueue& q = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.items.push_back(WorkItem{std::move(job), counter});
+    }
+    queuedCount.fetch_add(1, std::memory_order_release);
+
+    // Taking the sleep mutex orders this notify after a worker's predicate check (no lost wakeups).
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    sleepCv.notify_one();
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    const uint32_t preferred = (tlsOwner == this) ? tlsWorkerIndex : static_cast<uint32_t>(queues.size());
+    while (!counter.isDone()) {
+        if (!tryRunOne(preferred)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(uint32_t count, uint32_t grainSize, const RangeJob& fn)
+{
+    if (count == 0) return;
+    grainSize = std::max(1u, grainSize);
+
+    // A few chunks per thread balances uneven work without flooding the deques.
+    const uint32_t threads = getWorkerCount() + 1u;
+    uint32_t chunkCount = (count + grainSize - 1u) / grainSize;
+    chunkCount = std::min(chunkCount, threads * 4u);
+    if (chunkCount <= 1u || getWorkerCount() == 0u) {
+        fn(0, count);
+        return;
+    }
+    const uint32_t chunkSize = (count + chunkCount - 1u) / chunkCount;
+
+    JobCounter counter;
+    for (uint32_t begin = chunkSize; begin < count; begin += chunkSize) {
+        const uint32_t end = std::min(count, begin + chunkSize);
+        submit([&fn, begin, end]() { fn(begin, end); }, &counter);
+    }
+    fn(0, std::min(count, chunkSize));
+    wait(counter);
+}
+
+void JobSystem::workerLoop(uint32_t workerIndex)
+{
+    tlsOwner = this;
+    tlsWorkerIndex = workerIndex;
+    Trace::get().setThreadName("Worker " + std::to_string(workerIndex));
+
+    while (!stopping.load(std::memory_order_acquire)) {
+        if (tryRunOne(workerIndex)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCv.wait(lock, [this]() {
+            return stopping.load(std::memory_order_acquire) || queuedCount.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+bool JobSystem::tryRunOne(uint32_t preferredQueue)
+{
+    WorkItem item;
+    if (!popLocal(preferredQueue, item) && !steal(preferredQueue, item)) {
+        return false;
+    }
+    queuedCount.fetch_sub(1, std::memory_order_acq_rel);
+    run(item);
+    return true;
+}
+
+bool JobSystem::popLocal(uint32_t queueIndex, WorkItem& out)
+{
+    if (queueIndex >= queues.size()) return false;
+    WorkerQueue& q = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.items.empty()) return false;
+    out = std::move(q.items.back());
+    q.items.pop_back();
+    return true;
+}
+
+bool JobSystem::steal(uint32_t thiefIndex, WorkItem& out)
+{
+    const uint32_t queueCount = static_cast<uint32_t>(queues.size());
+    for (uint32_t k = 1; k <= queueCount; ++k) {
+        const uint32_t victim = (thiefIndex + k) % queueCount;
+        if (victim == thiefIndex) continue;
+        WorkerQueue& q = *queues[victim];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.items.empty()) continue;
+        out = std::move(q.items.front());
+        q.items.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::run(WorkItem& item)
+{
+    if (item.job) {
+        TRACE_SCOPE("Job");
+        item.job();
+    }
+    if (item.counter) {
+        item.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
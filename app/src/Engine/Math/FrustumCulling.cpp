@@ -0,0 +1,218 @@
+#include "Engine/Math/FrustumCulling.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define FRUSTUM_CULLING_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC allows any intrinsic in any function; dispatch is purely at runtime.
+#define FRUSTUM_CULLING_TARGET_SSE41
+#define FRUSTUM_CULLING_TARGET_AVX2
+#else
+#include <cpuid.h>
+#define FRUSTUM_CULLING_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define FRUSTUM_CULLING_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace FrustumCulling {
+namespace {
+
+// One active plane with its p-vertex columns resolved up front: the p-vertex choice only depends on
+// the plane normal's signs, so the inner loops are pure SoA multiply-adds.
+struct PlaneSel {
+    float nx = 0.0f, ny = 0.0f, nz = 0.0f, w = 0.0f;
+    const float* px = nullptr;
+    const float* py = nullptr;
+    const float* pz = nullptr;
+};
+
+uint32_t selectPlanes(const Frustum& frustum, const AabbSoA& boxes, uint32_t planeMask, PlaneSel* out)
+{
+    uint32_t n = 0;
+    const auto& planes = frustum.GetPlanes();
+    for (uint32_t i = 0; i < 6; ++i) {
+        if ((planeMask & (1u << i)) == 0u) continue;
+        const glm::vec4& p = planes[i];
+        PlaneSel& s = out[n++];
+        s.nx = p.x;
+        s.ny = p.y;
+        s.nz = p.z;
+        s.w = p.w;
+        s.px = (p.x >= 0.0f) ? boxes.maxX.data() : boxes.minX.data();
+        s.py = (p.y >= 0.0f) ? boxes.maxY.data() : boxes.minY.data();
+        s.pz = (p.z >= 0.0f) ? boxes.maxZ.data() : boxes.minZ.data();
+    }
+    return n;
+}
+
+inline bool testScalar(const PlaneSel* planes, uint32_t planeCount, uint32_t i)
+{
+    for (uint32_t p = 0; p < planeCount; ++p) {
+        const PlaneSel& s = planes[p];
+        // Same order as glm::dot(vec3(plane), pVertex) + plane.w in Frustum::Intersects.
+        const float d = s.nx * s.px[i] + s.ny * s.py[i] + s.nz * s.pz[i] + s.w;
+        if (d < 0.0f) return false;
+    }
+    return true;
+}
+
+uint32_t cullScalar(const PlaneSel* planes, uint32_t planeCount, uint32_t begin, uint32_t count, uint32_t* outMask)
+{
+    uint32_t visible = 0;
+    for (uint32_t i = begin; i < count; ++i) {
+        if (testScalar(planes, planeCount, i)) {
+            outMask[i >> 5] |= 1u << (i & 31u);
+            ++visible;
+        }
+    }
+    return visible;
+}
+
+#if defined(FRUSTUM_CULLING_X86)
+FRUSTUM_CULLING_TARGET_SSE41
+uint32_t cullSse41(const PlaneSel* planes, uint32_t planeCount, uint32_t count, uint32_t* outMask)
+{
+    const __m128 zero = _mm_setzero_ps();
+    uint32_t visible = 0;
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 outside = zero;
+        for (uint32_t p = 0; p < planeCount; ++p) {
+            const PlaneSel& s = planes[p];
+            __m128 d = _mm_mul_ps(_mm_set1_ps(s.nx), _mm_loadu_ps(s.px + i));
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(s.ny), _mm_loadu_ps(s.py + i)));
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(s.nz), _mm_loadu_ps(s.pz + i)));
+            d = _mm_add_ps(d, _mm_set1_ps(s.w));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(d, zero));
+            if (_mm_movemask_ps(outside) == 0xF) break;
+        }
+        const uint32_t bits = ~static_cast<uint32_t>(_mm_movemask_ps(outside)) & 0xFu;
+        outMask[i >> 5] |= bits << (i & 31u);
+        visible += static_cast<uint32_t>(std::bitset<4>(bits).count());
+    }
+    return visible + cullScalar(planes, planeCount, i, count, outMask);
+}
+
+FRUSTUM_CULLING_TARGET_AVX2
+uint32_t cullAvx2(const PlaneSel* planes, uint32_t planeCount, uint32_t count, uint32_t* outMask)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    uint32_t visible = 0;
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 outside = zero;
+        for (uint32_t p = 0; p < planeCount; ++p) {
+            const PlaneSel& s = planes[p];
+            __m256 d = _mm256_mul_ps(_mm256_set1_ps(s.nx), _mm256_loadu_ps(s.px + i));
+            d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(s.ny), _mm256_loadu_ps(s.py + i)));
+            d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(s.nz), _mm256_loadu_ps(s.pz + i)));
+            d = _mm256_add_ps(d, _mm256_set1_ps(s.w));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, zero, _CMP_LT_OQ));
+            if (_mm256_movemask_ps(outside) == 0xFF) break;
+        }
+        const uint32_t bits = ~static_cast<uint32_t>(_mm256_movemask_ps(outside)) & 0xFFu;
+        outMask[i >> 5] |= bits << (i & 31u);
+        visible += static_cast<uint32_t>(std::bitset<8>(bits).count());
+    }
+    _mm256_zeroupper();
+    return visible + cullScalar(planes, planeCount, i, count, outMask);
+}
+
+void cpuid(int out[4], int leaf, int subLeaf)
+{
+#if defined(_MSC_VER)
+    __cpuidex(out, leaf, subLeaf);
+#else
+    unsigned int a = 0, b = 0, c = 0, d = 0;
+    __cpuid_count(static_cast<unsigned int>(leaf), static_cast<unsigned int>(subLeaf), a, b, c, d);
+    out[0] = static_cast<int>(a);
+    out[1] = static_cast<int>(b);
+    out[2] = static_cast<int>(c);
+    out[3] = static_cast<int>(d);
+#endif
+}
+
+uint64_t readXcr0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t lo = 0, hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+}
+#endif
+
+SimdLevel detectOnce()
+{
+#if defined(FRUSTUM_CULLING_X86)
+    int regs[4] = {};
+    cpuid(regs, 0, 0);
+    const int maxLeaf = regs[0];
+    if (maxLeaf < 1) return SimdLevel::Scalar;
+
+    cpuid(regs, 1, 0);
+    const bool sse41 = (regs[2] & (1 << 19)) != 0;
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx = (regs[2] & (1 << 28)) != 0;
+    if (!sse41) return SimdLevel::Scalar;
+
+    if (maxLeaf >= 7 && osxsave && avx && (readXcr0() & 0x6u) == 0x6u) {
+        cpuid(regs, 7, 0);
+        if ((regs[1] & (1 << 5)) != 0) return SimdLevel::Avx2;
+    }
+    return SimdLevel::Sse41;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+}  // namespace
+
+SimdLevel DetectSimdLevel()
+{
+    static const SimdLevel level = detectOnce();
+    return level;
+}
+
+const char* GetSimdLevelName(SimdLevel level)
+{
+    switch (level) {
+    case SimdLevel::Avx2: return "avx2";
+    case SimdLevel::Sse41: return "sse4.1";
+    default: return "scalar";
+    }
+}
+
+uint32_t CullAabbBatch(const Frustum& frustum, const AabbSoA& boxes, uint32_t* outMask, uint32_t planeMask)
+{
+    return CullAabbBatch(frustum, boxes, outMask, planeMask, DetectSimdLevel());
+}
+
+uint32_t CullAabbBatch(const Frustum& frustum, const AabbSoA& boxes, uint32_t* outMask,
+                       uint32_t planeMask, SimdLevel level)
+{
+    const uint32_t count = boxes.Size();
+    if (count == 0 || !outMask) return 0;
+    std::memset(outMask, 0, MaskWordCount(count) * sizeof(uint32_t));
+
+    PlaneSel planes[6];
+    const uint32_t planeCount = selectPlanes(frustum, boxes, planeMask, planes);
+
+    if (static_cast<int>(level) > static_cast<int>(DetectSimdLevel())) {
+        level = DetectSimdLevel();
+    }
+#if defined(FRUSTUM_CULLING_X86)
+    if (level == SimdLevel::Avx2) return cullAvx2(planes, planeCount, count, outMask);
+    if (level == SimdLevel::Sse41) return cullSse41(planes, planeCount, count, outMask);
+#endif
+    return cullScalar(planes, planeCount, 0, count, outMask);
+}
+
+}  // namespace FrustumCulling
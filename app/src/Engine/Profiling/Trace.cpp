@@ -0,0 +1,200 @@
+#include "Engine/Profiling/Trace.h"
+
+#include "Configs/AppConfig.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace {
+void writeJsonString(std::ostream& out, const char* text)
+{
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\t': out << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(*c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(*c));
+                out << escaped;
+            } else {
+                out << *c;
+            }
+        }
+    }
+    out << '"';
+}
+}  // namespace
+
+Trace& Trace::get()
+{
+    static Trace instance;
+    return instance;
+}
+
+uint64_t Trace::nowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+Trace::Track& Trace::createTrack(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto track = std::make_unique<Track>();
+    track->id = static_cast<uint32_t>(tracks.size());
+    track->name = name.empty() ? "Thread " + std::to_string(track->id) : name;
+    track->events.resize(std::max(1u, AppConfig::TRACE_EVENTS_PER_THREAD));
+    tracks.push_back(std::move(track));
+    return *tracks.back();
+}
+
+Trace::Track& Trace::threadTrack()
+{
+    // Tracks are never destroyed, so the pointer stays valid for the thread's lifetime.
+    thread_local Track* track = nullptr;
+    if (!track) {
+        track = &createTrack({});
+    }
+    return *track;
+}
+
+void Trace::setThreadName(const std::string& name)
+{
+    Track& track = threadTrack();
+    std::lock_guard<std::mutex> lock(track.mutex);
+    track.name = name;
+}
+
+uint32_t Trace::registerTrack(const std::string& name)
+{
+    return createTrack(name).id;
+}
+
+const char* Trace::intern(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return internedNames.insert(name).first->c_str();
+}
+
+void Trace::push(Track& track, const Event& event)
+{
+    std::lock_guard<std::mutex> lock(track.mutex);
+    track.events[track.writeCount % track.events.size()] = event;
+    ++track.writeCount;
+}
+
+void Trace::record(const char* name, uint64_t beginNs, uint64_t endNs)
+{
+    push(threadTrack(), Event{name, beginNs, endNs});
+}
+
+void Trace::recordOnTrack(uint32_t trackId, const char* name, uint64_t beginNs, uint64_t endNs)
+{
+    Track* track = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        if (trackId >= tracks.size()) return;
+        track = tracks[trackId].get();
+    }
+    push(*track, Event{name, beginNs, endNs});
+}
+
+void Trace::requestCapture(uint32_t frameCount, const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(captureMutex);
+    if (captureFramesLeft > 0 || frameCount == 0) {
+        return;  // one capture at a time
+    }
+    captureFramesLeft = frameCount;
+    captureStartNs = nowNs();
+    capturePath = path;
+    enabledBeforeCapture = isEnabled();
+    setEnabled(true);
+}
+
+bool Trace::isCapturing() const
+{
+    std::lock_guard<std::mutex> lock(captureMutex);
+    return captureFramesLeft > 0;
+}
+
+void Trace::onFrameEnd()
+{
+    std::string path;
+    uint64_t fromNs = 0;
+    {
+        std::lock_guard<std::mutex> lock(captureMutex);
+        if (captureFramesLeft == 0 || --captureFramesLeft > 0) {
+            return;
+        }
+        path = capturePath;
+        fromNs = captureStartNs;
+        setEnabled(enabledBeforeCapture);
+    }
+
+    const uint64_t toNs = nowNs();
+    const bool written = writeChromeTrace(path, fromNs, toNs);
+    std::cout << "[Perf] Trace capture " << (written ? "written to " : "failed to write ") << path
+              << " window_ms=" << static_cast<double>(toNs - fromNs) * 1e-6 << "\n";
+}
+
+bool Trace::writeChromeTrace(const std::string& path, uint64_t fromNs, uint64_t toNs) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+
+    std::vector<const Track*> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const auto& track : tracks) {
+            snapshot.push_back(track.get());
+        }
+    }
+
+    // Timestamps are microseconds relative to the start of the window.
+    auto toUs = [fromNs](uint64_t ns) { return static_cast<double>(static_cast<int64_t>(ns - fromNs)) * 1e-3; };
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    bool first = true;
+    std::vector<Event> events;
+    for (const Track* track : snapshot) {
+        {
+            std::lock_guard<std::mutex> lock(track->mutex);
+            const uint64_t capacity = track->events.size();
+            const uint64_t count = std::min<uint64_t>(track->writeCount, capacity);
+            events.clear();
+            for (uint64_t i = track->writeCount - count; i < track->writeCount; ++i) {
+                const Event& event = track->events[i % capacity];
+                if (event.endNs >= fromNs && event.beginNs <= toNs) {
+                    events.push_back(event);
+                }
+            }
+
+            out << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << track->id
+                << ",\"args\":{\"name\":";
+            writeJsonString(out, track->name.c_str());
+            out << "}}";
+            first = false;
+        }
+
+        for (const Event& event : events) {
+            out << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << track->id << ",\"name\":";
+            writeJsonString(out, event.name ? event.name : "?");
+            out << ",\"ts\":" << toUs(event.beginNs) << ",\"dur\":" << static_cast<double>(event.endNs - event.beginNs) * 1e-3
+                << "}";
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
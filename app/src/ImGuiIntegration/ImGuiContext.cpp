@@ -2,7 +2,9 @@
 #include "Rendering/RHI/Vulkan/VulkanContext.h"
 #include "Rendering/RHI/Vulkan/SwapChain.h"
 #include "Rendering/RHI/Vulkan/VulkanResourceCreator.h"
+#include "Configs/AppConfig.h"
 #include "Configs/RuntimeConfig.h"
+#include "Engine/Profiling/Trace.h"
 
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
@@ -63,8 +65,10 @@ void ImGuiIntegration::init(VulkanContext& vulkanContext, VulkanResourceCreator&
     initInfo.QueueFamily = vulkanContext.findQueueFamilies(vulkanContext.getPhysicalDevice()).graphicsFamily.value();
     initInfo.Queue = static_cast<VkQueue>(static_cast<vk::Queue>(vulkanContext.getGraphicsQueue()));
     initInfo.DescriptorPool = static_cast<VkDescriptorPool>(static_cast<vk::DescriptorPool>(*descriptorPool));
+    initInfo.PipelineCache = static_cast<VkPipelineCache>(vulkanContext.getPipelineCache().get());
     initInfo.MinImageCount = minImageCount;
-    initInfo.ImageCount = imageCount;
+    // The backend cycles one vertex/index buffer set per ImageCount frames; it must cover every frame in flight.
+    initInfo.ImageCount = std::max(imageCount, static_cast<uint32_t>(AppConfig::MAX_FRAMES_IN_FLIGHT));
     initInfo.MinAllocationSize = 1024 * 1024;
     initInfo.CheckVkResultFn = checkVkResult;
     initInfo.UseDynamicRendering = true;
@@ -284,12 +288,24 @@ void ImGuiIntegration::buildDefaultUi()
     ImGui::Separator();
     ImGui::Text("Tonemap");
     ImGui::SliderFloat("Exposure", &RuntimeConfig::tonemapExposure, 0.1f, 4.0f);
+
+    ImGui::Separator();
+    ImGui::Checkbox("Frustum Culling", &RuntimeConfig::enableFrustumCulling);
+    ImGui::Checkbox("GPU Culling", &RuntimeConfig::enableGpuCulling);
+    ImGui::Checkbox("Hi-Z Occlusion", &RuntimeConfig::enableHizOcclusionCulling);
+    ImGui::Checkbox("Occlusion Queries", &RuntimeConfig::enableOcclusionCulling);
+    ImGui::Checkbox("Software Occlusion", &RuntimeConfig::enableSoftwareOcclusionCulling);
     if (ImGui::Button("Reset Defaults")) {
         RuntimeConfig::resetToDefaults();
     }
 
     ImGui::Text("Frame: %llu", static_cast<unsigned long long>(uiStats.frameCounter));
     ImGui::Text("Swapchain recreates: %llu", static_cast<unsigned long long>(uiStats.swapchainRecreateCount));
+    // Applied by the renderer at the next frame boundary (drains the GPU once).
+    int framesInFlight = static_cast<int>(RuntimeConfig::framesInFlight);
+    if (ImGui::SliderInt("Frames In Flight", &framesInFlight, 1, AppConfig::MAX_FRAMES_IN_FLIGHT)) {
+        RuntimeConfig::framesInFlight = static_cast<uint32_t>(framesInFlight);
+    }
     ImGui::Separator();
     ImGui::Text("Acquire: %.3f ms", uiStats.acquireMs);
     ImGui::Text("Record: %.3f ms", uiStats.recordMs);
@@ -297,6 +313,25 @@ void ImGuiIntegration::buildDefaultUi()
     ImGui::Text("Submit: %.3f ms", uiStats.submitMs);
     ImGui::Text("Present: %.3f ms", uiStats.presentMs);
     ImGui::Text("Total: %.3f ms", uiStats.totalMs);
+    if (!uiStats.gpuScopes.empty()) {
+        ImGui::Separator();
+        ImGui::Text("%-28s %7s %7s %7s", "GPU (ms)", "min", "avg", "p99");
+        for (const GpuScopeStats& scope : uiStats.gpuScopes) {
+            ImGui::Text("%-28s %7.3f %7.3f %7.3f", scope.name.c_str(), scope.minMs, scope.avgMs, scope.p99Ms);
+        }
+    }
+
+    ImGui::Separator();
+    Trace& trace = Trace::get();
+    bool traceEnabled = trace.isEnabled();
+    if (ImGui::Checkbox("Trace Markers", &traceEnabled)) {
+        trace.setEnabled(traceEnabled);
+    }
+    if (trace.isCapturing()) {
+        ImGui::Text("Capturing trace...");
+    } else if (ImGui::Button("Capture Trace (F4)")) {
+        trace.requestCapture(AppConfig::TRACE_CAPTURE_FRAMES, AppConfig::TRACE_OUTPUT_PATH);
+    }
     ImGui::End();
 }
 
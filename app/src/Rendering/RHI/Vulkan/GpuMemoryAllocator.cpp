@@ -0,0 +1,448 @@
+#include "Rendering/RHI/Vulkan/GpuMemoryAllocator.h"
+
+#include "Configs/AppConfig.h"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+uint32_t highestBit(uint64_t v)
+{
+    uint32_t bit = 0;
+    while (v >>= 1u) ++bit;
+    return bit;
+}
+
+uint32_t lowestBit(uint64_t v)
+{
+    uint32_t bit = 0;
+    while ((v & 1u) == 0u) {
+        v >>= 1u;
+        ++bit;
+    }
+    return bit;
+}
+
+uint64_t alignUp(uint64_t value, uint64_t alignment)
+{
+    return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+}
+
+}  // namespace
+
+// Two-level segregated fit over [0, capacity). Free ranges are bucketed by size class (first level = power of
+// two, second level = 16 linear steps inside it); two bitmaps find the smallest non-empty bucket that fits in
+// constant time. Ranges keep physical neighbour links so a freed range merges with free neighbours.
+class TlsfRange {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    explicit TlsfRange(uint64_t inCapacity) : capacity(inCapacity), freeBytes(inCapacity)
+    {
+        for (auto& row : heads) row.fill(NONE);
+        const uint32_t r = newRegion();
+        regions[r].offset = 0;
+        regions[r].size = capacity;
+        insertFree(r);
+    }
+
+    // Returns the range index (NONE when nothing fits); `offset` is aligned to `alignment` (a power of two).
+    uint32_t allocate(uint64_t size, uint64_t alignment, uint64_t& offset)
+    {
+        size = std::max<uint64_t>(size, 1);
+        const uint32_t r = findFree(size + (alignment > 1 ? alignment - 1 : 0));
+        if (r == NONE) return NONE;
+        removeFree(r);
+
+        const uint64_t aligned = alignUp(regions[r].offset, alignment);
+        const uint64_t padding = aligned - regions[r].offset;
+        if (padding > 0) {
+            // Leading padding stays free as its own range (the previous neighbour is in use).
+            const uint32_t p = newRegion();
+            regions[p].offset = regions[r].offset;
+            regions[p].size = padding;
+            regions[p].prevPhys = regions[r].prevPhys;
+            regions[p].nextPhys = r;
+            if (regions[p].prevPhys != NONE) regions[regions[p].prevPhys].nextPhys = p;
+            regions[r].prevPhys = p;
+            regions[r].offset = aligned;
+            regions[r].size -= padding;
+            insertFree(p);
+        }
+        if (regions[r].size - size >= MIN_SPLIT) {
+            const uint32_t t = newRegion();
+            regions[t].offset = aligned + size;
+            regions[t].size = regions[r].size - size;
+            regions[t].prevPhys = r;
+            regions[t].nextPhys = regions[r].nextPhys;
+            if (regions[t].nextPhys != NONE) regions[regions[t].nextPhys].prevPhys = t;
+            regions[r].nextPhys = t;
+            regions[r].size = size;
+            insertFree(t);
+        }
+        regions[r].free = false;
+        freeBytes -= regions[r].size;
+        offset = aligned;
+        return r;
+    }
+
+    void free(uint32_t r)
+    {
+        freeBytes += regions[r].size;
+        const uint32_t prev = regions[r].prevPhys;
+        if (prev != NONE && regions[prev].free) {
+            removeFree(prev);
+            regions[prev].size += regions[r].size;
+            unlinkPhys(r);
+            r = prev;
+        }
+        const uint32_t next = regions[r].nextPhys;
+        if (next != NONE && regions[next].free) {
+            removeFree(next);
+            regions[r].size += regions[next].size;
+            unlinkPhys(next);
+        }
+        insertFree(r);
+    }
+
+    uint64_t getFreeBytes() const { return freeBytes; }
+    bool isEmpty() const { return freeBytes == capacity; }
+
+    uint64_t getLargestFreeRange() const
+    {
+        if (flBitmap == 0) return 0;
+        const uint32_t fl = highestBit(flBitmap);
+        uint64_t largest = 0;
+        for (uint32_t r = heads[fl][highestBit(slBitmap[fl])]; r != NONE; r = regions[r].nextFree) {
+            largest = std::max(largest, regions[r].size);
+        }
+        return largest;
+    }
+
+private:
+    static constexpr uint32_t SL_LOG2 = 4;
+    static constexpr uint32_t SL_COUNT = 1u << SL_LOG2;
+    static constexpr uint32_t FL_OFFSET = 8;  // sizes below 256 bytes share first level 0
+    static constexpr uint32_t FL_COUNT = 64 - FL_OFFSET + 1;
+    static constexpr uint64_t SMALL_SIZE = 1ull << FL_OFFSET;
+    static constexpr uint64_t MIN_SPLIT = 256;  // smaller tails stay inside the allocation
+
+    struct Region {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint32_t prevPhys = NONE;
+        uint32_t nextPhys = NONE;
+        uint32_t prevFree = NONE;
+        uint32_t nextFree = NONE;
+        bool free = false;
+    };
+
+    static void mapping(uint64_t size, uint32_t& fl, uint32_t& sl)
+    {
+        if (size < SMALL_SIZE) {
+            fl = 0;
+            sl = static_cast<uint32_t>(size / (SMALL_SIZE / SL_COUNT));
+        } else {
+            const uint32_t f = highestBit(size);
+            sl = static_cast<uint32_t>(size >> (f - SL_LOG2)) - SL_COUNT;
+            fl = f - FL_OFFSET + 1;
+        }
+    }
+
+    uint32_t findFree(uint64_t size) const
+    {
+        // Round up to the next bucket boundary so every range in the chosen bucket fits.
+        if (size < SMALL_SIZE) {
+            size = alignUp(size, SMALL_SIZE / SL_COUNT);
+        } else {
+            size += (1ull << (highestBit(size) - SL_LOG2)) - 1;
+        }
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        mapping(size, fl, sl);
+        if (fl >= FL_COUNT) return NONE;
+
+        uint32_t slMap = slBitmap[fl] & (~0u << sl);
+        if (slMap == 0) {
+            const uint64_t flMap = (fl + 1 < 64) ? (flBitmap & (~0ull << (fl + 1))) : 0;
+            if (flMap == 0) return NONE;
+            fl = lowestBit(flMap);
+            slMap = slBitmap[fl];
+        }
+        return heads[fl][lowestBit(slMap)];
+    }
+
+    uint32_t newRegion()
+    {
+        if (!unusedRegions.empty()) {
+            const uint32_t r = unusedRegions.back();
+            unusedRegions.pop_back();
+            regions[r] = Region{};
+            return r;
+        }
+        regions.push_back(Region{});
+        return static_cast<uint32_t>(regions.size() - 1);
+    }
+
+    // Drops r from the physical chain (its range was merged into a neighbour).
+    void unlinkPhys(uint32_t r)
+    {
+        const uint32_t prev = regions[r].prevPhys;
+        const uint32_t next = regions[r].nextPhys;
+        if (prev != NONE) regions[prev].nextPhys = next;
+        if (next != NONE) regions[next].prevPhys = prev;
+        unusedRegions.push_back(r);
+    }
+
+    void insertFree(uint32_t r)
+    {
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        mapping(regions[r].size, fl, sl);
+        regions[r].free = true;
+        regions[r].prevFree = NONE;
+        regions[r].nextFree = heads[fl][sl];
+        if (heads[fl][sl] != NONE) regions[heads[fl][sl]].prevFree = r;
+        heads[fl][sl] = r;
+        flBitmap |= 1ull << fl;
+        slBitmap[fl] |= 1u << sl;
+    }
+
+    void removeFree(uint32_t r)
+    {
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        mapping(regions[r].size, fl, sl);
+        const uint32_t prev = regions[r].prevFree;
+        const uint32_t next = regions[r].nextFree;
+        if (prev != NONE) regions[prev].nextFree = next;
+        if (next != NONE) regions[next].prevFree = prev;
+        if (heads[fl][sl] == r) {
+            heads[fl][sl] = next;
+            if (next == NONE) {
+                slBitmap[fl] &= ~(1u << sl);
+                if (slBitmap[fl] == 0) flBitmap &= ~(1ull << fl);
+            }
+        }
+        regions[r].free = false;
+    }
+
+    uint64_t capacity = 0;
+    uint64_t freeBytes = 0;
+    std::vector<Region> regions;
+    std::vector<uint32_t> unusedRegions;
+    uint64_t flBitmap = 0;
+    std::array<uint32_t, FL_COUNT> slBitmap{};
+    std::array<std::array<uint32_t, SL_COUNT>, FL_COUNT> heads{};
+};
+
+struct GpuMemoryBlock {
+    std::optional<vk::raii::DeviceMemory> memory;
+    vk::DeviceSize size = 0;
+    void* mapped = nullptr;
+    std::optional<TlsfRange> ranges;  // empty for dedicated allocations
+    uint32_t pool = 0;
+};
+
+struct GpuMemoryState {
+    vk::raii::Device* device = nullptr;
+    vk::PhysicalDeviceMemoryProperties memoryProperties{};
+    mutable std::mutex mutex;
+    // Pool index = memoryType * 4 + (optimalImage ? 2 : 0) + (deviceAddress ? 1 : 0).
+    std::vector<std::vector<std::unique_ptr<GpuMemoryBlock>>> pools;
+    std::vector<std::unique_ptr<GpuMemoryBlock>> dedicated;
+    uint64_t usedBytes = 0;
+    uint32_t allocationCount = 0;
+
+    uint32_t findMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags properties) const
+    {
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+            if ((typeFilter & (1 << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+                return i;
+            }
+        }
+        throw std::runtime_error("failed to find suitable memory type!");
+    }
+
+    std::unique_ptr<GpuMemoryBlock> createBlock(vk::DeviceSize size, uint32_t memoryType, bool deviceAddress,
+                                                const vk::MemoryDedicatedAllocateInfo* dedicatedInfo) const
+    {
+        vk::MemoryAllocateInfo allocInfo{};
+        allocInfo.allocationSize = size;
+        allocInfo.memoryTypeIndex = memoryType;
+        vk::MemoryAllocateFlagsInfo allocFlagsInfo{};
+        const void* chain = dedicatedInfo;
+        if (deviceAddress) {
+            allocFlagsInfo.flags = vk::MemoryAllocateFlagBits::eDeviceAddress;
+            allocFlagsInfo.pNext = chain;
+            chain = &allocFlagsInfo;
+        }
+        allocInfo.pNext = chain;
+
+        auto block = std::make_unique<GpuMemoryBlock>();
+        block->memory.emplace(*device, allocInfo);
+        block->size = size;
+        if (memoryProperties.memoryTypes[memoryType].propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible) {
+            block->mapped = block->memory->mapMemory(0, VK_WHOLE_SIZE);
+        }
+        return block;
+    }
+
+    void release(GpuMemoryBlock* block, uint32_t region, vk::DeviceSize size)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        usedBytes -= size;
+        --allocationCount;
+        if (region == UINT32_MAX) {
+            dedicated.erase(std::find_if(dedicated.begin(), dedicated.end(),
+                                         [&](const auto& b) { return b.get() == block; }));
+            return;
+        }
+        block->ranges->free(region);
+        // Keep one empty block per pool so resize-style free/alloc churn does not hit vkAllocateMemory.
+        auto& blocks = pools[block->pool];
+        if (block->ranges->isEmpty() && blocks.size() > 1) {
+            blocks.erase(std::find_if(blocks.begin(), blocks.end(), [&](const auto& b) { return b.get() == block; }));
+        }
+    }
+};
+
+GpuAllocation::GpuAllocation(GpuAllocation&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+GpuAllocation& GpuAllocation::operator=(GpuAllocation&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        state = std::move(other.state);
+        block = other.block;
+        region = other.region;
+        memory = other.memory;
+        offset = other.offset;
+        size = other.size;
+        mapped = other.mapped;
+        other.block = nullptr;
+        other.memory = vk::DeviceMemory{};
+        other.mapped = nullptr;
+    }
+    return *this;
+}
+
+void* GpuAllocation::mapMemory(vk::DeviceSize mapOffset, vk::DeviceSize /*mapSize*/) const
+{
+    if (!mapped) {
+        throw std::runtime_error("GpuAllocation: memory is not host-visible");
+    }
+    return static_cast<char*>(mapped) + mapOffset;
+}
+
+void GpuAllocation::release()
+{
+    if (!state) return;
+    state->release(block, region, size);
+    state.reset();
+    block = nullptr;
+    memory = vk::DeviceMemory{};
+    mapped = nullptr;
+}
+
+void GpuMemoryAllocator::init(vk::raii::Device& device, const vk::raii::PhysicalDevice& physicalDevice)
+{
+    state = std::make_shared<GpuMemoryState>();
+    state->device = &device;
+    state->memoryProperties = physicalDevice.getMemoryProperties();
+    state->pools.resize(static_cast<size_t>(state->memoryProperties.memoryTypeCount) * 4u);
+}
+
+void GpuMemoryAllocator::cleanup()
+{
+    state.reset();
+}
+
+GpuAllocation GpuMemoryAllocator::allocate(const Request& request)
+{
+    if (!state) {
+        throw std::runtime_error("GpuMemoryAllocator is not initialized");
+    }
+    const uint32_t memoryType = state->findMemoryType(request.requirements.memoryTypeBits, request.properties);
+    const vk::DeviceSize size = request.requirements.size;
+
+    GpuAllocation allocation;
+    allocation.size = size;
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (request.dedicated || size > AppConfig::GPU_MEMORY_BLOCK_SIZE / 2) {
+        vk::MemoryDedicatedAllocateInfo dedicatedInfo{};
+        dedicatedInfo.image = request.dedicatedImage;
+        dedicatedInfo.buffer = request.dedicatedBuffer;
+        const bool chainDedicated = request.dedicatedImage || request.dedicatedBuffer;
+        state->dedicated.push_back(
+            state->createBlock(size, memoryType, request.deviceAddress, chainDedicated ? &dedicatedInfo : nullptr));
+        GpuMemoryBlock* block = state->dedicated.back().get();
+        allocation.block = block;
+        allocation.region = UINT32_MAX;
+        allocation.memory = **block->memory;
+        allocation.offset = 0;
+        allocation.mapped = block->mapped;
+    } else {
+        const uint32_t poolIndex = memoryType * 4u + (request.optimalImage ? 2u : 0u) + (request.deviceAddress ? 1u : 0u);
+        auto& blocks = state->pools[poolIndex];
+        uint64_t offset = 0;
+        uint32_t region = TlsfRange::NONE;
+        GpuMemoryBlock* block = nullptr;
+        for (const auto& candidate : blocks) {
+            region = candidate->ranges->allocate(size, request.requirements.alignment, offset);
+            if (region != TlsfRange::NONE) {
+                block = candidate.get();
+                break;
+            }
+        }
+        if (!block) {
+            blocks.push_back(state->createBlock(AppConfig::GPU_MEMORY_BLOCK_SIZE, memoryType, request.deviceAddress, nullptr));
+            block = blocks.back().get();
+            block->ranges.emplace(block->size);
+            block->pool = poolIndex;
+            region = block->ranges->allocate(size, request.requirements.alignment, offset);
+            if (region == TlsfRange::NONE) {
+                throw std::runtime_error("GpuMemoryAllocator: allocation does not fit an empty block");
+            }
+        }
+        allocation.block = block;
+        allocation.region = region;
+        allocation.memory = **block->memory;
+        allocation.offset = offset;
+        allocation.mapped = block->mapped ? static_cast<char*>(block->mapped) + offset : nullptr;
+    }
+    state->usedBytes += size;
+    ++state->allocationCount;
+    allocation.state = state;
+    return allocation;
+}
+
+GpuMemoryAllocator::Stats GpuMemoryAllocator::getStats() const
+{
+    Stats stats{};
+    if (!state) return stats;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    stats.usedBytes = state->usedBytes;
+    stats.allocationCount = state->allocationCount;
+    for (const auto& blocks : state->pools) {
+        for (const auto& block : blocks) {
+            stats.reservedBytes += block->size;
+            stats.fragmentedBytes += block->ranges->getFreeBytes() - block->ranges->getLargestFreeRange();
+            ++stats.blockCount;
+        }
+    }
+    for (const auto& block : state->dedicated) {
+        stats.reservedBytes += block->size;
+        ++stats.dedicatedCount;
+    }
+    return stats;
+}
@@ -0,0 +1,216 @@
+#include "Rendering/RHI/Vulkan/PipelineCache.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kMagic = 0x43504B56u;  // "VKPC"
+constexpr uint32_t kFileVersion = 1;
+
+struct DiskHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint32_t reserved;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+    uint64_t dataSize;
+    uint64_t checksum;
+};
+
+// FNV-1a; the blob is a few MB at most.
+uint64_t checksum(const uint8_t* data, size_t size)
+{
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= data[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+using Clock = std::chrono::high_resolution_clock;
+
+double msSince(Clock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+} // namespace
+
+void PipelineCache::init(vk::raii::Device& inDevice, const vk::raii::PhysicalDevice& physicalDevice, const std::string& inPath,
+                         bool inCreationFeedback)
+{
+    device = &inDevice;
+    path = inPath;
+    creationFeedback = inCreationFeedback;
+    loadedBytes = 0;
+    resetStats();
+
+    const vk::PhysicalDeviceProperties props = physicalDevice.getProperties();
+    vendorID = props.vendorID;
+    deviceID = props.deviceID;
+    driverVersion = props.driverVersion;
+    std::memcpy(pipelineCacheUUID, props.pipelineCacheUUID.data(), VK_UUID_SIZE);
+
+    const auto t0 = Clock::now();
+    std::vector<uint8_t> blob;
+    const char* rejected = nullptr;
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (in) {
+        const std::streamsize fileSize = in.tellg();
+        in.seekg(0);
+        DiskHeader header{};
+        if (fileSize < static_cast<std::streamsize>(sizeof(DiskHeader))
+            || !in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            rejected = "truncated";
+        } else if (header.magic != kMagic || header.version != kFileVersion) {
+            rejected = "unknown format";
+        } else if (header.vendorID != vendorID || header.deviceID != deviceID || header.driverVersion != driverVersion
+                   || std::memcmp(header.pipelineCacheUUID, pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+            rejected = "different device or driver";
+        } else if (header.dataSize != static_cast<uint64_t>(fileSize) - sizeof(DiskHeader)) {
+            rejected = "size mismatch";
+        } else {
+            blob.resize(static_cast<size_t>(header.dataSize));
+            if (!in.read(reinterpret_cast<char*>(blob.data()), static_cast<std::streamsize>(blob.size()))
+                || checksum(blob.data(), blob.size()) != header.checksum) {
+                rejected = "checksum mismatch";
+                blob.clear();
+            }
+        }
+    }
+
+    vk::PipelineCacheCreateInfo createInfo{};
+    createInfo.initialDataSize = blob.size();
+    createInfo.pInitialData = blob.empty() ? nullptr : blob.data();
+    try {
+        cache.emplace(*device, createInfo);
+        loadedBytes = blob.size();
+    } catch (const vk::SystemError&) {
+        // The driver refused the data despite a matching header; start empty rather than fail startup.
+        rejected = "rejected by driver";
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = nullptr;
+        cache.emplace(*device, createInfo);
+    }
+
+    std::cout << "[Perf] PipelineCache " << path << " loaded_bytes=" << loadedBytes << " load_ms=" << msSince(t0)
+              << " feedback=" << (creationFeedback ? 1 : 0);
+    if (rejected) std::cout << " ignored=\"" << rejected << "\"";
+    std::cout << "\n";
+}
+
+void PipelineCache::cleanup()
+{
+    if (cache) {
+        save();
+    }
+    cache.reset();
+    device = nullptr;
+}
+
+bool PipelineCache::save()
+{
+    if (!cache || path.empty()) return false;
+    const std::vector<uint8_t> data = cache->getData();
+    if (data.empty()) return false;
+
+    DiskHeader header{};
+    header.magic = kMagic;
+    header.version = kFileVersion;
+    header.vendorID = vendorID;
+    header.deviceID = deviceID;
+    header.driverVersion = driverVersion;
+    std::memcpy(header.pipelineCacheUUID, pipelineCacheUUID, VK_UUID_SIZE);
+    header.dataSize = data.size();
+    header.checksum = checksum(data.data(), data.size());
+
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    std::cout << "[Perf] PipelineCache saved " << path << " bytes=" << data.size() << "\n";
+    return true;
+}
+
+vk::raii::Pipeline PipelineCache::createGraphicsPipeline(const vk::GraphicsPipelineCreateInfo& info)
+{
+    vk::GraphicsPipelineCreateInfo chained = info;
+    vk::PipelineCreationFeedback pipelineFeedback{};
+    std::vector<vk::PipelineCreationFeedback> stageFeedback(info.stageCount);
+    vk::PipelineCreationFeedbackCreateInfo feedbackInfo{};
+    if (creationFeedback) {
+        feedbackInfo.pPipelineCreationFeedback = &pipelineFeedback;
+        feedbackInfo.pipelineStageCreationFeedbackCount = info.stageCount;
+        feedbackInfo.pPipelineStageCreationFeedbacks = stageFeedback.data();
+        feedbackInfo.pNext = info.pNext;
+        chained.pNext = &feedbackInfo;
+    }
+
+    const auto t0 = Clock::now();
+    vk::raii::Pipeline pipeline(*device, *cache, chained);
+    recordCreation(msSince(t0), pipelineFeedback);
+    return pipeline;
+}
+
+vk::raii::Pipeline PipelineCache::createComputePipeline(const vk::ComputePipelineCreateInfo& info)
+{
+    vk::ComputePipelineCreateInfo chained = info;
+    vk::PipelineCreationFeedback pipelineFeedback{};
+    vk::PipelineCreationFeedback stageFeedback{};
+    vk::PipelineCreationFeedbackCreateInfo feedbackInfo{};
+    if (creationFeedback) {
+        feedbackInfo.pPipelineCreationFeedback = &pipelineFeedback;
+        feedbackInfo.pipelineStageCreationFeedbackCount = 1;
+        feedbackInfo.pPipelineStageCreationFeedbacks = &stageFeedback;
+        feedbackInfo.pNext = info.pNext;
+        chained.pNext = &feedbackInfo;
+    }
+
+    const auto t0 = Clock::now();
+    vk::raii::Pipeline pipeline(*device, *cache, chained);
+    recordCreation(msSince(t0), pipelineFeedback);
+    return pipeline;
+}
+
+void PipelineCache::recordCreation(double ms, const vk::PipelineCreationFeedback& feedback)
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    ++stats.pipelines;
+    stats.createMs += ms;
+    if (feedback.flags & vk::PipelineCreationFeedbackFlagBits::eValid) {
+        ++stats.feedbackPipelines;
+        if (feedback.flags & vk::PipelineCreationFeedbackFlagBits::eApplicationPipelineCacheHit) {
+            ++stats.cacheHits;
+        }
+    }
+}
+
+PipelineCache::Stats PipelineCache::getStats() const
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return stats;
+}
+
+void PipelineCache::resetStats()
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats = Stats{};
+}
@@ -1,10 +1,21 @@
 #include "Rendering/RHI/Vulkan/RayTracingContext.h"
 
+#include "Configs/AppConfig.h"
+
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstring>
+#include <iostream>
 #include <stdexcept>
 
+namespace {
+vk::DeviceSize alignUp(vk::DeviceSize value, vk::DeviceSize alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
 BufferAllocation RayTracingContext::createDeviceAddressBuffer(
     vk::DeviceSize size, vk::BufferUsageFlags usage, vk::MemoryPropertyFlags properties) const
 {
@@ -43,7 +54,8 @@ vk::TransformMatrixKHR RayTracingContext::toVkTransformMatrix(const glm::mat4& m
     return transform;
 }
 
-void RayTracingContext::writeInstances(const std::vector<RayTracingInstanceDesc>& instances) const
+void RayTracingContext::writeInstances(const std::vector<RayTracingInstanceDesc>& instances,
+                                       uint32_t begin, uint32_t end) const
 {
     if (!instanceMapped || !instanceMemory || !instanceBuffer) {
         throw std::runtime_error("instance buffer is not initialized/mapped");
@@ -51,11 +63,15 @@ void RayTracingContext::writeInstances(const std::vector<RayTracingInstanceDesc>
     if (instances.size() != static_cast<size_t>(instanceCapacity)) {
         throw std::runtime_error("instance count mismatch: RayTracingContext must be re-initialized");
     }
+    if (begin > end || end > instanceCapacity) {
+        throw std::runtime_error("instance range out of bounds");
+    }
 
+    // Mapped memory is host-coherent: only the written range reaches the GPU, the rest keeps last frame's data.
     auto* out = reinterpret_cast<vk::AccelerationStructureInstanceKHR*>(instanceMapped);
-    for (uint32_t i = 0; i < instanceCapacity; ++i) {
+    for (uint32_t i = begin; i < end; ++i) {
         const RayTracingInstanceDesc& src = instances[i];
-        if (src.meshIndex >= bottomLevelASes.size() || !bottomLevelASes[src.meshIndex].as) {
+        if (src.meshIndex >= blasAddresses.size() || blasAddresses[src.meshIndex] == 0) {
             throw std::runtime_error("invalid meshIndex for ray tracing instance");
         }
 
@@ -65,7 +81,7 @@ void RayTracingContext::writeInstances(const std::vector<RayTracingInstanceDesc>
         inst.mask = 0xFF;
         inst.instanceShaderBindingTableRecordOffset = 0;
         inst.flags = static_cast<uint8_t>(vk::GeometryInstanceFlagBitsKHR::eTriangleFacingCullDisable);
-        inst.accelerationStructureReference = getAccelerationStructureAddress(*bottomLevelASes[src.meshIndex].as);
+        inst.accelerationStructureReference = blasAddresses[src.meshIndex];
         out[i] = inst;
     }
 }
@@ -95,7 +111,7 @@ void RayTracingContext::recordTopLevelASBuild(vk::raii::CommandBuffer& commandBu
     buildInfo.dstAccelerationStructure = *topLevelAS;
     buildInfo.geometryCount = 1;
     buildInfo.pGeometries = &geometry;
-    buildInfo.scratchData.deviceAddress = getBufferDeviceAddress(*topLevelScratchBuffer);
+    buildInfo.scratchData.deviceAddress = topLevelScratchAddress;
 
     vk::AccelerationStructureBuildRangeInfoKHR rangeInfo{};
     rangeInfo.primitiveCount = instanceCapacity;
@@ -129,11 +145,16 @@ void RayTracingContext::init(VulkanContext& context,
 {
     resourceCreator = &inResourceCreator;
     device = &context.getDevice();
+    const auto properties = context.getPhysicalDevice().getProperties2<
+        vk::PhysicalDeviceProperties2, vk::PhysicalDeviceAccelerationStructurePropertiesKHR>();
+    scratchAlignment = std::max<vk::DeviceSize>(
+        properties.get<vk::PhysicalDeviceAccelerationStructurePropertiesKHR>().minAccelerationStructureScratchOffsetAlignment, 1);
 
     buildBottomLevelASes(meshes, meshOpaqueFlags);
     buildTopLevelAS(static_cast<uint32_t>(instances.size()));
-    writeInstances(instances);
+    writeInstances(instances, 0, instanceCapacity);
     buildOrUpdateTopLevelAS(vk::BuildAccelerationStructureModeKHR::eBuild);
+    refitsSinceRebuild = 0;
 }
 
 void RayTracingContext::cleanup()
@@ -148,18 +169,22 @@ void RayTracingContext::cleanup()
     instanceMemory.reset();
     topLevelScratchBuffer.reset();
     topLevelScratchMemory.reset();
+    topLevelScratchAddress = 0;
 
     topLevelAS.reset();
     topLevelASBuffer.reset();
     topLevelASMemory.reset();
 
     bottomLevelASes.clear();
+    blasAddresses.clear();
 
     resourceCreator = nullptr;
     device = nullptr;
     topLevelBuildFlags = {};
     topLevelBuildScratchSize = 0;
     topLevelUpdateScratchSize = 0;
+    refitsSinceRebuild = 0;
+    lastUpdateStats = UpdateStats{};
 }
 
 void RayTracingContext::updateTopLevelAS(vk::raii::CommandBuffer& commandBuffer,
@@ -168,8 +193,51 @@ void RayTracingContext::updateTopLevelAS(vk::raii::CommandBuffer& commandBuffer,
     if (!topLevelAS || !instanceBuffer || !instanceMemory || !topLevelScratchBuffer) {
         throw std::runtime_error("cannot update TLAS before ray tracing structures are initialized");
     }
-    writeInstances(instances);
+    writeInstances(instances, 0, instanceCapacity);
+
+    lastUpdateStats = UpdateStats{};
+    lastUpdateStats.writtenInstances = instanceCapacity;
+    lastUpdateStats.rebuilt = true;
+    refitsSinceRebuild = 0;
+    recordTopLevelASUpdate(commandBuffer, vk::BuildAccelerationStructureModeKHR::eBuild);
+}
+
+void RayTracingContext::updateTopLevelAS(vk::raii::CommandBuffer& commandBuffer,
+                                         const std::vector<RayTracingInstanceDesc>& instances,
+                                         const std::vector<RayTracingInstanceRange>& dirtyRanges)
+{
+    if (!topLevelAS || !instanceBuffer || !instanceMemory || !topLevelScratchBuffer) {
+        throw std::runtime_error("cannot update TLAS before ray tracing structures are initialized");
+    }
+
+    lastUpdateStats = UpdateStats{};
+    for (const RayTracingInstanceRange& range : dirtyRanges) {
+        writeInstances(instances, range.begin, range.begin + range.count);
+        lastUpdateStats.writtenInstances += range.count;
+    }
+    if (lastUpdateStats.writtenInstances == 0) {
+        return;
+    }
+
+    // Refit keeps the old BVH topology, so quality degrades as instances move; rebuild when much of the
+    // scene moved this frame or enough refits have piled up.
+    const float dirtyFraction = static_cast<float>(lastUpdateStats.writtenInstances) / static_cast<float>(instanceCapacity);
+    const bool rebuild = dirtyFraction >= AppConfig::TLAS_REBUILD_DIRTY_FRACTION ||
+                         refitsSinceRebuild >= AppConfig::TLAS_MAX_REFITS_BEFORE_REBUILD;
+    if (rebuild) {
+        refitsSinceRebuild = 0;
+    } else {
+        ++refitsSinceRebuild;
+    }
+    lastUpdateStats.rebuilt = rebuild;
+    lastUpdateStats.refitsSinceRebuild = refitsSinceRebuild;
+    recordTopLevelASUpdate(commandBuffer, rebuild ? vk::BuildAccelerationStructureModeKHR::eBuild
+                                                  : vk::BuildAccelerationStructureModeKHR::eUpdate);
+}
 
+void RayTracingContext::recordTopLevelASUpdate(vk::raii::CommandBuffer& commandBuffer,
+                                               vk::BuildAccelerationStructureModeKHR mode)
+{
     commandBuffer.pipelineBarrier(
         vk::PipelineStageFlagBits::eHost,
         vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
@@ -181,7 +249,7 @@ void RayTracingContext::updateTopLevelAS(vk::raii::CommandBuffer& commandBuffer,
         {},
         {});
 
-    recordTopLevelASBuild(commandBuffer, vk::BuildAccelerationStructureModeKHR::eUpdate);
+    recordTopLevelASBuild(commandBuffer, mode);
 
     vk::MemoryBarrier postBarrier{};
     postBarrier.srcAccessMask = vk::AccessFlagBits::eAccelerationStructureWriteKHR;
@@ -198,83 +266,209 @@ void RayTracingContext::updateTopLevelAS(vk::raii::CommandBuffer& commandBuffer,
 
 void RayTracingContext::buildBottomLevelASes(const std::vector<GpuMesh>& meshes, const std::vector<uint8_t>& meshOpaqueFlags)
 {
+    const auto t0 = std::chrono::high_resolution_clock::now();
     bottomLevelASes.clear();
     bottomLevelASes.resize(meshes.size());
+    blasAddresses.assign(meshes.size(), 0);
 
+    struct PendingBuild {
+        uint32_t meshIndex = 0;
+        vk::AccelerationStructureGeometryKHR geometry{};
+        vk::AccelerationStructureBuildRangeInfoKHR rangeInfo{};
+        vk::DeviceSize scratchSize = 0;  // aligned to scratchAlignment
+        vk::DeviceSize scratchOffset = 0;
+    };
+    std::vector<PendingBuild> builds;
+    builds.reserve(meshes.size());
+
+    vk::BuildAccelerationStructureFlagsKHR blasFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace;
+    if (AppConfig::ENABLE_BLAS_COMPACTION) {
+        blasFlags |= vk::BuildAccelerationStructureFlagBitsKHR::eAllowCompaction;
+    }
+    // Size every BLAS and create its (uncompacted) storage up front.
+    vk::DeviceSize preCompactionBytes = 0;
+    vk::DeviceSize largestScratch = 0;
     for (size_t i = 0; i < meshes.size(); ++i) {
         const GpuMesh& mesh = meshes[i];
         if (!mesh.isUploaded() || mesh.getVertexCount() == 0 || mesh.getIndexCount() == 0) {
             continue;
         }
+        const uint32_t primitiveCount = mesh.getIndexCount() / 3;
+        if (primitiveCount == 0) {
+            continue;
+        }
 
-        vk::DeviceAddress vertexAddress = getBufferDeviceAddress(mesh.getVertexBuffer());
-        vk::DeviceAddress indexAddress = getBufferDeviceAddress(mesh.getIndexBuffer());
+        PendingBuild build{};
+        build.meshIndex = static_cast<uint32_t>(i);
 
         vk::AccelerationStructureGeometryTrianglesDataKHR triangles{};
         triangles.vertexFormat = vk::Format::eR32G32B32Sfloat;
-        triangles.vertexData.deviceAddress = vertexAddress;
+        triangles.vertexData.deviceAddress = getBufferDeviceAddress(mesh.getVertexBuffer());
         triangles.vertexStride = sizeof(Vertex);
         triangles.maxVertex = mesh.getVertexCount() > 0 ? (mesh.getVertexCount() - 1) : 0;
         triangles.indexType = vk::IndexType::eUint32;
-        triangles.indexData.deviceAddress = indexAddress;
+        triangles.indexData.deviceAddress = getBufferDeviceAddress(mesh.getIndexBuffer());
 
-        vk::AccelerationStructureGeometryKHR geometry{};
-        geometry.geometryType = vk::GeometryTypeKHR::eTriangles;
+        build.geometry.geometryType = vk::GeometryTypeKHR::eTriangles;
         // Per-mesh opaque policy:
         // - true  => mark geometry opaque for faster traversal
         // - false => allow candidate traversal + alpha test in ray query
         const bool isOpaque = (i < meshOpaqueFlags.size()) ? (meshOpaqueFlags[i] != 0u) : true;
-        geometry.flags = isOpaque ? vk::GeometryFlagBitsKHR::eOpaque : vk::GeometryFlagsKHR{};
-        geometry.geometry.triangles = triangles;
-
-        const uint32_t primitiveCount = mesh.getIndexCount() / 3;
-        if (primitiveCount == 0) {
-            continue;
-        }
+        build.geometry.flags = isOpaque ? vk::GeometryFlagBitsKHR::eOpaque : vk::GeometryFlagsKHR{};
+        build.geometry.geometry.triangles = triangles;
+        build.rangeInfo.primitiveCount = primitiveCount;
 
         vk::AccelerationStructureBuildGeometryInfoKHR buildInfo{};
         buildInfo.type = vk::AccelerationStructureTypeKHR::eBottomLevel;
-        buildInfo.flags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace;
+        buildInfo.flags = blasFlags;
         buildInfo.mode = vk::BuildAccelerationStructureModeKHR::eBuild;
         buildInfo.geometryCount = 1;
-        buildInfo.pGeometries = &geometry;
-
-        vk::AccelerationStructureBuildSizesInfoKHR buildSizeInfo{};
-        buildSizeInfo = device->getAccelerationStructureBuildSizesKHR(
+        buildInfo.pGeometries = &build.geometry;
+        const vk::AccelerationStructureBuildSizesInfoKHR buildSizeInfo = device->getAccelerationStructureBuildSizesKHR(
             vk::AccelerationStructureBuildTypeKHR::eDevice, buildInfo, primitiveCount);
 
-        BufferAllocation asStorage = createDeviceAddressBuffer(
-            buildSizeInfo.accelerationStructureSize,
-            vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR,
-            vk::MemoryPropertyFlagBits::eDeviceLocal);
-        bottomLevelASes[i].buffer = std::move(asStorage.buffer);
-        bottomLevelASes[i].memory = std::move(asStorage.memory);
+        createBlasStorage(bottomLevelASes[i], buildSizeInfo.accelerationStructureSize);
+        preCompactionBytes += buildSizeInfo.accelerationStructureSize;
+        build.scratchSize = alignUp(buildSizeInfo.buildScratchSize, scratchAlignment);
+        largestScratch = std::max(largestScratch, build.scratchSize);
+        builds.push_back(build);
+    }
+    if (builds.empty()) {
+        return;
+    }
 
-        vk::AccelerationStructureCreateInfoKHR createInfo{};
-        createInfo.buffer = *bottomLevelASes[i].buffer;
-        createInfo.size = buildSizeInfo.accelerationStructureSize;
-        createInfo.type = vk::AccelerationStructureTypeKHR::eBottomLevel;
-        bottomLevelASes[i].as = vk::raii::AccelerationStructureKHR(*device, createInfo);
+    // One scratch arena shared by all batches (each batch waits for completion before the next reuses it).
+    const vk::DeviceSize arenaSize = std::max<vk::DeviceSize>(AppConfig::BLAS_BUILD_SCRATCH_BUDGET, largestScratch);
+    BufferAllocation scratchArena = createDeviceAddressBuffer(
+        arenaSize + scratchAlignment,
+        vk::BufferUsageFlagBits::eStorageBuffer,
+        vk::MemoryPropertyFlagBits::eDeviceLocal);
+    const vk::DeviceAddress scratchBase = alignUp(getBufferDeviceAddress(*scratchArena.buffer), scratchAlignment);
+
+    std::optional<vk::raii::QueryPool> compactedSizeQueries;
+    if (AppConfig::ENABLE_BLAS_COMPACTION) {
+        vk::QueryPoolCreateInfo poolInfo{};
+        poolInfo.queryType = vk::QueryType::eAccelerationStructureCompactedSizeKHR;
+        poolInfo.queryCount = static_cast<uint32_t>(builds.size());
+        compactedSizeQueries = vk::raii::QueryPool(*device, poolInfo);
+    }
 
-        BufferAllocation scratch = createDeviceAddressBuffer(
-            buildSizeInfo.buildScratchSize,
-            vk::BufferUsageFlagBits::eStorageBuffer,
-            vk::MemoryPropertyFlagBits::eDeviceLocal);
+    // Batch builds until their scratch regions fill the arena; one vkCmdBuildAccelerationStructuresKHR per batch.
+    uint32_t batchCount = 0;
+    std::vector<vk::AccelerationStructureBuildGeometryInfoKHR> buildInfos;
+    std::vector<const vk::AccelerationStructureBuildRangeInfoKHR*> rangeInfos;
+    std::vector<vk::AccelerationStructureKHR> batchHandles;
+    size_t first = 0;
+    while (first < builds.size()) {
+        size_t last = first;
+        vk::DeviceSize scratchUsed = 0;
+        while (last < builds.size() && (last == first || scratchUsed + builds[last].scratchSize <= arenaSize)) {
+            builds[last].scratchOffset = scratchUsed;
+            scratchUsed += builds[last].scratchSize;
+            ++last;
+        }
 
-        buildInfo.dstAccelerationStructure = *bottomLevelASes[i].as;
-        buildInfo.scratchData.deviceAddress = getBufferDeviceAddress(*scratch.buffer);
+        buildInfos.clear();
+        rangeInfos.clear();
+        batchHandles.clear();
+        for (size_t k = first; k < last; ++k) {
+            PendingBuild& build = builds[k];
+            vk::AccelerationStructureBuildGeometryInfoKHR buildInfo{};
+            buildInfo.type = vk::AccelerationStructureTypeKHR::eBottomLevel;
+            buildInfo.flags = blasFlags;
+            buildInfo.mode = vk::BuildAccelerationStructureModeKHR::eBuild;
+            buildInfo.geometryCount = 1;
+            buildInfo.pGeometries = &build.geometry;
+            buildInfo.dstAccelerationStructure = *bottomLevelASes[build.meshIndex].as;
+            buildInfo.scratchData.deviceAddress = scratchBase + build.scratchOffset;
+            buildInfos.push_back(buildInfo);
+            rangeInfos.push_back(&build.rangeInfo);
+            batchHandles.push_back(buildInfo.dstAccelerationStructure);
+        }
 
-        vk::AccelerationStructureBuildRangeInfoKHR rangeInfo{};
-        rangeInfo.primitiveCount = primitiveCount;
-        rangeInfo.primitiveOffset = 0;
-        rangeInfo.firstVertex = 0;
-        rangeInfo.transformOffset = 0;
+        const uint32_t firstQuery = static_cast<uint32_t>(first);
+        resourceCreator->executeSingleTimeCommands([&](vk::raii::CommandBuffer& cb) {
+            if (compactedSizeQueries) {
+                cb.resetQueryPool(**compactedSizeQueries, firstQuery, static_cast<uint32_t>(batchHandles.size()));
+            }
+            cb.buildAccelerationStructuresKHR(buildInfos, rangeInfos);
+            if (compactedSizeQueries) {
+                // Compacted sizes can only be queried once the builds have finished writing.
+                cb.pipelineBarrier(
+                    vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
+                    vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
+                    {},
+                    vk::MemoryBarrier{
+                        vk::AccessFlagBits::eAccelerationStructureWriteKHR,
+                        vk::AccessFlagBits::eAccelerationStructureReadKHR
+                    },
+                    {},
+                    {});
+                cb.writeAccelerationStructuresPropertiesKHR(batchHandles,
+                    vk::QueryType::eAccelerationStructureCompactedSizeKHR, **compactedSizeQueries, firstQuery);
+            }
+        });
+        ++batchCount;
+        first = last;
+    }
 
-        std::array<const vk::AccelerationStructureBuildRangeInfoKHR*, 1> rangeInfos = {&rangeInfo};
+    // Copy every BLAS into storage of its compacted size, then drop the oversized originals.
+    vk::DeviceSize postCompactionBytes = preCompactionBytes;
+    if (compactedSizeQueries) {
+        const uint32_t queryCount = static_cast<uint32_t>(builds.size());
+        auto [result, compactedSizes] = compactedSizeQueries->getResults<vk::DeviceSize>(
+            0, queryCount, queryCount * sizeof(vk::DeviceSize), sizeof(vk::DeviceSize),
+            vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+        if (result != vk::Result::eSuccess) {
+            throw std::runtime_error("failed to query compacted BLAS sizes");
+        }
+
+        std::vector<BlasEntry> compacted(builds.size());
+        postCompactionBytes = 0;
+        for (size_t k = 0; k < builds.size(); ++k) {
+            createBlasStorage(compacted[k], compactedSizes[k]);
+            postCompactionBytes += compactedSizes[k];
+        }
         resourceCreator->executeSingleTimeCommands([&](vk::raii::CommandBuffer& cb) {
-            cb.buildAccelerationStructuresKHR(buildInfo, rangeInfos);
+            for (size_t k = 0; k < builds.size(); ++k) {
+                vk::CopyAccelerationStructureInfoKHR copyInfo{};
+                copyInfo.src = *bottomLevelASes[builds[k].meshIndex].as;
+                copyInfo.dst = *compacted[k].as;
+                copyInfo.mode = vk::CopyAccelerationStructureModeKHR::eCompact;
+                cb.copyAccelerationStructureKHR(copyInfo);
+            }
         });
+        for (size_t k = 0; k < builds.size(); ++k) {
+            bottomLevelASes[builds[k].meshIndex] = std::move(compacted[k]);
+        }
     }
+
+    for (const PendingBuild& build : builds) {
+        blasAddresses[build.meshIndex] = getAccelerationStructureAddress(*bottomLevelASes[build.meshIndex].as);
+    }
+
+    const double buildMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - t0).count();
+    std::cout << "[Perf] BLAS count=" << builds.size() << " batches=" << batchCount
+              << " scratch_MB=" << static_cast<double>(arenaSize) / (1024.0 * 1024.0)
+              << " bytes(pre/post)=" << preCompactionBytes << "/" << postCompactionBytes
+              << " build_ms=" << buildMs << std::endl;
+}
+
+void RayTracingContext::createBlasStorage(BlasEntry& entry, vk::DeviceSize size) const
+{
+    BufferAllocation asStorage = createDeviceAddressBuffer(
+        size,
+        vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR,
+        vk::MemoryPropertyFlagBits::eDeviceLocal);
+    entry.buffer = std::move(asStorage.buffer);
+    entry.memory = std::move(asStorage.memory);
+
+    vk::AccelerationStructureCreateInfoKHR createInfo{};
+    createInfo.buffer = *entry.buffer;
+    createInfo.size = size;
+    createInfo.type = vk::AccelerationStructureTypeKHR::eBottomLevel;
+    entry.as = vk::raii::AccelerationStructureKHR(*device, createInfo);
 }
 
 void RayTracingContext::buildTopLevelAS(uint32_t instanceCount)
@@ -332,12 +526,15 @@ void RayTracingContext::buildTopLevelAS(uint32_t instanceCount)
     createInfo.type = vk::AccelerationStructureTypeKHR::eTopLevel;
     topLevelAS = vk::raii::AccelerationStructureKHR(*device, createInfo);
 
+    // Sub-allocated buffers are only aligned to memReq.alignment: pad so the build can start at the next
+    // minAccelerationStructureScratchOffsetAlignment boundary (same as the BLAS scratch arena).
     BufferAllocation scratchAlloc = createDeviceAddressBuffer(
-        maxScratchSize,
+        maxScratchSize + scratchAlignment,
         vk::BufferUsageFlagBits::eStorageBuffer,
         vk::MemoryPropertyFlagBits::eDeviceLocal);
     topLevelScratchBuffer = std::move(scratchAlloc.buffer);
     topLevelScratchMemory = std::move(scratchAlloc.memory);
+    topLevelScratchAddress = alignUp(getBufferDeviceAddress(*topLevelScratchBuffer), scratchAlignment);
 
     if (!topLevelAS) {
         throw std::runtime_error("failed to build top-level acceleration structure");
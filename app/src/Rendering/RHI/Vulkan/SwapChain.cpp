@@ -1,7 +1,10 @@
 #include "Rendering/RHI/Vulkan/SwapChain.h"
 
+#include "Configs/AppConfig.h"
+
 #include <limits>
 #include <algorithm>
+#include <fstream>
 #include <stdexcept>
 
 namespace {
@@ -42,8 +45,33 @@ void SwapChain::init(VulkanContext& context, GLFWwindow* inWindow)
     createImageViews(context.getDevice());
 }
 
+void SwapChain::initHeadless(VulkanContext& context, VulkanResourceCreator& resourceCreator, vk::Extent2D extent)
+{
+    cleanup();
+    headless = true;
+    window = nullptr;
+    // Same format a desktop swapchain normally gets, so the tonemap pass output is identical.
+    swapChainImageFormat = vk::Format::eB8G8R8A8Srgb;
+    swapChainExtent = vk::Extent2D{std::max(1u, extent.width), std::max(1u, extent.height)};
+    headlessQueue.emplace(context.getGraphicsQueue());
+
+    // One more image than frames in flight, like minImageCount + 1 on a real swapchain.
+    const uint32_t imageCount = static_cast<uint32_t>(AppConfig::MAX_FRAMES_IN_FLIGHT) + 1u;
+    for (uint32_t i = 0; i < imageCount; ++i) {
+        offscreenImages.push_back(resourceCreator.createImage(
+            swapChainExtent.width, swapChainExtent.height, 1, vk::SampleCountFlagBits::e1, swapChainImageFormat,
+            vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc,
+            vk::MemoryPropertyFlagBits::eDeviceLocal));
+        swapChainImages.push_back(static_cast<vk::Image>(*offscreenImages.back().image));
+    }
+    createImageViews(context.getDevice());
+}
+
 void SwapChain::recreate(VulkanContext& context, GLFWwindow* inWindow)
 {
+    if (headless) {
+        return;  // fixed extent, nothing to recreate
+    }
     waitForValidFramebufferSize(inWindow);
 
     context.getDevice().waitIdle();
@@ -57,14 +85,75 @@ void SwapChain::recreate(VulkanContext& context, GLFWwindow* inWindow)
 void SwapChain::cleanup()
 {
     swapChainImageViews.clear();
+    swapChainImages.clear();
+    offscreenImages.clear();
+    headlessQueue.reset();
+    nextHeadlessImage = 0;
     swapChain.reset();
 }
 
 vk::ResultValue<uint32_t> SwapChain::acquireNextImage(uint64_t timeout, vk::Semaphore semaphore, vk::Fence fence) const
 {
+    if (headless) {
+        // The previous frame to use this image is ordered before the next submit on the same queue, so the image is
+        // available immediately; an empty submit signals the semaphore/fence the caller waits on.
+        const uint32_t index = nextHeadlessImage;
+        nextHeadlessImage = (nextHeadlessImage + 1u) % static_cast<uint32_t>(swapChainImages.size());
+        vk::SubmitInfo submitInfo{};
+        if (semaphore) {
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores = &semaphore;
+        }
+        headlessQueue->submit(submitInfo, fence);
+        return vk::ResultValue<uint32_t>(vk::Result::eSuccess, index);
+    }
     return swapChain->acquireNextImage(timeout, semaphore, fence);
 }
 
+bool SwapChain::saveImage(VulkanResourceCreator& resourceCreator, uint32_t imageIndex, const std::string& path) const
+{
+    if (!headless || imageIndex >= swapChainImages.size()) {
+        return false;
+    }
+
+    const uint32_t width = swapChainExtent.width;
+    const uint32_t height = swapChainExtent.height;
+    const vk::DeviceSize size = static_cast<vk::DeviceSize>(width) * height * 4u;
+    BufferAllocation readback = resourceCreator.createBuffer(
+        size, vk::BufferUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+
+    // Submitted after the frame on the same queue; the rendergraph's final barrier already made the color writes
+    // visible to transfer reads in eTransferSrcOptimal.
+    resourceCreator.executeSingleTimeCommands([&](vk::raii::CommandBuffer& cb) {
+        vk::BufferImageCopy region{};
+        region.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent = vk::Extent3D{width, height, 1};
+        cb.copyImageToBuffer(swapChainImages[imageIndex], vk::ImageLayout::eTransferSrcOptimal, *readback.buffer, region);
+    });
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    // Binary PPM (P6): RGB, 8 bit, values already sRGB-encoded by the B8G8R8A8_SRGB attachment.
+    out << "P6\n" << width << " " << height << "\n255\n";
+    const auto* pixels = static_cast<const uint8_t*>(readback.memory.mapMemory(0, size));
+    std::vector<uint8_t> row(static_cast<size_t>(width) * 3u);
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* src = pixels + static_cast<size_t>(y) * width * 4u;
+        for (uint32_t x = 0; x < width; ++x) {
+            row[x * 3u + 0u] = src[x * 4u + 2u];
+            row[x * 3u + 1u] = src[x * 4u + 1u];
+            row[x * 3u + 2u] = src[x * 4u + 0u];
+        }
+        out.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+    }
+    readback.memory.unmapMemory();
+    return static_cast<bool>(out);
+}
+
 std::vector<vk::ImageView> SwapChain::getImageViews() const
 {
     std::vector<vk::ImageView> result;
@@ -0,0 +1,420 @@
+#include "Rendering/RHI/Vulkan/UploadManager.h"
+
+#include "Configs/AppConfig.h"
+#include "Rendering/RHI/Vulkan/VulkanContext.h"
+#include "Rendering/RHI/Vulkan/VulkanResourceCreator.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+constexpr vk::DeviceSize kBufferCopyAlignment = 16;
+// Covers optimalBufferCopyOffsetAlignment and texel-size alignment of every format we upload.
+constexpr vk::DeviceSize kImageCopyAlignment = 256;
+
+vk::DeviceSize alignUp(vk::DeviceSize value, vk::DeviceSize alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+} // namespace
+
+void UploadManager::init(VulkanContext& context, VulkanResourceCreator& creator)
+{
+    device = &context.getDevice();
+    resourceCreator = &creator;
+    graphicsFamily = context.getGraphicsQueueFamilyIndex();
+    transferFamily = context.getTransferQueueFamilyIndex();
+    dedicatedTransfer = context.hasDedicatedTransferQueue();
+    graphicsQueue = context.getGraphicsQueue();
+    transferQueue = context.getTransferQueue();
+
+    vk::CommandPoolCreateInfo poolInfo{};
+    poolInfo.flags = vk::CommandPoolCreateFlagBits::eTransient;
+    poolInfo.queueFamilyIndex = graphicsFamily;
+    graphicsPool = device->createCommandPool(poolInfo);
+    if (dedicatedTransfer) {
+        poolInfo.queueFamilyIndex = transferFamily;
+        transferPool = device->createCommandPool(poolInfo);
+    }
+
+    vk::SemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.semaphoreType = vk::SemaphoreType::eTimeline;
+    typeInfo.initialValue = 0;
+    vk::SemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.pNext = &typeInfo;
+    timeline = device->createSemaphore(semaphoreInfo);
+
+    ringSize = AppConfig::UPLOAD_STAGING_RING_SIZE;
+    BufferAllocation ring = resourceCreator->createBuffer(
+        ringSize, vk::BufferUsageFlagBits::eTransferSrc,
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+    ringBuffer = std::move(ring.buffer);
+    ringMemory = std::move(ring.memory);
+    ringMapped = static_cast<uint8_t*>(ringMemory.mapMemory(0, ringSize));
+    ringHead = 0;
+    ringTail = 0;
+    stats = Stats{};
+}
+
+void UploadManager::cleanup()
+{
+    if (!device) return;
+    waitIdle();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    inFlight.clear();
+    pending = Batch{};
+    ringMapped = nullptr;
+    ringMemory = GpuAllocation{};
+    ringBuffer.reset();
+    timeline.reset();
+    transferPool.reset();
+    graphicsPool.reset();
+    transferQueue = vk::raii::Queue{nullptr};
+    graphicsQueue = vk::raii::Queue{nullptr};
+    device = nullptr;
+}
+
+uint64_t UploadManager::completedValue() const
+{
+    return timeline->getCounterValue();
+}
+
+vk::raii::CommandBuffer& UploadManager::transferCommands()
+{
+    if (!pending.transferCommands) {
+        vk::CommandBufferAllocateInfo allocInfo{};
+        allocInfo.commandPool = **transferPool;
+        allocInfo.level = vk::CommandBufferLevel::ePrimary;
+        allocInfo.commandBufferCount = 1;
+        pending.transferCommands.emplace(*device, allocInfo);
+        vk::CommandBufferBeginInfo beginInfo{};
+        beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+        (*pending.transferCommands)[0].begin(beginInfo);
+    }
+    return (*pending.transferCommands)[0];
+}
+
+vk::raii::CommandBuffer& UploadManager::graphicsCommands()
+{
+    if (!pending.graphicsCommands) {
+        vk::CommandBufferAllocateInfo allocInfo{};
+        allocInfo.commandPool = **graphicsPool;
+        allocInfo.level = vk::CommandBufferLevel::ePrimary;
+        allocInfo.commandBufferCount = 1;
+        pending.graphicsCommands.emplace(*device, allocInfo);
+        vk::CommandBufferBeginInfo beginInfo{};
+        beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+        (*pending.graphicsCommands)[0].begin(beginInfo);
+    }
+    return (*pending.graphicsCommands)[0];
+}
+
+bool UploadManager::tryAllocateRing(vk::DeviceSize size, vk::DeviceSize alignment, vk::DeviceSize& offset)
+{
+    bool empty = !pending.hasRingData;
+    for (const Batch& batch : inFlight) {
+        empty = empty && !batch.hasRingData;
+    }
+    if (empty) {
+        ringHead = 0;
+        ringTail = 0;
+    }
+
+    const vk::DeviceSize aligned = alignUp(ringHead, alignment);
+    if (empty || ringHead >= ringTail) {
+        // Live data (if any) is [tail, head): use the end of the ring, else wrap to the front.
+        if (aligned + size <= ringSize) {
+            offset = aligned;
+        } else if (size < ringTail) {
+            offset = 0;
+        } else {
+            return false;
+        }
+    } else {
+        // Wrapped: live data is [tail, end) + [0, head); keep head strictly below tail.
+        if (aligned + size < ringTail) {
+            offset = aligned;
+        } else {
+            return false;
+        }
+    }
+    ringHead = offset + size;
+    pending.hasRingData = true;
+    pending.ringEnd = ringHead;
+    return true;
+}
+
+UploadManager::StagingSlice UploadManager::allocateStaging(vk::DeviceSize size, vk::DeviceSize alignment)
+{
+    StagingSlice slice{};
+    if (size > ringSize) {
+        BufferAllocation staging = resourceCreator->createBuffer(
+            size, vk::BufferUsageFlagBits::eTransferSrc,
+            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+        slice.buffer = *staging.buffer;
+        slice.mapped = staging.memory.mapMemory(0, size);
+        pending.oversizeBuffers.push_back(std::move(staging.buffer));
+        pending.oversizeMemory.push_back(std::move(staging.memory));
+        ++stats.oversizeStagings;
+        return slice;
+    }
+
+    vk::DeviceSize offset = 0;
+    while (!tryAllocateRing(size, alignment, offset)) {
+        // Ring full: submit what we have, then free space by retiring the oldest batch.
+        if (pending.hasRingData) {
+            flushLocked();
+        }
+        retireCompleted(true);
+        ++stats.ringWaits;
+    }
+    slice.buffer = **ringBuffer;
+    slice.offset = offset;
+    slice.mapped = ringMapped + offset;
+    return slice;
+}
+
+UploadTicket UploadManager::uploadBuffer(vk::Buffer dst, vk::DeviceSize dstOffset, const void* data, vk::DeviceSize size)
+{
+    if (size == 0) return 0;
+    std::lock_guard<std::mutex> lock(mutex);
+    retireCompleted(false);
+
+    const StagingSlice staging = allocateStaging(size, kBufferCopyAlignment);
+    std::memcpy(staging.mapped, data, static_cast<size_t>(size));
+
+    vk::BufferCopy region{};
+    region.srcOffset = staging.offset;
+    region.dstOffset = dstOffset;
+    region.size = size;
+
+    if (dedicatedTransfer) {
+        vk::BufferMemoryBarrier release{};
+        release.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        release.srcQueueFamilyIndex = transferFamily;
+        release.dstQueueFamilyIndex = graphicsFamily;
+        release.buffer = dst;
+        release.offset = dstOffset;
+        release.size = size;
+        vk::raii::CommandBuffer& tcb = transferCommands();
+        tcb.copyBuffer(staging.buffer, dst, region);
+        tcb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe, {}, {}, release, {});
+
+        vk::BufferMemoryBarrier acquire = release;
+        acquire.srcAccessMask = {};
+        acquire.dstAccessMask = vk::AccessFlagBits::eMemoryRead;
+        graphicsCommands().pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eAllCommands,
+                                           {}, {}, acquire, {});
+    } else {
+        graphicsCommands().copyBuffer(staging.buffer, dst, region);
+        pending.hasBufferCopies = true;
+    }
+
+    stats.bytes += size;
+    ++stats.copies;
+    return nextTicket;
+}
+
+UploadTicket UploadManager::uploadImage(vk::Image dst, vk::Format format, const void* data, vk::DeviceSize size,
+                                        const std::vector<vk::BufferImageCopy>& regions, uint32_t mipLevels,
+                                        uint32_t layerCount, bool generateMips, vk::Extent2D baseExtent)
+{
+    if (regions.empty()) return 0;
+    std::lock_guard<std::mutex> lock(mutex);
+    retireCompleted(false);
+
+    const StagingSlice staging = allocateStaging(size, kImageCopyAlignment);
+    std::memcpy(staging.mapped, data, static_cast<size_t>(size));
+    std::vector<vk::BufferImageCopy> copies = regions;
+    for (vk::BufferImageCopy& copy : copies) {
+        copy.bufferOffset += staging.offset;
+    }
+
+    vk::ImageMemoryBarrier toTransferDst{};
+    toTransferDst.oldLayout = vk::ImageLayout::eUndefined;
+    toTransferDst.newLayout = vk::ImageLayout::eTransferDstOptimal;
+    toTransferDst.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransferDst.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransferDst.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+    toTransferDst.image = dst;
+    toTransferDst.subresourceRange = vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, 0, mipLevels, 0, layerCount};
+
+    // Final layout of the copy: mip generation starts from eTransferDstOptimal.
+    const vk::ImageLayout copiedLayout =
+        generateMips ? vk::ImageLayout::eTransferDstOptimal : vk::ImageLayout::eShaderReadOnlyOptimal;
+
+    vk::ImageMemoryBarrier finish{};
+    finish.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+    finish.newLayout = copiedLayout;
+    finish.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    finish.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    finish.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    finish.image = dst;
+    finish.subresourceRange = toTransferDst.subresourceRange;
+
+    const vk::PipelineStageFlags consumerStage =
+        generateMips ? vk::PipelineStageFlags(vk::PipelineStageFlagBits::eTransfer) : vk::PipelineStageFlagBits::eAllCommands;
+    const vk::AccessFlags consumerAccess =
+        generateMips ? (vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite) : vk::AccessFlagBits::eShaderRead;
+
+    if (dedicatedTransfer) {
+        vk::raii::CommandBuffer& tcb = transferCommands();
+        tcb.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, toTransferDst);
+        tcb.copyBufferToImage(staging.buffer, dst, vk::ImageLayout::eTransferDstOptimal, copies);
+
+        // Release/acquire pair: same layouts on both sides, the transition happens once.
+        finish.srcQueueFamilyIndex = transferFamily;
+        finish.dstQueueFamilyIndex = graphicsFamily;
+        tcb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe, {}, {}, {}, finish);
+
+        vk::ImageMemoryBarrier acquire = finish;
+        acquire.srcAccessMask = {};
+        acquire.dstAccessMask = consumerAccess;
+        graphicsCommands().pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, consumerStage, {}, {}, {}, acquire);
+    } else {
+        vk::raii::CommandBuffer& gcb = graphicsCommands();
+        gcb.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, toTransferDst);
+        gcb.copyBufferToImage(staging.buffer, dst, vk::ImageLayout::eTransferDstOptimal, copies);
+        if (!generateMips) {
+            finish.dstAccessMask = consumerAccess;
+            gcb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, consumerStage, {}, {}, {}, finish);
+        }
+    }
+    if (generateMips) {
+        resourceCreator->recordGenerateMipmaps(graphicsCommands(), dst, format, baseExtent.width, baseExtent.height, mipLevels);
+    }
+
+    stats.bytes += size;
+    stats.copies += copies.size();
+    return nextTicket;
+}
+
+UploadTicket UploadManager::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return flushLocked();
+}
+
+UploadTicket UploadManager::flushLocked()
+{
+    if (!pending.transferCommands && !pending.graphicsCommands) {
+        return lastSubmitted;
+    }
+
+    // Two timeline values per batch: transfer signals ticket - 1, graphics waits on it and signals the ticket.
+    const UploadTicket ticket = nextTicket;
+    const uint64_t transferValue = ticket - 1;
+    vk::Semaphore semaphore = **timeline;
+
+    if (pending.transferCommands) {
+        vk::raii::CommandBuffer& tcb = (*pending.transferCommands)[0];
+        tcb.end();
+        vk::CommandBuffer cb = *tcb;
+
+        vk::TimelineSemaphoreSubmitInfo timelineInfo{};
+        timelineInfo.signalSemaphoreValueCount = 1;
+        timelineInfo.pSignalSemaphoreValues = &transferValue;
+        vk::SubmitInfo submitInfo{};
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &cb;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &semaphore;
+        transferQueue.submit(submitInfo);
+    }
+
+    vk::raii::CommandBuffer& gcb = graphicsCommands();
+    if (pending.hasBufferCopies) {
+        vk::MemoryBarrier barrier{};
+        barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        barrier.dstAccessMask = vk::AccessFlagBits::eMemoryRead;
+        gcb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands, {}, barrier, {}, {});
+    }
+    gcb.end();
+    vk::CommandBuffer cb = *gcb;
+
+    const vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eAllCommands;
+    vk::TimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues = &ticket;
+    vk::SubmitInfo submitInfo{};
+    submitInfo.pNext = &timelineInfo;
+    if (pending.transferCommands) {
+        timelineInfo.waitSemaphoreValueCount = 1;
+        timelineInfo.pWaitSemaphoreValues = &transferValue;
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &semaphore;
+        submitInfo.pWaitDstStageMask = &waitStage;
+    }
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &cb;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &semaphore;
+    graphicsQueue.submit(submitInfo);
+
+    pending.ticket = ticket;
+    inFlight.push_back(std::move(pending));
+    pending = Batch{};
+    lastSubmitted = ticket;
+    nextTicket += 2;
+    ++stats.batches;
+    return ticket;
+}
+
+void UploadManager::retireCompleted(bool waitForOldest)
+{
+    if (waitForOldest && !inFlight.empty()) {
+        const uint64_t value = inFlight.front().ticket;
+        vk::Semaphore semaphore = **timeline;
+        vk::SemaphoreWaitInfo waitInfo{};
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &semaphore;
+        waitInfo.pValues = &value;
+        if (device->waitSemaphores(waitInfo, UINT64_MAX) != vk::Result::eSuccess) {
+            throw std::runtime_error("failed to wait for upload batch!");
+        }
+    }
+
+    const uint64_t completed = completedValue();
+    while (!inFlight.empty() && inFlight.front().ticket <= completed) {
+        if (inFlight.front().hasRingData) {
+            ringTail = inFlight.front().ringEnd;
+        }
+        inFlight.pop_front();
+    }
+}
+
+void UploadManager::wait(UploadTicket ticket)
+{
+    if (ticket == 0) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ticket >= nextTicket) {
+        // Still recording: submit it first.
+        flushLocked();
+    }
+    while (!inFlight.empty() && inFlight.front().ticket <= ticket) {
+        retireCompleted(true);
+    }
+}
+
+bool UploadManager::isComplete(UploadTicket ticket) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return ticket < nextTicket && completedValue() >= ticket;
+}
+
+void UploadManager::waitIdle()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    flushLocked();
+    while (!inFlight.empty()) {
+        retireCompleted(true);
+    }
+}
+
+UploadManager::Stats UploadManager::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
@@ -1,5 +1,7 @@
 #include "Rendering/RHI/Vulkan/VulkanContext.h"
 
+#include "Configs/AppConfig.h"
+
 #include <set>
 #include <cstring>
 #include <stdexcept>
@@ -20,15 +22,22 @@ vk::Bool32 VulkanContext::debugCallback(
 
 void VulkanContext::init(GLFWwindow* window)
 {
+    headless = (window == nullptr);
     createInstance();
     setupDebugMessenger();
-    createSurface(window);
+    if (!headless) {
+        createSurface(window);
+    }
     pickPhysicalDevice();
     createLogicalDevice();
+    pipelineCache.init(*device, *physicalDevice, AppConfig::PIPELINE_CACHE_PATH, pipelineCreationFeedbackEnabled);
 }
 
 void VulkanContext::cleanup()
 {
+    if (device) {
+        pipelineCache.cleanup();
+    }
     device.reset();
     surface.reset();
     debugMessenger.reset();
@@ -87,9 +96,12 @@ bool VulkanContext::checkValidationLayerSupport() const
 
 std::vector<const char*> VulkanContext::getRequiredExtensions() const
 {
-    uint32_t glfwExtensionCount = 0;
-    const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-    std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    std::vector<const char*> extensions;
+    if (!headless) {
+        uint32_t glfwExtensionCount = 0;
+        const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+        extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    }
     if (enableValidationLayers) {
         extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
     }
@@ -133,20 +145,24 @@ void VulkanContext::pickPhysicalDevice()
         throw std::runtime_error("failed to find GPUs with Vulkan support!");
     }
 
+    // Prefer a device with ray query (RT shadows/reflections, RTAO); fall back to the first suitable one without it.
     size_t pickIndex = 0;
     bool foundSuitable = false;
-    for (size_t i = 0; i < physicalDevices.size(); i++) {
-        if (isDeviceSuitable(physicalDevices[i])) {
+    bool foundRayTracing = false;
+    for (size_t i = 0; i < physicalDevices.size() && !foundRayTracing; i++) {
+        if (!isDeviceSuitable(physicalDevices[i])) continue;
+        const bool rayTracing = hasRayTracingSupport(physicalDevices[i]);
+        if (!foundSuitable || rayTracing) {
             pickIndex = i;
             foundSuitable = true;
-            break;
+            foundRayTracing = rayTracing;
         }
     }
 
     if (!foundSuitable) {
         throw std::runtime_error(
-            "failed to find a suitable GPU with required ray tracing shadow features "
-            "(rayQuery + accelerationStructure + bufferDeviceAddress + fragmentStoresAndAtomics)!");
+            "failed to find a suitable GPU "
+            "(multiDrawIndirect + shaderDrawParameters + fragmentStoresAndAtomics + samplerAnisotropy)!");
     }
 
     physicalDevice = std::move(physicalDevices[pickIndex]);
@@ -156,10 +172,10 @@ void VulkanContext::pickPhysicalDevice()
 bool VulkanContext::isDeviceSuitable(const vk::raii::PhysicalDevice& dev) const
 {
     QueueFamilyIndices indices = findQueueFamilies(dev);
-    bool extensionsSupported = checkDeviceExtensionSupport(dev);
+    bool extensionsSupported = checkDeviceExtensionSupport(dev, getRequiredDeviceExtensions());
 
-    bool swapChainAdequate = false;
-    if (extensionsSupported) {
+    bool swapChainAdequate = headless;
+    if (extensionsSupported && !headless) {
         SwapChainSupportDetails swapChainSupport = querySwapChainSupport(dev);
         swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
     }
@@ -175,12 +191,14 @@ bool VulkanContext::isDeviceSuitable(const vk::raii::PhysicalDevice& dev) const
         && supportedFeatures.samplerAnisotropy
         && supportedFeatures.multiDrawIndirect
         && supportedFeatures.fragmentStoresAndAtomics
-        && vulkan11Features.shaderDrawParameters
-        && hasRequiredRayTracingFeatures(dev);
+        && vulkan11Features.shaderDrawParameters;
 }
 
-bool VulkanContext::hasRequiredRayTracingFeatures(const vk::raii::PhysicalDevice& dev) const
+bool VulkanContext::hasRayTracingSupport(const vk::raii::PhysicalDevice& dev) const
 {
+    if (!checkDeviceExtensionSupport(dev, rayTracingDeviceExtensions)) {
+        return false;
+    }
     auto featuresChain = dev.getFeatures2<
         vk::PhysicalDeviceFeatures2,
         vk::PhysicalDeviceVulkan12Features,
@@ -204,21 +222,40 @@ QueueFamilyIndices VulkanContext::findQueueFamilies(const vk::raii::PhysicalDevi
 
     for (uint32_t i = 0; i < queueFamilies.size(); ++i) {
         const auto& queueFamily = queueFamilies[i];
-        if (queueFamily.queueFlags & vk::QueueFlagBits::eGraphics) {
+        if (!indices.graphicsFamily && (queueFamily.queueFlags & vk::QueueFlagBits::eGraphics)) {
             indices.graphicsFamily = i;
         }
-        if (dev.getSurfaceSupportKHR(i, *surface)) {
+        if (!indices.presentFamily && surface && dev.getSurfaceSupportKHR(i, *surface)) {
             indices.presentFamily = i;
         }
-        if (indices.isComplete()) break;
+        const vk::QueueFlags flags = queueFamily.queueFlags;
+        if (!indices.transferFamily && (flags & vk::QueueFlagBits::eTransfer) &&
+            !(flags & (vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute))) {
+            indices.transferFamily = i;
+        }
+    }
+    if (headless) {
+        // Nothing is presented; the "present" queue only has to exist for code that asks for it.
+        indices.presentFamily = indices.graphicsFamily;
     }
     return indices;
 }
 
-bool VulkanContext::checkDeviceExtensionSupport(const vk::raii::PhysicalDevice& dev) const
+std::vector<const char*> VulkanContext::getRequiredDeviceExtensions() const
+{
+    std::vector<const char*> extensions;
+    for (const char* extension : deviceExtensions) {
+        if (headless && std::strcmp(extension, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0) continue;
+        extensions.push_back(extension);
+    }
+    return extensions;
+}
+
+bool VulkanContext::checkDeviceExtensionSupport(const vk::raii::PhysicalDevice& dev,
+                                                const std::vector<const char*>& required) const
 {
     auto availableExtensions = dev.enumerateDeviceExtensionProperties();
-    std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
+    std::set<std::string> requiredExtensions(required.begin(), required.end());
     for (const auto& extension : availableExtensions) {
         requiredExtensions.erase(extension.extensionName);
     }
@@ -249,8 +286,9 @@ void VulkanContext::createLogicalDevice()
     QueueFamilyIndices indices = findQueueFamilies(*physicalDevice);
     graphicsQueueFamilyIndex = indices.graphicsFamily.value();
     presentQueueFamilyIndex = indices.presentFamily.value();
+    transferQueueFamilyIndex = indices.transferFamily.value_or(graphicsQueueFamilyIndex);
 
-    std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily.value(), indices.presentFamily.value()};
+    std::set<uint32_t> uniqueQueueFamilies = {graphicsQueueFamilyIndex, presentQueueFamilyIndex, transferQueueFamilyIndex};
 
     std::vector<vk::DeviceQueueCreateInfo> queueCreateInfos;
     float queuePriority = 1.0f;
@@ -270,9 +308,20 @@ void VulkanContext::createLogicalDevice()
     // Required by RTAO: fragment shader writes to storage image (imageStore).
     deviceFeatures.fragmentStoresAndAtomics = supported.fragmentStoresAndAtomics ? VK_TRUE : VK_FALSE;
 
+    auto supported12Chain = physicalDevice->getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>();
+    const auto& supported12 = supported12Chain.get<vk::PhysicalDeviceVulkan12Features>();
+
+    // Optional: ray query (and the device addresses / bindless reflection textures only its shaders use).
+    rayQueryEnabled = hasRayTracingSupport(*physicalDevice);
+
     vk::PhysicalDeviceVulkan12Features vulkan12Features{};
-    vulkan12Features.bufferDeviceAddress = VK_TRUE;
-    vulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    vulkan12Features.bufferDeviceAddress = rayQueryEnabled ? VK_TRUE : VK_FALSE;
+    vulkan12Features.shaderSampledImageArrayNonUniformIndexing = rayQueryEnabled ? VK_TRUE : VK_FALSE;
+    // Upload tickets (UploadManager) are timeline semaphore values; core and mandatory in Vulkan 1.2.
+    vulkan12Features.timelineSemaphore = VK_TRUE;
+    // Optional: GPU-driven culling writes per-bucket draw counts consumed by vkCmdDrawIndexedIndirectCount.
+    vulkan12Features.drawIndirectCount = supported12.drawIndirectCount;
+    drawIndirectCountEnabled = (supported12.drawIndirectCount == VK_TRUE);
 
     vk::PhysicalDeviceVulkan11Features vulkan11Features{};
     vulkan11Features.shaderDrawParameters = VK_TRUE;
@@ -286,17 +335,40 @@ void VulkanContext::createLogicalDevice()
     rayQueryFeatures.rayQuery = VK_TRUE;
     rayQueryFeatures.pNext = &accelFeatures;
 
+    // Rendergraph barriers: vkCmdPipelineBarrier2 batches and split barriers (vkCmdSetEvent2 / vkCmdWaitEvents2).
+    vk::PhysicalDeviceSynchronization2FeaturesKHR synchronization2Features{};
+    synchronization2Features.synchronization2 = VK_TRUE;
+    if (rayQueryEnabled) {
+        synchronization2Features.pNext = &rayQueryFeatures;
+    } else {
+        synchronization2Features.pNext = &vulkan11Features;
+    }
+
     vk::PhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeature{};
     dynamicRenderingFeature.dynamicRendering = VK_TRUE;
-    dynamicRenderingFeature.pNext = &rayQueryFeatures;
+    dynamicRenderingFeature.pNext = &synchronization2Features;
+
+    // Optional: per-pipeline cache-hit feedback for the PipelineCache stats (no features to enable).
+    std::vector<const char*> enabledExtensions = getRequiredDeviceExtensions();
+    if (rayQueryEnabled) {
+        enabledExtensions.insert(enabledExtensions.end(), rayTracingDeviceExtensions.begin(), rayTracingDeviceExtensions.end());
+    }
+    pipelineCreationFeedbackEnabled = false;
+    for (const auto& extension : physicalDevice->enumerateDeviceExtensionProperties()) {
+        if (std::strcmp(extension.extensionName, VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME) == 0) {
+            enabledExtensions.push_back(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME);
+            pipelineCreationFeedbackEnabled = true;
+            break;
+        }
+    }
 
     vk::DeviceCreateInfo createInfo{};
     createInfo.pNext = &dynamicRenderingFeature;
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     createInfo.pEnabledFeatures = &deviceFeatures;
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensions.size());
+    createInfo.ppEnabledExtensionNames = enabledExtensions.data();
     if (enableValidationLayers) {
         createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
         createInfo.ppEnabledLayerNames = validationLayers.data();
@@ -304,12 +376,9 @@ void VulkanContext::createLogicalDevice()
         createInfo.enabledLayerCount = 0;
     }
 
-    try {
-        device = vk::raii::Device(*physicalDevice, createInfo);
-    } catch (const std::exception& e) {
-        throw std::runtime_error(std::string("Ray tracing shadow requires VK_KHR_ray_query, ")
-                                 + "VK_KHR_acceleration_structure and VK_KHR_buffer_device_address: "
-                                 + e.what());
+    device = vk::raii::Device(*physicalDevice, createInfo);
+    if (!rayQueryEnabled) {
+        std::cout << "[Vulkan] VK_KHR_ray_query unavailable: ray traced shadows/reflections and RTAO disabled\n";
     }
 }
 
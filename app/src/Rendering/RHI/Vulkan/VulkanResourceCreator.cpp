@@ -1,5 +1,7 @@
 #include "Rendering/RHI/Vulkan/VulkanResourceCreator.h"
 
+#include "Configs/AppConfig.h"
+
 #include <stdexcept>
 
 bool VulkanResourceCreator::hasStencilComponent(vk::Format format)
@@ -11,6 +13,7 @@ void VulkanResourceCreator::init(VulkanContext& context)
 {
     device = &context.getDevice();
     physicalDevice = &context.getPhysicalDevice();
+    pipelineCache = &context.getPipelineCache();
     graphicsQueue = context.getGraphicsQueue();
 
     QueueFamilyIndices queueFamilyIndices = context.findQueueFamilies(context.getPhysicalDevice());
@@ -18,22 +21,16 @@ void VulkanResourceCreator::init(VulkanContext& context)
     poolInfo.flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer;
     poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
     commandPool = device->createCommandPool(poolInfo);
+    memoryAllocator.init(*device, *physicalDevice);
+    uploader.init(context, *this);
 }
 
 void VulkanResourceCreator::cleanup()
 {
+    uploader.cleanup();
     commandPool.reset();
-}
-
-uint32_t VulkanResourceCreator::findMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags properties)
-{
-    auto memProperties = physicalDevice->getMemoryProperties();
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            return i;
-        }
-    }
-    throw std::runtime_error("failed to find suitable memory type!");
+    // Blocks still referenced by live resources are freed with their last allocation.
+    memoryAllocator.cleanup();
 }
 
 BufferAllocation VulkanResourceCreator::createBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage, vk::MemoryPropertyFlags properties)
@@ -44,19 +41,13 @@ BufferAllocation VulkanResourceCreator::createBuffer(vk::DeviceSize size, vk::Bu
     bufferInfo.sharingMode = vk::SharingMode::eExclusive;
 
     vk::raii::Buffer buffer(*device, bufferInfo);
-    vk::MemoryRequirements memRequirements = buffer.getMemoryRequirements();
-
-    vk::MemoryAllocateInfo allocInfo{};
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-    vk::MemoryAllocateFlagsInfo allocFlagsInfo{};
-    if (usage & vk::BufferUsageFlagBits::eShaderDeviceAddress) {
-        allocFlagsInfo.flags = vk::MemoryAllocateFlagBits::eDeviceAddress;
-        allocInfo.pNext = &allocFlagsInfo;
-    }
 
-    vk::raii::DeviceMemory memory(*device, allocInfo);
-    buffer.bindMemory(*memory, 0);
+    GpuMemoryAllocator::Request request{};
+    request.requirements = buffer.getMemoryRequirements();
+    request.properties = properties;
+    request.deviceAddress = static_cast<bool>(usage & vk::BufferUsageFlagBits::eShaderDeviceAddress);
+    GpuAllocation memory = memoryAllocator.allocate(request);
+    buffer.bindMemory(memory.getMemory(), memory.getOffset());
 
     return {std::move(buffer), std::move(memory)};
 }
@@ -64,6 +55,15 @@ BufferAllocation VulkanResourceCreator::createBuffer(vk::DeviceSize size, vk::Bu
 ImageAllocation VulkanResourceCreator::createImage(uint32_t width, uint32_t height, uint32_t mipLevels, vk::SampleCountFlagBits samples,
                                                    vk::Format format, vk::ImageTiling tiling, vk::ImageUsageFlags usage, vk::MemoryPropertyFlags properties,
                                                    uint32_t arrayLayers, vk::ImageCreateFlags flags)
+{
+    vk::raii::Image image = createUnboundImage(width, height, mipLevels, samples, format, tiling, usage, arrayLayers, flags);
+    GpuAllocation memory = bindImageMemory(image, tiling, usage, properties);
+    return {std::move(image), std::move(memory)};
+}
+
+vk::raii::Image VulkanResourceCreator::createUnboundImage(uint32_t width, uint32_t height, uint32_t mipLevels, vk::SampleCountFlagBits samples,
+                                                          vk::Format format, vk::ImageTiling tiling, vk::ImageUsageFlags usage,
+                                                          uint32_t arrayLayers, vk::ImageCreateFlags flags)
 {
     vk::ImageCreateInfo imageInfo{};
     imageInfo.imageType = vk::ImageType::e2D;
@@ -78,17 +78,47 @@ ImageAllocation VulkanResourceCreator::createImage(uint32_t width, uint32_t heig
     imageInfo.sharingMode = vk::SharingMode::eExclusive;
     imageInfo.flags = flags;
 
-    vk::raii::Image image(*device, imageInfo);
-    vk::MemoryRequirements memRequirements = image.getMemoryRequirements();
+    return vk::raii::Image(*device, imageInfo);
+}
 
-    vk::MemoryAllocateInfo allocInfo{};
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+GpuAllocation VulkanResourceCreator::bindImageMemory(vk::raii::Image& image, vk::ImageTiling tiling, vk::ImageUsageFlags usage,
+                                                     vk::MemoryPropertyFlags properties)
+{
+    GpuMemoryAllocator::Request request{};
+    request.requirements = image.getMemoryRequirements();
+    request.properties = properties;
+    request.optimalImage = (tiling == vk::ImageTiling::eOptimal);
+    // Big render targets are recreated on resize: give them their own allocation instead of pinning a block.
+    const vk::ImageUsageFlags attachmentUsage =
+        vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eDepthStencilAttachment;
+    if ((usage & attachmentUsage) && request.requirements.size >= AppConfig::GPU_MEMORY_DEDICATED_THRESHOLD) {
+        request.dedicated = true;
+        request.dedicatedImage = *image;
+    }
+    GpuAllocation memory = memoryAllocator.allocate(request);
+    image.bindMemory(memory.getMemory(), memory.getOffset());
+    return memory;
+}
 
-    vk::raii::DeviceMemory memory(*device, allocInfo);
-    image.bindMemory(*memory, 0);
+GpuAllocation VulkanResourceCreator::allocateSharedImageMemory(const vk::MemoryRequirements& requirements, vk::MemoryPropertyFlags properties)
+{
+    GpuMemoryAllocator::Request request{};
+    request.requirements = requirements;
+    request.properties = properties;
+    request.optimalImage = true;
+    request.dedicated = true;
+    return memoryAllocator.allocate(request);
+}
 
-    return {std::move(image), std::move(memory)};
+bool VulkanResourceCreator::hasMemoryType(uint32_t memoryTypeBits, vk::MemoryPropertyFlags properties) const
+{
+    const vk::PhysicalDeviceMemoryProperties memoryProperties = physicalDevice->getMemoryProperties();
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+        if ((memoryTypeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return true;
+        }
+    }
+    return false;
 }
 
 vk::raii::ImageView VulkanResourceCreator::createImageView(vk::Image image, vk::Format format, vk::ImageAspectFlags aspectFlags, uint32_t mipLevels,
@@ -204,69 +234,75 @@ void VulkanResourceCreator::transitionImageLayout(vk::Image image, vk::Format fo
 }
 
 void VulkanResourceCreator::generateMipmaps(vk::Image image, vk::Format format, uint32_t texWidth, uint32_t texHeight, uint32_t mipLevels)
+{
+    executeSingleTimeCommands([&](vk::raii::CommandBuffer& cb) {
+        recordGenerateMipmaps(cb, image, format, texWidth, texHeight, mipLevels);
+    });
+}
+
+void VulkanResourceCreator::recordGenerateMipmaps(vk::raii::CommandBuffer& cb, vk::Image image, vk::Format format,
+                                                  uint32_t texWidth, uint32_t texHeight, uint32_t mipLevels)
 {
     auto formatProperties = physicalDevice->getFormatProperties(format);
     if (!(formatProperties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eSampledImageFilterLinear)) {
         throw std::runtime_error("texture image format does not support linear blitting!");
     }
 
-    executeSingleTimeCommands([&](vk::raii::CommandBuffer& cb) {
-        vk::ImageMemoryBarrier barrier{};
-        barrier.image = image;
-        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
-        barrier.subresourceRange.levelCount = 1;
-        barrier.subresourceRange.baseArrayLayer = 0;
-        barrier.subresourceRange.layerCount = 1;
-
-        int32_t mipWidth = static_cast<int32_t>(texWidth);
-        int32_t mipHeight = static_cast<int32_t>(texHeight);
-
-        for (uint32_t i = 1; i < mipLevels; i++) {
-            barrier.subresourceRange.baseMipLevel = i - 1;
-            barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
-            barrier.newLayout = vk::ImageLayout::eTransferSrcOptimal;
-            barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
-            barrier.dstAccessMask = vk::AccessFlagBits::eTransferRead;
-
-            cb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, barrier);
-
-            vk::ImageBlit blit{};
-            blit.srcOffsets[0] = vk::Offset3D{0, 0, 0};
-            blit.srcOffsets[1] = vk::Offset3D{mipWidth, mipHeight, 1};
-            blit.srcSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
-            blit.srcSubresource.mipLevel = i - 1;
-            blit.srcSubresource.baseArrayLayer = 0;
-            blit.srcSubresource.layerCount = 1;
-            blit.dstOffsets[0] = vk::Offset3D{0, 0, 0};
-            blit.dstOffsets[1] = vk::Offset3D{mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1, 1};
-            blit.dstSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
-            blit.dstSubresource.mipLevel = i;
-            blit.dstSubresource.baseArrayLayer = 0;
-            blit.dstSubresource.layerCount = 1;
-
-            cb.blitImage(image, vk::ImageLayout::eTransferSrcOptimal, image, vk::ImageLayout::eTransferDstOptimal, blit, vk::Filter::eLinear);
-
-            barrier.oldLayout = vk::ImageLayout::eTransferSrcOptimal;
-            barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-            barrier.srcAccessMask = vk::AccessFlagBits::eTransferRead;
-            barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
-
-            cb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {}, barrier);
+    vk::ImageMemoryBarrier barrier{};
+    barrier.image = image;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
 
-            if (mipWidth > 1) mipWidth /= 2;
-            if (mipHeight > 1) mipHeight /= 2;
-        }
+    int32_t mipWidth = static_cast<int32_t>(texWidth);
+    int32_t mipHeight = static_cast<int32_t>(texHeight);
 
-        barrier.subresourceRange.baseMipLevel = mipLevels - 1;
+    for (uint32_t i = 1; i < mipLevels; i++) {
+        barrier.subresourceRange.baseMipLevel = i - 1;
         barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
-        barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+        barrier.newLayout = vk::ImageLayout::eTransferSrcOptimal;
         barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        barrier.dstAccessMask = vk::AccessFlagBits::eTransferRead;
+
+        cb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, barrier);
+
+        vk::ImageBlit blit{};
+        blit.srcOffsets[0] = vk::Offset3D{0, 0, 0};
+        blit.srcOffsets[1] = vk::Offset3D{mipWidth, mipHeight, 1};
+        blit.srcSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+        blit.srcSubresource.mipLevel = i - 1;
+        blit.srcSubresource.baseArrayLayer = 0;
+        blit.srcSubresource.layerCount = 1;
+        blit.dstOffsets[0] = vk::Offset3D{0, 0, 0};
+        blit.dstOffsets[1] = vk::Offset3D{mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1, 1};
+        blit.dstSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+        blit.dstSubresource.mipLevel = i;
+        blit.dstSubresource.baseArrayLayer = 0;
+        blit.dstSubresource.layerCount = 1;
+
+        cb.blitImage(image, vk::ImageLayout::eTransferSrcOptimal, image, vk::ImageLayout::eTransferDstOptimal, blit, vk::Filter::eLinear);
+
+        barrier.oldLayout = vk::ImageLayout::eTransferSrcOptimal;
+        barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+        barrier.srcAccessMask = vk::AccessFlagBits::eTransferRead;
         barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
 
         cb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {}, barrier);
-    });
+
+        if (mipWidth > 1) mipWidth /= 2;
+        if (mipHeight > 1) mipHeight /= 2;
+    }
+
+    barrier.subresourceRange.baseMipLevel = mipLevels - 1;
+    barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+    barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+    barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+
+    cb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {}, barrier);
 }
 
 vk::Format VulkanResourceCreator::findDepthFormat()
@@ -22,14 +22,16 @@ void FrameManager::init(VulkanContext& context, SwapChain& swapChain, GraphicsPi
     (void)rendergraph;
     devicePtr = &context.getDevice();
     maxDraws = std::max(1u, inMaxDraws);
+    rayTracingEnabled = context.supportsRayQuery();
     pipelineLayoutHandle = pipeline.getPipelineLayout();
     swapChainExtent = swapChain.getExtent();
     materialCount = std::max(1u, static_cast<uint32_t>(model.getMaterials().size()));
     lastViewProj = glm::mat4(1.0f);
     uniformFrameIndex = 0;
 
-    createCommandBuffers(context.getDevice(), resourceCreator, swapChain);
-    createSyncObjects(context.getDevice(), swapChain);
+    createCommandBuffers(context.getDevice(), resourceCreator);
+    createFrameSyncObjects(context.getDevice());
+    createRenderFinishedSemaphores(context.getDevice(), swapChain);
     createUniformBuffers(context.getDevice(), resourceCreator);
     createDrawDataBuffers(context.getDevice(), resourceCreator);
     createIndirectCommandBuffers(context.getDevice(), resourceCreator);
@@ -39,43 +41,31 @@ void FrameManager::init(VulkanContext& context, SwapChain& swapChain, GraphicsPi
     createNormalTextures(resourceCreator, context.getMsaaSamples());
     createLinearDepthTextures(resourceCreator, context.getMsaaSamples());
     createRtaoComputeTextures(resourceCreator);
+    ++extentTargetsGeneration;
     createReflectionBuffers(resourceCreator, model);
     createDescriptorPool(context.getDevice());
     createDescriptorSets(context.getDevice(), resourceCreator, pipeline, model, rayTracingContext);
     buildSharedDrawSlots(model);
 }
 
-void FrameManager::recreate(VulkanContext& context, SwapChain& swapChain, GraphicsPipeline& pipeline,
-                            Rendergraph& rendergraph, VulkanResourceCreator& resourceCreator, Model& model,
-                            RayTracingContext& rayTracingContext, uint32_t inMaxDraws)
+void FrameManager::onSwapchainRecreated(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator)
 {
-    (void)rendergraph;
-    devicePtr = &context.getDevice();
-    maxDraws = std::max(1u, inMaxDraws);
-    pipelineLayoutHandle = pipeline.getPipelineLayout();
     swapChainExtent = swapChain.getExtent();
+    // RTAO history is reallocated below, so restart temporal accumulation.
     lastViewProj = glm::mat4(1.0f);
     uniformFrameIndex = 0;
-    cleanupSwapChainResources(context.getDevice());
-    materialCount = std::max(1u, static_cast<uint32_t>(model.getMaterials().size()));
-    createCommandBuffers(context.getDevice(), resourceCreator, swapChain);
-    createSyncObjects(context.getDevice(), swapChain);
-    createUniformBuffers(context.getDevice(), resourceCreator);
-    createDrawDataBuffers(context.getDevice(), resourceCreator);
-    createIndirectCommandBuffers(context.getDevice(), resourceCreator);
-    createDefaultPbrTextures(resourceCreator);
-    createDefaultIblTextures(resourceCreator);
+
+    if (renderFinishedSemaphores.size() != swapChain.getImages().size()) {
+        createRenderFinishedSemaphores(context.getDevice(), swapChain);
+    }
+
+    releaseExtentDependentTextures();
     createDepthResolveTexture(resourceCreator);
     createNormalTextures(resourceCreator, context.getMsaaSamples());
     createLinearDepthTextures(resourceCreator, context.getMsaaSamples());
     createRtaoComputeTextures(resourceCreator);
-    createReflectionBuffers(resourceCreator, model);
-    createDescriptorPool(context.getDevice());
-    createDescriptorSets(context.getDevice(), resourceCreator, pipeline, model, rayTracingContext);
-    buildSharedDrawSlots(model);
-    if (skyboxDescriptorSets) {
-        updateSkyboxDescriptorBuffers(context.getDevice());
-    }
+    ++extentTargetsGeneration;
+    updateExtentDependentDescriptors(context.getDevice());
 }
 
 void FrameManager::buildSharedDrawSlots(const Model& model)
@@ -113,21 +103,38 @@ void FrameManager::buildSharedDrawSlots(const Model& model)
             if (a.matIndex != b.matIndex) return a.matIndex < b.matIndex;
             return a.meshIndex < b.meshIndex;
         });
+    if (sharedOpaqueSlots.size() > maxDraws) {
+        sharedOpaqueSlots.resize(maxDraws);
+    }
+
+    sharedOpaqueSlotSpans.clear();
+    for (uint32_t i = 0; i < sharedOpaqueSlots.size(); ++i) {
+        const SharedOpaqueDrawSlot& slot = sharedOpaqueSlots[i];
+        if (sharedOpaqueSlotSpans.empty() || sharedOpaqueSlotSpans.back().doubleSided != slot.doubleSided
+            || sharedOpaqueSlotSpans.back().matIndex != slot.matIndex) {
+            SharedOpaqueBucketSpan span{};
+            span.doubleSided = slot.doubleSided;
+            span.matIndex = slot.matIndex;
+            span.firstCommand = i;
+            sharedOpaqueSlotSpans.push_back(span);
+        }
+        ++sharedOpaqueSlotSpans.back().drawCount;
+    }
+    drawDataSlotLayout.fill(false);
 }
 
-void FrameManager::prepareSharedOpaqueIndirect(const Model& model, const GlobalMeshBuffer& globalMeshBuffer, const glm::mat4& modelMatrix)
+void FrameManager::prepareSharedOpaqueIndirect(const Model& model, const GlobalMeshBuffer& globalMeshBuffer,
+                                               const std::vector<uint8_t>& nodeVisibility)
 {
-    const auto& linearNodes = model.getLinearNodes();
-    sharedNodeWorldMatrices.resize(linearNodes.size());
-    for (Node* n : linearNodes) {
-        if (!n || n->linearIndex >= linearNodes.size()) continue;
-        const glm::mat4 parentWorld = n->parent ? sharedNodeWorldMatrices[n->parent->linearIndex] : modelMatrix;
-        sharedNodeWorldMatrices[n->linearIndex] = parentWorld * n->getLocalMatrix();
-    }
+    const auto& sharedNodeWorldMatrices = model.getWorldMatrices();
+    sharedNodeVisibility = nodeVisibility;
+    sharedOpaqueGpuDriven = false;
 
     sharedOpaqueBucketSpans.clear();
     sharedOpaqueDrawCount = 0;
     const uint32_t frameIdx = getCurrentFrame();
+    // Compacted draw ids overwrite the slot-indexed layout of this frame slot.
+    drawDataSlotLayout[frameIdx] = false;
     auto* drawDataMapped = static_cast<glm::mat4*>(getDrawDataMapped(frameIdx));
     auto* indirectMapped = static_cast<vk::DrawIndexedIndirectCommand*>(getIndirectCommandsMapped(frameIdx));
     const auto& meshInfos = globalMeshBuffer.getMeshInfos();
@@ -138,6 +145,7 @@ void FrameManager::prepareSharedOpaqueIndirect(const Model& model, const GlobalM
     for (const auto& slot : sharedOpaqueSlots) {
         if (drawId >= maxDraws) break;
         if (slot.nodeLinearIndex >= sharedNodeWorldMatrices.size() || slot.meshIndex >= meshInfos.size()) continue;
+        if (!isSharedNodeVisible(slot.nodeLinearIndex)) continue;  // frustum-culled: compacted out of the span
         if (drawDataMapped) drawDataMapped[drawId] = sharedNodeWorldMatrices[slot.nodeLinearIndex];
         const MeshDrawInfo& info = meshInfos[slot.meshIndex];
         vk::DrawIndexedIndirectCommand cmd{};
@@ -174,6 +182,35 @@ void FrameManager::prepareSharedOpaqueIndirect(const Model& model, const GlobalM
     sharedOpaqueDrawCount = drawId;
 }
 
+void FrameManager::prepareSharedOpaqueGpuDriven(const Model& model, const std::vector<uint8_t>& nodeVisibility)
+{
+    const auto& worldMatrices = model.getWorldMatrices();
+    const auto& nodeVersions = model.getNodeWorldVersions();
+    sharedNodeVisibility = nodeVisibility;
+    sharedOpaqueGpuDriven = true;
+    sharedOpaqueBucketSpans = sharedOpaqueSlotSpans;
+    sharedOpaqueDrawCount = static_cast<uint32_t>(sharedOpaqueSlots.size());
+
+    const uint32_t frameIdx = getCurrentFrame();
+    auto* drawDataMapped = static_cast<glm::mat4*>(getDrawDataMapped(frameIdx));
+    if (!drawDataMapped) {
+        return;
+    }
+    const bool fullSync = !drawDataSlotLayout[frameIdx];
+    const uint64_t syncedVersion = drawDataSyncedVersion[frameIdx];
+    if (!fullSync && syncedVersion == model.getTransformVersion()) {
+        return;  // static scene: nothing to write
+    }
+    for (uint32_t drawId = 0; drawId < sharedOpaqueSlots.size(); ++drawId) {
+        const uint32_t node = sharedOpaqueSlots[drawId].nodeLinearIndex;
+        if (node >= worldMatrices.size()) continue;
+        if (!fullSync && node < nodeVersions.size() && nodeVersions[node] <= syncedVersion) continue;
+        drawDataMapped[drawId] = worldMatrices[node];
+    }
+    drawDataSlotLayout[frameIdx] = true;
+    drawDataSyncedVersion[frameIdx] = model.getTransformVersion();
+}
+
 vk::DescriptorSet FrameManager::getDescriptorSet(uint32_t frameIndex, uint32_t materialIndex) const
 {
     if (!descriptorSets) {
@@ -343,6 +380,25 @@ void FrameManager::setIblResources(vk::raii::Device& device, vk::ImageView irrad
     }
 }
 
+void FrameManager::updateExtentDependentDescriptors(vk::raii::Device& device)
+{
+    if (!descriptorSets) return;
+
+    // rtao_full (binding 15) is the only extent-sized image the material sets reference.
+    vk::DescriptorImageInfo rtaoFullInfo{};
+    rtaoFullInfo.imageLayout = vk::ImageLayout::eGeneral;
+    rtaoFullInfo.imageView = getRtaoFullImageView();
+    rtaoFullInfo.sampler = getRtaoFullSampler();
+
+    const uint32_t setCount = AppConfig::MAX_FRAMES_IN_FLIGHT * materialCount;
+    std::vector<vk::WriteDescriptorSet> writes;
+    writes.reserve(setCount);
+    for (uint32_t i = 0; i < setCount; ++i) {
+        writes.push_back(vk::WriteDescriptorSet{(*descriptorSets)[i], 15, 0, 1, vk::DescriptorType::eCombinedImageSampler, &rtaoFullInfo});
+    }
+    device.updateDescriptorSets(writes, nullptr);
+}
+
 void FrameManager::updateSkyboxDescriptorBuffers(vk::raii::Device& device)
 {
     if (!skyboxDescriptorSets || uniformBuffers.size() < AppConfig::MAX_FRAMES_IN_FLIGHT) return;
@@ -427,13 +483,18 @@ void FrameManager::cleanup(vk::raii::Device& device)
     postDescriptorSets.reset();
     postDescriptorPool.reset();
     postSampler.reset();
-    imageAvailableFence.reset();
     renderFinishedSemaphores.clear();
-    inFlightFences.clear();
+    imageAvailableSemaphores.clear();
+    frameTimeline.reset();
+    slotTimelineValues.fill(0);
+    lastTimelineValue = 0;
     sharedOpaqueSlots.clear();
-    sharedNodeWorldMatrices.clear();
+    sharedOpaqueSlotSpans.clear();
     sharedOpaqueBucketSpans.clear();
     sharedOpaqueDrawCount = 0;
+    sharedNodeVisibility.clear();
+    sharedOpaqueGpuDriven = false;
+    drawDataSlotLayout.fill(false);
     devicePtr = nullptr;
 }
 
@@ -448,8 +509,8 @@ void FrameManager::updateUniformBuffer(uint32_t currentImage, vk::Extent2D exten
     PBRUniformBufferObject ubo{};
     ubo.model = modelMatrix;
     ubo.view = camera.getViewMatrix();
-    // Use a larger far plane so common glTF scenes (e.g. Sponza) are not clipped away.
-    ubo.proj = camera.getProjMatrix(extent.width / static_cast<float>(extent.height), 0.1f, 1000.0f);
+    ubo.proj = camera.getProjMatrix(extent.width / static_cast<float>(extent.height),
+                                    AppConfig::CAMERA_NEAR_PLANE, AppConfig::CAMERA_FAR_PLANE);
     ubo.prevViewProj = lastViewProj;
 
     setPbrLights(ubo);
@@ -499,7 +560,7 @@ void FrameManager::setPbrLights(PBRUniformBufferObject& ubo)
         debugViewW);
 
     ubo.rtaoParams0 = glm::vec4(
-        AppConfig::ENABLE_RTAO ? 1.0f : 0.0f,
+        (AppConfig::ENABLE_RTAO && rayTracingEnabled) ? 1.0f : 0.0f,
         static_cast<float>(AppConfig::RTAO_RAY_COUNT),
         AppConfig::RTAO_RADIUS,
         AppConfig::RTAO_BIAS);
@@ -510,39 +571,84 @@ void FrameManager::setPbrLights(PBRUniformBufferObject& ubo)
         static_cast<float>(uniformFrameIndex));
 }
 
-void FrameManager::createCommandBuffers(vk::raii::Device& device, VulkanResourceCreator& resourceCreator, SwapChain& swapChain)
+void FrameManager::createCommandBuffers(vk::raii::Device& device, VulkanResourceCreator& resourceCreator)
 {
     commandPoolPtr = &resourceCreator.getCommandPool();
     vk::CommandBufferAllocateInfo allocInfo{};
     allocInfo.level = vk::CommandBufferLevel::ePrimary;
     allocInfo.commandPool = *commandPoolPtr;
-    allocInfo.commandBufferCount = static_cast<uint32_t>(swapChain.getImages().size());
+    // One per frame slot (indexed by currentFrame), independent of the swapchain image count.
+    allocInfo.commandBufferCount = AppConfig::MAX_FRAMES_IN_FLIGHT;
 
     commandBuffers = vk::raii::CommandBuffers(device, allocInfo);
 }
 
-void FrameManager::createSyncObjects(vk::raii::Device& device, SwapChain& swapChain)
+void FrameManager::createFrameSyncObjects(vk::raii::Device& device)
 {
-    imageAvailableFence.reset();
-    renderFinishedSemaphores.clear();
-    inFlightFences.clear();
+    vk::SemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.semaphoreType = vk::SemaphoreType::eTimeline;
+    typeInfo.initialValue = 0;
+    vk::SemaphoreCreateInfo timelineInfo{};
+    timelineInfo.pNext = &typeInfo;
+    frameTimeline = device.createSemaphore(timelineInfo);
+    slotTimelineValues.fill(0);
+    lastTimelineValue = 0;
+
+    imageAvailableSemaphores.clear();
+    imageAvailableSemaphores.reserve(AppConfig::MAX_FRAMES_IN_FLIGHT);
+    for (uint32_t i = 0; i < AppConfig::MAX_FRAMES_IN_FLIGHT; i++) {
+        imageAvailableSemaphores.push_back(vk::raii::Semaphore(device, vk::SemaphoreCreateInfo{}));
+    }
+}
 
-    uint32_t imageCount = static_cast<uint32_t>(swapChain.getImages().size());
+void FrameManager::createRenderFinishedSemaphores(vk::raii::Device& device, SwapChain& swapChain)
+{
+    // Per swapchain image: presentation may still be reading the semaphore when the same frame slot comes around.
+    renderFinishedSemaphores.clear();
+    const uint32_t imageCount = static_cast<uint32_t>(swapChain.getImages().size());
     renderFinishedSemaphores.reserve(imageCount);
-    inFlightFences.reserve(AppConfig::MAX_FRAMES_IN_FLIGHT);
-
-    vk::SemaphoreCreateInfo semaphoreInfo{};
-    vk::FenceCreateInfo fenceInfo{};
-    fenceInfo.flags = vk::FenceCreateFlagBits::eSignaled;
+    for (uint32_t i = 0; i < imageCount; i++) {
+        renderFinishedSemaphores.push_back(vk::raii::Semaphore(device, vk::SemaphoreCreateInfo{}));
+    }
+}
 
-    imageAvailableFence = vk::raii::Fence(device, fenceInfo);
+void FrameManager::waitForCurrentFrameSlot(vk::raii::Device& device) const
+{
+    const uint64_t value = slotTimelineValues[currentFrame];
+    if (value == 0 || frameTimeline->getCounterValue() >= value) {
+        return;
+    }
+    vk::Semaphore semaphore = **frameTimeline;
+    vk::SemaphoreWaitInfo waitInfo{};
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &semaphore;
+    waitInfo.pValues = &value;
+    (void)device.waitSemaphores(waitInfo, UINT64_MAX);
+}
 
-    for (uint32_t i = 0; i < imageCount; i++) {
-        renderFinishedSemaphores.push_back(vk::raii::Semaphore(device, semaphoreInfo));
+void FrameManager::waitForAllFrames(vk::raii::Device& device) const
+{
+    if (lastTimelineValue == 0) {
+        return;
     }
-    for (size_t i = 0; i < AppConfig::MAX_FRAMES_IN_FLIGHT; i++) {
-        inFlightFences.push_back(vk::raii::Fence(device, fenceInfo));
+    vk::Semaphore semaphore = **frameTimeline;
+    vk::SemaphoreWaitInfo waitInfo{};
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &semaphore;
+    waitInfo.pValues = &lastTimelineValue;
+    (void)device.waitSemaphores(waitInfo, UINT64_MAX);
+}
+
+void FrameManager::setFramesInFlight(vk::raii::Device& device, uint32_t count)
+{
+    count = std::clamp(count, 1u, static_cast<uint32_t>(AppConfig::MAX_FRAMES_IN_FLIGHT));
+    if (count == framesInFlight) {
+        return;
     }
+    // Slots are re-indexed from 0, so nothing recorded under the old count may still be running.
+    waitForAllFrames(device);
+    framesInFlight = count;
+    currentFrame = 0;
 }
 
 void FrameManager::createDrawDataBuffers(vk::raii::Device& device, VulkanResourceCreator& resourceCreator)
@@ -1152,15 +1258,15 @@ vk::Sampler FrameManager::getLinearDepthResolveSampler() const
     return linearDepthResolve.sampler ? static_cast<vk::Sampler>(*linearDepthResolve.sampler) : vk::Sampler{};
 }
 
-vk::ImageView FrameManager::getRtaoHalfHistoryImageViewForFrame(uint32_t frameIndex, bool previous) const
+vk::ImageView FrameManager::getRtaoHalfHistoryImageView(bool previous) const
 {
-    const uint32_t index = previous ? (((frameIndex % 2) + 1) % 2) : (frameIndex % 2);
+    const uint32_t index = static_cast<uint32_t>((frameSerial + (previous ? 1u : 0u)) % 2u);
     return rtaoHalfHistory[index].view ? static_cast<vk::ImageView>(*rtaoHalfHistory[index].view) : vk::ImageView{};
 }
 
-vk::Image FrameManager::getRtaoHalfHistoryImageForFrame(uint32_t frameIndex, bool previous) const
+vk::Image FrameManager::getRtaoHalfHistoryImage(bool previous) const
 {
-    const uint32_t index = previous ? (((frameIndex % 2) + 1) % 2) : (frameIndex % 2);
+    const uint32_t index = static_cast<uint32_t>((frameSerial + (previous ? 1u : 0u)) % 2u);
     return rtaoHalfHistory[index].image ? static_cast<vk::Image>(*rtaoHalfHistory[index].image) : vk::Image{};
 }
 
@@ -1387,14 +1493,15 @@ void FrameManager::createDescriptorPool(vk::raii::Device& device)
     poolSizes[0].descriptorCount = static_cast<uint32_t>(AppConfig::MAX_FRAMES_IN_FLIGHT * materialCount);
     poolSizes[1].type = vk::DescriptorType::eCombinedImageSampler;
     poolSizes[1].descriptorCount = static_cast<uint32_t>(AppConfig::MAX_FRAMES_IN_FLIGHT * materialCount * (5 + AppConfig::MAX_REFLECTION_MATERIAL_COUNT + 3 + 1));
-    poolSizes[2].type = vk::DescriptorType::eAccelerationStructureKHR;
-    poolSizes[2].descriptorCount = static_cast<uint32_t>(AppConfig::MAX_FRAMES_IN_FLIGHT * materialCount);
-    poolSizes[3].type = vk::DescriptorType::eStorageBuffer;
-    poolSizes[3].descriptorCount = static_cast<uint32_t>(AppConfig::MAX_FRAMES_IN_FLIGHT * materialCount * 4);  // 3 reflection + 1 drawData
+    poolSizes[2].type = vk::DescriptorType::eStorageBuffer;
+    poolSizes[2].descriptorCount = static_cast<uint32_t>(AppConfig::MAX_FRAMES_IN_FLIGHT * materialCount * 4);  // 3 reflection + 1 drawData
+    poolSizes[3].type = vk::DescriptorType::eAccelerationStructureKHR;
+    poolSizes[3].descriptorCount = static_cast<uint32_t>(AppConfig::MAX_FRAMES_IN_FLIGHT * materialCount);
 
     vk::DescriptorPoolCreateInfo poolInfo{};
     poolInfo.flags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet;
-    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    // Without ray query the layout has no TLAS binding, so the (last) acceleration structure size is dropped.
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size()) - (rayTracingEnabled ? 0u : 1u);
     poolInfo.pPoolSizes = poolSizes.data();
     poolInfo.maxSets = static_cast<uint32_t>(AppConfig::MAX_FRAMES_IN_FLIGHT * materialCount);
 
@@ -1415,8 +1522,9 @@ void FrameManager::createDescriptorSets(vk::raii::Device& device, VulkanResource
 
     descriptorSets = vk::raii::DescriptorSets(device, allocInfo);
 
-    const vk::AccelerationStructureKHR topLevelAS = rayTracingContext.getTopLevelAS();
-    if (!topLevelAS) {
+    const vk::AccelerationStructureKHR topLevelAS =
+        rayTracingEnabled ? rayTracingContext.getTopLevelAS() : vk::AccelerationStructureKHR{};
+    if (rayTracingEnabled && !topLevelAS) {
         throw std::runtime_error("ray tracing TLAS is not initialized");
     }
 
@@ -1618,11 +1726,62 @@ void FrameManager::createDescriptorSets(vk::raii::Device& device, VulkanResource
             descriptorWritesWithDrawData[14] = vk::WriteDescriptorSet{(*descriptorSets)[flatIndex], 14, 0, 1, vk::DescriptorType::eCombinedImageSampler, &brdfLutInfo};
             descriptorWritesWithDrawData[15] = vk::WriteDescriptorSet{(*descriptorSets)[flatIndex], 15, 0, 1, vk::DescriptorType::eCombinedImageSampler, &rtaoFullInfo};
 
-            device.updateDescriptorSets(descriptorWritesWithDrawData, nullptr);
+            if (rayTracingEnabled) {
+                device.updateDescriptorSets(descriptorWritesWithDrawData, nullptr);
+            } else {
+                // No binding 6 in the layout: write everything but the TLAS.
+                std::vector<vk::WriteDescriptorSet> writes(descriptorWritesWithDrawData.begin(), descriptorWritesWithDrawData.end());
+                writes.erase(writes.begin() + 6);
+                device.updateDescriptorSets(writes, nullptr);
+            }
         }
     }
 }
 
+void FrameManager::releaseExtentDependentTextures()
+{
+    depthResolve.sampler.reset();
+    depthResolve.view.reset();
+    depthResolve.image.reset();
+    depthResolve.memory.reset();
+    depthResolveFormat = vk::Format::eUndefined;
+    normalPrepass.sampler.reset();
+    normalPrepass.view.reset();
+    normalPrepass.image.reset();
+    normalPrepass.memory.reset();
+    normalResolve.sampler.reset();
+    normalResolve.view.reset();
+    normalResolve.image.reset();
+    normalResolve.memory.reset();
+    normalFormat = vk::Format::eUndefined;
+    linearDepthPrepass.sampler.reset();
+    linearDepthPrepass.view.reset();
+    linearDepthPrepass.image.reset();
+    linearDepthPrepass.memory.reset();
+    linearDepthResolve.sampler.reset();
+    linearDepthResolve.view.reset();
+    linearDepthResolve.image.reset();
+    linearDepthResolve.memory.reset();
+    linearDepthFormat = vk::Format::eUndefined;
+    for (auto& tex : rtaoHalfHistory) {
+        tex.sampler.reset();
+        tex.view.reset();
+        tex.image.reset();
+        tex.memory.reset();
+    }
+    for (auto& tex : rtaoAtrousPingPong) {
+        tex.sampler.reset();
+        tex.view.reset();
+        tex.image.reset();
+        tex.memory.reset();
+    }
+    rtaoFull.sampler.reset();
+    rtaoFull.view.reset();
+    rtaoFull.image.reset();
+    rtaoFull.memory.reset();
+    rtaoFormat = vk::Format::eUndefined;
+}
+
 void FrameManager::cleanupSwapChainResources(vk::raii::Device& device)
 {
     (void)device;
@@ -1685,46 +1844,7 @@ void FrameManager::cleanupSwapChainResources(vk::raii::Device& device)
     defaultIblBrdf.view.reset();
     defaultIblBrdf.image.reset();
     defaultIblBrdf.memory.reset();
-    depthResolve.sampler.reset();
-    depthResolve.view.reset();
-    depthResolve.image.reset();
-    depthResolve.memory.reset();
-    depthResolveFormat = vk::Format::eUndefined;
-    normalPrepass.sampler.reset();
-    normalPrepass.view.reset();
-    normalPrepass.image.reset();
-    normalPrepass.memory.reset();
-    normalResolve.sampler.reset();
-    normalResolve.view.reset();
-    normalResolve.image.reset();
-    normalResolve.memory.reset();
-    normalFormat = vk::Format::eUndefined;
-    linearDepthPrepass.sampler.reset();
-    linearDepthPrepass.view.reset();
-    linearDepthPrepass.image.reset();
-    linearDepthPrepass.memory.reset();
-    linearDepthResolve.sampler.reset();
-    linearDepthResolve.view.reset();
-    linearDepthResolve.image.reset();
-    linearDepthResolve.memory.reset();
-    linearDepthFormat = vk::Format::eUndefined;
-    for (auto& tex : rtaoHalfHistory) {
-        tex.sampler.reset();
-        tex.view.reset();
-        tex.image.reset();
-        tex.memory.reset();
-    }
-    for (auto& tex : rtaoAtrousPingPong) {
-        tex.sampler.reset();
-        tex.view.reset();
-        tex.image.reset();
-        tex.memory.reset();
-    }
-    rtaoFull.sampler.reset();
-    rtaoFull.view.reset();
-    rtaoFull.image.reset();
-    rtaoFull.memory.reset();
-    rtaoFormat = vk::Format::eUndefined;
+    releaseExtentDependentTextures();
 
     descriptorSets.reset();
     descriptorPool.reset();
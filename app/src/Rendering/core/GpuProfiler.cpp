@@ -0,0 +1,198 @@
+#include "Rendering/core/GpuProfiler.h"
+
+#include "Engine/Profiling/Percentile.h"
+#include "Engine/Profiling/Trace.h"
+#include "Rendering/RHI/Vulkan/VulkanContext.h"
+
+#include <algorithm>
+#include <numeric>
+
+void GpuProfiler::init(VulkanContext& context)
+{
+    cleanup();
+    if (!AppConfig::ENABLE_GPU_PROFILER) {
+        return;
+    }
+
+    const vk::raii::PhysicalDevice& physicalDevice = context.getPhysicalDevice();
+    const vk::PhysicalDeviceLimits limits = physicalDevice.getProperties().limits;
+    const auto queueFamilies = physicalDevice.getQueueFamilyProperties();
+    const uint32_t validBits = queueFamilies[context.getGraphicsQueueFamilyIndex()].timestampValidBits;
+    if (validBits == 0 || limits.timestampPeriod <= 0.0f) {
+        return;
+    }
+    nsPerTick = static_cast<double>(limits.timestampPeriod);
+    timestampMask = (validBits >= 64) ? ~0ull : ((1ull << validBits) - 1ull);
+
+    vk::QueryPoolCreateInfo poolInfo{};
+    poolInfo.queryType = vk::QueryType::eTimestamp;
+    poolInfo.queryCount = 2u * AppConfig::GPU_PROFILER_MAX_SCOPES;
+    for (FrameQueries& frame : frames) {
+        frame.queryPool = vk::raii::QueryPool(context.getDevice(), poolInfo);
+        frame.scopes.reserve(AppConfig::GPU_PROFILER_MAX_SCOPES);
+    }
+    if (traceTrack == UINT32_MAX) {
+        traceTrack = Trace::get().registerTrack("GPU");
+    }
+    active = true;
+}
+
+void GpuProfiler::cleanup()
+{
+    for (FrameQueries& frame : frames) {
+        frame.queryPool.reset();
+        frame.scopes.clear();
+    }
+    recording = nullptr;
+    active = false;
+    names.clear();
+    traceNames.clear();
+    nameIndices.clear();
+    histories.clear();
+    summaries.clear();
+    lastHarvest = HarvestedFrame{};
+    recordedFrames = 0;
+    lateScopes = 0;
+}
+
+void GpuProfiler::reset()
+{
+    for (FrameQueries& frame : frames) {
+        frame.scopes.clear();
+        frame.submitNs = 0;
+    }
+    recording = nullptr;
+    for (ScopeHistory& history : histories) {
+        history = ScopeHistory{};
+    }
+    summaries.clear();
+    lastHarvest = HarvestedFrame{};
+    lateScopes = 0;
+}
+
+void GpuProfiler::beginFrame(vk::raii::CommandBuffer& commandBuffer, uint32_t frameIndex)
+{
+    recording = nullptr;
+    if (!active) return;
+
+    FrameQueries& frame = frames[frameIndex % AppConfig::MAX_FRAMES_IN_FLIGHT];
+    harvest(frame);
+    commandBuffer.resetQueryPool(**frame.queryPool, 0, 2u * AppConfig::GPU_PROFILER_MAX_SCOPES);
+    frame.frameNumber = ++recordedFrames;
+    recording = &frame;
+}
+
+uint32_t GpuProfiler::beginScope(vk::raii::CommandBuffer& commandBuffer, const std::string& name)
+{
+    if (!recording || recording->scopes.size() >= AppConfig::GPU_PROFILER_MAX_SCOPES) {
+        return UINT32_MAX;
+    }
+    const uint32_t scope = static_cast<uint32_t>(recording->scopes.size());
+    recording->scopes.push_back({internName(name), false});
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, **recording->queryPool, 2u * scope);
+    return scope;
+}
+
+void GpuProfiler::endScope(vk::raii::CommandBuffer& commandBuffer, uint32_t scope)
+{
+    if (!recording || scope >= recording->scopes.size()) {
+        return;
+    }
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, **recording->queryPool, 2u * scope + 1u);
+    recording->scopes[scope].closed = true;
+}
+
+void GpuProfiler::markSubmitted(uint32_t frameIndex)
+{
+    if (!active) return;
+    frames[frameIndex % AppConfig::MAX_FRAMES_IN_FLIGHT].submitNs = Trace::get().isEnabled() ? Trace::nowNs() : 0;
+}
+
+uint32_t GpuProfiler::internName(const std::string& name)
+{
+    auto [it, inserted] = nameIndices.try_emplace(name, static_cast<uint32_t>(names.size()));
+    if (inserted) {
+        names.push_back(name);
+        traceNames.push_back(Trace::get().intern(name));
+        histories.emplace_back();
+    }
+    return it->second;
+}
+
+void GpuProfiler::harvest(FrameQueries& frame)
+{
+    lastHarvest.frameNumber = frame.frameNumber;
+    lastHarvest.scopes.clear();
+    const uint32_t queryCount = 2u * static_cast<uint32_t>(frame.scopes.size());
+    if (queryCount == 0 || !frame.queryPool) {
+        frame.scopes.clear();
+        return;
+    }
+
+    // No eWait: each query yields {timestamp, available}. The slot's timeline value has been waited, so results are
+    // normally ready; a scope with either timestamp unavailable is dropped.
+    constexpr vk::DeviceSize stride = 2u * sizeof(uint64_t);
+    const vk::QueryResultFlags flags = vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability;
+    auto [result, data] = frame.queryPool->getResults<uint64_t>(0, queryCount, static_cast<size_t>(queryCount * stride), stride, flags);
+    (void)result;  // eNotReady is expected when some queries are unavailable
+
+    // The first recorded scope is the earliest timestamp of the frame; the trace places it at submit time.
+    const bool traced = frame.submitNs != 0 && Trace::get().isEnabled() && data[1] != 0u;
+    const uint64_t traceOriginTicks = data[0];
+    for (uint32_t i = 0; i < frame.scopes.size(); ++i) {
+        const RecordedScope& scope = frame.scopes[i];
+        if (!scope.closed) continue;
+        const uint64_t begin = data[4u * i];
+        const uint64_t beginAvailable = data[4u * i + 1u];
+        const uint64_t end = data[4u * i + 2u];
+        const uint64_t endAvailable = data[4u * i + 3u];
+        if (beginAvailable == 0u || endAvailable == 0u) {
+            ++lateScopes;
+            continue;
+        }
+
+        const uint64_t ticks = (end - begin) & timestampMask;
+        const double ms = static_cast<double>(ticks) * nsPerTick * 1e-6;
+        ScopeHistory& history = histories[scope.nameIndex];
+        if (history.samples.size() < AppConfig::GPU_PROFILER_WINDOW) {
+            history.samples.push_back(ms);
+        } else {
+            history.samples[history.next] = ms;
+        }
+        history.next = (history.next + 1) % AppConfig::GPU_PROFILER_WINDOW;
+        history.lastMs = ms;
+        lastHarvest.scopes.push_back({scope.nameIndex, ms});
+
+        if (traced) {
+            const uint64_t beginNs =
+                frame.submitNs + static_cast<uint64_t>(static_cast<double>((begin - traceOriginTicks) & timestampMask) * nsPerTick);
+            const uint64_t durationNs = static_cast<uint64_t>(static_cast<double>(ticks) * nsPerTick);
+            Trace::get().recordOnTrack(traceTrack, traceNames[scope.nameIndex], beginNs, beginNs + durationNs);
+        }
+    }
+    frame.scopes.clear();
+    frame.submitNs = 0;
+    updateSummaries();
+}
+
+void GpuProfiler::updateSummaries()
+{
+    summaries.clear();
+    std::vector<double> sorted;
+    for (size_t i = 0; i < names.size(); ++i) {
+        const ScopeHistory& history = histories[i];
+        if (history.samples.empty()) continue;
+
+        sorted = history.samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        ScopeSummary summary;
+        summary.name = names[i];
+        summary.lastMs = history.lastMs;
+        summary.minMs = sorted.front();
+        summary.avgMs = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+        summary.p99Ms = nearestRankPercentile(sorted, 99);
+        summary.samples = static_cast<uint32_t>(sorted.size());
+        summaries.push_back(std::move(summary));
+    }
+}
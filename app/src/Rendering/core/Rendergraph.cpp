@@ -1,72 +1,102 @@
 #include "Rendering/core/Rendergraph.h"
 #include "Configs/AppConfig.h"
+#include "Engine/Profiling/Trace.h"
+#include "Rendering/core/GpuProfiler.h"
 
 #include <algorithm>
 #include <chrono>
+#include <iostream>
 #include <stdexcept>
+#include <utility>
 
 namespace {
-struct BarrierParams {
-    vk::PipelineStageFlags srcStage{};
-    vk::PipelineStageFlags dstStage{};
-    vk::AccessFlags srcAccess{};
-    vk::AccessFlags dstAccess{};
-};
-
-BarrierParams inferBarrierParams(vk::ImageLayout oldLayout, vk::ImageLayout newLayout)
+using Stage = vk::PipelineStageFlagBits2KHR;
+using Access = vk::AccessFlagBits2KHR;
+
+constexpr vk::AccessFlags2KHR WRITE_ACCESS = Access::eColorAttachmentWrite | Access::eDepthStencilAttachmentWrite
+    | Access::eShaderStorageWrite | Access::eShaderWrite | Access::eTransferWrite | Access::eMemoryWrite;
+
+// Stages/accesses through which a pass touches an image in the given layout. Attachment layouts map to the fixed-function
+// stages; sampled/storage layouts to the shader stages the pass runs.
+ImageSyncState usageScope(vk::ImageLayout layout, bool write, vk::PipelineStageFlags2KHR shaderStages)
 {
-    // Minimal set for this project (dynamic rendering attachments + present).
-    if (oldLayout == vk::ImageLayout::eUndefined && newLayout == vk::ImageLayout::eColorAttachmentOptimal) {
-        return {vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eColorAttachmentOutput, {}, vk::AccessFlagBits::eColorAttachmentWrite};
-    }
-    if (oldLayout == vk::ImageLayout::ePresentSrcKHR && newLayout == vk::ImageLayout::eColorAttachmentOptimal) {
-        return {vk::PipelineStageFlagBits::eBottomOfPipe, vk::PipelineStageFlagBits::eColorAttachmentOutput, {}, vk::AccessFlagBits::eColorAttachmentWrite};
-    }
-    if (oldLayout == vk::ImageLayout::eColorAttachmentOptimal && newLayout == vk::ImageLayout::ePresentSrcKHR) {
-        return {vk::PipelineStageFlagBits::eColorAttachmentOutput, vk::PipelineStageFlagBits::eBottomOfPipe, vk::AccessFlagBits::eColorAttachmentWrite, {}};
-    }
-    if (oldLayout == vk::ImageLayout::eUndefined && newLayout == vk::ImageLayout::eDepthStencilAttachmentOptimal) {
-        return {vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eEarlyFragmentTests, {}, vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite};
-    }
-    if (oldLayout == vk::ImageLayout::eColorAttachmentOptimal && newLayout == vk::ImageLayout::eShaderReadOnlyOptimal) {
-        return {vk::PipelineStageFlagBits::eColorAttachmentOutput, vk::PipelineStageFlagBits::eFragmentShader,
-                vk::AccessFlagBits::eColorAttachmentWrite, vk::AccessFlagBits::eShaderRead};
-    }
-    if (oldLayout == vk::ImageLayout::eShaderReadOnlyOptimal && newLayout == vk::ImageLayout::eColorAttachmentOptimal) {
-        return {vk::PipelineStageFlagBits::eFragmentShader, vk::PipelineStageFlagBits::eColorAttachmentOutput,
-                vk::AccessFlagBits::eShaderRead, vk::AccessFlagBits::eColorAttachmentWrite};
-    }
-    if (oldLayout == vk::ImageLayout::eUndefined && newLayout == vk::ImageLayout::eShaderReadOnlyOptimal) {
-        return {vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eFragmentShader, {},
-                vk::AccessFlagBits::eShaderRead};
+    ImageSyncState scope{};
+    scope.layout = layout;
+    switch (layout) {
+    case vk::ImageLayout::eColorAttachmentOptimal:
+        scope.stages = Stage::eColorAttachmentOutput;
+        scope.access = write ? Access::eColorAttachmentRead | Access::eColorAttachmentWrite
+                             : vk::AccessFlags2KHR(Access::eColorAttachmentRead);
+        break;
+    case vk::ImageLayout::eDepthStencilAttachmentOptimal:
+        scope.stages = Stage::eEarlyFragmentTests | Stage::eLateFragmentTests;
+        scope.access = Access::eDepthStencilAttachmentRead;
+        if (write) {
+            // Depth resolves are performed in the color-attachment-output stage.
+            scope.stages |= Stage::eColorAttachmentOutput;
+            scope.access |= Access::eDepthStencilAttachmentWrite | Access::eColorAttachmentWrite;
+        }
+        break;
+    case vk::ImageLayout::eDepthStencilReadOnlyOptimal:
+    case vk::ImageLayout::eShaderReadOnlyOptimal:
+        scope.stages = shaderStages;
+        scope.access = Access::eShaderSampledRead;
+        break;
+    case vk::ImageLayout::eGeneral:
+        scope.stages = shaderStages;
+        scope.access = write ? Access::eShaderSampledRead | Access::eShaderStorageRead | Access::eShaderStorageWrite
+                             : Access::eShaderSampledRead | Access::eShaderStorageRead;
+        break;
+    case vk::ImageLayout::ePresentSrcKHR:
+        // Presentation is ordered by the submit's semaphores; later users (ImGui) synchronize against attachment output.
+        scope.stages = Stage::eColorAttachmentOutput;
+        break;
+    case vk::ImageLayout::eTransferSrcOptimal:
+        scope.stages = Stage::eAllTransfer;
+        scope.access = Access::eTransferRead;
+        break;
+    default:
+        scope.stages = Stage::eAllCommands;
+        scope.access = write ? Access::eMemoryRead | Access::eMemoryWrite : vk::AccessFlags2KHR(Access::eMemoryRead);
+        break;
     }
-
-    // Fallback: conservative synchronization (kept minimal for now).
-    return {vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eAllCommands, {}, {}};
+    return scope;
 }
 
-void transitionImageLayout(
-    vk::raii::CommandBuffer& cb,
-    vk::Image image,
-    vk::ImageAspectFlags aspectFlags,
-    vk::ImageLayout oldLayout,
-    vk::ImageLayout newLayout)
+// External outputs handed to a consumer outside the graph (present, or a headless readback copy): rendered as color
+// attachments and transitioned to this layout after every pass that writes them.
+bool isHandOff(const ImageResource& res)
 {
-    if (!image || oldLayout == newLayout) return;
+    return res.isExternal
+        && (res.finalLayout == vk::ImageLayout::ePresentSrcKHR || res.finalLayout == vk::ImageLayout::eTransferSrcOptimal);
+}
 
-    BarrierParams params = inferBarrierParams(oldLayout, newLayout);
+// Read-after-read in the same layout needs no barrier; anything involving a write or a layout change does.
+bool needsBarrier(const ImageSyncState& current, const ImageSyncState& next)
+{
+    return current.layout != next.layout || (current.access & WRITE_ACCESS) || (next.access & WRITE_ACCESS);
+}
 
-    vk::ImageMemoryBarrier barrier{};
-    barrier.setOldLayout(oldLayout)
-        .setNewLayout(newLayout)
+vk::ImageMemoryBarrier2KHR makeBarrier(const ImageSyncState& src, const ImageSyncState& dst, vk::Image image,
+                                       vk::ImageAspectFlags aspectFlags)
+{
+    vk::ImageMemoryBarrier2KHR barrier{};
+    barrier.setSrcStageMask(src.stages)
+        .setSrcAccessMask(src.access & WRITE_ACCESS)  // only writes have to be made available (WAR is execution-only)
+        .setDstStageMask(dst.stages)
+        .setDstAccessMask(dst.access)
+        .setOldLayout(src.layout)
+        .setNewLayout(dst.layout)
         .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
         .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
         .setImage(image)
-        .setSubresourceRange({aspectFlags, 0, 1, 0, 1})
-        .setSrcAccessMask(params.srcAccess)
-        .setDstAccessMask(params.dstAccess);
+        .setSubresourceRange({aspectFlags, 0, 1, 0, 1});
+    return barrier;
+}
 
-    cb.pipelineBarrier(params.srcStage, params.dstStage, vk::DependencyFlagBits::eByRegion, {}, {}, barrier);
+bool lifetimesOverlap(const ImageResource& a, const ImageResource& b)
+{
+    return !(a.lastUse < b.firstUse || b.lastUse < a.firstUse);
 }
 }  // namespace
 
@@ -108,13 +138,14 @@ void Rendergraph::AddResource(const std::string& name, vk::Format format, vk::Ex
     resource.samples = samples;
     resource.extentDivisor = std::max(1u, extentDivisor);
     resource.isExternal = false;
-    resource.currentLayout = initialLayout;
+    resource.state.layout = initialLayout;
 
     resources[name] = std::move(resource);
 }
 
 void Rendergraph::AddExternalResource(const std::string& name, vk::Format format, vk::Extent2D ext,
-                                      vk::ImageLayout initialLayout, vk::ImageLayout finalLayout)
+                                      vk::ImageLayout initialLayout, vk::ImageLayout finalLayout,
+                                      vk::ImageAspectFlags aspectFlags)
 {
     if (compiled) {
         throw std::runtime_error("Rendergraph: cannot AddExternalResource after Compile");
@@ -128,11 +159,11 @@ void Rendergraph::AddExternalResource(const std::string& name, vk::Format format
     resource.usage = vk::ImageUsageFlags{};
     resource.initialLayout = initialLayout;
     resource.finalLayout = finalLayout;
-    resource.aspectFlags = vk::ImageAspectFlagBits::eColor;
+    resource.aspectFlags = aspectFlags;
     resource.samples = vk::SampleCountFlagBits::e1;
     resource.extentDivisor = 1;
     resource.isExternal = true;
-    resource.currentLayout = initialLayout;
+    resource.state.layout = initialLayout;
 
     resources[name] = std::move(resource);
 }
@@ -200,6 +231,7 @@ void Rendergraph::Compile()
     }
 
     allocateInternalResources();
+    planSplitBarriers();
     compiled = true;
 }
 
@@ -214,117 +246,392 @@ void Rendergraph::Recompile(vk::Extent2D newExtent)
     Compile();
 }
 
+void Rendergraph::Resize(vk::Extent2D newExtent)
+{
+    if (!compiled) {
+        Recompile(newExtent);
+        return;
+    }
+    // The swapchain images are new even when the extent is not (handles may be reused).
+    externalImageStates.clear();
+    if (newExtent == extent) {
+        return;
+    }
+
+    extent = newExtent;
+    for (auto& [name, resource] : resources) {
+        resource.extent = applyExtentDivisor(newExtent, resource.extentDivisor);
+    }
+    // Free before allocating so the allocator can hand the old blocks straight back.
+    releaseInternalResources();
+    allocateInternalResources();
+}
+
 void Rendergraph::Cleanup()
+{
+    releaseInternalResources();
+    executionOrder.clear();
+    splitBarriers.clear();
+    splitEvents.clear();
+    externalImageStates.clear();
+    compiled = false;
+}
+
+void Rendergraph::releaseInternalResources()
 {
     for (auto& [name, resource] : resources) {
         if (!resource.isExternal) {
             resource.view.reset();
             resource.image.reset();
             resource.memory.reset();
+            resource.aliasSlot = -1;
+        }
+    }
+    aliasSlots.clear();
+}
+
+std::vector<Rendergraph::PassResourceUsage> Rendergraph::collectPassUsages(const RenderPass& pass) const
+{
+    std::vector<PassResourceUsage> usages;
+    auto add = [&](const std::string& name, bool write) {
+        auto rit = resources.find(name);
+        if (rit == resources.end()) return;
+        const ImageResource& res = rit->second;
+        vk::ImageLayout layout = res.finalLayout;
+        if (write) {
+            layout = pass.getRequiredOutputLayout(name).value_or(res.finalLayout);
+            // Swapchain-like outputs are rendered as attachments and handed back after the pass.
+            if (isHandOff(res)) {
+                layout = vk::ImageLayout::eColorAttachmentOptimal;
+            }
+        } else {
+            layout = pass.getRequiredInputLayout(name).value_or(res.finalLayout);
+        }
+
+        auto it = std::find_if(usages.begin(), usages.end(), [&](const PassResourceUsage& u) { return u.name == name; });
+        if (it == usages.end()) {
+            usages.push_back({name, ImageSyncState{layout, {}, {}}, write});
+        } else {
+            // Read and written by the same pass: the output layout wins.
+            if (write) it->scope.layout = layout;
+            it->writes = it->writes || write;
+        }
+    };
+    for (const auto& input : pass.getInputs()) {
+        add(input, false);
+    }
+    for (const auto& output : pass.getOutputs()) {
+        add(output, true);
+    }
+    for (PassResourceUsage& usage : usages) {
+        usage.scope = usageScope(usage.scope.layout, usage.writes, pass.getShaderStages());
+    }
+    return usages;
+}
+
+void Rendergraph::computeLifetimes()
+{
+    for (auto& [name, resource] : resources) {
+        resource.firstUse = UINT32_MAX;
+        resource.lastUse = 0;
+        resource.firstUseWrites = false;
+    }
+
+    for (uint32_t order = 0; order < executionOrder.size(); ++order) {
+        const RenderPass& pass = *passes[executionOrder[order]];
+        auto touch = [&](const std::string& name, bool write) {
+            auto it = resources.find(name);
+            if (it == resources.end()) return;
+            ImageResource& resource = it->second;
+            if (resource.firstUse == UINT32_MAX) {
+                resource.firstUse = order;
+                resource.firstUseWrites = write;
+            } else if (resource.firstUse == order && !write) {
+                resource.firstUseWrites = false;
+            }
+            resource.lastUse = order;
+        };
+        for (const auto& input : pass.getInputs()) {
+            touch(input, false);
+        }
+        for (const auto& output : pass.getOutputs()) {
+            touch(output, true);
+        }
+    }
+}
+
+void Rendergraph::planSplitBarriers()
+{
+    splitBarriers.clear();
+    splitEvents.clear();
+    if (!AppConfig::ENABLE_SPLIT_BARRIERS) return;
+
+    // Previous use of each resource in this frame: (order, wrote).
+    std::unordered_map<std::string, std::pair<uint32_t, bool>> previousUse;
+    for (uint32_t order = 0; order < executionOrder.size(); ++order) {
+        for (const PassResourceUsage& usage : collectPassUsages(*passes[executionOrder[order]])) {
+            const ImageResource& res = resources.at(usage.name);
+            auto it = previousUse.find(usage.name);
+            // Hand-off images go back to their final layout after every writer, so there is nothing to split.
+            if (it != previousUse.end() && it->second.second && order - it->second.first > 1 && !isHandOff(res)) {
+                SplitBarrier split;
+                split.resource = usage.name;
+                split.producerOrder = it->second.first;
+                split.consumerOrder = order;
+                split.consumerScope = usage.scope;
+                splitBarriers.push_back(std::move(split));
+            }
+            previousUse[usage.name] = {order, usage.writes};
+        }
+    }
+
+    // Event state is per command buffer in flight: a frame resets its events only after its own waits.
+    vk::EventCreateInfo eventInfo{};
+    eventInfo.flags = vk::EventCreateFlagBits::eDeviceOnlyKHR;
+    splitEvents.resize(AppConfig::MAX_FRAMES_IN_FLIGHT);
+    for (auto& frameEvents : splitEvents) {
+        frameEvents.reserve(splitBarriers.size());
+        for (size_t i = 0; i < splitBarriers.size(); ++i) {
+            frameEvents.emplace_back(device, eventInfo);
         }
     }
-    executionOrder.clear();
-    externalImageLayouts.clear();
-    compiled = false;
 }
 
 void Rendergraph::allocateInternalResources()
 {
+    computeLifetimes();
+
+    struct AliasCandidate {
+        ImageResource* resource;
+        vk::MemoryRequirements requirements;
+    };
+    std::vector<AliasCandidate> candidates;
+    const vk::MemoryPropertyFlags lazyProperties = vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eLazilyAllocated;
+    uint64_t unaliasedBytes = 0;
+    uint64_t residentBytes = 0;
+    uint64_t lazyBytes = 0;
+
     for (auto& [name, resource] : resources) {
         if (resource.isExternal) continue;
 
-        ImageAllocation alloc = resourceCreator.createImage(
+        resource.image = resourceCreator.createUnboundImage(
             resource.extent.width, resource.extent.height, 1, resource.samples,
-            resource.format, vk::ImageTiling::eOptimal, resource.usage,
-            vk::MemoryPropertyFlagBits::eDeviceLocal);
+            resource.format, vk::ImageTiling::eOptimal, resource.usage);
+        const vk::MemoryRequirements requirements = resource.image->getMemoryRequirements();
+        unaliasedBytes += requirements.size;
+
+        if (AppConfig::ENABLE_RENDERGRAPH_ALIASING && (resource.usage & vk::ImageUsageFlagBits::eTransientAttachment)
+            && resourceCreator.hasMemoryType(requirements.memoryTypeBits, lazyProperties)) {
+            resource.memory = resourceCreator.bindImageMemory(*resource.image, vk::ImageTiling::eOptimal, resource.usage, lazyProperties);
+            lazyBytes += requirements.size;
+        } else if (AppConfig::ENABLE_RENDERGRAPH_ALIASING && resource.firstUse != UINT32_MAX && resource.firstUseWrites) {
+            candidates.push_back({&resource, requirements});
+        } else {
+            resource.memory = resourceCreator.bindImageMemory(*resource.image, vk::ImageTiling::eOptimal, resource.usage,
+                                                              vk::MemoryPropertyFlagBits::eDeviceLocal);
+            residentBytes += requirements.size;
+        }
+    }
+
+    // Greedy interval colouring, largest first: each resource joins the first slot whose members' lifetimes it does
+    // not overlap (and whose memory types it shares); a slot is as large as its largest member.
+    std::sort(candidates.begin(), candidates.end(), [](const AliasCandidate& a, const AliasCandidate& b) {
+        if (a.requirements.size != b.requirements.size) return a.requirements.size > b.requirements.size;
+        return a.resource->name < b.resource->name;
+    });
+    struct SlotBuild {
+        std::vector<AliasCandidate> members;
+        vk::MemoryRequirements requirements;
+    };
+    std::vector<SlotBuild> slotBuilds;
+    for (const AliasCandidate& candidate : candidates) {
+        SlotBuild* target = nullptr;
+        for (SlotBuild& slot : slotBuilds) {
+            if (!(slot.requirements.memoryTypeBits & candidate.requirements.memoryTypeBits)) continue;
+            const bool overlaps = std::any_of(slot.members.begin(), slot.members.end(), [&](const AliasCandidate& member) {
+                return lifetimesOverlap(*member.resource, *candidate.resource);
+            });
+            if (!overlaps) {
+                target = &slot;
+                break;
+            }
+        }
+        if (!target) {
+            slotBuilds.push_back({{}, candidate.requirements});
+            target = &slotBuilds.back();
+        }
+        target->members.push_back(candidate);
+        target->requirements.size = std::max(target->requirements.size, candidate.requirements.size);
+        target->requirements.alignment = std::max(target->requirements.alignment, candidate.requirements.alignment);
+        target->requirements.memoryTypeBits &= candidate.requirements.memoryTypeBits;
+    }
 
-        resource.image = std::move(alloc.image);
-        resource.memory = std::move(alloc.memory);
+    uint32_t aliasedResourceCount = 0;
+    for (SlotBuild& slotBuild : slotBuilds) {
+        residentBytes += slotBuild.requirements.size;
+        if (slotBuild.members.size() == 1) {
+            ImageResource& resource = *slotBuild.members.front().resource;
+            resource.memory = resourceCreator.bindImageMemory(*resource.image, vk::ImageTiling::eOptimal, resource.usage,
+                                                              vk::MemoryPropertyFlagBits::eDeviceLocal);
+            continue;
+        }
+
+        std::sort(slotBuild.members.begin(), slotBuild.members.end(), [](const AliasCandidate& a, const AliasCandidate& b) {
+            return a.resource->firstUse < b.resource->firstUse;
+        });
+        AliasSlot slot;
+        slot.memory = resourceCreator.allocateSharedImageMemory(slotBuild.requirements, vk::MemoryPropertyFlagBits::eDeviceLocal);
+        for (const AliasCandidate& member : slotBuild.members) {
+            member.resource->image->bindMemory(slot.memory->getMemory(), slot.memory->getOffset());
+            member.resource->aliasSlot = static_cast<int32_t>(aliasSlots.size());
+            slot.members.push_back(member.resource->name);
+            ++aliasedResourceCount;
+        }
+        aliasSlots.push_back(std::move(slot));
+    }
+
+    for (auto& [name, resource] : resources) {
+        if (resource.isExternal) continue;
         resource.view = resourceCreator.createImageView(
             static_cast<vk::Image>(*resource.image), resource.format,
             resource.aspectFlags, 1);
 
         // Newly created images start in undefined.
-        resource.currentLayout = vk::ImageLayout::eUndefined;
+        resource.state = ImageSyncState{};
     }
+
+    constexpr double toMb = 1.0 / (1024.0 * 1024.0);
+    std::cout << "[Perf] Rendergraph memory extent=" << extent.width << "x" << extent.height
+              << " unaliased_mb=" << unaliasedBytes * toMb << " resident_mb=" << residentBytes * toMb
+              << " lazy_mb=" << lazyBytes * toMb << " alias_slots=" << aliasSlots.size()
+              << " aliased_resources=" << aliasedResourceCount << "\n";
+}
+
+const ImageSyncState& Rendergraph::previousAliasOccupant(const ImageResource& resource) const
+{
+    // The memory was last used by the previous slot member (this frame, or the last member of the previous frame).
+    const AliasSlot& slot = aliasSlots[static_cast<size_t>(resource.aliasSlot)];
+    const auto self = std::find(slot.members.begin(), slot.members.end(), resource.name);
+    const size_t index = static_cast<size_t>(self - slot.members.begin());
+    const std::string& previousName = slot.members[(index + slot.members.size() - 1) % slot.members.size()];
+    return resources.at(previousName).state;
+}
+
+ImageSyncState* Rendergraph::resolveSyncState(ImageResource& resource,
+                                              const std::unordered_map<std::string, ExternalResourceView>& externalViews,
+                                              vk::Image& image)
+{
+    if (!resource.isExternal) {
+        if (!resource.image) return nullptr;
+        image = static_cast<vk::Image>(*resource.image);
+        return &resource.state;
+    }
+
+    auto extIt = externalViews.find(resource.name);
+    if (extIt == externalViews.end() || !extIt->second.image) return nullptr;
+    image = extIt->second.image;
+    const uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(static_cast<VkImage>(image)));
+    auto [it, inserted] = externalImageStates[resource.name].try_emplace(key);
+    if (inserted) {
+        // First sight of this image: whatever used it before (e.g. the acquire semaphore wait) is unknown to the graph.
+        it->second = ImageSyncState{resource.initialLayout, Stage::eAllCommands, Access::eMemoryWrite};
+    }
+    return &it->second;
 }
 
 void Rendergraph::Execute(vk::raii::CommandBuffer& commandBuffer, uint32_t imageIndex,
                           const glm::mat4& modelMatrix,
                           const std::unordered_map<std::string, ExternalResourceView>& externalViews,
                           const Camera* camera,
-                          RenderStats* stats)
+                          RenderStats* stats,
+                          GpuProfiler* profiler)
 {
     if (!compiled) {
         throw std::runtime_error("Rendergraph: must Compile before Execute");
     }
-
-    auto getExternalLayoutKey = [](vk::Image img) -> uint64_t {
-        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(static_cast<VkImage>(img)));
-    };
-
-    auto ensureLayout = [&](const std::string& resName, vk::Image image, vk::ImageAspectFlags aspect, vk::ImageLayout desiredLayout) {
-        if (!image) return;
-
-        auto& perImage = externalImageLayouts[resName];
-        const uint64_t key = getExternalLayoutKey(image);
-        vk::ImageLayout& tracked = perImage[key];  // default-inits to eUndefined
-        transitionImageLayout(commandBuffer, image, aspect, tracked, desiredLayout);
-        tracked = desiredLayout;
-    };
-
-    auto ensureResourceLayout = [&](const std::string& resName, vk::ImageLayout desiredLayout) {
-        auto it = resources.find(resName);
-        if (it == resources.end()) return;
-
-        ImageResource& res = it->second;
-        if (res.isExternal) {
-            auto extIt = externalViews.find(resName);
-            if (extIt == externalViews.end()) return;
-            ensureLayout(resName, extIt->second.image, res.aspectFlags, desiredLayout);
-            return;
+    const size_t frameSlot = static_cast<size_t>(executeCount++ % AppConfig::MAX_FRAMES_IN_FLIGHT);
+
+    std::vector<vk::ImageMemoryBarrier2KHR> batch;
+    auto flushBatch = [&]() {
+        if (batch.empty()) return;
+        vk::DependencyInfoKHR dependency{};
+        dependency.setImageMemoryBarriers(batch);
+        commandBuffer.pipelineBarrier2KHR(dependency);
+        if (stats) {
+            ++stats->graphBarrierBatches;
+            stats->graphImageBarriers += batch.size();
         }
-
-        if (!res.image) return;
-        vk::Image img = static_cast<vk::Image>(*res.image);
-        transitionImageLayout(commandBuffer, img, res.aspectFlags, res.currentLayout, desiredLayout);
-        res.currentLayout = desiredLayout;
+        batch.clear();
     };
 
-    PassExecuteContext ctx{commandBuffer, imageIndex, modelMatrix, camera, stats};
-    for (auto passIdx : executionOrder) {
-        // Pre-pass: transition inputs/outputs to the layouts required for the pass.
-        // Current minimal policy:
-        // - Internal resources use their declared finalLayout as "working layout".
-        // - External swapchain-like outputs (finalLayout == Present) are transitioned to color-attachment for rendering,
-        //   then transitioned back to present after the pass.
+    PassExecuteContext ctx{commandBuffer, imageIndex, modelMatrix, camera, stats, profiler};
+    GpuProfileScope graphScope(profiler, commandBuffer, "Rendergraph");
+    for (uint32_t order = 0; order < executionOrder.size(); ++order) {
+        const size_t passIdx = executionOrder[order];
+        // Pre-pass synchronization, derived from the declared usages (see collectPassUsages):
+        // - Split barriers whose producer ran earlier this frame are waited on together (one vkCmdWaitEvents2).
+        // - Every other transition of the pass's images goes into one vkCmdPipelineBarrier2; read-after-read in the
+        //   same layout is skipped and only widens the tracked scope.
+        // - Aliased internal resources discard their contents at their first write and wait for the previous
+        //   occupant of the memory.
+        // - External swapchain-like outputs (finalLayout == Present, or TransferSrc when headless) are rendered as
+        //   color attachments and transitioned back to their final layout after the pass.
         const RenderPass& pass = *passes[passIdx];
-        for (const auto& input : pass.getInputs()) {
-            auto rit = resources.find(input);
-            if (rit != resources.end()) {
-                const vk::ImageLayout inputLayout = pass.getRequiredInputLayout(input).value_or(rit->second.finalLayout);
-                ensureResourceLayout(input, inputLayout);
+
+        std::vector<vk::Event> waitEvents;
+        std::vector<vk::DependencyInfoKHR> waitDependencies;
+        std::vector<std::string> waitedResources;
+        for (size_t i = 0; i < splitBarriers.size(); ++i) {
+            SplitBarrier& split = splitBarriers[i];
+            if (split.consumerOrder != order || !split.signalled) continue;
+            waitEvents.push_back(*splitEvents[frameSlot][i]);
+            waitDependencies.push_back(vk::DependencyInfoKHR{}.setImageMemoryBarriers(split.pending));
+            waitedResources.push_back(split.resource);
+        }
+        if (!waitEvents.empty()) {
+            commandBuffer.waitEvents2KHR(waitEvents, waitDependencies);
+            if (stats) {
+                stats->graphSplitBarriers += waitEvents.size();
+                stats->graphImageBarriers += waitEvents.size();
             }
         }
-        for (const auto& output : pass.getOutputs()) {
-            auto rit = resources.find(output);
-            if (rit == resources.end()) continue;
-            const ImageResource& res = rit->second;
-            const vk::ImageLayout outputLayout = pass.getRequiredOutputLayout(output).value_or(res.finalLayout);
-            if (res.isExternal && res.finalLayout == vk::ImageLayout::ePresentSrcKHR) {
-                ensureResourceLayout(output, vk::ImageLayout::eColorAttachmentOptimal);
+
+        for (const PassResourceUsage& usage : collectPassUsages(pass)) {
+            if (std::find(waitedResources.begin(), waitedResources.end(), usage.name) != waitedResources.end()) {
+                continue;  // already in the consumer's scope
+            }
+            ImageResource& res = resources.at(usage.name);
+            vk::Image image;
+            ImageSyncState* state = resolveSyncState(res, externalViews, image);
+            if (!state) continue;
+
+            if (res.aliasSlot >= 0 && res.firstUse == order) {
+                ImageSyncState src = previousAliasOccupant(res);
+                src.layout = vk::ImageLayout::eUndefined;
+                batch.push_back(makeBarrier(src, usage.scope, image, res.aspectFlags));
+                *state = usage.scope;
+            } else if (needsBarrier(*state, usage.scope)) {
+                batch.push_back(makeBarrier(*state, usage.scope, image, res.aspectFlags));
+                *state = usage.scope;
             } else {
-                ensureResourceLayout(output, outputLayout);
+                state->stages |= usage.scope.stages;
+                state->access |= usage.scope.access;
             }
         }
+        flushBatch();
 
         const auto tPass0 = std::chrono::high_resolution_clock::now();
-        passes[passIdx]->execute(ctx);
+        {
+            TRACE_SCOPE(pass.getName().c_str());
+            GpuProfileScope passScope(profiler, commandBuffer, pass.getName());
+            passes[passIdx]->execute(ctx);
+        }
         const auto tPass1 = std::chrono::high_resolution_clock::now();
         if (AppConfig::ENABLE_PERF_DEBUG && stats) {
             const double passMs = std::chrono::duration<double, std::milli>(tPass1 - tPass0).count();
             const std::string& name = pass.getName();
             if (name == "DepthPrepass") stats->depthPrepassMs = passMs;
+            else if (name == "GpuCullingPass") stats->gpuCullMs = passMs;
             else if (name == "RtaoComputePass") stats->rtaoMs = passMs;
             else if (name == "SkyboxPass") stats->skyboxMs = passMs;
             else if (name == "ScenePass") stats->forwardMs = passMs;
@@ -335,13 +642,36 @@ void Rendergraph::Execute(vk::raii::CommandBuffer& commandBuffer, uint32_t image
             else if (name == "OcclusionPass") stats->occlusionMs = passMs;
         }
 
-        // Post-pass: bring external presentable outputs back to their declared finalLayout.
+        // Post-pass: bring external hand-off outputs back to their declared finalLayout.
         for (const auto& output : pass.getOutputs()) {
             auto rit = resources.find(output);
             if (rit == resources.end()) continue;
-            const ImageResource& res = rit->second;
-            if (res.isExternal && res.finalLayout == vk::ImageLayout::ePresentSrcKHR) {
-                ensureResourceLayout(output, vk::ImageLayout::ePresentSrcKHR);
+            ImageResource& res = rit->second;
+            if (!isHandOff(res)) continue;
+            vk::Image image;
+            ImageSyncState* state = resolveSyncState(res, externalViews, image);
+            if (!state) continue;
+            const ImageSyncState handOff = usageScope(res.finalLayout, false, {});
+            batch.push_back(makeBarrier(*state, handOff, image, res.aspectFlags));
+            *state = handOff;
+        }
+        flushBatch();
+
+        // Signal split barriers produced by this pass, and reset the events this pass consumed.
+        for (size_t i = 0; i < splitBarriers.size(); ++i) {
+            SplitBarrier& split = splitBarriers[i];
+            if (split.producerOrder == order) {
+                ImageResource& res = resources.at(split.resource);
+                vk::Image image;
+                ImageSyncState* state = resolveSyncState(res, externalViews, image);
+                if (!state) continue;
+                split.pending = makeBarrier(*state, split.consumerScope, image, res.aspectFlags);
+                commandBuffer.setEvent2KHR(*splitEvents[frameSlot][i], vk::DependencyInfoKHR{}.setImageMemoryBarriers(split.pending));
+                *state = split.consumerScope;
+                split.signalled = true;
+            } else if (split.consumerOrder == order && split.signalled) {
+                commandBuffer.resetEvent2KHR(*splitEvents[frameSlot][i], split.consumerScope.stages);
+                split.signalled = false;
             }
         }
     }
@@ -0,0 +1,237 @@
+#include "Rendering/culling/HierarchicalCuller.h"
+
+#include "Engine/Jobs/JobSystem.h"
+#include "Resource/model/Model.h"
+
+#include <algorithm>
+
+void HierarchicalCuller::cull(const Model& model, const Frustum& frustum)
+{
+    const auto& worldMatrices = model.getWorldMatrices();
+    const uint32_t count = static_cast<uint32_t>(model.getLinearNodes().size());
+
+    stats = Stats{};
+    if (worldMatrices.size() != count) {
+        setAllVisible(model);
+        return;
+    }
+
+    nodeVisibility.assign(count, 0u);
+    leafResults.assign(count, LEAF_UNTESTED);
+    if (contexts.empty()) {
+        contexts.resize(1);
+    }
+    contexts[0].visible.clear();
+    contexts[0].stats = Stats{};
+
+    const bool parallel = count >= PARALLEL_CULL_MIN_NODES;
+    if (parallel) {
+        splitRanges(model, frustum, contexts[0]);
+    } else {
+        jobRanges.assign(1, CullRange{0, count, Frustum::ALL_PLANES_MASK});
+    }
+
+    const uint32_t rangeCount = static_cast<uint32_t>(jobRanges.size());
+    if (contexts.size() < rangeCount + 1) {
+        contexts.resize(rangeCount + 1);
+    }
+    auto runRanges = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t k = begin; k < end; ++k) {
+            JobContext& ctx = contexts[k + 1];
+            ctx.visible.clear();
+            ctx.stats = Stats{};
+            cullRange(model, frustum, jobRanges[k], ctx);
+        }
+    };
+    if (parallel) {
+        JobSystem::get().parallelFor(rangeCount, 1, runRanges);
+    } else {
+        runRanges(0, rangeCount);
+    }
+
+    // Merge the per-job visible spans (ranges are disjoint, so order does not matter).
+    for (uint32_t k = 0; k <= rangeCount; ++k) {
+        const JobContext& ctx = contexts[k];
+        for (const VisibleSpan& span : ctx.visible) {
+            std::fill(nodeVisibility.begin() + span.begin, nodeVisibility.begin() + span.end, uint8_t{1});
+        }
+        stats.testedNodes += ctx.stats.testedNodes;
+        stats.culledNodes += ctx.stats.culledNodes;
+        stats.acceptedSubtrees += ctx.stats.acceptedSubtrees;
+    }
+}
+
+HierarchicalCuller::NodeResult HierarchicalCuller::testNode(const Node& node, uint32_t index,
+                                                            const std::vector<glm::mat4>& worldMatrices,
+                                                            const Frustum& frustum, uint32_t& planeMask,
+                                                            Stats& outStats) const
+{
+    // No bounds below this node: nothing to test against, keep it (conservative).
+    if (!node.hasSubtreeBounds) {
+        planeMask = 0u;
+    }
+    if (planeMask != 0u) {
+        BoundingBox worldBounds = node.subtreeBounds;
+        worldBounds.Transform(worldMatrices[index]);
+        ++outStats.testedNodes;
+        if (!frustum.IntersectsMasked(worldBounds, planeMask)) {
+            return NodeResult::Culled;
+        }
+    }
+    return planeMask == 0u ? NodeResult::Accepted : NodeResult::Partial;
+}
+
+void HierarchicalCuller::splitRanges(const Model& model, const Frustum& frustum, JobContext& ctx)
+{
+    const auto& linearNodes = model.getLinearNodes();
+    const auto& worldMatrices = model.getWorldMatrices();
+    const uint32_t count = static_cast<uint32_t>(linearNodes.size());
+
+    jobRanges.clear();
+    pendingRanges.assign(1, CullRange{0, count, Frustum::ALL_PLANES_MASK});
+    while (!pendingRanges.empty()) {
+        const CullRange r = pendingRanges.back();
+        pendingRanges.pop_back();
+        if (r.end - r.begin <= PARALLEL_CULL_GRAIN) {
+            jobRanges.push_back(r);
+            continue;
+        }
+
+        // Group small sibling subtrees into job ranges; open up large ones by classifying their root here.
+        CullRange group{r.begin, r.begin, r.planeMask};
+        auto flushGroup = [&](uint32_t next) {
+            if (group.end > group.begin) {
+                jobRanges.push_back(group);
+            }
+            group.begin = group.end = next;
+        };
+        uint32_t i = r.begin;
+        while (i < r.end) {
+            const Node* node = linearNodes[i];
+            const uint32_t end = std::max(std::min(node->subtreeEnd, r.end), i + 1);
+            if (end - i <= PARALLEL_CULL_GRAIN) {
+                if (group.end - group.begin + (end - i) > PARALLEL_CULL_GRAIN) {
+                    flushGroup(i);
+                }
+                group.end = end;
+                i = end;
+                continue;
+            }
+
+            flushGroup(end);
+            uint32_t mask = r.planeMask;
+            switch (testNode(*node, i, worldMatrices, frustum, mask, ctx.stats)) {
+            case NodeResult::Culled:
+                ctx.stats.culledNodes += end - i;
+                break;
+            case NodeResult::Accepted:
+                ctx.markVisible(i, end);
+                ++ctx.stats.acceptedSubtrees;
+                break;
+            case NodeResult::Partial:
+                ctx.markVisible(i, i + 1);
+                if (node->children.size() >= BATCH_MIN_CHILDREN) {
+                    batchTestLeafChildren(*node, worldMatrices, frustum, mask, ctx);
+                }
+                pendingRanges.push_back(CullRange{i + 1, end, mask});
+                break;
+            }
+            i = end;
+        }
+        flushGroup(r.end);
+    }
+}
+
+void HierarchicalCuller::cullRange(const Model& model, const Frustum& frustum, const CullRange& range,
+                                   JobContext& ctx)
+{
+    const auto& linearNodes = model.getLinearNodes();
+    const auto& worldMatrices = model.getWorldMatrices();
+
+    ctx.stack.clear();
+    uint32_t i = range.begin;
+    while (i < range.end) {
+        while (!ctx.stack.empty() && i >= ctx.stack.back().subtreeEnd) {
+            ctx.stack.pop_back();
+        }
+        uint32_t mask = ctx.stack.empty() ? range.planeMask : ctx.stack.back().planeMask;
+
+        const Node* node = linearNodes[i];
+        const uint32_t end = std::max(std::min(node->subtreeEnd, range.end), i + 1);
+
+        // Leaf already classified by its parent's batch test.
+        if (leafResults[i] != LEAF_UNTESTED) {
+            if (leafResults[i] == LEAF_VISIBLE) {
+                ctx.markVisible(i, i + 1);
+            } else {
+                ++ctx.stats.culledNodes;
+            }
+            ++i;
+            continue;
+        }
+
+        switch (testNode(*node, i, worldMatrices, frustum, mask, ctx.stats)) {
+        case NodeResult::Culled:
+            ctx.stats.culledNodes += end - i;
+            i = end;
+            break;
+        case NodeResult::Accepted:
+            // Fully inside: accept the whole subtree without further plane tests.
+            ctx.markVisible(i, end);
+            ++ctx.stats.acceptedSubtrees;
+            i = end;
+            break;
+        case NodeResult::Partial:
+            ctx.markVisible(i, i + 1);
+            if (end > i + 1) {
+                ctx.stack.push_back(StackEntry{end, mask});
+                if (node->children.size() >= BATCH_MIN_CHILDREN) {
+                    batchTestLeafChildren(*node, worldMatrices, frustum, mask, ctx);
+                }
+            }
+            ++i;
+            break;
+        }
+    }
+}
+
+void HierarchicalCuller::batchTestLeafChildren(const Node& node, const std::vector<glm::mat4>& worldMatrices,
+                                               const Frustum& frustum, uint32_t planeMask, JobContext& ctx)
+{
+    ctx.batchNodes.clear();
+    ctx.batchBounds.Clear();
+    for (const Node* child : node.children) {
+        if (!child || !child->hasSubtreeBounds) continue;
+        const uint32_t index = child->linearIndex;
+        if (index >= worldMatrices.size() || child->subtreeEnd != index + 1) continue;  // leaves only
+
+        BoundingBox worldBounds = child->subtreeBounds;
+        worldBounds.Transform(worldMatrices[index]);
+        ctx.batchNodes.push_back(index);
+        ctx.batchBounds.PushBack(worldBounds);
+    }
+    if (ctx.batchNodes.empty()) return;
+
+    ctx.batchMask.resize(FrustumCulling::MaskWordCount(ctx.batchBounds.Size()));
+    FrustumCulling::CullAabbBatch(frustum, ctx.batchBounds, ctx.batchMask.data(), planeMask);
+    ctx.stats.testedNodes += ctx.batchBounds.Size();
+    for (uint32_t k = 0; k < ctx.batchBounds.Size(); ++k) {
+        const bool visible = ((ctx.batchMask[k >> 5] >> (k & 31u)) & 1u) != 0u;
+        leafResults[ctx.batchNodes[k]] = visible ? LEAF_VISIBLE : LEAF_CULLED;
+    }
+}
+
+void HierarchicalCuller::JobContext::markVisible(uint32_t begin, uint32_t end)
+{
+    if (!visible.empty() && visible.back().end == begin) {
+        visible.back().end = end;
+    } else {
+        visible.push_back(VisibleSpan{begin, end});
+    }
+}
+
+void HierarchicalCuller::setAllVisible(const Model& model)
+{
+    nodeVisibility.assign(model.getLinearNodes().size(), 1u);
+    stats = Stats{};
+}
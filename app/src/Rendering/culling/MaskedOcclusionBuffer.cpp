@@ -0,0 +1,306 @@
+#include "Rendering/culling/MaskedOcclusionBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MASKED_OCCLUSION_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#define MASKED_OCCLUSION_TARGET_SSE41
+#define MASKED_OCCLUSION_TARGET_AVX2
+#else
+#define MASKED_OCCLUSION_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define MASKED_OCCLUSION_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+
+constexpr uint32_t FULL_COVERAGE = 0xFFFFFFFFu;
+// Clip-space w below this counts as crossing the near plane.
+constexpr float MIN_CLIP_W = 1e-5f;
+// Pixel coordinates beyond this are dropped (keeps edge functions well inside float precision).
+constexpr float GUARD_BAND = 16384.0f;
+// testAabb: occludee depth is pulled this far toward the camera (NDC z, ~16 ulp near 1.0), so a box whose nearest
+// point lies on an occluder (its own planar mesh, a coplanar neighbour) never fails on projection round-off.
+constexpr float OCCLUDEE_DEPTH_BIAS = 1e-6f;
+
+// Edge e: E(p) = a[e] * (p.x - ax[e]) + b[e] * (p.y - ay[e]), anchored at the edge's lexicographically smaller
+// vertex; `base` holds E at the tile's first pixel center. Every SIMD level evaluates (base + b * row) + a * column
+// in the same order, so masks are bit-identical.
+struct TileEdges {
+    float a[3];
+    float b[3];
+    float base[3];
+};
+
+uint32_t coverageScalar(const TileEdges& edges)
+{
+    uint32_t mask = 0;
+    for (uint32_t row = 0; row < MaskedOcclusionBuffer::TILE_HEIGHT; ++row) {
+        float rowBase[3];
+        for (int e = 0; e < 3; ++e) {
+            rowBase[e] = edges.base[e] + edges.b[e] * static_cast<float>(row);
+        }
+        for (uint32_t col = 0; col < MaskedOcclusionBuffer::TILE_WIDTH; ++col) {
+            bool inside = true;
+            for (int e = 0; e < 3; ++e) {
+                inside = inside && (rowBase[e] + edges.a[e] * static_cast<float>(col) >= 0.0f);
+            }
+            if (inside) {
+                mask |= 1u << (row * MaskedOcclusionBuffer::TILE_WIDTH + col);
+            }
+        }
+    }
+    return mask;
+}
+
+#if defined(MASKED_OCCLUSION_X86)
+MASKED_OCCLUSION_TARGET_SSE41
+uint32_t coverageSse41(const TileEdges& edges)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 colLo = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 colHi = _mm_setr_ps(4.0f, 5.0f, 6.0f, 7.0f);
+    uint32_t mask = 0;
+    for (uint32_t row = 0; row < MaskedOcclusionBuffer::TILE_HEIGHT; ++row) {
+        __m128 insideLo = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        __m128 insideHi = insideLo;
+        for (int e = 0; e < 3; ++e) {
+            const __m128 rowBase = _mm_set1_ps(edges.base[e] + edges.b[e] * static_cast<float>(row));
+            const __m128 a = _mm_set1_ps(edges.a[e]);
+            insideLo = _mm_and_ps(insideLo, _mm_cmpge_ps(_mm_add_ps(rowBase, _mm_mul_ps(a, colLo)), zero));
+            insideHi = _mm_and_ps(insideHi, _mm_cmpge_ps(_mm_add_ps(rowBase, _mm_mul_ps(a, colHi)), zero));
+        }
+        const uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(insideLo))
+                            | (static_cast<uint32_t>(_mm_movemask_ps(insideHi)) << 4);
+        mask |= bits << (row * MaskedOcclusionBuffer::TILE_WIDTH);
+    }
+    return mask;
+}
+
+MASKED_OCCLUSION_TARGET_AVX2
+uint32_t coverageAvx2(const TileEdges& edges)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 cols = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    uint32_t mask = 0;
+    for (uint32_t row = 0; row < MaskedOcclusionBuffer::TILE_HEIGHT; ++row) {
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int e = 0; e < 3; ++e) {
+            const __m256 rowBase = _mm256_set1_ps(edges.base[e] + edges.b[e] * static_cast<float>(row));
+            const __m256 value = _mm256_add_ps(rowBase, _mm256_mul_ps(_mm256_set1_ps(edges.a[e]), cols));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(value, zero, _CMP_GE_OQ));
+        }
+        mask |= static_cast<uint32_t>(_mm256_movemask_ps(inside)) << (row * MaskedOcclusionBuffer::TILE_WIDTH);
+    }
+    _mm256_zeroupper();
+    return mask;
+}
+#endif
+
+using CoverageFn = uint32_t (*)(const TileEdges&);
+
+CoverageFn selectCoverage(FrustumCulling::SimdLevel level)
+{
+    const FrustumCulling::SimdLevel best = FrustumCulling::DetectSimdLevel();
+    if (static_cast<int>(level) > static_cast<int>(best)) {
+        level = best;
+    }
+#if defined(MASKED_OCCLUSION_X86)
+    if (level == FrustumCulling::SimdLevel::Avx2) return coverageAvx2;
+    if (level == FrustumCulling::SimdLevel::Sse41) return coverageSse41;
+#endif
+    return coverageScalar;
+}
+
+}  // namespace
+
+void MaskedOcclusionBuffer::resize(uint32_t inWidth, uint32_t inHeight)
+{
+    tilesX = std::max(1u, (inWidth + TILE_WIDTH - 1u) / TILE_WIDTH);
+    tilesY = std::max(1u, (inHeight + TILE_HEIGHT - 1u) / TILE_HEIGHT);
+    width = tilesX * TILE_WIDTH;
+    height = tilesY * TILE_HEIGHT;
+    const size_t tileCount = static_cast<size_t>(tilesX) * tilesY;
+    zMax0.resize(tileCount);
+    zMax1.resize(tileCount);
+    masks.resize(tileCount);
+    clear();
+}
+
+void MaskedOcclusionBuffer::clear()
+{
+    std::fill(zMax0.begin(), zMax0.end(), 1.0f);
+    std::fill(zMax1.begin(), zMax1.end(), 0.0f);
+    std::fill(masks.begin(), masks.end(), 0u);
+}
+
+bool MaskedOcclusionBuffer::projectTriangle(const glm::vec4& c0, const glm::vec4& c1, const glm::vec4& c2,
+                                            ScreenTriangle& out) const
+{
+    out.tileMinX = 0;
+    out.tileMinY = 0;
+    out.tileMaxX = -1;
+    out.tileMaxY = -1;
+
+    const glm::vec4* clip[3] = {&c0, &c1, &c2};
+    for (int v = 0; v < 3; ++v) {
+        const glm::vec4& c = *clip[v];
+        if (c.w <= MIN_CLIP_W) return false;
+        const float invW = 1.0f / c.w;
+        out.x[v] = (c.x * invW * 0.5f + 0.5f) * static_cast<float>(width);
+        out.y[v] = (c.y * invW * 0.5f + 0.5f) * static_cast<float>(height);
+        out.z[v] = c.z * invW;
+        if (out.z[v] < 0.0f) return false;
+        if (std::fabs(out.x[v]) > GUARD_BAND || std::fabs(out.y[v]) > GUARD_BAND) return false;
+    }
+    if (out.z[0] > 1.0f && out.z[1] > 1.0f && out.z[2] > 1.0f) return false;
+
+    const float area2 = (out.x[1] - out.x[0]) * (out.y[2] - out.y[0]) - (out.x[2] - out.x[0]) * (out.y[1] - out.y[0]);
+    if (area2 == 0.0f) return false;
+
+    const float minX = std::min({out.x[0], out.x[1], out.x[2]});
+    const float maxX = std::max({out.x[0], out.x[1], out.x[2]});
+    const float minY = std::min({out.y[0], out.y[1], out.y[2]});
+    const float maxY = std::max({out.y[0], out.y[1], out.y[2]});
+    if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(width) || minY >= static_cast<float>(height)) {
+        return false;
+    }
+
+    out.tileMinX = static_cast<int32_t>(std::max(minX, 0.0f)) / static_cast<int32_t>(TILE_WIDTH);
+    out.tileMinY = static_cast<int32_t>(std::max(minY, 0.0f)) / static_cast<int32_t>(TILE_HEIGHT);
+    out.tileMaxX = static_cast<int32_t>(std::min(maxX, static_cast<float>(width - 1u))) / static_cast<int32_t>(TILE_WIDTH);
+    out.tileMaxY = static_cast<int32_t>(std::min(maxY, static_cast<float>(height - 1u))) / static_cast<int32_t>(TILE_HEIGHT);
+    return true;
+}
+
+void MaskedOcclusionBuffer::updateTile(uint32_t tile, uint32_t coverage, float triangleDepth)
+{
+    float& z0 = zMax0[tile];
+    float& z1 = zMax1[tile];
+    uint32_t& mask = masks[tile];
+
+    // Working layer much farther than the new triangle (relative to the gap to layer 0): drop it rather than
+    // let it drag the merged depth back. Always safe, since zMax0 alone stays conservative.
+    if (z1 - triangleDepth > z0 - z1) {
+        z1 = 0.0f;
+        mask = 0u;
+    }
+    z1 = std::max(z1, triangleDepth);
+    mask |= coverage;
+    if (mask == FULL_COVERAGE) {
+        z0 = std::min(z0, z1);
+        z1 = 0.0f;
+        mask = 0u;
+    }
+}
+
+void MaskedOcclusionBuffer::rasterize(const ScreenTriangle* triangles, size_t count, uint32_t tileRowBegin,
+                                      uint32_t tileRowEnd, FrustumCulling::SimdLevel level)
+{
+    const CoverageFn coverage = selectCoverage(level);
+    tileRowEnd = std::min(tileRowEnd, tilesY);
+    if (tileRowBegin >= tileRowEnd) return;
+
+    for (size_t i = 0; i < count; ++i) {
+        const ScreenTriangle& tri = triangles[i];
+        if (tri.tileMaxX < tri.tileMinX) continue;
+        const int32_t rowBegin = std::max(tri.tileMinY, static_cast<int32_t>(tileRowBegin));
+        const int32_t rowEnd = std::min(tri.tileMaxY + 1, static_cast<int32_t>(tileRowEnd));
+        if (rowBegin >= rowEnd) continue;
+
+        TileEdges edges{};
+        float anchorX[3];
+        float anchorY[3];
+        const float area2 = (tri.x[1] - tri.x[0]) * (tri.y[2] - tri.y[0]) - (tri.x[2] - tri.x[0]) * (tri.y[1] - tri.y[0]);
+        const float orient = (area2 > 0.0f) ? 1.0f : -1.0f;
+        for (int e = 0; e < 3; ++e) {
+            // Same anchor for both triangles sharing an edge: their edge functions are then exact negations of each
+            // other, so no pixel center on a shared edge is left uncovered by both (no cracks in occluder meshes).
+            int p = e;
+            int q = (e + 1) % 3;
+            float sign = orient;
+            if (tri.x[q] < tri.x[p] || (tri.x[q] == tri.x[p] && tri.y[q] < tri.y[p])) {
+                std::swap(p, q);
+                sign = -orient;
+            }
+            edges.a[e] = -(tri.y[q] - tri.y[p]) * sign;
+            edges.b[e] = (tri.x[q] - tri.x[p]) * sign;
+            anchorX[e] = tri.x[p];
+            anchorY[e] = tri.y[p];
+        }
+
+        // Depth plane z(x, y) = z0 + dzdx * (x - x0) + dzdy * (y - y0), clamped to the triangle's far vertex.
+        const float dzdx = ((tri.z[1] - tri.z[0]) * (tri.y[2] - tri.y[0]) - (tri.z[2] - tri.z[0]) * (tri.y[1] - tri.y[0])) / area2;
+        const float dzdy = ((tri.z[2] - tri.z[0]) * (tri.x[1] - tri.x[0]) - (tri.z[1] - tri.z[0]) * (tri.x[2] - tri.x[0])) / area2;
+        const float zFar = std::max({tri.z[0], tri.z[1], tri.z[2]});
+        const float cornerX = (dzdx > 0.0f) ? static_cast<float>(TILE_WIDTH) : 0.0f;
+        const float cornerY = (dzdy > 0.0f) ? static_cast<float>(TILE_HEIGHT) : 0.0f;
+
+        for (int32_t ty = rowBegin; ty < rowEnd; ++ty) {
+            const float tileY = static_cast<float>(ty * static_cast<int32_t>(TILE_HEIGHT));
+            for (int32_t tx = tri.tileMinX; tx <= tri.tileMaxX; ++tx) {
+                const uint32_t tile = static_cast<uint32_t>(ty) * tilesX + static_cast<uint32_t>(tx);
+                const float tileX = static_cast<float>(tx * static_cast<int32_t>(TILE_WIDTH));
+
+                const float zPlane = tri.z[0] + dzdx * (tileX + cornerX - tri.x[0]) + dzdy * (tileY + cornerY - tri.y[0]);
+                const float zTile = std::min(zPlane, zFar);
+                if (zTile >= zMax0[tile]) continue;  // behind what already fully covers the tile
+
+                for (int e = 0; e < 3; ++e) {
+                    edges.base[e] = edges.a[e] * (tileX + 0.5f - anchorX[e]) + edges.b[e] * (tileY + 0.5f - anchorY[e]);
+                }
+                const uint32_t mask = coverage(edges);
+                if (mask != 0u) {
+                    updateTile(tile, mask, zTile);
+                }
+            }
+        }
+    }
+}
+
+bool MaskedOcclusionBuffer::testAabb(const glm::mat4& worldToClip, const BoundingBox& worldBounds) const
+{
+    if (zMax0.empty()) return true;
+
+    float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+    float nearestZ = 1e30f;
+    for (int i = 0; i < 8; ++i) {
+        const glm::vec3 corner((i & 1) ? worldBounds.max.x : worldBounds.min.x,
+                               (i & 2) ? worldBounds.max.y : worldBounds.min.y,
+                               (i & 4) ? worldBounds.max.z : worldBounds.min.z);
+        const glm::vec4 clip = worldToClip * glm::vec4(corner, 1.0f);
+        if (clip.w <= MIN_CLIP_W) return true;
+        const float invW = 1.0f / clip.w;
+        const float z = clip.z * invW;
+        if (z < 0.0f) return true;
+        const float x = (clip.x * invW * 0.5f + 0.5f) * static_cast<float>(width);
+        const float y = (clip.y * invW * 0.5f + 0.5f) * static_cast<float>(height);
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        nearestZ = std::min(nearestZ, z);
+    }
+    // Entirely off-screen: leave that decision to frustum culling.
+    if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(width) || minY >= static_cast<float>(height)) {
+        return true;
+    }
+
+    const uint32_t tx0 = static_cast<uint32_t>(std::max(minX, 0.0f)) / TILE_WIDTH;
+    const uint32_t ty0 = static_cast<uint32_t>(std::max(minY, 0.0f)) / TILE_HEIGHT;
+    const uint32_t tx1 = static_cast<uint32_t>(std::min(maxX, static_cast<float>(width - 1u))) / TILE_WIDTH;
+    const uint32_t ty1 = static_cast<uint32_t>(std::min(maxY, static_cast<float>(height - 1u))) / TILE_HEIGHT;
+    // Equal depth counts as visible: only boxes strictly behind the occluders are rejected.
+    const float testZ = nearestZ - OCCLUDEE_DEPTH_BIAS;
+    for (uint32_t ty = ty0; ty <= ty1; ++ty) {
+        const float* row = zMax0.data() + static_cast<size_t>(ty) * tilesX;
+        for (uint32_t tx = tx0; tx <= tx1; ++tx) {
+            if (row[tx] >= testZ) return true;
+        }
+    }
+    return false;
+}
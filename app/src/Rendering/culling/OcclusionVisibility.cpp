@@ -0,0 +1,150 @@
+#include "Rendering/culling/OcclusionVisibility.h"
+
+#include "Engine/Math/BoundingBox.h"
+#include "Resource/model/Model.h"
+#include "Resource/model/Node.h"
+
+#include <algorithm>
+
+namespace {
+// Bounds closer than the near plane may be clipped by it and report zero samples: never query those.
+constexpr float CAMERA_INSIDE_MARGIN = 0.2f;
+}  // namespace
+
+void OcclusionVisibilityBuffer::init(vk::raii::Device& device, uint32_t inMaxQueries)
+{
+    maxQueries = std::max(1u, inMaxQueries);
+
+    vk::QueryPoolCreateInfo poolInfo{};
+    poolInfo.queryType = vk::QueryType::eOcclusion;
+    poolInfo.queryCount = maxQueries;
+    for (FrameQueries& frame : frames) {
+        frame.queryPool = vk::raii::QueryPool(device, poolInfo);
+        frame.queries.reserve(maxQueries);
+        frame.issuedCount = 0;
+    }
+    reset();
+}
+
+void OcclusionVisibilityBuffer::cleanup()
+{
+    for (FrameQueries& frame : frames) {
+        frame.queryPool.reset();
+        frame.queries.clear();
+        frame.issuedCount = 0;
+    }
+    hiddenNodes.clear();
+    nodeVisibility.clear();
+}
+
+void OcclusionVisibilityBuffer::reset()
+{
+    for (FrameQueries& frame : frames) {
+        frame.queries.clear();
+        frame.issuedCount = 0;
+    }
+    std::fill(hiddenNodes.begin(), hiddenNodes.end(), uint8_t{0});
+    stats = Stats{};
+}
+
+void OcclusionVisibilityBuffer::harvest(FrameQueries& frame)
+{
+    const uint32_t count = std::min(frame.issuedCount, static_cast<uint32_t>(frame.queries.size()));
+    frame.issuedCount = 0;
+    if (count == 0 || !frame.queryPool) {
+        return;
+    }
+
+    // No eWait: each query yields {samples, available}. The slot's timeline value has been waited, so results are
+    // normally ready; anything still unavailable is counted as late and left visible.
+    constexpr vk::DeviceSize stride = 2u * sizeof(uint64_t);
+    const vk::QueryResultFlags flags = vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability;
+    auto [result, data] = frame.queryPool->getResults<uint64_t>(0, count, static_cast<size_t>(count * stride), stride, flags);
+    (void)result;  // eNotReady is expected when some queries are unavailable
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t node = frame.queries[i].linearIndex;
+        if (node >= hiddenNodes.size()) continue;
+        const uint64_t samples = data[2u * i];
+        const uint64_t available = data[2u * i + 1u];
+        if (available == 0u) {
+            hiddenNodes[node] = 0u;
+            ++stats.lateQueries;
+            continue;
+        }
+        hiddenNodes[node] = (samples == 0u) ? 1u : 0u;
+        ++stats.resolvedQueries;
+    }
+}
+
+void OcclusionVisibilityBuffer::beginFrame(uint32_t frameIndex, const Model& model,
+                                           const std::vector<uint8_t>& frustumVisibility,
+                                           const glm::vec3& cameraPosition)
+{
+    const auto& linearNodes = model.getLinearNodes();
+    const auto& worldMatrices = model.getWorldMatrices();
+    const uint32_t count = static_cast<uint32_t>(linearNodes.size());
+
+    stats = Stats{};
+    if (hiddenNodes.size() != count) {
+        hiddenNodes.assign(count, 0u);
+    }
+
+    FrameQueries& frame = frames[frameIndex];
+    harvest(frame);
+
+    nodeVisibility = frustumVisibility;
+    frame.queries.clear();
+    if (worldMatrices.size() != count || nodeVisibility.size() != count) {
+        std::fill(hiddenNodes.begin(), hiddenNodes.end(), uint8_t{0});
+        return;
+    }
+
+    uint32_t i = 0;
+    while (i < count) {
+        const Node* node = linearNodes[i];
+        const uint32_t end = std::max(std::min(node->subtreeEnd, count), i + 1);
+
+        // Outside the frustum (or under a hidden parent): forget any old result so the node starts visible again.
+        if (nodeVisibility[i] == 0u) {
+            hiddenNodes[i] = 0u;
+            ++i;
+            continue;
+        }
+        if (node->meshIndices.empty() || !node->hasSubtreeBounds) {
+            hiddenNodes[i] = 0u;
+            ++i;
+            continue;
+        }
+
+        BoundingBox worldBounds = node->subtreeBounds;
+        worldBounds.Transform(worldMatrices[i]);
+        const glm::vec3 margin(CAMERA_INSIDE_MARGIN);
+        const bool cameraInside = glm::all(glm::greaterThanEqual(cameraPosition, worldBounds.min - margin)) &&
+                                  glm::all(glm::lessThanEqual(cameraPosition, worldBounds.max + margin));
+        if (cameraInside) {
+            hiddenNodes[i] = 0u;
+        } else if (frame.queries.size() < maxQueries) {
+            QueryEntry entry{};
+            entry.linearIndex = i;
+            entry.center = 0.5f * (worldBounds.min + worldBounds.max);
+            entry.halfExtent = 0.5f * (worldBounds.max - worldBounds.min);
+            frame.queries.push_back(entry);
+        } else {
+            hiddenNodes[i] = 0u;
+        }
+
+        // Subtree bounds cover every descendant, so a hidden node hides its whole subtree.
+        if (hiddenNodes[i] != 0u) {
+            for (uint32_t k = i; k < end; ++k) {
+                stats.hiddenNodes += nodeVisibility[k];
+                nodeVisibility[k] = 0u;
+            }
+        }
+        ++i;
+    }
+
+    // The pass records every planned query after one batched reset of [0, issuedCount).
+    frame.issuedCount = static_cast<uint32_t>(frame.queries.size());
+    stats.issuedQueries = frame.issuedCount;
+}
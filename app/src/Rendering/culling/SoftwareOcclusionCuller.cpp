@@ -0,0 +1,266 @@
+#include "Rendering/culling/SoftwareOcclusionCuller.h"
+
+#include "Configs/AppConfig.h"
+#include "Engine/Camera/Camera.h"
+#include "Engine/Camera/CameraPath.h"
+#include "Engine/Jobs/JobSystem.h"
+#include "Rendering/culling/HierarchicalCuller.h"
+#include "Resource/model/Model.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+void SoftwareOcclusionCuller::selectOccluders(const Model& model)
+{
+    occluders.clear();
+    occludersSelected = true;
+
+    const auto& linearNodes = model.getLinearNodes();
+    const auto& worldMatrices = model.getWorldMatrices();
+    const auto& meshes = model.getMeshes();
+    const auto& materials = model.getMaterials();
+    if (worldMatrices.size() != linearNodes.size()) return;
+
+    struct Candidate {
+        Occluder occluder;
+        float size = 0.0f;
+    };
+    std::vector<Candidate> candidateList;
+    for (size_t i = 0; i < linearNodes.size(); ++i) {
+        for (uint32_t meshIndex : linearNodes[i]->meshIndices) {
+            if (meshIndex >= meshes.size()) continue;
+            const Mesh& mesh = meshes[meshIndex];
+            const uint32_t triangleCount = static_cast<uint32_t>(mesh.indices.size() / 3u);
+            if (!mesh.hasBounds || triangleCount == 0 || triangleCount > AppConfig::SOFTWARE_OCCLUSION_MAX_OCCLUDER_TRIANGLES) {
+                continue;
+            }
+            // Alpha-tested / blended surfaces have holes: never use them as occluders.
+            const int matIdx = mesh.materialIndex;
+            if (matIdx >= 0 && matIdx < static_cast<int>(materials.size()) &&
+                materials[static_cast<size_t>(matIdx)].alphaMode != AlphaMode::Opaque) {
+                continue;
+            }
+
+            BoundingBox worldBounds = mesh.bounds;
+            worldBounds.Transform(worldMatrices[i]);
+            Candidate c{};
+            c.occluder.linearIndex = static_cast<uint32_t>(i);
+            c.occluder.meshIndex = meshIndex;
+            c.occluder.triangleCount = triangleCount;
+            c.occluder.worldCenter = 0.5f * (worldBounds.min + worldBounds.max);
+            c.size = glm::length(worldBounds.max - worldBounds.min);
+            candidateList.push_back(c);
+        }
+    }
+
+    // Largest first until the triangle budget is used up.
+    std::sort(candidateList.begin(), candidateList.end(),
+              [](const Candidate& a, const Candidate& b) { return a.size > b.size; });
+    uint32_t budget = AppConfig::SOFTWARE_OCCLUSION_TRIANGLE_BUDGET;
+    for (const Candidate& c : candidateList) {
+        if (c.occluder.triangleCount > budget) continue;
+        budget -= c.occluder.triangleCount;
+        occluders.push_back(c.occluder);
+    }
+}
+
+void SoftwareOcclusionCuller::rasterizeOccluders(const Model& model, const glm::mat4& viewProj,
+                                                 const glm::vec3& cameraPosition)
+{
+    const auto& worldMatrices = model.getWorldMatrices();
+    const auto& meshes = model.getMeshes();
+
+    frameOccluders.clear();
+    for (const Occluder& occluder : occluders) {
+        if (nodeVisibility[occluder.linearIndex] != 0u) {
+            frameOccluders.push_back(occluder);
+        }
+    }
+    // Front to back: near occluders fill tiles first, so later (farther) triangles early-out on zMax0.
+    std::sort(frameOccluders.begin(), frameOccluders.end(), [&](const Occluder& a, const Occluder& b) {
+        const glm::vec3 da = a.worldCenter - cameraPosition;
+        const glm::vec3 db = b.worldCenter - cameraPosition;
+        return glm::dot(da, da) < glm::dot(db, db);
+    });
+
+    uint32_t triangleCount = 0;
+    for (Occluder& occluder : frameOccluders) {
+        occluder.firstTriangle = triangleCount;
+        triangleCount += occluder.triangleCount;
+    }
+    triangles.resize(triangleCount);
+    stats.occluders = static_cast<uint32_t>(frameOccluders.size());
+    stats.occluderTriangles = triangleCount;
+
+    buffer.clear();
+    if (triangleCount == 0) return;
+
+    JobSystem& jobs = JobSystem::get();
+    jobs.parallelFor(static_cast<uint32_t>(frameOccluders.size()), 4, [&](uint32_t begin, uint32_t end) {
+        thread_local std::vector<glm::vec4> clipVertices;
+        for (uint32_t o = begin; o < end; ++o) {
+            const Occluder& occluder = frameOccluders[o];
+            const Mesh& mesh = meshes[occluder.meshIndex];
+            const glm::mat4 worldToClip = viewProj * worldMatrices[occluder.linearIndex];
+            clipVertices.resize(mesh.vertices.size());
+            for (size_t v = 0; v < mesh.vertices.size(); ++v) {
+                clipVertices[v] = worldToClip * glm::vec4(mesh.vertices[v].pos, 1.0f);
+            }
+            MaskedOcclusionBuffer::ScreenTriangle* out = triangles.data() + occluder.firstTriangle;
+            const uint32_t vertexCount = static_cast<uint32_t>(clipVertices.size());
+            for (uint32_t t = 0; t < occluder.triangleCount; ++t) {
+                const uint32_t i0 = mesh.indices[3u * t + 0u];
+                const uint32_t i1 = mesh.indices[3u * t + 1u];
+                const uint32_t i2 = mesh.indices[3u * t + 2u];
+                if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+                    out[t] = MaskedOcclusionBuffer::ScreenTriangle{};
+                    continue;
+                }
+                buffer.projectTriangle(clipVertices[i0], clipVertices[i1], clipVertices[i2], out[t]);
+            }
+        }
+    });
+
+    // Tile rows are disjoint, so bands rasterize without synchronization.
+    jobs.parallelFor(buffer.getTileCountY(), 2, [&](uint32_t begin, uint32_t end) {
+        buffer.rasterize(triangles.data(), triangles.size(), begin, end, simdLevel);
+    });
+}
+
+void SoftwareOcclusionCuller::cull(const Model& model, const glm::mat4& viewProj, const glm::vec3& cameraPosition,
+                                   const std::vector<uint8_t>& frustumVisibility)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    const auto& linearNodes = model.getLinearNodes();
+    const auto& worldMatrices = model.getWorldMatrices();
+    const uint32_t count = static_cast<uint32_t>(linearNodes.size());
+
+    stats = Stats{};
+    nodeVisibility = frustumVisibility;
+    if (worldMatrices.size() != count || nodeVisibility.size() != count) {
+        return;
+    }
+    if (buffer.getWidth() == 0) {
+        buffer.resize(AppConfig::SOFTWARE_OCCLUSION_WIDTH, AppConfig::SOFTWARE_OCCLUSION_HEIGHT);
+    }
+    if (!occludersSelected) {
+        selectOccluders(model);
+    }
+
+    const auto t0 = Clock::now();
+    rasterizeOccluders(model, viewProj, cameraPosition);
+    const auto t1 = Clock::now();
+
+    candidates.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        const Node* node = linearNodes[i];
+        if (nodeVisibility[i] != 0u && node->hasSubtreeBounds && !node->meshIndices.empty()) {
+            candidates.push_back(i);
+        }
+    }
+    candidateVisible.assign(candidates.size(), 1u);
+    JobSystem::get().parallelFor(static_cast<uint32_t>(candidates.size()), 64, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t c = begin; c < end; ++c) {
+            const uint32_t i = candidates[c];
+            BoundingBox worldBounds = linearNodes[i]->subtreeBounds;
+            worldBounds.Transform(worldMatrices[i]);
+            const bool cameraInside = glm::all(glm::greaterThanEqual(cameraPosition, worldBounds.min)) &&
+                                      glm::all(glm::lessThanEqual(cameraPosition, worldBounds.max));
+            candidateVisible[c] = (cameraInside || buffer.testAabb(viewProj, worldBounds)) ? 1u : 0u;
+        }
+    });
+    stats.testedNodes = static_cast<uint32_t>(candidates.size());
+
+    // Subtree bounds cover every descendant, so a rejected node drops its whole subtree.
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        if (candidateVisible[c] != 0u) continue;
+        const uint32_t i = candidates[c];
+        const uint32_t end = std::max(std::min(linearNodes[i]->subtreeEnd, count), i + 1);
+        for (uint32_t k = i; k < end; ++k) {
+            stats.culledNodes += nodeVisibility[k];
+            nodeVisibility[k] = 0u;
+        }
+    }
+    stats.rasterMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    stats.testMs = std::chrono::duration<double, std::milli>(Clock::now() - t1).count();
+}
+
+void runMaskedOcclusionBenchmark(const Model& model, const std::vector<std::string>& cameraPathFiles, float aspectRatio)
+{
+    using FrustumCulling::SimdLevel;
+
+    struct Pose {
+        glm::mat4 viewProj{1.0f};
+        glm::vec3 position{0.0f};
+        std::vector<uint8_t> frustumVisibility;
+    };
+
+    const SimdLevel best = FrustumCulling::DetectSimdLevel();
+    for (const std::string& file : cameraPathFiles) {
+        const CameraPath path = CameraPath::loadFromFile(file);
+
+        // Same cadence as a --benchmark run: one pose per fixed timestep, both ends included.
+        const uint32_t frameCount = static_cast<uint32_t>(path.getDuration() / AppConfig::BENCHMARK_TIMESTEP) + 1u;
+        HierarchicalCuller frustumCuller;
+        Camera camera;
+        std::vector<Pose> poses(frameCount);
+        uint64_t frustumVisible = 0;
+        for (uint32_t f = 0; f < frameCount; ++f) {
+            path.apply(camera, static_cast<float>(f) * AppConfig::BENCHMARK_TIMESTEP);
+            Pose& pose = poses[f];
+            pose.viewProj = camera.getProjMatrix(aspectRatio, AppConfig::CAMERA_NEAR_PLANE, AppConfig::CAMERA_FAR_PLANE)
+                * camera.getViewMatrix();
+            pose.position = camera.getPosition();
+            frustumCuller.cull(model, Frustum(pose.viewProj));
+            pose.frustumVisibility = frustumCuller.getNodeVisibility();
+            for (uint8_t visible : pose.frustumVisibility) {
+                frustumVisible += visible;
+            }
+        }
+
+        std::vector<std::vector<float>> referenceDepths(frameCount);
+        std::vector<std::vector<uint8_t>> referenceVisibility(frameCount);
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse41, SimdLevel::Avx2}) {
+            if (static_cast<int>(level) > static_cast<int>(best)) break;
+
+            // Fresh culler per level: occluder selection and buffer state start identical.
+            SoftwareOcclusionCuller culler;
+            culler.setResolution(AppConfig::SOFTWARE_OCCLUSION_WIDTH, AppConfig::SOFTWARE_OCCLUSION_HEIGHT);
+            culler.setSimdLevel(level);
+            double rasterMs = 0.0;
+            double testMs = 0.0;
+            uint64_t occluderTriangles = 0;
+            uint64_t tested = 0;
+            uint64_t rejected = 0;
+            bool identical = true;
+            for (uint32_t f = 0; f < frameCount; ++f) {
+                const Pose& pose = poses[f];
+                culler.cull(model, pose.viewProj, pose.position, pose.frustumVisibility);
+                const SoftwareOcclusionCuller::Stats& stats = culler.getStats();
+                rasterMs += stats.rasterMs;
+                testMs += stats.testMs;
+                occluderTriangles += stats.occluderTriangles;
+                tested += stats.testedNodes;
+                rejected += stats.culledNodes;
+
+                if (level == SimdLevel::Scalar) {
+                    referenceDepths[f] = culler.getBuffer().getTileDepths();
+                    referenceVisibility[f] = culler.getNodeVisibility();
+                } else {
+                    identical = identical && (culler.getBuffer().getTileDepths() == referenceDepths[f]) &&
+                                (culler.getNodeVisibility() == referenceVisibility[f]);
+                }
+            }
+
+            std::cout << "[Perf] MaskedOcclusion path=" << file << " level=" << FrustumCulling::GetSimdLevelName(level)
+                      << " frames=" << frameCount << " workers=" << JobSystem::get().getWorkerCount()
+                      << " occluderTris=" << (occluderTriangles / frameCount)
+                      << " raster_ms=" << (rasterMs / frameCount) << " test_ms=" << (testMs / frameCount)
+                      << " tested=" << tested << " visible=" << frustumVisible << " rejected=" << rejected
+                      << " rejected_ratio="
+                      << (frustumVisible ? static_cast<double>(rejected) / static_cast<double>(frustumVisible) : 0.0)
+                      << " matches_scalar=" << (identical ? "yes" : "NO") << std::endl;
+        }
+    }
+}
@@ -297,7 +297,7 @@ CubemapResult EquirectToCubemap::convert(
     pipelineInfo.pDepthStencilState = &depthStencil;
     pipelineInfo.layout = *pipelineLayout;
 
-    vk::raii::Pipeline pipeline(device, nullptr, pipelineInfo);
+    vk::raii::Pipeline pipeline = resourceCreator.getPipelineCache().createGraphicsPipeline(pipelineInfo);
 
     // Create 6 image views for each face (each is a 2D view of one layer)
     std::array<vk::raii::ImageView, 6> faceViews = {
@@ -220,7 +220,7 @@ IblResult IblPrecompute::compute(VulkanResourceCreator& resourceCreator,
     irrPipeInfo.pColorBlendState = &irrBlendState;
     irrPipeInfo.pDynamicState = &irrDynState;
     irrPipeInfo.layout = *irrPipeLayout;
-    vk::raii::Pipeline irrPipeline(device, nullptr, irrPipeInfo);
+    vk::raii::Pipeline irrPipeline = resourceCreator.getPipelineCache().createGraphicsPipeline(irrPipeInfo);
 
     std::vector<vk::raii::ImageView> irrFaceViews;
     irrFaceViews.reserve(6);
@@ -360,7 +360,7 @@ IblResult IblPrecompute::compute(VulkanResourceCreator& resourceCreator,
     prePipeInfo.pColorBlendState = &irrBlendState;
     prePipeInfo.pDynamicState = &irrDynState;
     prePipeInfo.layout = *prePipeLayout;
-    vk::raii::Pipeline prePipeline(device, nullptr, prePipeInfo);
+    vk::raii::Pipeline prePipeline = resourceCreator.getPipelineCache().createGraphicsPipeline(prePipeInfo);
 
     resourceCreator.transitionImageLayout(
         static_cast<vk::Image>(*prefilterAlloc.image), vk::Format::eR16G16B16A16Sfloat,
@@ -508,7 +508,7 @@ IblResult IblPrecompute::compute(VulkanResourceCreator& resourceCreator,
     brdfPipeInfo.pDynamicState = &irrDynState;
     brdfPipeInfo.layout = *brdfPipeLayout;
 
-    vk::raii::Pipeline brdfPipeline(device, nullptr, brdfPipeInfo);
+    vk::raii::Pipeline brdfPipeline = resourceCreator.getPipelineCache().createGraphicsPipeline(brdfPipeInfo);
 
     vk::raii::ImageView brdfView = resourceCreator.createImageView(*brdfAlloc.image, vk::Format::eR16G16Sfloat,
         vk::ImageAspectFlagBits::eColor, 1);
@@ -1,10 +1,10 @@
 #include "Rendering/mesh/GlobalMeshBuffer.h"
 #include "Rendering/mesh/GpuMesh.h"
+#include "Resource/model/Model.h"
 #include "Resource/model/Vertex.h"
 
-#include <cstring>
-
-void GlobalMeshBuffer::init(VulkanResourceCreator& resourceCreator, const std::vector<GpuMesh>& meshes)
+void GlobalMeshBuffer::init(VulkanResourceCreator& resourceCreator, const std::vector<GpuMesh>& meshes,
+                            const CookedMeshStreams* cooked)
 {
     cleanup();
     if (meshes.empty()) return;
@@ -25,53 +25,34 @@ void GlobalMeshBuffer::init(VulkanResourceCreator& resourceCreator, const std::v
     const vk::DeviceSize vertexBufferSize = static_cast<vk::DeviceSize>(totalVertices) * sizeof(Vertex);
     const vk::DeviceSize indexBufferSize = static_cast<vk::DeviceSize>(totalIndices) * sizeof(uint32_t);
 
-    // Staging vertex buffer
-    std::vector<Vertex> allVertices;
-    allVertices.reserve(totalVertices);
-    for (const auto& m : meshes) {
-        for (const Vertex& v : m.getVertices()) {
-            allVertices.push_back(v);
-        }
-    }
-
-    BufferAllocation vertexStaging = resourceCreator.createBuffer(
-        vertexBufferSize,
-        vk::BufferUsageFlagBits::eTransferSrc,
-        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
-    void* vmap = vertexStaging.memory.mapMemory(0, vertexBufferSize);
-    std::memcpy(vmap, allVertices.data(), static_cast<size_t>(vertexBufferSize));
-    vertexStaging.memory.unmapMemory();
-
+    // Each mesh goes straight to its slice of the shared buffers (no CPU-side concatenation); one batch on the uploader.
+    UploadManager& uploader = resourceCreator.getUploader();
     BufferAllocation vertexGpu = resourceCreator.createBuffer(
         vertexBufferSize,
         vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer,
         vk::MemoryPropertyFlagBits::eDeviceLocal);
-    resourceCreator.copyBuffer(*vertexStaging.buffer, *vertexGpu.buffer, vertexBufferSize);
-    vertexBuffer = std::move(vertexGpu.buffer);
-    vertexBufferMemory = std::move(vertexGpu.memory);
-
-    // Staging index buffer: keep each mesh's indices local; use vertexOffset (baseVertex) at draw time.
-    std::vector<uint32_t> allIndices;
-    allIndices.reserve(totalIndices);
-    for (size_t i = 0; i < meshes.size(); ++i) {
-        for (uint32_t idx : meshes[i].getIndices()) {
-            allIndices.push_back(idx);
-        }
-    }
-
-    BufferAllocation indexStaging = resourceCreator.createBuffer(
-        indexBufferSize,
-        vk::BufferUsageFlagBits::eTransferSrc,
-        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
-    void* imap = indexStaging.memory.mapMemory(0, indexBufferSize);
-    std::memcpy(imap, allIndices.data(), static_cast<size_t>(indexBufferSize));
-    indexStaging.memory.unmapMemory();
-
     BufferAllocation indexGpu = resourceCreator.createBuffer(
         indexBufferSize,
         vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eIndexBuffer,
         vk::MemoryPropertyFlagBits::eDeviceLocal);
-    resourceCreator.copyBuffer(*indexStaging.buffer, *indexGpu.buffer, indexBufferSize);
+
+    // Keep each mesh's indices local; use vertexOffset (baseVertex) at draw time.
+    if (cooked && cooked->vertexCount == totalVertices && cooked->indexCount == totalIndices) {
+        // The cache stores exactly this layout: one copy per buffer, straight from the mapped file.
+        uploader.uploadBuffer(*vertexGpu.buffer, 0, cooked->vertices, vertexBufferSize);
+        uploader.uploadBuffer(*indexGpu.buffer, 0, cooked->indices, indexBufferSize);
+    } else {
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            const auto& vertices = meshes[i].getVertices();
+            const auto& indices = meshes[i].getIndices();
+            uploader.uploadBuffer(*vertexGpu.buffer, static_cast<vk::DeviceSize>(meshInfos[i].vertexOffset) * sizeof(Vertex),
+                                  vertices.data(), static_cast<vk::DeviceSize>(vertices.size()) * sizeof(Vertex));
+            uploader.uploadBuffer(*indexGpu.buffer, static_cast<vk::DeviceSize>(meshInfos[i].firstIndex) * sizeof(uint32_t),
+                                  indices.data(), static_cast<vk::DeviceSize>(indices.size()) * sizeof(uint32_t));
+        }
+    }
+    vertexBuffer = std::move(vertexGpu.buffer);
+    vertexBufferMemory = std::move(vertexGpu.memory);
     indexBuffer = std::move(indexGpu.buffer);
     indexBufferMemory = std::move(indexGpu.memory);
 }
@@ -1,11 +1,9 @@
 #include "Rendering/mesh/GpuMesh.h"
 
-// System
-#include <cstring>
-
 void GpuMesh::upload(VulkanResourceCreator& resourceCreator,
                      const std::vector<Vertex>& inVertices,
-                     const std::vector<uint32_t>& inIndices)
+                     const std::vector<uint32_t>& inIndices,
+                     bool accelerationStructureInput)
 {
     vertices = inVertices;
     indices = inIndices;
@@ -15,8 +13,8 @@ void GpuMesh::upload(VulkanResourceCreator& resourceCreator,
         return;
     }
 
-    createVertexBuffer(resourceCreator, vertices);
-    createIndexBuffer(resourceCreator, indices);
+    createVertexBuffer(resourceCreator, vertices, accelerationStructureInput);
+    createIndexBuffer(resourceCreator, indices, accelerationStructureInput);
 }
 
 void GpuMesh::reset()
@@ -30,61 +28,50 @@ void GpuMesh::reset()
     indices.clear();
 }
 
-void GpuMesh::createVertexBuffer(VulkanResourceCreator& resourceCreator, const std::vector<Vertex>& verts)
+void GpuMesh::createVertexBuffer(VulkanResourceCreator& resourceCreator, const std::vector<Vertex>& verts,
+                                 bool accelerationStructureInput)
 {
     const vk::DeviceSize bufferSize = sizeof(verts[0]) * verts.size();
 
-    BufferAllocation staging = resourceCreator.createBuffer(
-        bufferSize,
-        vk::BufferUsageFlagBits::eTransferSrc,
-        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
-
-    void* data = staging.memory.mapMemory(0, bufferSize);
-    std::memcpy(data, verts.data(), static_cast<size_t>(bufferSize));
-    staging.memory.unmapMemory();
-
-    const vk::BufferUsageFlags vertexUsage = vk::BufferUsageFlagBits::eTransferDst
+    vk::BufferUsageFlags vertexUsage = vk::BufferUsageFlagBits::eTransferDst
         | vk::BufferUsageFlagBits::eVertexBuffer
-        | vk::BufferUsageFlagBits::eStorageBuffer
-        | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR
-        | vk::BufferUsageFlagBits::eShaderDeviceAddress;
+        | vk::BufferUsageFlagBits::eStorageBuffer;
+    if (accelerationStructureInput) {
+        vertexUsage |= vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR
+            | vk::BufferUsageFlagBits::eShaderDeviceAddress;
+    }
 
     BufferAllocation vertAlloc = resourceCreator.createBuffer(
         bufferSize,
         vertexUsage,
         vk::MemoryPropertyFlagBits::eDeviceLocal);
 
-    resourceCreator.copyBuffer(*staging.buffer, *vertAlloc.buffer, bufferSize);
+    // Async: the caller waits on the uploader before the first use (Renderer::init).
+    resourceCreator.getUploader().uploadBuffer(*vertAlloc.buffer, 0, verts.data(), bufferSize);
 
     vertexBuffer = std::move(vertAlloc.buffer);
     vertexBufferMemory = std::move(vertAlloc.memory);
 }
 
-void GpuMesh::createIndexBuffer(VulkanResourceCreator& resourceCreator, const std::vector<uint32_t>& idx)
+void GpuMesh::createIndexBuffer(VulkanResourceCreator& resourceCreator, const std::vector<uint32_t>& idx,
+                                bool accelerationStructureInput)
 {
     const vk::DeviceSize bufferSize = sizeof(idx[0]) * idx.size();
 
-    BufferAllocation staging = resourceCreator.createBuffer(
-        bufferSize,
-        vk::BufferUsageFlagBits::eTransferSrc,
-        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
-
-    void* data = staging.memory.mapMemory(0, bufferSize);
-    std::memcpy(data, idx.data(), static_cast<size_t>(bufferSize));
-    staging.memory.unmapMemory();
-
-    const vk::BufferUsageFlags indexUsage = vk::BufferUsageFlagBits::eTransferDst
+    vk::BufferUsageFlags indexUsage = vk::BufferUsageFlagBits::eTransferDst
         | vk::BufferUsageFlagBits::eIndexBuffer
-        | vk::BufferUsageFlagBits::eStorageBuffer
-        | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR
-        | vk::BufferUsageFlagBits::eShaderDeviceAddress;
+        | vk::BufferUsageFlagBits::eStorageBuffer;
+    if (accelerationStructureInput) {
+        indexUsage |= vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR
+            | vk::BufferUsageFlagBits::eShaderDeviceAddress;
+    }
 
     BufferAllocation idxAlloc = resourceCreator.createBuffer(
         bufferSize,
         indexUsage,
         vk::MemoryPropertyFlagBits::eDeviceLocal);
 
-    resourceCreator.copyBuffer(*staging.buffer, *idxAlloc.buffer, bufferSize);
+    resourceCreator.getUploader().uploadBuffer(*idxAlloc.buffer, 0, idx.data(), bufferSize);
 
     indexBuffer = std::move(idxAlloc.buffer);
     indexBufferMemory = std::move(idxAlloc.memory);
@@ -1,12 +1,15 @@
 #include "Rendering/pass/DepthPrepass.h"
 #include "Rendering/core/FrameManager.h"
+#include "Rendering/pass/GpuCullingPass.h"
 
 #include <array>
 
 DepthPrepass::DepthPrepass(DepthPrepassPipeline& inPipeline, FrameManager& inFrameManager, Model& inModel, std::vector<GpuMesh>& inMeshes,
                            GlobalMeshBuffer& inGlobalMeshBuffer, uint32_t inMaxDraws,
                            Rendergraph& inRendergraph, bool inEnableDepthResolve)
-    : RenderPass("DepthPrepass", {}, {"depth"})
+    : RenderPass("DepthPrepass", {},
+                 inEnableDepthResolve ? std::vector<std::string>{"depth", "depth_resolve", "normal_resolve", "linear_depth_resolve"}
+                                      : std::vector<std::string>{"depth"})
     , pipeline(&inPipeline)
     , frameManager(&inFrameManager)
     , model(&inModel)
@@ -102,7 +105,10 @@ void DepthPrepass::render(const PassExecuteContext& ctx)
     const uint32_t frameIdx = frameManager->getCurrentFrame();
     const auto& bucketSpans = frameManager->getSharedOpaqueBucketSpans();
 
-    const vk::Buffer indirectBuffer = frameManager->getIndirectCommandsBuffer(frameIdx);
+    const bool useGpuCulling = gpuCullingPass && gpuCullingPass->isActiveThisFrame();
+    const vk::Buffer indirectBuffer = useGpuCulling ? gpuCullingPass->getCulledCommandBuffer(frameIdx)
+                                                    : frameManager->getIndirectCommandsBuffer(frameIdx);
+    const vk::Buffer countBuffer = useGpuCulling ? gpuCullingPass->getDrawCountBuffer(frameIdx) : vk::Buffer{};
     const vk::Buffer globalVB = globalMeshBuffer->getVertexBuffer();
     const vk::Buffer globalIB = globalMeshBuffer->getIndexBuffer();
     if (!indirectBuffer || !globalVB || !globalIB) {
@@ -114,7 +120,8 @@ void DepthPrepass::render(const PassExecuteContext& ctx)
     cb.bindVertexBuffers(0, vertexBuffers, offsets);
     cb.bindIndexBuffer(globalIB, 0, vk::IndexType::eUint32);
 
-    for (const auto& span : bucketSpans) {
+    for (size_t spanIndex = 0; spanIndex < bucketSpans.size(); ++spanIndex) {
+        const auto& span = bucketSpans[spanIndex];
         if (span.firstCommand >= maxDraws) {
             break;
         }
@@ -143,11 +150,22 @@ void DepthPrepass::render(const PassExecuteContext& ctx)
             0,
             {pc});
 
-        cb.drawIndexedIndirect(
-            indirectBuffer,
-            static_cast<vk::DeviceSize>(span.firstCommand) * sizeof(vk::DrawIndexedIndirectCommand),
-            drawCount,
-            sizeof(vk::DrawIndexedIndirectCommand));
+        if (useGpuCulling) {
+            // drawCount is the upper bound; the GPU-written count for this bucket decides how many are drawn.
+            cb.drawIndexedIndirectCount(
+                indirectBuffer,
+                static_cast<vk::DeviceSize>(span.firstCommand) * sizeof(vk::DrawIndexedIndirectCommand),
+                countBuffer,
+                static_cast<vk::DeviceSize>(spanIndex) * sizeof(uint32_t),
+                drawCount,
+                sizeof(vk::DrawIndexedIndirectCommand));
+        } else {
+            cb.drawIndexedIndirect(
+                indirectBuffer,
+                static_cast<vk::DeviceSize>(span.firstCommand) * sizeof(vk::DrawIndexedIndirectCommand),
+                drawCount,
+                sizeof(vk::DrawIndexedIndirectCommand));
+        }
         if (ctx.stats) {
             ctx.stats->depthDrawCalls += drawCount;
         }
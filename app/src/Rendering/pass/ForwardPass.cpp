@@ -8,6 +8,7 @@
 #include "Configs/AppConfig.h"
 #include "Engine/Math/BoundingBox.h"
 #include "Rendering/mesh/GlobalMeshBuffer.h"
+#include "Rendering/pass/GpuCullingPass.h"
 #include "Resource/model/Material.h"
 #include "Resource/model/Mesh.h"
 #include "Resource/model/Node.h"
@@ -146,7 +147,7 @@ void ForwardPass::render(const PassExecuteContext& ctx)
     const auto& materials = model->getMaterials();
     const glm::mat4 viewMat = ctx.camera ? ctx.camera->getViewMatrix() : glm::mat4(1.0f);
     const auto& linearNodes = model->getLinearNodes();
-    const auto& sharedNodeWorldMatrices = frameManager->getSharedNodeWorldMatrices();
+    const auto& sharedNodeWorldMatrices = model->getWorldMatrices();
     const auto& sharedBucketSpans = frameManager->getSharedOpaqueBucketSpans();
     const uint32_t sharedOpaqueDrawCount = frameManager->getSharedOpaqueDrawCount();
 
@@ -159,6 +160,7 @@ void ForwardPass::render(const PassExecuteContext& ctx)
     const auto tCollect0 = now();
     for (const DrawSlot& slot : transparentSlots) {
         if (slot.nodeLinearIndex >= sharedNodeWorldMatrices.size()) continue;
+        if (!frameManager->isSharedNodeVisible(slot.nodeLinearIndex)) continue;
         const glm::mat4 worldFromNode = sharedNodeWorldMatrices[slot.nodeLinearIndex];
         Node* node = linearNodes[slot.nodeLinearIndex];
         const Mesh& cpuMesh = cpuMeshes[slot.meshIndex];
@@ -214,7 +216,10 @@ void ForwardPass::render(const PassExecuteContext& ctx)
         const uint32_t frameIdx = frameManager->getCurrentFrame();
         glm::mat4* drawDataMapped = static_cast<glm::mat4*>(frameManager->getDrawDataMapped(frameIdx));
 
-        vk::Buffer indirectBuffer = frameManager->getIndirectCommandsBuffer(frameIdx);
+        const bool useGpuCulling = gpuCullingPass && gpuCullingPass->isActiveThisFrame();
+        vk::Buffer indirectBuffer = useGpuCulling ? gpuCullingPass->getCulledCommandBuffer(frameIdx)
+                                                  : frameManager->getIndirectCommandsBuffer(frameIdx);
+        const vk::Buffer countBuffer = useGpuCulling ? gpuCullingPass->getDrawCountBuffer(frameIdx) : vk::Buffer{};
         if (indirectBuffer && globalVB && globalIB) {
             vk::Buffer vertexBuffers[] = {globalVB};
             vk::DeviceSize offsets[] = {0};
@@ -223,7 +228,8 @@ void ForwardPass::render(const PassExecuteContext& ctx)
             vertexBindCount = 1;
             indexBindCount = 1;
 
-            for (const auto& span : sharedBucketSpans) {
+            for (size_t spanIndex = 0; spanIndex < sharedBucketSpans.size(); ++spanIndex) {
+                const auto& span = sharedBucketSpans[spanIndex];
                 if (span.firstCommand >= maxDraws) {
                     break;
                 }
@@ -261,10 +267,19 @@ void ForwardPass::render(const PassExecuteContext& ctx)
                 cb.pushConstants<PBRPushConstants>(frameManager->getPipelineLayout(),
                     vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, 0, {pc});
 
-                cb.drawIndexedIndirect(indirectBuffer,
-                                       static_cast<vk::DeviceSize>(span.firstCommand) * sizeof(vk::DrawIndexedIndirectCommand),
-                                       drawCount,
-                                       sizeof(vk::DrawIndexedIndirectCommand));
+                if (useGpuCulling) {
+                    cb.drawIndexedIndirectCount(indirectBuffer,
+                                                static_cast<vk::DeviceSize>(span.firstCommand) * sizeof(vk::DrawIndexedIndirectCommand),
+                                                countBuffer,
+                                                static_cast<vk::DeviceSize>(spanIndex) * sizeof(uint32_t),
+                                                drawCount,
+                                                sizeof(vk::DrawIndexedIndirectCommand));
+                } else {
+                    cb.drawIndexedIndirect(indirectBuffer,
+                                           static_cast<vk::DeviceSize>(span.firstCommand) * sizeof(vk::DrawIndexedIndirectCommand),
+                                           drawCount,
+                                           sizeof(vk::DrawIndexedIndirectCommand));
+                }
                 forwardDrawCallsCount += drawCount;
             }
         }
@@ -0,0 +1,582 @@
+#include "Rendering/pass/GpuCullingPass.h"
+
+#include "Configs/AppConfig.h"
+#include "Configs/RuntimeConfig.h"
+#include "Engine/Camera/Camera.h"
+#include "Engine/Math/Frustum.h"
+#include "Rendering/mesh/GlobalMeshBuffer.h"
+#include "Resource/model/Mesh.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {
+uint32_t divUp(uint32_t x, uint32_t y)
+{
+    return (x + y - 1u) / y;
+}
+}  // namespace
+
+GpuCullingPass::GpuCullingPass(VulkanContext& context, VulkanResourceCreator& inResourceCreator, GpuCullingPipeline& inPipeline,
+                               FrameManager& inFrameManager, Model& inModel, uint32_t inMaxDraws, bool inEnableDepthResolve)
+    : RenderPass("GpuCullingPass", {"depth_resolve"}, {})
+    , device(&context.getDevice())
+    , resourceCreator(&inResourceCreator)
+    , pipeline(&inPipeline)
+    , frameManager(&inFrameManager)
+    , model(&inModel)
+    , maxDraws(std::max(1u, inMaxDraws))
+    , enableDepthResolve(inEnableDepthResolve)
+    , drawIndirectCountSupported(context.supportsDrawIndirectCount())
+{
+    createFrameResources();
+    createDescriptorPool();
+    createDescriptorSets();
+}
+
+vk::Buffer GpuCullingPass::getCulledCommandBuffer(uint32_t frameIndex) const
+{
+    const FrameResources& frame = frames[frameIndex % AppConfig::MAX_FRAMES_IN_FLIGHT];
+    return frame.culledCommandBuffer ? static_cast<vk::Buffer>(*frame.culledCommandBuffer) : vk::Buffer{};
+}
+
+vk::Buffer GpuCullingPass::getDrawCountBuffer(uint32_t frameIndex) const
+{
+    const FrameResources& frame = frames[frameIndex % AppConfig::MAX_FRAMES_IN_FLIGHT];
+    return frame.countBuffer ? static_cast<vk::Buffer>(*frame.countBuffer) : vk::Buffer{};
+}
+
+bool GpuCullingPass::canRun(const Camera* camera) const
+{
+    return RuntimeConfig::enableGpuCulling && drawIndirectCountSupported && camera && drawInstanceBuffer
+        && pipeline->getCullPipeline();
+}
+
+std::optional<vk::ImageLayout> GpuCullingPass::getRequiredInputLayout(const std::string& resource) const
+{
+    if (resource == "depth_resolve") {
+        return vk::ImageLayout::eDepthStencilReadOnlyOptimal;
+    }
+    return std::nullopt;
+}
+
+void GpuCullingPass::beginPass(const PassExecuteContext& ctx)
+{
+    activeThisFrame = false;
+    hizThisFrame = false;
+
+    const uint32_t frameIdx = frameManager->getCurrentFrame();
+    FrameResources& frame = frames[frameIdx % AppConfig::MAX_FRAMES_IN_FLIGHT];
+    // The timeline value of this slot was waited before recording, so the last copy into the readback buffer is done.
+    readBackStats(frame, ctx.stats);
+
+    // The Renderer decided before recording: only run when the draw data was prepared in the slot-indexed layout.
+    if (!frameManager->isSharedOpaqueGpuDriven() || !canRun(ctx.camera)) {
+        return;
+    }
+
+    ensureHizResources();
+    frame.submittedBucketCount = drawBucketCount;
+    activeThisFrame = true;
+
+    const vk::Extent2D extent = frameManager->getSwapChainExtent();
+    const float aspect = extent.width / static_cast<float>(std::max(extent.height, 1u));
+    const glm::mat4 viewProj = ctx.camera->getProjMatrix(aspect, AppConfig::CAMERA_NEAR_PLANE, AppConfig::CAMERA_FAR_PLANE)
+        * ctx.camera->getViewMatrix();
+
+    hizThisFrame = RuntimeConfig::enableHizOcclusionCulling && enableDepthResolve && hizDescriptorSets
+        && hizMipCount > 0 && hizHistoryFrames > 0 && hasLastViewProj;
+
+    CullParams params{};
+    params.viewProj = viewProj;
+    params.prevViewProj = hasLastViewProj ? lastViewProj : viewProj;
+    params.frustumPlanes = Frustum(viewProj).GetPlanes();
+    params.counts = glm::uvec4(drawInstanceCount,
+                               drawBucketCount,
+                               hizThisFrame ? hizMipCount : 0u,
+                               RuntimeConfig::enableFrustumCulling ? 1u : 0u);
+    params.hizParams = glm::vec4(static_cast<float>(hizSourceExtent.width), static_cast<float>(hizSourceExtent.height),
+                                 static_cast<float>(hizExtent.width), static_cast<float>(hizExtent.height));
+    std::memcpy(frame.paramsMapped, &params, sizeof(CullParams));
+
+    lastViewProj = viewProj;
+    hasLastViewProj = true;
+
+    vk::raii::CommandBuffer& cb = ctx.commandBuffer;
+
+    // WAR: previous users of this slot's count/output buffers (indirect reads, readback copy) must finish first.
+    cb.pipelineBarrier(vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eTransfer,
+                       vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eComputeShader,
+                       {}, {}, {}, {});
+    cb.fillBuffer(*frame.countBuffer, 0, countBufferSize(), 0u);
+
+    vk::BufferMemoryBarrier clearBarrier{};
+    clearBarrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    clearBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+    clearBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    clearBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    clearBarrier.buffer = *frame.countBuffer;
+    clearBarrier.offset = 0;
+    clearBarrier.size = VK_WHOLE_SIZE;
+    cb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eComputeShader,
+                       {}, {}, clearBarrier, {});
+
+    if (hizNeedsLayoutInit && hizImage) {
+        vk::ImageMemoryBarrier initBarrier{};
+        initBarrier.oldLayout = vk::ImageLayout::eUndefined;
+        initBarrier.newLayout = vk::ImageLayout::eGeneral;
+        initBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        initBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        initBarrier.image = *hizImage;
+        initBarrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+        initBarrier.subresourceRange.baseMipLevel = 0;
+        initBarrier.subresourceRange.levelCount = hizMipCount;
+        initBarrier.subresourceRange.baseArrayLayer = 0;
+        initBarrier.subresourceRange.layerCount = 1;
+        initBarrier.srcAccessMask = {};
+        initBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+        cb.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eComputeShader,
+                           {}, {}, {}, initBarrier);
+        hizNeedsLayoutInit = false;
+    }
+}
+
+void GpuCullingPass::render(const PassExecuteContext& ctx)
+{
+    if (!activeThisFrame) {
+        return;
+    }
+
+    vk::raii::CommandBuffer& cb = ctx.commandBuffer;
+    if (hizThisFrame) {
+        buildHiz(cb);
+    }
+
+    if (drawInstanceCount == 0) {
+        return;
+    }
+
+    const uint32_t frameIdx = frameManager->getCurrentFrame();
+    updateCullDescriptors(frameIdx);
+
+    vk::DescriptorSet set = (*cullDescriptorSets)[frameIdx % AppConfig::MAX_FRAMES_IN_FLIGHT];
+    cb.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline->getCullPipeline());
+    cb.bindDescriptorSets(vk::PipelineBindPoint::eCompute, pipeline->getCullPipelineLayout(), 0, {set}, nullptr);
+    cb.dispatch(divUp(drawInstanceCount, GpuCull::GROUP_SIZE), 1, 1);
+}
+
+void GpuCullingPass::endPass(const PassExecuteContext& ctx)
+{
+    // The depth prepass of this frame refreshes the depth resolve, so the next frame has history to build from.
+    if (enableDepthResolve && hizImage) {
+        hizHistoryFrames = std::min(hizHistoryFrames + 1u, 2u);
+    }
+    if (!activeThisFrame) {
+        return;
+    }
+
+    const uint32_t frameIdx = frameManager->getCurrentFrame();
+    FrameResources& frame = frames[frameIdx % AppConfig::MAX_FRAMES_IN_FLIGHT];
+    vk::raii::CommandBuffer& cb = ctx.commandBuffer;
+
+    // Culled commands + counts -> indirect draws of DepthPrepass/ForwardPass and the stats readback copy.
+    vk::MemoryBarrier cullBarrier{};
+    cullBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eTransferWrite;
+    cullBarrier.dstAccessMask = vk::AccessFlagBits::eIndirectCommandRead | vk::AccessFlagBits::eTransferRead;
+    cb.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eTransfer,
+                       vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eTransfer,
+                       {}, cullBarrier, {}, {});
+
+    vk::BufferCopy copyRegion{};
+    copyRegion.srcOffset = 0;
+    copyRegion.dstOffset = 0;
+    copyRegion.size = countBufferSize();
+    cb.copyBuffer(*frame.countBuffer, *frame.countReadbackBuffer, copyRegion);
+
+    vk::BufferMemoryBarrier hostBarrier{};
+    hostBarrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    hostBarrier.dstAccessMask = vk::AccessFlagBits::eHostRead;
+    hostBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hostBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hostBarrier.buffer = *frame.countReadbackBuffer;
+    hostBarrier.offset = 0;
+    hostBarrier.size = VK_WHOLE_SIZE;
+    cb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost,
+                       {}, {}, hostBarrier, {});
+
+    frame.submittedInstanceCount = drawInstanceCount;
+    frame.hasPendingReadback = true;
+}
+
+void GpuCullingPass::createFrameResources()
+{
+    const vk::DeviceSize paramsSize = sizeof(CullParams);
+    const vk::DeviceSize commandsSize = static_cast<vk::DeviceSize>(maxDraws) * sizeof(vk::DrawIndexedIndirectCommand);
+    const vk::MemoryPropertyFlags hostFlags =
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+
+    for (FrameResources& frame : frames) {
+        BufferAllocation params = resourceCreator->createBuffer(paramsSize, vk::BufferUsageFlagBits::eUniformBuffer, hostFlags);
+        frame.paramsMapped = params.memory.mapMemory(0, paramsSize);
+        frame.paramsBuffer = std::move(params.buffer);
+        frame.paramsMemory = std::move(params.memory);
+
+        BufferAllocation culled = resourceCreator->createBuffer(
+            commandsSize,
+            vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer,
+            vk::MemoryPropertyFlagBits::eDeviceLocal);
+        frame.culledCommandBuffer = std::move(culled.buffer);
+        frame.culledCommandMemory = std::move(culled.memory);
+
+        BufferAllocation counts = resourceCreator->createBuffer(
+            countBufferSize(),
+            vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer
+                | vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eTransferSrc,
+            vk::MemoryPropertyFlagBits::eDeviceLocal);
+        frame.countBuffer = std::move(counts.buffer);
+        frame.countMemory = std::move(counts.memory);
+
+        BufferAllocation readback = resourceCreator->createBuffer(
+            countBufferSize(), vk::BufferUsageFlagBits::eTransferDst, hostFlags);
+        frame.countReadbackMapped = readback.memory.mapMemory(0, countBufferSize());
+        frame.countReadbackBuffer = std::move(readback.buffer);
+        frame.countReadbackMemory = std::move(readback.memory);
+    }
+}
+
+void GpuCullingPass::createDescriptorPool()
+{
+    std::array<vk::DescriptorPoolSize, 3> poolSizes{};
+    poolSizes[0] = vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer, AppConfig::MAX_FRAMES_IN_FLIGHT};
+    poolSizes[1] = vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, AppConfig::MAX_FRAMES_IN_FLIGHT * 4u};
+    poolSizes[2] = vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, AppConfig::MAX_FRAMES_IN_FLIGHT};
+
+    vk::DescriptorPoolCreateInfo poolInfo{};
+    poolInfo.maxSets = AppConfig::MAX_FRAMES_IN_FLIGHT;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+    descriptorPool = vk::raii::DescriptorPool(*device, poolInfo);
+}
+
+void GpuCullingPass::createDescriptorSets()
+{
+    std::vector<vk::DescriptorSetLayout> layouts(AppConfig::MAX_FRAMES_IN_FLIGHT, pipeline->getCullDescriptorSetLayout());
+    vk::DescriptorSetAllocateInfo allocInfo{};
+    allocInfo.descriptorPool = *descriptorPool;
+    allocInfo.descriptorSetCount = AppConfig::MAX_FRAMES_IN_FLIGHT;
+    allocInfo.pSetLayouts = layouts.data();
+    cullDescriptorSets = vk::raii::DescriptorSets(*device, allocInfo);
+}
+
+void GpuCullingPass::ensureHizResources()
+{
+    // The depth resolve is reallocated on every swapchain recreation, even at the same extent.
+    const uint64_t generation = frameManager->getExtentTargetsGeneration();
+    const vk::Extent2D extent = frameManager->getSwapChainExtent();
+    if (hizImage && generation == hizSourceGeneration && extent == hizSourceExtent) {
+        return;
+    }
+
+    // Only reached on first use or after swapchain recreation (device idle), so the old pyramid is no longer in use.
+    hizDescriptorSets.reset();
+    hizDescriptorPool.reset();
+    hizMipViews.clear();
+    hizView.reset();
+    hizSampler.reset();
+    hizImage.reset();
+    hizMemory.reset();
+
+    hizSourceGeneration = generation;
+    hizSourceExtent = extent;
+    hizHistoryFrames = 0;
+    hizExtent = vk::Extent2D{std::max(1u, extent.width / 2u), std::max(1u, extent.height / 2u)};
+    hizMipCount = 1;
+    for (uint32_t size = std::max(hizExtent.width, hizExtent.height); size > 1u; size /= 2u) {
+        ++hizMipCount;
+    }
+    hizMipCount = std::min(hizMipCount, MAX_HIZ_MIPS);
+
+    const vk::Format hizFormat = vk::Format::eR32Sfloat;
+    ImageAllocation alloc = resourceCreator->createImage(
+        hizExtent.width, hizExtent.height, hizMipCount, vk::SampleCountFlagBits::e1,
+        hizFormat, vk::ImageTiling::eOptimal,
+        vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled,
+        vk::MemoryPropertyFlagBits::eDeviceLocal);
+    hizImage = std::move(alloc.image);
+    hizMemory = std::move(alloc.memory);
+    hizView = resourceCreator->createImageView(static_cast<vk::Image>(*hizImage), hizFormat,
+                                               vk::ImageAspectFlagBits::eColor, hizMipCount);
+    hizMipViews.reserve(hizMipCount);
+    for (uint32_t mip = 0; mip < hizMipCount; ++mip) {
+        hizMipViews.push_back(resourceCreator->createImageView(static_cast<vk::Image>(*hizImage), hizFormat,
+                                                               vk::ImageAspectFlagBits::eColor, hizMipCount,
+                                                               vk::ImageViewType::e2D, 0, 1, mip, 1));
+    }
+
+    vk::SamplerCreateInfo samplerInfo{};
+    samplerInfo.magFilter = vk::Filter::eNearest;
+    samplerInfo.minFilter = vk::Filter::eNearest;
+    samplerInfo.mipmapMode = vk::SamplerMipmapMode::eNearest;
+    samplerInfo.addressModeU = vk::SamplerAddressMode::eClampToEdge;
+    samplerInfo.addressModeV = vk::SamplerAddressMode::eClampToEdge;
+    samplerInfo.addressModeW = vk::SamplerAddressMode::eClampToEdge;
+    samplerInfo.compareEnable = VK_FALSE;
+    samplerInfo.minLod = 0.0f;
+    samplerInfo.maxLod = static_cast<float>(hizMipCount);
+    hizSampler = vk::raii::Sampler(*device, samplerInfo);
+    hizNeedsLayoutInit = true;
+
+    const vk::ImageView depthView = frameManager->getDepthResolveImageView();
+    const vk::Sampler depthSampler = frameManager->getDepthResolveSampler();
+    if (!depthView || !depthSampler) {
+        return;
+    }
+
+    std::array<vk::DescriptorPoolSize, 2> poolSizes{};
+    poolSizes[0] = vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, hizMipCount};
+    poolSizes[1] = vk::DescriptorPoolSize{vk::DescriptorType::eStorageImage, hizMipCount};
+
+    vk::DescriptorPoolCreateInfo poolInfo{};
+    poolInfo.maxSets = hizMipCount;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+    hizDescriptorPool = vk::raii::DescriptorPool(*device, poolInfo);
+
+    std::vector<vk::DescriptorSetLayout> layouts(hizMipCount, pipeline->getHizDescriptorSetLayout());
+    vk::DescriptorSetAllocateInfo allocInfo{};
+    allocInfo.descriptorPool = *hizDescriptorPool;
+    allocInfo.descriptorSetCount = hizMipCount;
+    allocInfo.pSetLayouts = layouts.data();
+    hizDescriptorSets = vk::raii::DescriptorSets(*device, allocInfo);
+
+    // Set i reads mip i - 1 (mip 0 reads the depth resolve) and writes mip i.
+    std::vector<vk::DescriptorImageInfo> srcInfos(hizMipCount);
+    std::vector<vk::DescriptorImageInfo> dstInfos(hizMipCount);
+    std::vector<vk::WriteDescriptorSet> writes;
+    writes.reserve(hizMipCount * 2u);
+    for (uint32_t mip = 0; mip < hizMipCount; ++mip) {
+        vk::DescriptorSet set = (*hizDescriptorSets)[mip];
+        if (mip == 0) {
+            srcInfos[mip].imageLayout = vk::ImageLayout::eDepthStencilReadOnlyOptimal;
+            srcInfos[mip].imageView = depthView;
+            srcInfos[mip].sampler = depthSampler;
+        } else {
+            srcInfos[mip].imageLayout = vk::ImageLayout::eGeneral;
+            srcInfos[mip].imageView = *hizMipViews[mip - 1u];
+            srcInfos[mip].sampler = *hizSampler;
+        }
+        dstInfos[mip].imageLayout = vk::ImageLayout::eGeneral;
+        dstInfos[mip].imageView = *hizMipViews[mip];
+        dstInfos[mip].sampler = VK_NULL_HANDLE;
+
+        vk::WriteDescriptorSet srcWrite{};
+        srcWrite.dstSet = set;
+        srcWrite.dstBinding = 0;
+        srcWrite.descriptorCount = 1;
+        srcWrite.descriptorType = vk::DescriptorType::eCombinedImageSampler;
+        srcWrite.pImageInfo = &srcInfos[mip];
+        writes.push_back(srcWrite);
+
+        vk::WriteDescriptorSet dstWrite{};
+        dstWrite.dstSet = set;
+        dstWrite.dstBinding = 1;
+        dstWrite.descriptorCount = 1;
+        dstWrite.descriptorType = vk::DescriptorType::eStorageImage;
+        dstWrite.pImageInfo = &dstInfos[mip];
+        writes.push_back(dstWrite);
+    }
+    device->updateDescriptorSets(writes, nullptr);
+}
+
+void GpuCullingPass::updateCullDescriptors(uint32_t frameIndex)
+{
+    FrameResources& frame = frames[frameIndex % AppConfig::MAX_FRAMES_IN_FLIGHT];
+    vk::DescriptorSet set = (*cullDescriptorSets)[frameIndex % AppConfig::MAX_FRAMES_IN_FLIGHT];
+
+    vk::DescriptorBufferInfo paramsInfo{};
+    paramsInfo.buffer = *frame.paramsBuffer;
+    paramsInfo.offset = 0;
+    paramsInfo.range = sizeof(CullParams);
+
+    // Draw data is owned by FrameManager and recreated with the swapchain.
+    vk::DescriptorBufferInfo drawDataInfo{};
+    drawDataInfo.buffer = frameManager->getDrawDataBuffer(frameIndex);
+    drawDataInfo.offset = 0;
+    drawDataInfo.range = VK_WHOLE_SIZE;
+
+    vk::DescriptorBufferInfo instancesInfo{};
+    instancesInfo.buffer = *drawInstanceBuffer;
+    instancesInfo.offset = 0;
+    instancesInfo.range = VK_WHOLE_SIZE;
+
+    vk::DescriptorBufferInfo outCommandsInfo{};
+    outCommandsInfo.buffer = *frame.culledCommandBuffer;
+    outCommandsInfo.offset = 0;
+    outCommandsInfo.range = VK_WHOLE_SIZE;
+
+    vk::DescriptorBufferInfo countsInfo{};
+    countsInfo.buffer = *frame.countBuffer;
+    countsInfo.offset = 0;
+    countsInfo.range = VK_WHOLE_SIZE;
+
+    vk::DescriptorImageInfo hizInfo{};
+    hizInfo.imageLayout = vk::ImageLayout::eGeneral;
+    hizInfo.imageView = *hizView;
+    hizInfo.sampler = *hizSampler;
+
+    std::array<vk::WriteDescriptorSet, 6> writes{};
+    const std::array<const vk::DescriptorBufferInfo*, 5> bufferInfos = {
+        &paramsInfo, &drawDataInfo, &instancesInfo, &outCommandsInfo, &countsInfo};
+    for (uint32_t binding = 0; binding < bufferInfos.size(); ++binding) {
+        writes[binding] = vk::WriteDescriptorSet{};
+        writes[binding].dstSet = set;
+        writes[binding].dstBinding = binding;
+        writes[binding].descriptorCount = 1;
+        writes[binding].descriptorType = (binding == 0) ? vk::DescriptorType::eUniformBuffer : vk::DescriptorType::eStorageBuffer;
+        writes[binding].pBufferInfo = bufferInfos[binding];
+    }
+
+    writes[5] = vk::WriteDescriptorSet{};
+    writes[5].dstSet = set;
+    writes[5].dstBinding = 5;
+    writes[5].descriptorCount = 1;
+    writes[5].descriptorType = vk::DescriptorType::eCombinedImageSampler;
+    writes[5].pImageInfo = &hizInfo;
+
+    device->updateDescriptorSets(writes, nullptr);
+}
+
+void GpuCullingPass::readBackStats(FrameResources& frame, RenderStats* stats)
+{
+    if (!frame.hasPendingReadback || !frame.countReadbackMapped) {
+        return;
+    }
+    frame.hasPendingReadback = false;
+    if (!stats) {
+        return;
+    }
+
+    const auto* counts = static_cast<const uint32_t*>(frame.countReadbackMapped);
+    uint64_t visible = 0;
+    for (uint32_t i = 0; i < frame.submittedBucketCount; ++i) {
+        visible += counts[i];
+    }
+    stats->gpuCullInputDraws = frame.submittedInstanceCount;
+    stats->gpuCullVisibleDraws = visible;
+    stats->gpuCullFrustumCulled = counts[frame.submittedBucketCount];
+    stats->gpuCullOcclusionCulled = counts[frame.submittedBucketCount + 1u];
+}
+
+void GpuCullingPass::uploadDrawInstances(const GlobalMeshBuffer& globalMeshBuffer)
+{
+    const auto& slots = frameManager->getSharedOpaqueSlots();
+    const auto& spans = frameManager->getSharedOpaqueSlotSpans();
+    const auto& meshInfos = globalMeshBuffer.getMeshInfos();
+    const auto& cpuMeshes = model->getMeshes();
+
+    std::vector<DrawInstance> instances(std::min(static_cast<uint32_t>(slots.size()), maxDraws));
+    for (uint32_t spanIndex = 0; spanIndex < spans.size(); ++spanIndex) {
+        const auto& span = spans[spanIndex];
+        const uint32_t end = std::min(span.firstCommand + span.drawCount, static_cast<uint32_t>(instances.size()));
+        for (uint32_t drawId = span.firstCommand; drawId < end; ++drawId) {
+            const uint32_t meshIndex = slots[drawId].meshIndex;
+            DrawInstance& instance = instances[drawId];
+            if (meshIndex < cpuMeshes.size() && cpuMeshes[meshIndex].hasBounds) {
+                const BoundingBox& bounds = cpuMeshes[meshIndex].bounds;
+                instance.boundsMin = glm::vec4(bounds.min, 1.0f);
+                instance.boundsMax = glm::vec4(bounds.max, 0.0f);
+            }
+            if (meshIndex < meshInfos.size()) {
+                const MeshDrawInfo& info = meshInfos[meshIndex];
+                instance.indexCount = info.indexCount;
+                instance.firstIndex = info.firstIndex;
+                instance.vertexOffset = static_cast<int32_t>(info.vertexOffset);
+            }
+            instance.bucketIndex = spanIndex;
+            instance.bucketFirstCommand = span.firstCommand;
+        }
+    }
+
+    drawInstanceBuffer.reset();
+    drawInstanceMemory.reset();
+    drawInstanceCount = static_cast<uint32_t>(instances.size());
+    drawBucketCount = static_cast<uint32_t>(spans.size());
+    if (instances.empty()) {
+        return;
+    }
+
+    const vk::DeviceSize size = static_cast<vk::DeviceSize>(instances.size()) * sizeof(DrawInstance);
+    BufferAllocation alloc = resourceCreator->createBuffer(
+        size, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eDeviceLocal);
+    UploadManager& uploader = resourceCreator->getUploader();
+    uploader.wait(uploader.uploadBuffer(*alloc.buffer, 0, instances.data(), size));
+    drawInstanceBuffer = std::move(alloc.buffer);
+    drawInstanceMemory = std::move(alloc.memory);
+}
+
+void GpuCullingPass::buildHiz(vk::raii::CommandBuffer& cb)
+{
+    const vk::Image depthImage = frameManager->getDepthResolveImage();
+    if (!depthImage || !hizImage || !hizDescriptorSets) {
+        return;
+    }
+
+    // depth_resolve is in DepthStencilReadOnlyOptimal here: the Rendergraph transitions it from the declared input.
+
+    // Previous frame's cull dispatch read the pyramid; the rebuild overwrites every mip.
+    vk::ImageMemoryBarrier hizBarrier{};
+    hizBarrier.oldLayout = vk::ImageLayout::eGeneral;
+    hizBarrier.newLayout = vk::ImageLayout::eGeneral;
+    hizBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hizBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hizBarrier.image = *hizImage;
+    hizBarrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+    hizBarrier.subresourceRange.baseMipLevel = 0;
+    hizBarrier.subresourceRange.levelCount = hizMipCount;
+    hizBarrier.subresourceRange.baseArrayLayer = 0;
+    hizBarrier.subresourceRange.layerCount = 1;
+    hizBarrier.srcAccessMask = vk::AccessFlagBits::eShaderRead;
+    hizBarrier.dstAccessMask = vk::AccessFlagBits::eShaderWrite;
+
+    cb.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eComputeShader,
+                       {}, {}, {}, hizBarrier);
+
+    cb.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline->getHizBuildPipeline());
+    uint32_t srcWidth = hizSourceExtent.width;
+    uint32_t srcHeight = hizSourceExtent.height;
+    for (uint32_t mip = 0; mip < hizMipCount; ++mip) {
+        const uint32_t dstWidth = std::max(1u, hizExtent.width >> mip);
+        const uint32_t dstHeight = std::max(1u, hizExtent.height >> mip);
+
+        vk::DescriptorSet set = (*hizDescriptorSets)[mip];
+        cb.bindDescriptorSets(vk::PipelineBindPoint::eCompute, pipeline->getHizPipelineLayout(), 0, {set}, nullptr);
+        PushParams push{};
+        push.srcWidth = srcWidth;
+        push.srcHeight = srcHeight;
+        push.dstWidth = dstWidth;
+        push.dstHeight = dstHeight;
+        cb.pushConstants<PushParams>(pipeline->getHizPipelineLayout(), vk::ShaderStageFlagBits::eCompute, 0, push);
+        cb.dispatch(divUp(dstWidth, 8u), divUp(dstHeight, 8u), 1);
+
+        vk::ImageMemoryBarrier mipBarrier{};
+        mipBarrier.oldLayout = vk::ImageLayout::eGeneral;
+        mipBarrier.newLayout = vk::ImageLayout::eGeneral;
+        mipBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        mipBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        mipBarrier.image = *hizImage;
+        mipBarrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+        mipBarrier.subresourceRange.baseMipLevel = mip;
+        mipBarrier.subresourceRange.levelCount = 1;
+        mipBarrier.subresourceRange.baseArrayLayer = 0;
+        mipBarrier.subresourceRange.layerCount = 1;
+        mipBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
+        mipBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+        cb.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eComputeShader,
+                           {}, {}, {}, mipBarrier);
+
+        srcWidth = dstWidth;
+        srcHeight = dstHeight;
+    }
+}
@@ -1,34 +1,37 @@
 #include "Rendering/pass/OcclusionCullingPass.h"
 
-#include "Engine/Math/Frustum.h"
+#include "Configs/RuntimeConfig.h"
 #include "Rendering/RHI/Vulkan/VulkanTypes.h"
 
 #include <array>
 #include <glm/gtc/matrix_transform.hpp>
 
-OcclusionCullingPass::OcclusionCullingPass(OcclusionPipeline& inPipeline, FrameManager& inFrameManager, Model& inModel, Rendergraph& inRendergraph)
+OcclusionCullingPass::OcclusionCullingPass(OcclusionPipeline& inPipeline, FrameManager& inFrameManager,
+                                           OcclusionVisibilityBuffer& inVisibility, Rendergraph& inRendergraph)
     : RenderPass("OcclusionPass", {"depth"}, {"depth"})
     , pipeline(&inPipeline)
     , frameManager(&inFrameManager)
-    , model(&inModel)
+    , visibility(&inVisibility)
     , rendergraph(&inRendergraph)
 {
 }
 
 void OcclusionCullingPass::beginPass(const PassExecuteContext& ctx)
 {
-    vk::raii::CommandBuffer& cb = ctx.commandBuffer;
+    const uint32_t frameIndex = frameManager->getCurrentFrame();
+    const vk::QueryPool qp = visibility->getQueryPool(frameIndex);
+    const uint32_t queryCount = static_cast<uint32_t>(visibility->getQueries(frameIndex).size());
 
-    if (!ctx.enableOcclusionQueries) {
+    activeThisFrame = RuntimeConfig::enableOcclusionCulling && pipeline->getPipeline() && qp && queryCount > 0;
+    if (!activeThisFrame) {
+        visibility->discardQueries(frameIndex);
         return;
     }
 
-    // Reset queries for this frame before recording any beginQuery.
-    const vk::QueryPool qp = frameManager->getOcclusionQueryPool(frameManager->getCurrentFrame());
-    const uint32_t queryCount = frameManager->getOcclusionQueryCount();
-    if (qp && queryCount > 0) {
-        cb.resetQueryPool(qp, 0, queryCount);
-    }
+    vk::raii::CommandBuffer& cb = ctx.commandBuffer;
+
+    // One batched reset for the whole slot (outside rendering); the CPU already harvested its previous results.
+    cb.resetQueryPool(qp, 0, queryCount);
 
     vk::ImageView depthImageView = rendergraph->GetImageView("depth");
 
@@ -50,7 +53,7 @@ void OcclusionCullingPass::beginPass(const PassExecuteContext& ctx)
 
 void OcclusionCullingPass::render(const PassExecuteContext& ctx)
 {
-    if (!ctx.enableOcclusionQueries) {
+    if (!activeThisFrame) {
         return;
     }
     vk::raii::CommandBuffer& cb = ctx.commandBuffer;
@@ -69,82 +72,44 @@ void OcclusionCullingPass::render(const PassExecuteContext& ctx)
     scissor.extent = frameManager->getSwapChainExtent();
     cb.setScissor(0, scissor);
 
-    if (!pipeline || !frameManager || !model) {
-        return;
-    }
-
-    const vk::QueryPool qp = frameManager->getOcclusionQueryPool(frameManager->getCurrentFrame());
-    const uint32_t queryCount = frameManager->getOcclusionQueryCount();
-    if (!qp || queryCount == 0) {
-        return;
-    }
+    const uint32_t frameIndex = frameManager->getCurrentFrame();
+    const vk::QueryPool qp = visibility->getQueryPool(frameIndex);
 
     cb.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline->getPipeline());
 
     // Bind any valid descriptor set: UBO is required for view/proj; textures unused.
-    vk::DescriptorSet descriptorSet = frameManager->getDescriptorSet(frameManager->getCurrentFrame(), 0);
+    vk::DescriptorSet descriptorSet = frameManager->getDescriptorSet(frameIndex, 0);
     cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, frameManager->getPipelineLayout(), 0, descriptorSet, nullptr);
 
-    const Frustum* frustum = ctx.frustum;
-
-    auto renderNodes = [&](auto&& self, const std::vector<Node*>& nodes, const glm::mat4& parentWorld) -> void {
-        for (Node* node : nodes) {
-            if (!node) continue;
-            if (!node->hasSubtreeBounds) {
-                if (!node->children.empty()) {
-                    self(self, node->children, parentWorld * node->getLocalMatrix());
-                }
-                continue;
-            }
-
-            const glm::mat4 worldFromNode = parentWorld * node->getLocalMatrix();
-            BoundingBox worldBounds = node->subtreeBounds;
-            worldBounds.Transform(worldFromNode);
-
-            if (frustum && !frustum->Intersects(worldBounds)) {
-                continue;
-            }
-
-            const uint32_t qIndex = frameManager->getOcclusionQueryIndex(node->linearIndex);
-            const bool shouldQuery = (qIndex != UINT32_MAX) && (qIndex < queryCount);
-            if (shouldQuery) {
-                const glm::vec3 center = 0.5f * (worldBounds.min + worldBounds.max);
-                const glm::vec3 halfExt = 0.5f * (worldBounds.max - worldBounds.min);
-                const glm::mat4 boxModel = glm::translate(glm::mat4(1.0f), center) * glm::scale(glm::mat4(1.0f), halfExt);
-
-                cb.beginQuery(qp, qIndex, vk::QueryControlFlags{});
-
-                PBRPushConstants pc{};
-                pc.model = boxModel;
-                const std::array<PBRPushConstants, 1> pcs = {pc};
-                cb.pushConstants<PBRPushConstants>(
-                    frameManager->getPipelineLayout(),
-                    vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
-                    0,
-                    pcs);
-
-                cb.draw(36, 1, 0, 0);
-                if (ctx.stats) {
-                    ctx.stats->occlusionDrawCalls++;
-                    ctx.stats->occlusionQueriedNodes++;
-                }
-                cb.endQuery(qp, qIndex);
-            }
-
-            if (!node->children.empty()) {
-                self(self, node->children, worldFromNode);
-            }
-        }
-    };
-
-    renderNodes(renderNodes, model->getRootNodes(), ctx.modelMatrix);
+    // Every planned query must be recorded: the CPU harvests [0, count) of this slot frames-in-flight frames later.
+    const auto& queries = visibility->getQueries(frameIndex);
+    for (uint32_t qIndex = 0; qIndex < static_cast<uint32_t>(queries.size()); ++qIndex) {
+        const auto& query = queries[qIndex];
+        const glm::mat4 boxModel = glm::translate(glm::mat4(1.0f), query.center) * glm::scale(glm::mat4(1.0f), query.halfExtent);
+
+        cb.beginQuery(qp, qIndex, vk::QueryControlFlags{});
+
+        PBRPushConstants pc{};
+        pc.model = boxModel;
+        const std::array<PBRPushConstants, 1> pcs = {pc};
+        cb.pushConstants<PBRPushConstants>(
+            frameManager->getPipelineLayout(),
+            vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
+            0,
+            pcs);
+
+        cb.draw(36, 1, 0, 0);
+        cb.endQuery(qp, qIndex);
+    }
+    if (ctx.stats) {
+        ctx.stats->occlusionDrawCalls += queries.size();
+    }
 }
 
 void OcclusionCullingPass::endPass(const PassExecuteContext& ctx)
 {
-    if (!ctx.enableOcclusionQueries) {
+    if (!activeThisFrame) {
         return;
     }
     ctx.commandBuffer.endRendering();
 }
-
@@ -1,9 +1,11 @@
 #include "Rendering/pass/RtaoComputePass.h"
 
 #include "Configs/AppConfig.h"
+#include "Rendering/core/GpuProfiler.h"
 
 #include <algorithm>
 #include <array>
+#include <string>
 #include <vector>
 
 namespace {
@@ -14,7 +16,7 @@ uint32_t divUp(uint32_t x, uint32_t y)
 }
 
 RtaoComputePass::RtaoComputePass(vk::raii::Device& inDevice, RtaoComputePipeline& inPipeline, FrameManager& inFrameManager, RayTracingContext& inRayTracingContext)
-    : RenderPass("RtaoComputePass", {"depth"}, {"rtao_full"})
+    : RenderPass("RtaoComputePass", {"depth_resolve", "normal_resolve", "linear_depth_resolve"}, {"rtao_full"})
     , device(&inDevice)
     , pipeline(&inPipeline)
     , frameManager(&inFrameManager)
@@ -24,79 +26,20 @@ RtaoComputePass::RtaoComputePass(vk::raii::Device& inDevice, RtaoComputePipeline
     createDescriptorSets();
 }
 
-void RtaoComputePass::beginPass(const PassExecuteContext& ctx)
+std::optional<vk::ImageLayout> RtaoComputePass::getRequiredInputLayout(const std::string& resource) const
 {
-    vk::Image depthImage = frameManager->getDepthResolveImage();
-    if (!depthImage) return;
-
-    vk::ImageMemoryBarrier barrier{};
-    barrier.oldLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
-    barrier.newLayout = vk::ImageLayout::eDepthStencilReadOnlyOptimal;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = depthImage;
-    barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eDepth;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
-    barrier.srcAccessMask = vk::AccessFlagBits::eDepthStencilAttachmentWrite;
-    barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
-    ctx.commandBuffer.pipelineBarrier(
-        vk::PipelineStageFlagBits::eLateFragmentTests,
-        vk::PipelineStageFlagBits::eComputeShader,
-        {},
-        {},
-        {},
-        barrier);
-
-    vk::Image normalImage = frameManager->getNormalResolveImage();
-    if (!normalImage) return;
-
-    vk::ImageMemoryBarrier normalBarrier{};
-    normalBarrier.oldLayout = vk::ImageLayout::eColorAttachmentOptimal;
-    normalBarrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-    normalBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    normalBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    normalBarrier.image = normalImage;
-    normalBarrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
-    normalBarrier.subresourceRange.baseMipLevel = 0;
-    normalBarrier.subresourceRange.levelCount = 1;
-    normalBarrier.subresourceRange.baseArrayLayer = 0;
-    normalBarrier.subresourceRange.layerCount = 1;
-    normalBarrier.srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite;
-    normalBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
-    ctx.commandBuffer.pipelineBarrier(
-        vk::PipelineStageFlagBits::eColorAttachmentOutput,
-        vk::PipelineStageFlagBits::eComputeShader,
-        {},
-        {},
-        {},
-        normalBarrier);
-
-    vk::Image linearDepthImage = frameManager->getLinearDepthResolveImage();
-    if (!linearDepthImage) return;
-
-    vk::ImageMemoryBarrier linearDepthBarrier{};
-    linearDepthBarrier.oldLayout = vk::ImageLayout::eColorAttachmentOptimal;
-    linearDepthBarrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-    linearDepthBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    linearDepthBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    linearDepthBarrier.image = linearDepthImage;
-    linearDepthBarrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
-    linearDepthBarrier.subresourceRange.baseMipLevel = 0;
-    linearDepthBarrier.subresourceRange.levelCount = 1;
-    linearDepthBarrier.subresourceRange.baseArrayLayer = 0;
-    linearDepthBarrier.subresourceRange.layerCount = 1;
-    linearDepthBarrier.srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite;
-    linearDepthBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
-    ctx.commandBuffer.pipelineBarrier(
-        vk::PipelineStageFlagBits::eColorAttachmentOutput,
-        vk::PipelineStageFlagBits::eComputeShader,
-        {},
-        {},
-        {},
-        linearDepthBarrier);
+    if (resource == "depth_resolve") {
+        return vk::ImageLayout::eDepthStencilReadOnlyOptimal;
+    }
+    if (resource == "normal_resolve" || resource == "linear_depth_resolve") {
+        return vk::ImageLayout::eShaderReadOnlyOptimal;
+    }
+    return std::nullopt;
+}
+
+void RtaoComputePass::beginPass(const PassExecuteContext& /*ctx*/)
+{
+    // Resolve targets and rtao_full are transitioned by the Rendergraph from the declared inputs/outputs.
 }
 
 void RtaoComputePass::render(const PassExecuteContext& ctx)
@@ -109,7 +52,10 @@ void RtaoComputePass::render(const PassExecuteContext& ctx)
     updateDescriptorsForFrame(frameIdx);
 
     vk::raii::CommandBuffer& cb = ctx.commandBuffer;
-    dispatchTrace(cb, frameIdx);
+    {
+        GpuProfileScope traceScope(ctx.profiler, cb, "RtaoComputePass/trace");
+        dispatchTrace(cb, frameIdx);
+    }
 
     // trace -> atrous read barrier
     {
@@ -118,7 +64,7 @@ void RtaoComputePass::render(const PassExecuteContext& ctx)
         barrier.newLayout = vk::ImageLayout::eGeneral;
         barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image = frameManager->getRtaoHalfHistoryImageForFrame(frameIdx, false);
+        barrier.image = frameManager->getRtaoHalfHistoryImage(false);
         barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
         barrier.subresourceRange.baseMipLevel = 0;
         barrier.subresourceRange.levelCount = 1;
@@ -129,7 +75,7 @@ void RtaoComputePass::render(const PassExecuteContext& ctx)
         cb.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eComputeShader, {}, {}, {}, barrier);
     }
 
-    dispatchAtrous(cb, frameIdx);
+    dispatchAtrous(cb, frameIdx, ctx.profiler);
 
     const uint32_t atrousIterations = std::max(1u, AppConfig::ENABLE_RTAO_SPATIAL_DENOISE ? AppConfig::RTAO_ATROUS_ITERATIONS : 1u);
     const uint32_t finalAtrousIndex = ((atrousIterations - 1u) % 2u == 0u) ? 0u : 1u;
@@ -152,106 +98,12 @@ void RtaoComputePass::render(const PassExecuteContext& ctx)
         cb.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eComputeShader, {}, {}, {}, barrier);
     }
 
+    GpuProfileScope upsampleScope(ctx.profiler, cb, "RtaoComputePass/upsample");
     dispatchUpsample(cb, frameIdx);
 }
 
-void RtaoComputePass::endPass(const PassExecuteContext& ctx)
+void RtaoComputePass::endPass(const PassExecuteContext& /*ctx*/)
 {
-    vk::Image fullImage = frameManager->getRtaoFullImage();
-    if (fullImage) {
-        vk::ImageMemoryBarrier fullBarrier{};
-        fullBarrier.oldLayout = vk::ImageLayout::eGeneral;
-        fullBarrier.newLayout = vk::ImageLayout::eGeneral;
-        fullBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        fullBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        fullBarrier.image = fullImage;
-        fullBarrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
-        fullBarrier.subresourceRange.baseMipLevel = 0;
-        fullBarrier.subresourceRange.levelCount = 1;
-        fullBarrier.subresourceRange.baseArrayLayer = 0;
-        fullBarrier.subresourceRange.layerCount = 1;
-        fullBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
-        fullBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
-        ctx.commandBuffer.pipelineBarrier(
-            vk::PipelineStageFlagBits::eComputeShader,
-            vk::PipelineStageFlagBits::eFragmentShader,
-            {},
-            {},
-            {},
-            fullBarrier);
-    }
-
-    vk::Image depthImage = frameManager->getDepthResolveImage();
-    if (depthImage) {
-        vk::ImageMemoryBarrier depthBarrier{};
-        depthBarrier.oldLayout = vk::ImageLayout::eDepthStencilReadOnlyOptimal;
-        depthBarrier.newLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
-        depthBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        depthBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        depthBarrier.image = depthImage;
-        depthBarrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eDepth;
-        depthBarrier.subresourceRange.baseMipLevel = 0;
-        depthBarrier.subresourceRange.levelCount = 1;
-        depthBarrier.subresourceRange.baseArrayLayer = 0;
-        depthBarrier.subresourceRange.layerCount = 1;
-        depthBarrier.srcAccessMask = vk::AccessFlagBits::eShaderRead;
-        depthBarrier.dstAccessMask = vk::AccessFlagBits::eDepthStencilAttachmentWrite;
-        ctx.commandBuffer.pipelineBarrier(
-            vk::PipelineStageFlagBits::eComputeShader,
-            vk::PipelineStageFlagBits::eEarlyFragmentTests,
-            {},
-            {},
-            {},
-            depthBarrier);
-    }
-
-    vk::Image normalImage = frameManager->getNormalResolveImage();
-    if (normalImage) {
-        vk::ImageMemoryBarrier normalBarrier{};
-        normalBarrier.oldLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-        normalBarrier.newLayout = vk::ImageLayout::eColorAttachmentOptimal;
-        normalBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        normalBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        normalBarrier.image = normalImage;
-        normalBarrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
-        normalBarrier.subresourceRange.baseMipLevel = 0;
-        normalBarrier.subresourceRange.levelCount = 1;
-        normalBarrier.subresourceRange.baseArrayLayer = 0;
-        normalBarrier.subresourceRange.layerCount = 1;
-        normalBarrier.srcAccessMask = vk::AccessFlagBits::eShaderRead;
-        normalBarrier.dstAccessMask = vk::AccessFlagBits::eColorAttachmentWrite;
-        ctx.commandBuffer.pipelineBarrier(
-            vk::PipelineStageFlagBits::eComputeShader,
-            vk::PipelineStageFlagBits::eColorAttachmentOutput,
-            {},
-            {},
-            {},
-            normalBarrier);
-    }
-
-    vk::Image linearDepthImage = frameManager->getLinearDepthResolveImage();
-    if (linearDepthImage) {
-        vk::ImageMemoryBarrier linearDepthBarrier{};
-        linearDepthBarrier.oldLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-        linearDepthBarrier.newLayout = vk::ImageLayout::eColorAttachmentOptimal;
-        linearDepthBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        linearDepthBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        linearDepthBarrier.image = linearDepthImage;
-        linearDepthBarrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
-        linearDepthBarrier.subresourceRange.baseMipLevel = 0;
-        linearDepthBarrier.subresourceRange.levelCount = 1;
-        linearDepthBarrier.subresourceRange.baseArrayLayer = 0;
-        linearDepthBarrier.subresourceRange.layerCount = 1;
-        linearDepthBarrier.srcAccessMask = vk::AccessFlagBits::eShaderRead;
-        linearDepthBarrier.dstAccessMask = vk::AccessFlagBits::eColorAttachmentWrite;
-        ctx.commandBuffer.pipelineBarrier(
-            vk::PipelineStageFlagBits::eComputeShader,
-            vk::PipelineStageFlagBits::eColorAttachmentOutput,
-            {},
-            {},
-            {},
-            linearDepthBarrier);
-    }
 }
 
 void RtaoComputePass::createDescriptorPool()
@@ -329,17 +181,17 @@ void RtaoComputePass::updateDescriptorsForFrame(uint32_t frameIndex)
 
     vk::DescriptorImageInfo historyIn{};
     historyIn.imageLayout = vk::ImageLayout::eGeneral;
-    historyIn.imageView = frameManager->getRtaoHalfHistoryImageViewForFrame(frameIndex, true);
+    historyIn.imageView = frameManager->getRtaoHalfHistoryImageView(true);
     historyIn.sampler = frameManager->getRtaoHalfHistorySampler();
 
     vk::DescriptorImageInfo historyOut{};
     historyOut.imageLayout = vk::ImageLayout::eGeneral;
-    historyOut.imageView = frameManager->getRtaoHalfHistoryImageViewForFrame(frameIndex, false);
+    historyOut.imageView = frameManager->getRtaoHalfHistoryImageView(false);
     historyOut.sampler = VK_NULL_HANDLE;
 
     vk::DescriptorImageInfo historyCurrSampled{};
     historyCurrSampled.imageLayout = vk::ImageLayout::eGeneral;
-    historyCurrSampled.imageView = frameManager->getRtaoHalfHistoryImageViewForFrame(frameIndex, false);
+    historyCurrSampled.imageView = frameManager->getRtaoHalfHistoryImageView(false);
     historyCurrSampled.sampler = frameManager->getRtaoHalfHistorySampler();
 
     vk::DescriptorImageInfo ping0Sampled{};
@@ -516,7 +368,7 @@ void RtaoComputePass::dispatchTrace(vk::raii::CommandBuffer& cb, uint32_t frameI
     cb.dispatch(divUp(halfWidth, 8u), divUp(halfHeight, 8u), 1);
 }
 
-void RtaoComputePass::dispatchAtrous(vk::raii::CommandBuffer& cb, uint32_t frameIndex)
+void RtaoComputePass::dispatchAtrous(vk::raii::CommandBuffer& cb, uint32_t frameIndex, GpuProfiler* profiler)
 {
     const vk::Extent2D extent = frameManager->getSwapChainExtent();
     const uint32_t halfWidth = extent.width;
@@ -528,6 +380,7 @@ void RtaoComputePass::dispatchAtrous(vk::raii::CommandBuffer& cb, uint32_t frame
 
     const uint32_t iterations = std::max(1u, AppConfig::ENABLE_RTAO_SPATIAL_DENOISE ? AppConfig::RTAO_ATROUS_ITERATIONS : 1u);
     for (uint32_t i = 0; i < iterations; ++i) {
+        GpuProfileScope iterationScope(profiler, cb, "RtaoComputePass/atrous" + std::to_string(i));
         PushParams push{};
         push.width = halfWidth;
         push.height = halfHeight;
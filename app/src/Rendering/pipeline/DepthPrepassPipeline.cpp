@@ -4,11 +4,13 @@
 
 #include <array>
 
-void DepthPrepassPipeline::init(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                                const GraphicsPipeline& basePipeline, Shader& vertShader, Shader& fragShader)
+void DepthPrepassPipeline::init(VulkanContext& context, VulkanResourceCreator& resourceCreator, const GraphicsPipeline& basePipeline,
+                                Shader& vertShader, Shader& fragShader, PipelineBuilder& builder)
 {
-    createPipelines(context.getDevice(), swapChain, resourceCreator, context.getMsaaSamples(), basePipeline.getPipelineLayout(),
-                    vertShader, fragShader);
+    pipelineCache = &resourceCreator.getPipelineCache();
+    depthFormat = resourceCreator.findDepthFormat();
+    msaaSamples = context.getMsaaSamples();
+    enqueuePipelines(basePipeline.getPipelineLayout(), vertShader, fragShader, builder);
 }
 
 void DepthPrepassPipeline::cleanup()
@@ -18,21 +20,35 @@ void DepthPrepassPipeline::cleanup()
     }
 }
 
-void DepthPrepassPipeline::recreate(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                                    const GraphicsPipeline& basePipeline, Shader& vertShader, Shader& fragShader)
+void DepthPrepassPipeline::recreate(VulkanContext& context, VulkanResourceCreator& resourceCreator, const GraphicsPipeline& basePipeline,
+                                    Shader& vertShader, Shader& fragShader, PipelineBuilder& builder)
 {
+    const vk::Format newDepthFormat = resourceCreator.findDepthFormat();
+    const vk::SampleCountFlagBits newMsaaSamples = context.getMsaaSamples();
+    if (pipelines[0] && newDepthFormat == depthFormat && newMsaaSamples == msaaSamples) {
+        return;
+    }
+
     for (auto& p : pipelines) {
         p.reset();
     }
-    createPipelines(context.getDevice(), swapChain, resourceCreator, context.getMsaaSamples(), basePipeline.getPipelineLayout(),
-                    vertShader, fragShader);
+    depthFormat = newDepthFormat;
+    msaaSamples = newMsaaSamples;
+    enqueuePipelines(basePipeline.getPipelineLayout(), vertShader, fragShader, builder);
 }
 
-void DepthPrepassPipeline::createPipelines(vk::raii::Device& device, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                                          vk::SampleCountFlagBits msaaSamples, vk::PipelineLayout pipelineLayout,
-                                          Shader& vertShader, Shader& fragShader)
+void DepthPrepassPipeline::enqueuePipelines(vk::PipelineLayout pipelineLayout, Shader& vertShader, Shader& fragShader,
+                                            PipelineBuilder& builder)
+{
+    for (const bool doubleSided : {false, true}) {
+        builder.enqueue([this, doubleSided, pipelineLayout, &vertShader, &fragShader]() {
+            createPipeline(doubleSided, pipelineLayout, vertShader, fragShader);
+        });
+    }
+}
+
+void DepthPrepassPipeline::createPipeline(bool doubleSided, vk::PipelineLayout pipelineLayout, Shader& vertShader, Shader& fragShader)
 {
-    depthFormat = resourceCreator.findDepthFormat();
     const vk::Format normalFormat = vk::Format::eR16G16B16A16Sfloat;
     const vk::Format linearDepthFormat = vk::Format::eR16Sfloat;
 
@@ -60,35 +76,23 @@ void DepthPrepassPipeline::createPipelines(vk::raii::Device& device, SwapChain&
     inputAssembly.topology = vk::PrimitiveTopology::eTriangleList;
     inputAssembly.primitiveRestartEnable = VK_FALSE;
 
-    vk::Viewport viewport{};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = static_cast<float>(swapChain.getExtent().width);
-    viewport.height = static_cast<float>(swapChain.getExtent().height);
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-
-    vk::Rect2D scissor{};
-    scissor.offset = vk::Offset2D{0, 0};
-    scissor.extent = swapChain.getExtent();
-
     std::vector<vk::DynamicState> dynamicStates = {vk::DynamicState::eViewport, vk::DynamicState::eScissor};
     vk::PipelineDynamicStateCreateInfo dynamicState{};
     dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
     dynamicState.pDynamicStates = dynamicStates.data();
 
+    // Viewport and scissor are dynamic.
     vk::PipelineViewportStateCreateInfo viewportState{};
     viewportState.viewportCount = 1;
-    viewportState.pViewports = &viewport;
     viewportState.scissorCount = 1;
-    viewportState.pScissors = &scissor;
 
     vk::PipelineRasterizationStateCreateInfo rasterizer{};
     rasterizer.depthClampEnable = VK_FALSE;
     rasterizer.rasterizerDiscardEnable = VK_FALSE;
     rasterizer.polygonMode = vk::PolygonMode::eFill;
     rasterizer.lineWidth = 1.0f;
-    rasterizer.cullMode = vk::CullModeFlagBits::eBack;
+    // Double-sided (no cull) matches the forward pass for doubleSided materials.
+    rasterizer.cullMode = doubleSided ? vk::CullModeFlagBits::eNone : vk::CullModeFlagBits::eBack;
     rasterizer.frontFace = vk::FrontFace::eCounterClockwise;
     rasterizer.depthBiasEnable = VK_FALSE;
 
@@ -137,12 +141,5 @@ void DepthPrepassPipeline::createPipelines(vk::raii::Device& device, SwapChain&
     pipelineInfo.renderPass = VK_NULL_HANDLE;
     pipelineInfo.subpass = 0;
 
-    // Variant 0: single-sided (backface cull)
-    rasterizer.cullMode = vk::CullModeFlagBits::eBack;
-    pipelines[0] = vk::raii::Pipeline(device, nullptr, pipelineInfo);
-
-    // Variant 1: double-sided (no cull) to match forward pass for doubleSided materials.
-    rasterizer.cullMode = vk::CullModeFlagBits::eNone;
-    pipelines[1] = vk::raii::Pipeline(device, nullptr, pipelineInfo);
+    pipelines[doubleSided ? 1u : 0u] = pipelineCache->createGraphicsPipeline(pipelineInfo);
 }
-
@@ -0,0 +1,38 @@
+#include "Rendering/pipeline/GpuCullingPipeline.h"
+
+#include "Rendering/RHI/Vulkan/VulkanContext.h"
+#include "Rendering/pipeline/PipelineBuilder.h"
+#include "Resource/shader/Shader.h"
+
+void GpuCullingPipeline::init(VulkanContext& context, Shader& hizBuildShader, Shader& cullShader, PipelineBuilder& builder)
+{
+    initLayouts(context.getDevice());
+    enqueuePipelines(context.getPipelineCache(), hizBuildShader, cullShader, builder);
+}
+
+void GpuCullingPipeline::recreate(VulkanContext& context, Shader& hizBuildShader, Shader& cullShader, PipelineBuilder& builder)
+{
+    cleanup();
+    init(context, hizBuildShader, cullShader, builder);
+}
+
+void GpuCullingPipeline::enqueuePipelines(PipelineCache& pipelineCache, Shader& hizBuildShader, Shader& cullShader, PipelineBuilder& builder)
+{
+    auto enqueueOne = [&](std::optional<vk::raii::Pipeline>& target, Shader& shader, const vk::raii::PipelineLayout& layoutRaii) {
+        const vk::PipelineLayout layout = static_cast<vk::PipelineLayout>(*layoutRaii);
+        builder.enqueue([&pipelineCache, &target, &shader, layout]() {
+            vk::PipelineShaderStageCreateInfo stageInfo{};
+            stageInfo.stage = shader.getStage();
+            stageInfo.module = shader.getShaderModule();
+            stageInfo.pName = "main";
+
+            vk::ComputePipelineCreateInfo pipelineInfo{};
+            pipelineInfo.stage = stageInfo;
+            pipelineInfo.layout = layout;
+            target = pipelineCache.createComputePipeline(pipelineInfo);
+        });
+    };
+
+    enqueueOne(hizBuildPipeline, hizBuildShader, *hizPipelineLayout);
+    enqueueOne(cullPipeline, cullShader, *cullPipelineLayout);
+}
@@ -0,0 +1,65 @@
+#include "Rendering/pipeline/GpuCullingPipeline.h"
+
+#include <array>
+
+void GpuCullingPipeline::initLayouts(vk::raii::Device& device)
+{
+    createDescriptorSetLayouts(device);
+    createPipelineLayouts(device);
+}
+
+void GpuCullingPipeline::cleanup()
+{
+    hizBuildPipeline.reset();
+    cullPipeline.reset();
+    hizPipelineLayout.reset();
+    cullPipelineLayout.reset();
+    hizDescriptorSetLayout.reset();
+    cullDescriptorSetLayout.reset();
+}
+
+void GpuCullingPipeline::createDescriptorSetLayouts(vk::raii::Device& device)
+{
+    std::array<vk::DescriptorSetLayoutBinding, 2> hizBindings{};
+    hizBindings[0] = vk::DescriptorSetLayoutBinding{0, vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eCompute, nullptr}; // source (depth resolve or previous mip)
+    hizBindings[1] = vk::DescriptorSetLayoutBinding{1, vk::DescriptorType::eStorageImage, 1, vk::ShaderStageFlagBits::eCompute, nullptr};         // destination mip
+
+    vk::DescriptorSetLayoutCreateInfo hizLayoutInfo{};
+    hizLayoutInfo.bindingCount = static_cast<uint32_t>(hizBindings.size());
+    hizLayoutInfo.pBindings = hizBindings.data();
+    hizDescriptorSetLayout = vk::raii::DescriptorSetLayout(device, hizLayoutInfo);
+
+    std::array<vk::DescriptorSetLayoutBinding, 6> cullBindings{};
+    cullBindings[0] = vk::DescriptorSetLayoutBinding{0, vk::DescriptorType::eUniformBuffer, 1, vk::ShaderStageFlagBits::eCompute, nullptr};         // cull params
+    cullBindings[1] = vk::DescriptorSetLayoutBinding{1, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute, nullptr};         // draw data (mat4 per drawId)
+    cullBindings[2] = vk::DescriptorSetLayoutBinding{2, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute, nullptr};         // persistent draw instances (mesh draw + bounds + bucket)
+    cullBindings[3] = vk::DescriptorSetLayoutBinding{3, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute, nullptr};         // generated output commands
+    cullBindings[4] = vk::DescriptorSetLayoutBinding{4, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute, nullptr};         // per-bucket draw counts
+    cullBindings[5] = vk::DescriptorSetLayoutBinding{5, vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eCompute, nullptr}; // Hi-Z pyramid
+
+    vk::DescriptorSetLayoutCreateInfo cullLayoutInfo{};
+    cullLayoutInfo.bindingCount = static_cast<uint32_t>(cullBindings.size());
+    cullLayoutInfo.pBindings = cullBindings.data();
+    cullDescriptorSetLayout = vk::raii::DescriptorSetLayout(device, cullLayoutInfo);
+}
+
+void GpuCullingPipeline::createPipelineLayouts(vk::raii::Device& device)
+{
+    vk::PushConstantRange pushRange{};
+    pushRange.stageFlags = vk::ShaderStageFlagBits::eCompute;
+    pushRange.offset = 0;
+    pushRange.size = sizeof(uint32_t) * 4;
+
+    auto createOne = [&](const vk::raii::DescriptorSetLayout& setLayoutRaii) -> vk::raii::PipelineLayout {
+        vk::PipelineLayoutCreateInfo layoutInfo{};
+        vk::DescriptorSetLayout setLayout = static_cast<vk::DescriptorSetLayout>(*setLayoutRaii);
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &setLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushRange;
+        return vk::raii::PipelineLayout(device, layoutInfo);
+    };
+
+    hizPipelineLayout = createOne(*hizDescriptorSetLayout);
+    cullPipelineLayout = createOne(*cullDescriptorSetLayout);
+}
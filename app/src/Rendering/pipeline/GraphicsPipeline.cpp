@@ -1,6 +1,7 @@
 #include "Rendering/pipeline/GraphicsPipeline.h"
 
 #include <array>
+#include <vector>
 
 #include "Configs/AppConfig.h"
 #include "Resource/model/Vertex.h"
@@ -15,11 +16,17 @@ uint32_t pipelineVariantIndex(bool enableBlend, bool doubleSided)
 }
 } // namespace
 
-void GraphicsPipeline::init(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                            Shader& vertShader, Shader& fragShader, vk::Format targetColorFormat)
+void GraphicsPipeline::init(VulkanContext& context, VulkanResourceCreator& resourceCreator, Shader& vertShader, Shader& fragShader,
+                            vk::Format targetColorFormat, PipelineBuilder& builder)
 {
-    createDescriptorSetLayout(context.getDevice());
-    createGraphicsPipeline(context.getDevice(), swapChain, resourceCreator, context.getMsaaSamples(), vertShader, fragShader, targetColorFormat);
+    pipelineCache = &resourceCreator.getPipelineCache();
+    colorFormat = targetColorFormat;
+    depthFormat = resourceCreator.findDepthFormat();
+    msaaSamples = context.getMsaaSamples();
+
+    createDescriptorSetLayout(context.getDevice(), context.supportsRayQuery());
+    createPipelineLayout(context.getDevice());
+    enqueuePipelines(vertShader, fragShader, builder);
 }
 
 void GraphicsPipeline::cleanup()
@@ -31,17 +38,22 @@ void GraphicsPipeline::cleanup()
     descriptorSetLayout.reset();
 }
 
-void GraphicsPipeline::recreate(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                                Shader& vertShader, Shader& fragShader, vk::Format targetColorFormat)
+void GraphicsPipeline::recreate(VulkanContext& context, VulkanResourceCreator& resourceCreator, Shader& vertShader, Shader& fragShader,
+                                vk::Format targetColorFormat, PipelineBuilder& builder)
 {
+    const vk::Format newDepthFormat = resourceCreator.findDepthFormat();
+    const vk::SampleCountFlagBits newMsaaSamples = context.getMsaaSamples();
+    if (pipelines[0] && targetColorFormat == colorFormat && newDepthFormat == depthFormat && newMsaaSamples == msaaSamples) {
+        return;
+    }
+
     for (auto& p : pipelines) {
         p.reset();
     }
-    pipelineLayout.reset();
-    descriptorSetLayout.reset();
-
-    createDescriptorSetLayout(context.getDevice());
-    createGraphicsPipeline(context.getDevice(), swapChain, resourceCreator, context.getMsaaSamples(), vertShader, fragShader, targetColorFormat);
+    colorFormat = targetColorFormat;
+    depthFormat = newDepthFormat;
+    msaaSamples = newMsaaSamples;
+    enqueuePipelines(vertShader, fragShader, builder);
 }
 
 vk::Pipeline GraphicsPipeline::getPipeline(bool enableBlend, bool doubleSided) const
@@ -53,7 +65,7 @@ vk::Pipeline GraphicsPipeline::getPipeline(bool enableBlend, bool doubleSided) c
     return static_cast<vk::Pipeline>(*pipelines[idx]);
 }
 
-void GraphicsPipeline::createDescriptorSetLayout(vk::raii::Device& device)
+void GraphicsPipeline::createDescriptorSetLayout(vk::raii::Device& device, bool withAccelerationStructure)
 {
     vk::DescriptorSetLayoutBinding uboLayoutBinding{};
     uboLayoutBinding.binding = 0;
@@ -117,7 +129,7 @@ void GraphicsPipeline::createDescriptorSetLayout(vk::raii::Device& device)
     vk::DescriptorSetLayoutBinding brdfLutBinding = makeSamplerBinding(14);
     vk::DescriptorSetLayoutBinding rtaoFullBinding = makeSamplerBinding(15);
 
-    std::array<vk::DescriptorSetLayoutBinding, 16> bindings = {
+    std::vector<vk::DescriptorSetLayoutBinding> bindings = {
         uboLayoutBinding,
         baseColorBinding,
         metallicRoughnessBinding,
@@ -134,6 +146,9 @@ void GraphicsPipeline::createDescriptorSetLayout(vk::raii::Device& device)
         prefilterBinding,
         brdfLutBinding,
         rtaoFullBinding};
+    if (!withAccelerationStructure) {
+        bindings.erase(bindings.begin() + 6);
+    }
 
     vk::DescriptorSetLayoutCreateInfo layoutInfo{};
     layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
@@ -142,12 +157,36 @@ void GraphicsPipeline::createDescriptorSetLayout(vk::raii::Device& device)
     descriptorSetLayout = vk::raii::DescriptorSetLayout(device, layoutInfo);
 }
 
-void GraphicsPipeline::createGraphicsPipeline(vk::raii::Device& device, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                                             vk::SampleCountFlagBits msaaSamples, Shader& vertShader, Shader& fragShader,
-                                             vk::Format targetColorFormat)
+
+void GraphicsPipeline::createPipelineLayout(vk::raii::Device& device)
 {
-    colorFormat = targetColorFormat;
-    depthFormat = resourceCreator.findDepthFormat();
+    vk::PipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.setLayoutCount = 1;
+    vk::DescriptorSetLayout layoutHandle = *descriptorSetLayout;
+    pipelineLayoutInfo.pSetLayouts = &layoutHandle;
+
+    vk::PushConstantRange pushRange{};
+    pushRange.stageFlags = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment;
+    pushRange.offset = 0;
+    pushRange.size = sizeof(PBRPushConstants);
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushRange;
+
+    pipelineLayout = vk::raii::PipelineLayout(device, pipelineLayoutInfo);
+}
+
+void GraphicsPipeline::enqueuePipelines(Shader& vertShader, Shader& fragShader, PipelineBuilder& builder)
+{
+    // 4 variants (opaque/blend) x (cull/double-sided), one build each.
+    for (uint32_t idx = 0; idx < pipelines.size(); ++idx) {
+        builder.enqueue([this, idx, &vertShader, &fragShader]() { createGraphicsPipeline(idx, vertShader, fragShader); });
+    }
+}
+
+void GraphicsPipeline::createGraphicsPipeline(uint32_t variantIndex, Shader& vertShader, Shader& fragShader)
+{
+    const bool enableBlend = (variantIndex & 0b10u) != 0;
+    const bool doubleSided = (variantIndex & 0b01u) != 0;
 
     vk::PipelineShaderStageCreateInfo vertShaderStageInfo{};
     vertShaderStageInfo.stage = vertShader.getStage();
@@ -173,36 +212,22 @@ void GraphicsPipeline::createGraphicsPipeline(vk::raii::Device& device, SwapChai
     inputAssembly.topology = vk::PrimitiveTopology::eTriangleList;
     inputAssembly.primitiveRestartEnable = VK_FALSE;
 
-    vk::Extent2D swapChainExtent = swapChain.getExtent();
-    vk::Viewport viewport{};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = static_cast<float>(swapChainExtent.width);
-    viewport.height = static_cast<float>(swapChainExtent.height);
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-
-    vk::Rect2D scissor{};
-    scissor.offset = vk::Offset2D{0, 0};
-    scissor.extent = swapChainExtent;
-
     std::vector<vk::DynamicState> dynamicStates = {vk::DynamicState::eViewport, vk::DynamicState::eScissor};
     vk::PipelineDynamicStateCreateInfo dynamicState{};
     dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
     dynamicState.pDynamicStates = dynamicStates.data();
 
+    // Viewport and scissor are dynamic: the pipeline does not depend on the swapchain extent.
     vk::PipelineViewportStateCreateInfo viewportState{};
     viewportState.viewportCount = 1;
-    viewportState.pViewports = &viewport;
     viewportState.scissorCount = 1;
-    viewportState.pScissors = &scissor;
 
     vk::PipelineRasterizationStateCreateInfo rasterizer{};
     rasterizer.depthClampEnable = VK_FALSE;
     rasterizer.rasterizerDiscardEnable = VK_FALSE;
     rasterizer.polygonMode = vk::PolygonMode::eFill;
     rasterizer.lineWidth = 1.0f;
-    rasterizer.cullMode = vk::CullModeFlagBits::eBack;
+    rasterizer.cullMode = doubleSided ? vk::CullModeFlagBits::eNone : vk::CullModeFlagBits::eBack;
     rasterizer.frontFace = vk::FrontFace::eCounterClockwise;
     rasterizer.depthBiasEnable = VK_FALSE;
 
@@ -221,30 +246,25 @@ void GraphicsPipeline::createGraphicsPipeline(vk::raii::Device& device, SwapChai
     vk::PipelineColorBlendAttachmentState colorBlendAttachment{};
     colorBlendAttachment.colorWriteMask = vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG
         | vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA;
-    colorBlendAttachment.blendEnable = VK_FALSE;
+    colorBlendAttachment.blendEnable = enableBlend ? VK_TRUE : VK_FALSE;
+    if (enableBlend) {
+        // Premultiplied alpha blending: output.rgb is already multiplied by alpha in shader.
+        colorBlendAttachment.srcColorBlendFactor = vk::BlendFactor::eOne;
+        colorBlendAttachment.dstColorBlendFactor = vk::BlendFactor::eOneMinusSrcAlpha;
+        colorBlendAttachment.colorBlendOp = vk::BlendOp::eAdd;
+        colorBlendAttachment.srcAlphaBlendFactor = vk::BlendFactor::eOne;
+        colorBlendAttachment.dstAlphaBlendFactor = vk::BlendFactor::eZero;
+        colorBlendAttachment.alphaBlendOp = vk::BlendOp::eAdd;
+    }
 
     vk::PipelineColorBlendStateCreateInfo colorBlendState{};
     colorBlendState.logicOpEnable = VK_FALSE;
     colorBlendState.attachmentCount = 1;
     colorBlendState.pAttachments = &colorBlendAttachment;
 
-    vk::PipelineLayoutCreateInfo pipelineLayoutInfo{};
-    pipelineLayoutInfo.setLayoutCount = 1;
-    vk::DescriptorSetLayout layoutHandle = *descriptorSetLayout;
-    pipelineLayoutInfo.pSetLayouts = &layoutHandle;
-
-    vk::PushConstantRange pushRange{};
-    pushRange.stageFlags = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment;
-    pushRange.offset = 0;
-    pushRange.size = sizeof(PBRPushConstants);
-    pipelineLayoutInfo.pushConstantRangeCount = 1;
-    pipelineLayoutInfo.pPushConstantRanges = &pushRange;
-
-    pipelineLayout = vk::raii::PipelineLayout(device, pipelineLayoutInfo);
-
     vk::PipelineDepthStencilStateCreateInfo depthStencilState{};
     depthStencilState.depthTestEnable = VK_TRUE;
-    depthStencilState.depthWriteEnable = VK_TRUE;
+    depthStencilState.depthWriteEnable = enableBlend ? VK_FALSE : VK_TRUE;
     // This project uses a depth prepass. Using Less would reject equal-depth fragments in the forward pass.
     depthStencilState.depthCompareOp = vk::CompareOp::eLessOrEqual;
     depthStencilState.depthBoundsTestEnable = VK_FALSE;
@@ -271,29 +291,5 @@ void GraphicsPipeline::createGraphicsPipeline(vk::raii::Device& device, SwapChai
     pipelineInfo.renderPass = VK_NULL_HANDLE;
     pipelineInfo.subpass = 0;
 
-    // Create 4 variants (opaque/blend) x (cull/double-sided).
-    for (uint32_t idx = 0; idx < pipelines.size(); ++idx) {
-        const bool enableBlend = (idx & 0b10u) != 0;
-        const bool doubleSided = (idx & 0b01u) != 0;
-
-        rasterizer.cullMode = doubleSided ? vk::CullModeFlagBits::eNone : vk::CullModeFlagBits::eBack;
-
-        if (enableBlend) {
-            colorBlendAttachment.blendEnable = VK_TRUE;
-            // Premultiplied alpha blending: output.rgb is already multiplied by alpha in shader.
-            colorBlendAttachment.srcColorBlendFactor = vk::BlendFactor::eOne;
-            colorBlendAttachment.dstColorBlendFactor = vk::BlendFactor::eOneMinusSrcAlpha;
-            colorBlendAttachment.colorBlendOp = vk::BlendOp::eAdd;
-            colorBlendAttachment.srcAlphaBlendFactor = vk::BlendFactor::eOne;
-            colorBlendAttachment.dstAlphaBlendFactor = vk::BlendFactor::eZero;
-            colorBlendAttachment.alphaBlendOp = vk::BlendOp::eAdd;
-            depthStencilState.depthWriteEnable = VK_FALSE;
-        } else {
-            colorBlendAttachment.blendEnable = VK_FALSE;
-            depthStencilState.depthWriteEnable = VK_TRUE;
-        }
-
-        pipelines[idx] = vk::raii::Pipeline(device, nullptr, pipelineInfo);
-    }
+    pipelines[variantIndex] = pipelineCache->createGraphicsPipeline(pipelineInfo);
 }
-
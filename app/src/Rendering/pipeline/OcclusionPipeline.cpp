@@ -2,11 +2,13 @@
 
 #include <array>
 
-void OcclusionPipeline::init(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                            const GraphicsPipeline& basePipeline, Shader& vertShader, Shader& fragShader)
+void OcclusionPipeline::init(VulkanContext& context, VulkanResourceCreator& resourceCreator, const GraphicsPipeline& basePipeline,
+                            Shader& vertShader, PipelineBuilder& builder)
 {
-    createPipeline(context.getDevice(), swapChain, resourceCreator, context.getMsaaSamples(), basePipeline.getPipelineLayout(),
-                   vertShader, fragShader);
+    pipelineCache = &resourceCreator.getPipelineCache();
+    depthFormat = resourceCreator.findDepthFormat();
+    msaaSamples = context.getMsaaSamples();
+    enqueuePipeline(basePipeline.getPipelineLayout(), vertShader, builder);
 }
 
 void OcclusionPipeline::cleanup()
@@ -14,31 +16,35 @@ void OcclusionPipeline::cleanup()
     pipeline.reset();
 }
 
-void OcclusionPipeline::recreate(VulkanContext& context, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                                const GraphicsPipeline& basePipeline, Shader& vertShader, Shader& fragShader)
+void OcclusionPipeline::recreate(VulkanContext& context, VulkanResourceCreator& resourceCreator, const GraphicsPipeline& basePipeline,
+                                Shader& vertShader, PipelineBuilder& builder)
 {
+    const vk::Format newDepthFormat = resourceCreator.findDepthFormat();
+    const vk::SampleCountFlagBits newMsaaSamples = context.getMsaaSamples();
+    if (pipeline && newDepthFormat == depthFormat && newMsaaSamples == msaaSamples) {
+        return;
+    }
+
     pipeline.reset();
-    createPipeline(context.getDevice(), swapChain, resourceCreator, context.getMsaaSamples(), basePipeline.getPipelineLayout(),
-                   vertShader, fragShader);
+    depthFormat = newDepthFormat;
+    msaaSamples = newMsaaSamples;
+    enqueuePipeline(basePipeline.getPipelineLayout(), vertShader, builder);
 }
 
-void OcclusionPipeline::createPipeline(vk::raii::Device& device, SwapChain& swapChain, VulkanResourceCreator& resourceCreator,
-                                      vk::SampleCountFlagBits msaaSamples, vk::PipelineLayout pipelineLayout,
-                                      Shader& vertShader, Shader& fragShader)
+void OcclusionPipeline::enqueuePipeline(vk::PipelineLayout pipelineLayout, Shader& vertShader, PipelineBuilder& builder)
 {
-    depthFormat = resourceCreator.findDepthFormat();
+    builder.enqueue([this, pipelineLayout, &vertShader]() { createPipeline(pipelineLayout, vertShader); });
+}
 
+void OcclusionPipeline::createPipeline(vk::PipelineLayout pipelineLayout, Shader& vertShader)
+{
     vk::PipelineShaderStageCreateInfo vertShaderStageInfo{};
     vertShaderStageInfo.stage = vertShader.getStage();
     vertShaderStageInfo.module = vertShader.getShaderModule();
     vertShaderStageInfo.pName = "main";
 
-    vk::PipelineShaderStageCreateInfo fragShaderStageInfo{};
-    fragShaderStageInfo.stage = fragShader.getStage();
-    fragShaderStageInfo.module = fragShader.getShaderModule();
-    fragShaderStageInfo.pName = "main";
-
-    std::array<vk::PipelineShaderStageCreateInfo, 2> shaderStages = {vertShaderStageInfo, fragShaderStageInfo};
+    // No fragment stage: the query only counts samples passing the depth test.
+    std::array<vk::PipelineShaderStageCreateInfo, 1> shaderStages = {vertShaderStageInfo};
 
     vk::PipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.vertexBindingDescriptionCount = 0;
@@ -50,28 +56,15 @@ void OcclusionPipeline::createPipeline(vk::raii::Device& device, SwapChain& swap
     inputAssembly.topology = vk::PrimitiveTopology::eTriangleList;
     inputAssembly.primitiveRestartEnable = VK_FALSE;
 
-    vk::Viewport viewport{};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = static_cast<float>(swapChain.getExtent().width);
-    viewport.height = static_cast<float>(swapChain.getExtent().height);
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-
-    vk::Rect2D scissor{};
-    scissor.offset = vk::Offset2D{0, 0};
-    scissor.extent = swapChain.getExtent();
-
     std::vector<vk::DynamicState> dynamicStates = {vk::DynamicState::eViewport, vk::DynamicState::eScissor};
     vk::PipelineDynamicStateCreateInfo dynamicState{};
     dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
     dynamicState.pDynamicStates = dynamicStates.data();
 
+    // Viewport and scissor are dynamic.
     vk::PipelineViewportStateCreateInfo viewportState{};
     viewportState.viewportCount = 1;
-    viewportState.pViewports = &viewport;
     viewportState.scissorCount = 1;
-    viewportState.pScissors = &scissor;
 
     vk::PipelineRasterizationStateCreateInfo rasterizer{};
     rasterizer.depthClampEnable = VK_FALSE;
@@ -119,6 +112,6 @@ void OcclusionPipeline::createPipeline(vk::raii::Device& device, SwapChain& swap
     pipelineInfo.renderPass = VK_NULL_HANDLE;
     pipelineInfo.subpass = 0;
 
-    pipeline = vk::raii::Pipeline(device, nullptr, pipelineInfo);
+    pipeline = pipelineCache->createGraphicsPipeline(pipelineInfo);
 }
 
@@ -0,0 +1,52 @@
+#include "Rendering/pipeline/PipelineBuilder.h"
+
+#include "Configs/AppConfig.h"
+#include "Engine/Profiling/Trace.h"
+
+#include <chrono>
+#include <utility>
+
+PipelineBuilder::~PipelineBuilder()
+{
+    JobSystem::get().wait(counter);
+}
+
+void PipelineBuilder::enqueue(Build build)
+{
+    ++buildCount;
+    if (!AppConfig::ENABLE_PARALLEL_PIPELINE_BUILD) {
+        run(build);
+        return;
+    }
+    JobSystem::get().submit([this, build = std::move(build)]() { run(build); }, &counter);
+}
+
+void PipelineBuilder::wait()
+{
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    JobSystem::get().wait(counter);
+    waitMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        error = std::exchange(firstError, nullptr);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void PipelineBuilder::run(const Build& build)
+{
+    TRACE_SCOPE("PipelineBuild");
+    // Jobs must not throw: park the exception for wait().
+    try {
+        build();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!firstError) {
+            firstError = std::current_exception();
+        }
+    }
+}
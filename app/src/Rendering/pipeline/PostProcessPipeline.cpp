@@ -4,21 +4,35 @@
 
 void PostProcessPipeline::init(VulkanContext& context, VulkanResourceCreator& resourceCreator, vk::Format hdrColorFormat, vk::Format swapchainColorFormat,
                                Shader& fullscreenVertShader, Shader& bloomExtractFragShader, Shader& bloomBlurFragShader,
-                               Shader& tonemapBloomFragShader)
+                               Shader& tonemapBloomFragShader, PipelineBuilder& builder)
 {
     (void)resourceCreator;
+    pipelineCache = &context.getPipelineCache();
     createDescriptorSetLayout(context.getDevice());
-    createPipelines(context.getDevice(), hdrColorFormat, swapchainColorFormat, fullscreenVertShader, bloomExtractFragShader, bloomBlurFragShader, tonemapBloomFragShader);
+    enqueuePipeline(Mode::Extract, hdrColorFormat, fullscreenVertShader, bloomExtractFragShader, builder);
+    enqueuePipeline(Mode::Blur, hdrColorFormat, fullscreenVertShader, bloomBlurFragShader, builder);
+    enqueuePipeline(Mode::Tonemap, swapchainColorFormat, fullscreenVertShader, tonemapBloomFragShader, builder);
 }
 
 void PostProcessPipeline::recreate(VulkanContext& context, VulkanResourceCreator& resourceCreator, vk::Format hdrColorFormat, vk::Format swapchainColorFormat,
                                    Shader& fullscreenVertShader, Shader& bloomExtractFragShader, Shader& bloomBlurFragShader,
-                                   Shader& tonemapBloomFragShader)
+                                   Shader& tonemapBloomFragShader, PipelineBuilder& builder)
 {
+    (void)context;
     (void)resourceCreator;
-    cleanup();
-    createDescriptorSetLayout(context.getDevice());
-    createPipelines(context.getDevice(), hdrColorFormat, swapchainColorFormat, fullscreenVertShader, bloomExtractFragShader, bloomBlurFragShader, tonemapBloomFragShader);
+    auto needsRebuild = [&](Mode mode, vk::Format colorFormat) {
+        const size_t idx = static_cast<size_t>(mode);
+        return !pipelines[idx] || pipelineFormats[idx] != colorFormat;
+    };
+    if (needsRebuild(Mode::Extract, hdrColorFormat)) {
+        enqueuePipeline(Mode::Extract, hdrColorFormat, fullscreenVertShader, bloomExtractFragShader, builder);
+    }
+    if (needsRebuild(Mode::Blur, hdrColorFormat)) {
+        enqueuePipeline(Mode::Blur, hdrColorFormat, fullscreenVertShader, bloomBlurFragShader, builder);
+    }
+    if (needsRebuild(Mode::Tonemap, swapchainColorFormat)) {
+        enqueuePipeline(Mode::Tonemap, swapchainColorFormat, fullscreenVertShader, tonemapBloomFragShader, builder);
+    }
 }
 
 void PostProcessPipeline::cleanup()
@@ -70,76 +84,77 @@ void PostProcessPipeline::createDescriptorSetLayout(vk::raii::Device& device)
     pipelineLayout = vk::raii::PipelineLayout(device, pipelineLayoutInfo);
 }
 
-void PostProcessPipeline::createPipelines(vk::raii::Device& device, vk::Format hdrColorFormat, vk::Format swapchainColorFormat, Shader& fullscreenVertShader,
-                                          Shader& bloomExtractFragShader, Shader& bloomBlurFragShader, Shader& tonemapBloomFragShader)
+void PostProcessPipeline::enqueuePipeline(Mode mode, vk::Format colorFormat, Shader& vertShader, Shader& fragShader,
+                                          PipelineBuilder& builder)
 {
-    auto createPipelineForFrag = [&](Shader& fragShader, vk::Format colorFormat) -> vk::raii::Pipeline {
-        vk::PipelineShaderStageCreateInfo vertStage{};
-        vertStage.stage = fullscreenVertShader.getStage();
-        vertStage.module = fullscreenVertShader.getShaderModule();
-        vertStage.pName = "main";
-
-        vk::PipelineShaderStageCreateInfo fragStage{};
-        fragStage.stage = fragShader.getStage();
-        fragStage.module = fragShader.getShaderModule();
-        fragStage.pName = "main";
-
-        std::array<vk::PipelineShaderStageCreateInfo, 2> stages = {vertStage, fragStage};
-
-        vk::PipelineVertexInputStateCreateInfo vertexInput{};
-        vk::PipelineInputAssemblyStateCreateInfo inputAssembly{};
-        inputAssembly.topology = vk::PrimitiveTopology::eTriangleList;
-
-        vk::PipelineViewportStateCreateInfo viewportState{};
-        viewportState.viewportCount = 1;
-        viewportState.scissorCount = 1;
-
-        vk::PipelineRasterizationStateCreateInfo rasterizer{};
-        rasterizer.polygonMode = vk::PolygonMode::eFill;
-        // Fullscreen triangle: avoid winding issues under Vulkan viewport conventions.
-        rasterizer.cullMode = vk::CullModeFlagBits::eNone;
-        rasterizer.frontFace = vk::FrontFace::eCounterClockwise;
-        rasterizer.lineWidth = 1.0f;
-
-        vk::PipelineMultisampleStateCreateInfo multisample{};
-        multisample.rasterizationSamples = vk::SampleCountFlagBits::e1;
-
-        vk::PipelineColorBlendAttachmentState colorBlendAttachment{};
-        colorBlendAttachment.colorWriteMask = vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
-                                              vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA;
-        colorBlendAttachment.blendEnable = VK_FALSE;
-
-        vk::PipelineColorBlendStateCreateInfo colorBlend{};
-        colorBlend.attachmentCount = 1;
-        colorBlend.pAttachments = &colorBlendAttachment;
-
-        std::array<vk::DynamicState, 2> dynamicStates = {vk::DynamicState::eViewport, vk::DynamicState::eScissor};
-        vk::PipelineDynamicStateCreateInfo dynamicState{};
-        dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
-        dynamicState.pDynamicStates = dynamicStates.data();
-
-        vk::PipelineRenderingCreateInfoKHR renderingInfo{};
-        renderingInfo.colorAttachmentCount = 1;
-        renderingInfo.pColorAttachmentFormats = &colorFormat;
-
-        vk::GraphicsPipelineCreateInfo pipelineInfo{};
-        pipelineInfo.pNext = &renderingInfo;
-        pipelineInfo.stageCount = static_cast<uint32_t>(stages.size());
-        pipelineInfo.pStages = stages.data();
-        pipelineInfo.pVertexInputState = &vertexInput;
-        pipelineInfo.pInputAssemblyState = &inputAssembly;
-        pipelineInfo.pViewportState = &viewportState;
-        pipelineInfo.pRasterizationState = &rasterizer;
-        pipelineInfo.pMultisampleState = &multisample;
-        pipelineInfo.pColorBlendState = &colorBlend;
-        pipelineInfo.pDynamicState = &dynamicState;
-        pipelineInfo.layout = static_cast<vk::PipelineLayout>(*pipelineLayout);
-
-        return vk::raii::Pipeline(device, nullptr, pipelineInfo);
-    };
-
-    pipelines[static_cast<size_t>(Mode::Extract)] = createPipelineForFrag(bloomExtractFragShader, hdrColorFormat);
-    pipelines[static_cast<size_t>(Mode::Blur)] = createPipelineForFrag(bloomBlurFragShader, hdrColorFormat);
-    pipelines[static_cast<size_t>(Mode::Tonemap)] = createPipelineForFrag(tonemapBloomFragShader, swapchainColorFormat);
+    const size_t idx = static_cast<size_t>(mode);
+    pipelines[idx].reset();
+    pipelineFormats[idx] = colorFormat;
+    builder.enqueue([this, mode, colorFormat, &vertShader, &fragShader]() { createPipeline(mode, colorFormat, vertShader, fragShader); });
 }
 
+void PostProcessPipeline::createPipeline(Mode mode, vk::Format colorFormat, Shader& vertShader, Shader& fragShader)
+{
+    vk::PipelineShaderStageCreateInfo vertStage{};
+    vertStage.stage = vertShader.getStage();
+    vertStage.module = vertShader.getShaderModule();
+    vertStage.pName = "main";
+
+    vk::PipelineShaderStageCreateInfo fragStage{};
+    fragStage.stage = fragShader.getStage();
+    fragStage.module = fragShader.getShaderModule();
+    fragStage.pName = "main";
+
+    std::array<vk::PipelineShaderStageCreateInfo, 2> stages = {vertStage, fragStage};
+
+    vk::PipelineVertexInputStateCreateInfo vertexInput{};
+    vk::PipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.topology = vk::PrimitiveTopology::eTriangleList;
+
+    vk::PipelineViewportStateCreateInfo viewportState{};
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    vk::PipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.polygonMode = vk::PolygonMode::eFill;
+    // Fullscreen triangle: avoid winding issues under Vulkan viewport conventions.
+    rasterizer.cullMode = vk::CullModeFlagBits::eNone;
+    rasterizer.frontFace = vk::FrontFace::eCounterClockwise;
+    rasterizer.lineWidth = 1.0f;
+
+    vk::PipelineMultisampleStateCreateInfo multisample{};
+    multisample.rasterizationSamples = vk::SampleCountFlagBits::e1;
+
+    vk::PipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask = vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
+                                          vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA;
+    colorBlendAttachment.blendEnable = VK_FALSE;
+
+    vk::PipelineColorBlendStateCreateInfo colorBlend{};
+    colorBlend.attachmentCount = 1;
+    colorBlend.pAttachments = &colorBlendAttachment;
+
+    std::array<vk::DynamicState, 2> dynamicStates = {vk::DynamicState::eViewport, vk::DynamicState::eScissor};
+    vk::PipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+    dynamicState.pDynamicStates = dynamicStates.data();
+
+    vk::PipelineRenderingCreateInfoKHR renderingInfo{};
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachmentFormats = &colorFormat;
+
+    vk::GraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.pNext = &renderingInfo;
+    pipelineInfo.stageCount = static_cast<uint32_t>(stages.size());
+    pipelineInfo.pStages = stages.data();
+    pipelineInfo.pVertexInputState = &vertexInput;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState = &multisample;
+    pipelineInfo.pColorBlendState = &colorBlend;
+    pipelineInfo.pDynamicState = &dynamicState;
+    pipelineInfo.layout = static_cast<vk::PipelineLayout>(*pipelineLayout);
+
+    pipelines[static_cast<size_t>(mode)] = pipelineCache->createGraphicsPipeline(pipelineInfo);
+}
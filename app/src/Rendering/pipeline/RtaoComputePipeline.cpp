@@ -4,12 +4,12 @@
 
 #include <array>
 
-void RtaoComputePipeline::init(VulkanContext& context, Shader& traceShader, Shader& atrousShader, Shader& upsampleShader)
+void RtaoComputePipeline::init(VulkanContext& context, Shader& traceShader, Shader& atrousShader, Shader& upsampleShader, PipelineBuilder& builder)
 {
     vk::raii::Device& device = context.getDevice();
     createDescriptorSetLayout(device);
     createPipelineLayout(device);
-    createPipelines(device, traceShader, atrousShader, upsampleShader);
+    enqueuePipelines(context.getPipelineCache(), traceShader, atrousShader, upsampleShader, builder);
 }
 
 void RtaoComputePipeline::cleanup()
@@ -21,10 +21,10 @@ void RtaoComputePipeline::cleanup()
     descriptorSetLayout.reset();
 }
 
-void RtaoComputePipeline::recreate(VulkanContext& context, Shader& traceShader, Shader& atrousShader, Shader& upsampleShader)
+void RtaoComputePipeline::recreate(VulkanContext& context, Shader& traceShader, Shader& atrousShader, Shader& upsampleShader, PipelineBuilder& builder)
 {
     cleanup();
-    init(context, traceShader, atrousShader, upsampleShader);
+    init(context, traceShader, atrousShader, upsampleShader, builder);
 }
 
 void RtaoComputePipeline::createDescriptorSetLayout(vk::raii::Device& device)
@@ -74,22 +74,24 @@ void RtaoComputePipeline::createPipelineLayout(vk::raii::Device& device)
     pipelineLayout = vk::raii::PipelineLayout(device, layoutInfo);
 }
 
-void RtaoComputePipeline::createPipelines(vk::raii::Device& device, Shader& traceShader, Shader& atrousShader, Shader& upsampleShader)
+void RtaoComputePipeline::enqueuePipelines(PipelineCache& pipelineCache, Shader& traceShader, Shader& atrousShader, Shader& upsampleShader, PipelineBuilder& builder)
 {
-    auto createOne = [&](Shader& shader) -> vk::raii::Pipeline {
-        vk::PipelineShaderStageCreateInfo stageInfo{};
-        stageInfo.stage = shader.getStage();
-        stageInfo.module = shader.getShaderModule();
-        stageInfo.pName = "main";
+    const vk::PipelineLayout layout = static_cast<vk::PipelineLayout>(*pipelineLayout);
+    auto enqueueOne = [&](std::optional<vk::raii::Pipeline>& target, Shader& shader) {
+        builder.enqueue([&pipelineCache, &target, &shader, layout]() {
+            vk::PipelineShaderStageCreateInfo stageInfo{};
+            stageInfo.stage = shader.getStage();
+            stageInfo.module = shader.getShaderModule();
+            stageInfo.pName = "main";
 
-        vk::ComputePipelineCreateInfo pipelineInfo{};
-        pipelineInfo.stage = stageInfo;
-        pipelineInfo.layout = static_cast<vk::PipelineLayout>(*pipelineLayout);
-        return vk::raii::Pipeline(device, nullptr, pipelineInfo);
+            vk::ComputePipelineCreateInfo pipelineInfo{};
+            pipelineInfo.stage = stageInfo;
+            pipelineInfo.layout = layout;
+            target = pipelineCache.createComputePipeline(pipelineInfo);
+        });
     };
 
-    tracePipeline = createOne(traceShader);
-    atrousPipeline = createOne(atrousShader);
-    upsamplePipeline = createOne(upsampleShader);
+    enqueueOne(tracePipeline, traceShader);
+    enqueueOne(atrousPipeline, atrousShader);
+    enqueueOne(upsamplePipeline, upsampleShader);
 }
-
@@ -2,10 +2,14 @@
 #include "Resource/shader/Shader.h"
 
 void SkyboxPipeline::init(vk::raii::Device& device, VulkanResourceCreator& resourceCreator, vk::Format colorFormat, vk::Format depthFormat,
-                          vk::SampleCountFlagBits msaaSamples, Shader& vertShader, Shader& fragShader)
+                          vk::SampleCountFlagBits msaaSamples, Shader& vertShader, Shader& fragShader, PipelineBuilder& builder)
 {
     createDescriptorSetLayout(device);
-    createPipeline(device, resourceCreator, colorFormat, depthFormat, msaaSamples, vertShader, fragShader);
+    createPipelineLayout(device);
+    PipelineCache* pipelineCache = &resourceCreator.getPipelineCache();
+    builder.enqueue([this, pipelineCache, colorFormat, depthFormat, msaaSamples, &vertShader, &fragShader]() {
+        createPipeline(*pipelineCache, colorFormat, depthFormat, msaaSamples, vertShader, fragShader);
+    });
 }
 
 void SkyboxPipeline::cleanup()
@@ -36,11 +40,18 @@ void SkyboxPipeline::createDescriptorSetLayout(vk::raii::Device& device)
     descriptorSetLayout = vk::raii::DescriptorSetLayout(device, layoutInfo);
 }
 
-void SkyboxPipeline::createPipeline(vk::raii::Device& device, VulkanResourceCreator& resourceCreator, vk::Format colorFormat, vk::Format depthFormat,
-                                    vk::SampleCountFlagBits msaaSamples, Shader& vertShader, Shader& fragShader)
+void SkyboxPipeline::createPipelineLayout(vk::raii::Device& device)
 {
-    (void)resourceCreator;
+    vk::PipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.setLayoutCount = 1;
+    vk::DescriptorSetLayout layoutHandle = *descriptorSetLayout;
+    layoutInfo.pSetLayouts = &layoutHandle;
+    pipelineLayout = vk::raii::PipelineLayout(device, layoutInfo);
+}
 
+void SkyboxPipeline::createPipeline(PipelineCache& pipelineCache, vk::Format colorFormat, vk::Format depthFormat,
+                                    vk::SampleCountFlagBits msaaSamples, Shader& vertShader, Shader& fragShader)
+{
     vk::PipelineShaderStageCreateInfo vertStage{};
     vertStage.stage = vk::ShaderStageFlagBits::eVertex;
     vertStage.module = vertShader.getShaderModule();
@@ -106,12 +117,6 @@ void SkyboxPipeline::createPipeline(vk::raii::Device& device, VulkanResourceCrea
     depthStencil.depthBoundsTestEnable = VK_FALSE;
     depthStencil.stencilTestEnable = VK_FALSE;
 
-    vk::PipelineLayoutCreateInfo layoutInfo{};
-    layoutInfo.setLayoutCount = 1;
-    vk::DescriptorSetLayout layoutHandle = *descriptorSetLayout;
-    layoutInfo.pSetLayouts = &layoutHandle;
-    pipelineLayout = vk::raii::PipelineLayout(device, layoutInfo);
-
     vk::PipelineRenderingCreateInfoKHR renderingInfo{};
     renderingInfo.colorAttachmentCount = 1;
     renderingInfo.pColorAttachmentFormats = &colorFormat;
@@ -131,5 +136,5 @@ void SkyboxPipeline::createPipeline(vk::raii::Device& device, VulkanResourceCrea
     pipelineInfo.pDepthStencilState = &depthStencil;
     pipelineInfo.layout = *pipelineLayout;
 
-    pipeline = vk::raii::Pipeline(device, nullptr, pipelineInfo);
+    pipeline = pipelineCache.createGraphicsPipeline(pipelineInfo);
 }
@@ -1,12 +1,16 @@
 #include "Rendering/renderer/Renderer.h"
 #include "Rendering/pass/DepthPrepass.h"
 #include "Rendering/pass/ForwardPass.h"
+#include "Rendering/pass/GpuCullingPass.h"
+#include "Rendering/pass/OcclusionCullingPass.h"
 #include "Rendering/pass/BloomExtractPass.h"
 #include "Rendering/pass/BloomBlurPass.h"
 #include "Rendering/pass/RtaoComputePass.h"
 #include "Rendering/pass/SkyboxPass.h"
 #include "Rendering/pass/TonemapBloomPass.h"
 #include "Configs/AppConfig.h"
+#include "Configs/RuntimeConfig.h"
+#include "Engine/Profiling/Trace.h"
 #include "Resource/model/Node.h"
 #include "Resource/texture/HdrTextureLoader.h"
 
@@ -30,6 +34,12 @@ Renderer::~Renderer()
     }
 }
 
+void Renderer::initHeadless(vk::Extent2D extent)
+{
+    headlessExtent = extent;
+    init(nullptr);
+}
+
 glm::mat4 Renderer::computeSceneModelMatrix() const
 {
     return glm::scale(glm::mat4(1.0f), glm::vec3(AppConfig::SCENE_MODEL_SCALE));
@@ -37,20 +47,33 @@ glm::mat4 Renderer::computeSceneModelMatrix() const
 
 void Renderer::init(GLFWwindow* inWindow)
 {
+    TRACE_SCOPE("Renderer::init");
     window = inWindow;
 
     vulkanContext.init(window);
-    swapChain.init(vulkanContext, window);
-    resourceManager.init(vulkanContext);
+    if (window) {
+        swapChain.init(vulkanContext, window);
+        resourceManager.init(vulkanContext);
+    } else {
+        resourceManager.init(vulkanContext);
+        swapChain.initHeadless(vulkanContext, *resourceManager.getResourceCreator(), headlessExtent);
+    }
 
+    // Without ray query: no TLAS/BLAS, no RTAO pass, and pbr.frag without the ray queries (constant AO).
+    const bool rayTracing = vulkanContext.supportsRayQuery();
     modelHandle = resourceManager.Load<Model>("bistro/bistro");
     vertShaderHandle = resourceManager.Load<Shader>("pbr_vert");
-    fragShaderHandle = resourceManager.Load<Shader>("pbr_frag");
+    fragShaderHandle = resourceManager.Load<Shader>(rayTracing ? "pbr_frag" : "pbr_noraytrace_frag");
     depthPrepassVertShaderHandle = resourceManager.Load<Shader>("depth_prepass_vert");
     depthOnlyFragShaderHandle = resourceManager.Load<Shader>("depth_only_frag");
-    rtaoTraceCompShaderHandle = resourceManager.Load<Shader>("rtao_trace_half_comp");
-    rtaoAtrousCompShaderHandle = resourceManager.Load<Shader>("rtao_atrous_comp");
-    rtaoUpsampleCompShaderHandle = resourceManager.Load<Shader>("rtao_upsample_comp");
+    if (rayTracing) {
+        rtaoTraceCompShaderHandle = resourceManager.Load<Shader>("rtao_trace_half_comp");
+        rtaoAtrousCompShaderHandle = resourceManager.Load<Shader>("rtao_atrous_comp");
+        rtaoUpsampleCompShaderHandle = resourceManager.Load<Shader>("rtao_upsample_comp");
+    }
+    hizBuildCompShaderHandle = resourceManager.Load<Shader>("hiz_build_comp");
+    gpuCullCompShaderHandle = resourceManager.Load<Shader>("gpu_cull_comp");
+    occlusionBoundsVertShaderHandle = resourceManager.Load<Shader>("occlusion_bounds_vert");
     skyboxVertShaderHandle = resourceManager.Load<Shader>("skybox_vert");
     skyboxFragShaderHandle = resourceManager.Load<Shader>("skybox_frag");
     fullscreenVertShaderHandle = resourceManager.Load<Shader>("fullscreen_vert");
@@ -61,7 +84,10 @@ void Renderer::init(GLFWwindow* inWindow)
     if (!modelHandle.IsValid() || !vertShaderHandle.IsValid() || !fragShaderHandle.IsValid() ||
         !depthPrepassVertShaderHandle.IsValid() ||
         !depthOnlyFragShaderHandle.IsValid() ||
-        !rtaoTraceCompShaderHandle.IsValid() || !rtaoAtrousCompShaderHandle.IsValid() || !rtaoUpsampleCompShaderHandle.IsValid() ||
+        (rayTracing && (!rtaoTraceCompShaderHandle.IsValid() || !rtaoAtrousCompShaderHandle.IsValid() ||
+                        !rtaoUpsampleCompShaderHandle.IsValid())) ||
+        !hizBuildCompShaderHandle.IsValid() || !gpuCullCompShaderHandle.IsValid() ||
+        !occlusionBoundsVertShaderHandle.IsValid() ||
         !skyboxVertShaderHandle.IsValid() || !skyboxFragShaderHandle.IsValid() ||
         !fullscreenVertShaderHandle.IsValid() || !bloomExtractFragShaderHandle.IsValid() ||
         !bloomBlurFragShaderHandle.IsValid() || !tonemapBloomFragShaderHandle.IsValid()) {
@@ -79,14 +105,16 @@ void Renderer::init(GLFWwindow* inWindow)
     modelMeshes.resize(cpuMeshes.size());
     std::vector<uint8_t> meshOpaqueFlags(cpuMeshes.size(), 1u);
     for (size_t i = 0; i < cpuMeshes.size(); ++i) {
-        modelMeshes[i].upload(*resourceCreator, cpuMeshes[i].vertices, cpuMeshes[i].indices);
+        modelMeshes[i].upload(*resourceCreator, cpuMeshes[i].vertices, cpuMeshes[i].indices, rayTracing);
         const int matIdx = cpuMeshes[i].materialIndex;
         const bool hasMat = (matIdx >= 0) && (matIdx < static_cast<int>(materials.size()));
         const bool opaque = !hasMat || (materials[static_cast<size_t>(matIdx)].alphaMode == AlphaMode::Opaque);
         meshOpaqueFlags[i] = opaque ? 1u : 0u;
     }
 
-    globalMeshBuffer.init(*resourceCreator, modelMeshes);
+    globalMeshBuffer.init(*resourceCreator, modelMeshes, modelHandle->getCookedMeshStreams());
+    // uploadBuffer() has already copied the streams into staging, the cache mapping is no longer needed.
+    modelHandle->releaseCookedMeshStreams();
 
     auto countMaxDraws = [](auto&& self, const std::vector<Node*>& nodes) -> uint32_t {
         uint32_t count = 0;
@@ -103,32 +131,70 @@ void Renderer::init(GLFWwindow* inWindow)
     maxDraws = std::max(1u, maxDraws);
 
     const vk::Format hdrColorFormat = vk::Format::eR16G16B16A16Sfloat;
-    graphicsPipeline.init(vulkanContext, swapChain, *resourceCreator, *vertShaderHandle.Get(), *fragShaderHandle.Get(), hdrColorFormat);
-    depthPrepassPipeline.init(vulkanContext, swapChain, *resourceCreator, graphicsPipeline,
-                              *depthPrepassVertShaderHandle.Get(), *depthOnlyFragShaderHandle.Get());
-    rtaoComputePipeline.init(vulkanContext, *rtaoTraceCompShaderHandle.Get(), *rtaoAtrousCompShaderHandle.Get(), *rtaoUpsampleCompShaderHandle.Get());
+    const vk::Format swapchainColorFormat = swapChain.getImageFormat();
+    const vk::Format depthFormat = resourceCreator->findDepthFormat();
+    // Layouts are created here; the pipeline compiles run on workers while the HDR map loads and uploads drain,
+    // and are joined below before anything records with them.
+    PipelineBuilder pipelineBuilder;
+    graphicsPipeline.init(vulkanContext, *resourceCreator, *vertShaderHandle.Get(), *fragShaderHandle.Get(), hdrColorFormat,
+                          pipelineBuilder);
+    depthPrepassPipeline.init(vulkanContext, *resourceCreator, graphicsPipeline,
+                              *depthPrepassVertShaderHandle.Get(), *depthOnlyFragShaderHandle.Get(), pipelineBuilder);
+    if (rayTracing) {
+        rtaoComputePipeline.init(vulkanContext, *rtaoTraceCompShaderHandle.Get(), *rtaoAtrousCompShaderHandle.Get(),
+                                 *rtaoUpsampleCompShaderHandle.Get(), pipelineBuilder);
+    }
+    gpuCullingPipeline.init(vulkanContext, *hizBuildCompShaderHandle.Get(), *gpuCullCompShaderHandle.Get(), pipelineBuilder);
+    occlusionPipeline.init(vulkanContext, *resourceCreator, graphicsPipeline, *occlusionBoundsVertShaderHandle.Get(), pipelineBuilder);
+    skyboxPipeline.init(vulkanContext.getDevice(), *resourceCreator, hdrColorFormat, depthFormat,
+                        vulkanContext.getMsaaSamples(), *skyboxVertShaderHandle.Get(), *skyboxFragShaderHandle.Get(), pipelineBuilder);
+    postProcessPipeline.init(vulkanContext, *resourceCreator, hdrColorFormat, swapchainColorFormat, *fullscreenVertShaderHandle.Get(),
+                             *bloomExtractFragShaderHandle.Get(), *bloomBlurFragShaderHandle.Get(), *tonemapBloomFragShaderHandle.Get(),
+                             pipelineBuilder);
+    occlusionVisibility.init(vulkanContext.getDevice(), static_cast<uint32_t>(modelHandle->getLinearNodes().size()));
+    gpuProfiler.init(vulkanContext);
+    softwareOcclusionCuller.setResolution(AppConfig::SOFTWARE_OCCLUSION_WIDTH, AppConfig::SOFTWARE_OCCLUSION_HEIGHT);
 
     // Load HDR equirect and convert to cubemap for skybox
     std::string hdrPath = AppConfig::ENV_HDR_PATH;
     // NOTE: equirectangular map must wrap in U (longitude), otherwise seams will appear in the converted cubemap.
     auto equirectResult = HdrTextureLoader::loadFromFile(hdrPath, resourceCreator,
         vk::SamplerAddressMode::eRepeat, vk::SamplerAddressMode::eClampToEdge);
+
+    // Model textures, mesh buffers and the HDR map were only enqueued: wait once before anything samples them.
+    {
+        TRACE_SCOPE("UploadWait");
+        UploadManager& uploader = resourceCreator->getUploader();
+        const auto waitStart = std::chrono::high_resolution_clock::now();
+        uploader.waitIdle();
+        const double waitMs =
+            std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - waitStart).count();
+        const UploadManager::Stats uploadStats = uploader.getStats();
+        std::cout << "[Perf] Upload MB=" << (static_cast<double>(uploadStats.bytes) / (1024.0 * 1024.0))
+                  << " copies=" << uploadStats.copies << " batches=" << uploadStats.batches
+                  << " ring_waits=" << uploadStats.ringWaits << " oversize=" << uploadStats.oversizeStagings
+                  << " transfer_queue=" << (uploader.usesTransferQueue() ? "yes" : "no")
+                  << " wait_ms=" << waitMs << "\n";
+    }
     if (equirectResult && equirectResult->imageView && equirectResult->sampler) {
+        TRACE_SCOPE("EquirectToCubemap");
         envCubemapResult = EquirectToCubemap::convert(*resourceCreator, *equirectResult->imageView, *equirectResult->sampler, 512);
     }
 
-    vk::Format swapchainColorFormat = swapChain.getImageFormat();
-    vk::Format depthFormat = resourceCreator->findDepthFormat();
-    skyboxPipeline.init(vulkanContext.getDevice(), *resourceCreator, hdrColorFormat, depthFormat,
-                        vulkanContext.getMsaaSamples(), *skyboxVertShaderHandle.Get(), *skyboxFragShaderHandle.Get());
-    postProcessPipeline.init(vulkanContext, *resourceCreator, hdrColorFormat, swapchainColorFormat, *fullscreenVertShaderHandle.Get(),
-                             *bloomExtractFragShaderHandle.Get(), *bloomBlurFragShaderHandle.Get(), *tonemapBloomFragShaderHandle.Get());
+    {
+        TRACE_SCOPE("PipelineWait");
+        pipelineBuilder.wait();
+    }
 
-    const glm::mat4 sceneModelMatrix = computeSceneModelMatrix();
-    rebuildRayTracingInstances(sceneModelMatrix);
-    rayTracingContext.init(vulkanContext, *resourceCreator, modelMeshes, meshOpaqueFlags, rayTracingInstances);
-    cachedModelMatrixForTlas = sceneModelMatrix;
-    tlasNeedsUpdate = false;  // TLAS just built in init
+    if (rayTracing) {
+        const glm::mat4 sceneModelMatrix = computeSceneModelMatrix();
+        rebuildRayTracingInstances(sceneModelMatrix);
+        {
+            TRACE_SCOPE("BuildAccelerationStructures");
+            rayTracingContext.init(vulkanContext, *resourceCreator, modelMeshes, meshOpaqueFlags, rayTracingInstances);
+        }
+        tlasNeedsUpdate = false;  // TLAS just built in init
+    }
 
     rendergraph.emplace(vulkanContext.getDevice(), *resourceCreator);
     vk::Extent2D extent = swapChain.getExtent();
@@ -154,20 +220,43 @@ void Renderer::init(GLFWwindow* inWindow)
                              vk::ImageLayout::eUndefined, vk::ImageLayout::eDepthStencilAttachmentOptimal,
                              vk::ImageAspectFlagBits::eDepth, vulkanContext.getMsaaSamples());
     rendergraph->AddExternalResource("swapchain", swapchainColorFormat, extent,
-                                     vk::ImageLayout::eUndefined, vk::ImageLayout::ePresentSrcKHR);
+                                     vk::ImageLayout::eUndefined, swapChain.getFinalLayout());
+    // FrameManager-owned images shared between passes: created in their initial layout, kept across frames.
+    rendergraph->AddExternalResource("depth_resolve", depthFormat, extent,
+                                     vk::ImageLayout::eDepthStencilAttachmentOptimal, vk::ImageLayout::eDepthStencilAttachmentOptimal,
+                                     vk::ImageAspectFlagBits::eDepth);
+    rendergraph->AddExternalResource("normal_resolve", vk::Format::eR16G16B16A16Sfloat, extent,
+                                     vk::ImageLayout::eColorAttachmentOptimal, vk::ImageLayout::eColorAttachmentOptimal);
+    rendergraph->AddExternalResource("linear_depth_resolve", vk::Format::eR16Sfloat, extent,
+                                     vk::ImageLayout::eColorAttachmentOptimal, vk::ImageLayout::eColorAttachmentOptimal);
+    rendergraph->AddExternalResource("rtao_full", vk::Format::eR16Sfloat, extent,
+                                     vk::ImageLayout::eGeneral, vk::ImageLayout::eGeneral);
 
     bool hasEnvCubemap = envCubemapResult.cubeView && envCubemapResult.sampler;
+    const bool useSkyboxIblDebug = (AppConfig::SKYBOX_IBL_DEBUG_MODE > 0);
+    const bool enableDepthResolve = (vulkanContext.getMsaaSamples() != vk::SampleCountFlagBits::e1);
+    // Reads depth_resolve before DepthPrepass writes it (insertion order keeps it first), so its Hi-Z sees last frame's depth.
+    auto gpuCullingPass = std::make_unique<GpuCullingPass>(vulkanContext, *resourceCreator, gpuCullingPipeline, frameManager,
+                                                           *modelHandle.Get(), maxDraws, enableDepthResolve);
+    gpuCullingPassPtr = gpuCullingPass.get();
+    rendergraph->AddPass(std::move(gpuCullingPass));
     if (hasEnvCubemap) {
         rendergraph->AddPass(std::make_unique<SkyboxPass>(skyboxPipeline, frameManager, *rendergraph, swapChain));
     }
-    const bool useSkyboxIblDebug = (AppConfig::SKYBOX_IBL_DEBUG_MODE > 0);
-    const bool enableDepthResolve = (vulkanContext.getMsaaSamples() != vk::SampleCountFlagBits::e1);
-    rendergraph->AddPass(std::make_unique<DepthPrepass>(
+    auto depthPrepass = std::make_unique<DepthPrepass>(
         depthPrepassPipeline, frameManager, *modelHandle.Get(), modelMeshes, globalMeshBuffer, maxDraws,
-        *rendergraph, enableDepthResolve));
-    rendergraph->AddPass(std::make_unique<RtaoComputePass>(vulkanContext.getDevice(), rtaoComputePipeline, frameManager, rayTracingContext));
-    rendergraph->AddPass(std::make_unique<ForwardPass>(graphicsPipeline, frameManager, *modelHandle.Get(), modelMeshes,
-                                                        globalMeshBuffer, maxDraws, *rendergraph, false, !hasEnvCubemap));
+        *rendergraph, enableDepthResolve);
+    depthPrepass->setGpuCullingPass(gpuCullingPassPtr);
+    rendergraph->AddPass(std::move(depthPrepass));
+    rendergraph->AddPass(std::make_unique<OcclusionCullingPass>(occlusionPipeline, frameManager, occlusionVisibility, *rendergraph));
+    if (rayTracing) {
+        rendergraph->AddPass(std::make_unique<RtaoComputePass>(vulkanContext.getDevice(), rtaoComputePipeline, frameManager,
+                                                               rayTracingContext));
+    }
+    auto forwardPass = std::make_unique<ForwardPass>(graphicsPipeline, frameManager, *modelHandle.Get(), modelMeshes,
+                                                     globalMeshBuffer, maxDraws, *rendergraph, false, !hasEnvCubemap);
+    forwardPass->setGpuCullingPass(gpuCullingPassPtr);
+    rendergraph->AddPass(std::move(forwardPass));
     if (AppConfig::ENABLE_BLOOM) {
         rendergraph->AddPass(std::make_unique<BloomExtractPass>(postProcessPipeline, frameManager, *rendergraph));
         rendergraph->AddPass(std::make_unique<BloomBlurPass>("BloomBlurPassH", "bloom_a", "bloom_b", true,
@@ -180,15 +269,18 @@ void Renderer::init(GLFWwindow* inWindow)
 
     frameManager.init(vulkanContext, swapChain, graphicsPipeline, *rendergraph, *resourceCreator,
                       *modelHandle.Get(), rayTracingContext, maxDraws);
+    // The opaque draw slots exist once FrameManager is initialized; their instances stay on the GPU from here on.
+    gpuCullingPassPtr->uploadDrawInstances(globalMeshBuffer);
     frameManager.createPostProcessResources(vulkanContext.getDevice(), postProcessPipeline.getDescriptorSetLayout());
 
-    if (AppConfig::ENABLE_IMGUI) {
+    if (isUiEnabled()) {
         imguiIntegration.init(vulkanContext, *resourceManager.getResourceCreator(), swapChain, window);
     }
 
     if (hasEnvCubemap) {
         // 若 SKYBOX_IBL_DEBUG_MODE > 0，需先计算 IBL，再用 irradiance/prefilter 作为天空盒纹理
         if (useSkyboxIblDebug) {
+            TRACE_SCOPE("IblPrecompute");
             iblResult = IblPrecompute::compute(*resourceCreator, *envCubemapResult.cubeView, *envCubemapResult.sampler);
         }
         vk::ImageView skyboxView = *envCubemapResult.cubeView;
@@ -205,6 +297,7 @@ void Renderer::init(GLFWwindow* inWindow)
         frameManager.createSkyboxResources(*resourceCreator, skyboxPipeline.getDescriptorSetLayout(),
                                            skyboxView, skyboxSampler);
         if (!useSkyboxIblDebug) {
+            TRACE_SCOPE("IblPrecompute");
             iblResult = IblPrecompute::compute(*resourceCreator, *envCubemapResult.cubeView, *envCubemapResult.sampler);
         }
         if (iblResult.irradianceView && iblResult.prefilterView && iblResult.brdfLutView && iblResult.sampler) {
@@ -212,13 +305,63 @@ void Renderer::init(GLFWwindow* inWindow)
                                          *iblResult.brdfLutView, *iblResult.sampler);
         }
     }
+    reportPipelineStats("init", pipelineBuilder);
 }
 
-void Renderer::update(float deltaTime)
+void Renderer::reportPipelineStats(const char* stage, const PipelineBuilder& builder)
 {
-    if (animationPlayer.update(deltaTime)) {
-        tlasNeedsUpdate = true;  // Animation modified node transforms
+    PipelineCache& pipelineCache = vulkanContext.getPipelineCache();
+    const PipelineCache::Stats stats = pipelineCache.getStats();
+    std::cout << "[Perf] Pipelines stage=" << stage << " created=" << stats.pipelines << " parallel_builds=" << builder.getBuildCount()
+              << " join_ms=" << builder.getWaitMs();
+    if (stats.feedbackPipelines > 0) {
+        std::cout << " cache_hits=" << stats.cacheHits << "/" << stats.feedbackPipelines;
+    } else {
+        std::cout << " cache_hits=n/a";
     }
+    std::cout << " create_ms=" << stats.createMs << " cache_loaded_bytes=" << pipelineCache.getLoadedBytes() << "\n";
+    pipelineCache.resetStats();
+}
+
+void Renderer::recreateSwapChain()
+{
+    TRACE_SCOPE("RecreateSwapChain");
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    swapchainRecreateCount++;
+    swapChain.recreate(vulkanContext, window);
+    const vk::Format hdrColorFormat = vk::Format::eR16G16B16A16Sfloat;
+    // Pipelines only depend on formats/MSAA (viewport/scissor are dynamic), so a plain resize rebuilds none;
+    // any that do change compile on workers while the extent-sized images are reallocated. Compute pipelines are untouched.
+    PipelineBuilder pipelineBuilder;
+    graphicsPipeline.recreate(vulkanContext, *resourceManager.getResourceCreator(), *vertShaderHandle.Get(), *fragShaderHandle.Get(),
+                              hdrColorFormat, pipelineBuilder);
+    depthPrepassPipeline.recreate(vulkanContext, *resourceManager.getResourceCreator(), graphicsPipeline,
+                                  *depthPrepassVertShaderHandle.Get(), *depthOnlyFragShaderHandle.Get(), pipelineBuilder);
+    occlusionPipeline.recreate(vulkanContext, *resourceManager.getResourceCreator(), graphicsPipeline,
+                               *occlusionBoundsVertShaderHandle.Get(), pipelineBuilder);
+    postProcessPipeline.recreate(vulkanContext, *resourceManager.getResourceCreator(), hdrColorFormat, swapChain.getImageFormat(),
+                                 *fullscreenVertShaderHandle.Get(), *bloomExtractFragShaderHandle.Get(),
+                                 *bloomBlurFragShaderHandle.Get(), *tonemapBloomFragShaderHandle.Get(), pipelineBuilder);
+    // Only extent-sized images are reallocated; buffers, descriptor sets (material/IBL, skybox, post) and the
+    // rendergraph's pass order survive. Post-process and RTAO sets are rewritten per frame anyway.
+    rendergraph->Resize(swapChain.getExtent());
+    frameManager.onSwapchainRecreated(vulkanContext, swapChain, *resourceManager.getResourceCreator());
+    // GPU timings at the old extent are not comparable with the new ones.
+    gpuProfiler.reset();
+    pipelineBuilder.wait();
+    reportPipelineStats("resize", pipelineBuilder);
+    if (isUiEnabled()) {
+        imguiIntegration.onSwapchainRecreated(swapChain, window);
+    }
+    const vk::Extent2D extent = swapChain.getExtent();
+    std::cout << "[Perf] Resize extent=" << extent.width << "x" << extent.height << " ms="
+              << std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count() << "\n";
+}
+
+void Renderer::update(float deltaTime)
+{
+    // Animated nodes are marked transformDirty; recordCommandBuffer picks them up via Model::getNodeWorldVersions().
+    animationPlayer.update(deltaTime);
 }
 
 void Renderer::cleanup()
@@ -227,7 +370,7 @@ void Renderer::cleanup()
         waitIdle();
     }
 
-    if (AppConfig::ENABLE_IMGUI) {
+    if (isUiEnabled()) {
         imguiIntegration.cleanup();
     }
     frameManager.cleanup(vulkanContext.getDevice());
@@ -235,8 +378,13 @@ void Renderer::cleanup()
     if (rendergraph) {
         rendergraph->Cleanup();
     }
+    gpuCullingPassPtr = nullptr;
     rayTracingContext.cleanup();
     rtaoComputePipeline.cleanup();
+    gpuCullingPipeline.cleanup();
+    occlusionVisibility.cleanup();
+    gpuProfiler.cleanup();
+    occlusionPipeline.cleanup();
     depthPrepassPipeline.cleanup();
     skyboxPipeline.cleanup();
     postProcessPipeline.cleanup();
@@ -262,58 +410,53 @@ void Renderer::drawFrame()
 
     frameCounter++;
 
-    vk::Fence inFlightFence = frameManager.getInFlightFence();
-    (void)device.waitForFences(inFlightFence, VK_TRUE, UINT64_MAX);
+    // A frames-in-flight change (ImGui / --frames-in-flight) re-indexes the frame slots, so it lands between frames.
+    RuntimeConfig::framesInFlight =
+        std::clamp(RuntimeConfig::framesInFlight, 1u, static_cast<uint32_t>(AppConfig::MAX_FRAMES_IN_FLIGHT));
+    if (RuntimeConfig::framesInFlight != frameManager.getFramesInFlight()) {
+        frameManager.setFramesInFlight(device, RuntimeConfig::framesInFlight);
+        // Slots above the new count would otherwise be harvested with stale query results later.
+        gpuProfiler.reset();
+        occlusionVisibility.reset();
+    }
+
+    // The only CPU wait: the GPU must be done with this slot's command buffer, UBO and query slots. The image is
+    // acquired without blocking; the submit waits on the acquire semaphore instead, so recording overlaps the
+    // presentation engine's acquire latency.
+    {
+        TRACE_SCOPE("WaitFrameSlot");
+        frameManager.waitForCurrentFrameSlot(device);
+    }
 
-    vk::Fence imageAvailableFence = frameManager.getImageAvailableFence();
-    device.resetFences(imageAvailableFence);
+    vk::Semaphore imageAvailableSemaphore = frameManager.getImageAvailableSemaphore();
     vk::Result result = vk::Result::eSuccess;
     uint32_t imageIndex = 0;
     const auto tAcquire0 = now();
-    try {
-        auto acquireResult = swapChain.acquireNextImage(UINT64_MAX, VK_NULL_HANDLE, imageAvailableFence);
-        result = acquireResult.result;
-        imageIndex = acquireResult.value;
-    } catch (const vk::OutOfDateKHRError&) {
-        // vulkan-hpp may throw for OutOfDate instead of returning a VkResult.
-        result = vk::Result::eErrorOutOfDateKHR;
-    }
-
-    if (result == vk::Result::eErrorOutOfDateKHR || result == vk::Result::eSuboptimalKHR) {
-        swapchainRecreateCount++;
-        swapChain.recreate(vulkanContext, window);
-        const vk::Format hdrColorFormat = vk::Format::eR16G16B16A16Sfloat;
-        graphicsPipeline.recreate(vulkanContext, swapChain, *resourceManager.getResourceCreator(),
-                                  *vertShaderHandle.Get(), *fragShaderHandle.Get(), hdrColorFormat);
-        depthPrepassPipeline.recreate(vulkanContext, swapChain, *resourceManager.getResourceCreator(),
-                                      graphicsPipeline, *depthPrepassVertShaderHandle.Get(), *depthOnlyFragShaderHandle.Get());
-        postProcessPipeline.recreate(vulkanContext, *resourceManager.getResourceCreator(), hdrColorFormat, swapChain.getImageFormat(),
-                                     *fullscreenVertShaderHandle.Get(), *bloomExtractFragShaderHandle.Get(),
-                                     *bloomBlurFragShaderHandle.Get(), *tonemapBloomFragShaderHandle.Get());
-        rtaoComputePipeline.recreate(vulkanContext, *rtaoTraceCompShaderHandle.Get(), *rtaoAtrousCompShaderHandle.Get(), *rtaoUpsampleCompShaderHandle.Get());
-        rendergraph->Recompile(swapChain.getExtent());
-        frameManager.recreate(vulkanContext, swapChain, graphicsPipeline, *rendergraph,
-                              *resourceManager.getResourceCreator(), *modelHandle.Get(), rayTracingContext, maxDraws);
-        frameManager.createPostProcessResources(vulkanContext.getDevice(), postProcessPipeline.getDescriptorSetLayout());
-        if (iblResult.irradianceView && iblResult.prefilterView && iblResult.brdfLutView && iblResult.sampler) {
-            frameManager.setIblResources(vulkanContext.getDevice(), *iblResult.irradianceView, *iblResult.prefilterView,
-                                         *iblResult.brdfLutView, *iblResult.sampler);
-        }
-        if (AppConfig::ENABLE_IMGUI) {
-            imguiIntegration.onSwapchainRecreated(swapChain, window);
+    {
+        TRACE_SCOPE("Acquire");
+        try {
+            auto acquireResult = swapChain.acquireNextImage(UINT64_MAX, imageAvailableSemaphore, VK_NULL_HANDLE);
+            result = acquireResult.result;
+            imageIndex = acquireResult.value;
+        } catch (const vk::OutOfDateKHRError&) {
+            // vulkan-hpp may throw for OutOfDate instead of returning a VkResult.
+            result = vk::Result::eErrorOutOfDateKHR;
         }
+    }
+
+    // OutOfDate leaves the semaphore unsignalled. Suboptimal has already signalled it, so that frame is still
+    // rendered and presented, and the swapchain is recreated afterwards.
+    if (result == vk::Result::eErrorOutOfDateKHR) {
+        recreateSwapChain();
         return;
     }
     if (result != vk::Result::eSuccess && result != vk::Result::eSuboptimalKHR) {
         throw std::runtime_error("failed to acquire swap chain image!");
     }
-
-    (void)device.waitForFences(imageAvailableFence, VK_TRUE, UINT64_MAX);
+    const bool acquireSuboptimal = (result == vk::Result::eSuboptimalKHR);
     lastCpuTimings.acquireMs = toMs(now() - tAcquire0);
-    device.resetFences(imageAvailableFence);
-    device.resetFences(inFlightFence);
 
-    if (AppConfig::ENABLE_IMGUI) {
+    if (isUiEnabled()) {
         ImGuiIntegration::UiStats stats{};
         stats.acquireMs = lastCpuTimings.acquireMs;
         stats.recordMs = lastCpuTimings.recordMs;
@@ -323,6 +466,9 @@ void Renderer::drawFrame()
         stats.totalMs = lastCpuTimings.totalMs;
         stats.swapchainRecreateCount = swapchainRecreateCount;
         stats.frameCounter = frameCounter;
+        for (const GpuProfiler::ScopeSummary& scope : gpuProfiler.getSummaries()) {
+            stats.gpuScopes.push_back({scope.name, scope.minMs, scope.avgMs, scope.p99Ms});
+        }
         imguiIntegration.setUiStats(stats);
         imguiIntegration.newFrame();
     }
@@ -331,10 +477,14 @@ void Renderer::drawFrame()
     commandBuffer.reset();
     const glm::mat4 modelMatrix = computeSceneModelMatrix();
     const auto tRecord0 = now();
-    recordCommandBuffer(commandBuffer, imageIndex, modelMatrix);
+    {
+        TRACE_SCOPE("Record");
+        recordCommandBuffer(commandBuffer, imageIndex, modelMatrix);
+    }
     lastCpuTimings.recordMs = toMs(now() - tRecord0);
 
     if (camera) {
+        TRACE_SCOPE("UpdateUBO");
         const auto tUbo0 = now();
         frameManager.updateUniformBuffer(frameManager.getCurrentFrame(), frameManager.getSwapChainExtent(),
                                          *camera, modelMatrix);
@@ -343,64 +493,70 @@ void Renderer::drawFrame()
         lastCpuTimings.updateUboMs = 0.0;
     }
 
-    vk::Semaphore signalSemaphores[] = {frameManager.getRenderFinishedSemaphore(imageIndex)};
-
+    // Headless frames are never presented, so nothing waits on a render-finished semaphore.
+    const bool present = !swapChain.isHeadless();
+    const uint64_t timelineValue = frameManager.claimFrameTimelineValue();
+    vk::Semaphore signalSemaphores[] = {frameManager.getFrameTimeline(), frameManager.getRenderFinishedSemaphore(imageIndex)};
+    const uint64_t signalValues[] = {timelineValue, 0};  // binary semaphores ignore their value
+    // The swapchain image is first touched as a color attachment (see Rendergraph::usageScope); earlier stages run
+    // before the acquire completes.
+    const vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+
+    vk::TimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.signalSemaphoreValueCount = present ? 2u : 1u;
+    timelineInfo.pSignalSemaphoreValues = signalValues;
     vk::SubmitInfo submitInfo{};
-    submitInfo.waitSemaphoreCount = 0;
-    submitInfo.pWaitSemaphores = nullptr;
-    submitInfo.pWaitDstStageMask = nullptr;
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.pWaitSemaphores = &imageAvailableSemaphore;
+    submitInfo.pWaitDstStageMask = &waitStage;
     submitInfo.commandBufferCount = 1;
     vk::CommandBuffer cb = commandBuffer;
     submitInfo.pCommandBuffers = &cb;
-    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.signalSemaphoreCount = present ? 2u : 1u;
     submitInfo.pSignalSemaphores = signalSemaphores;
 
     const auto tSubmit0 = now();
-    vulkanContext.getGraphicsQueue().submit(submitInfo, inFlightFence);
+    {
+        TRACE_SCOPE("Submit");
+        vulkanContext.getGraphicsQueue().submit(submitInfo);
+    }
+    gpuProfiler.markSubmitted(frameManager.getCurrentFrame());
     lastCpuTimings.submitMs = toMs(now() - tSubmit0);
 
-    vk::SwapchainKHR swapChains[] = {swapChain.getSwapChain()};
+    if (!pendingCapturePath.empty() && swapChain.isHeadless()) {
+        TRACE_SCOPE("CaptureFrame");
+        const bool written = swapChain.saveImage(*resourceManager.getResourceCreator(), imageIndex, pendingCapturePath);
+        std::cout << "[Headless] Frame " << frameCounter << (written ? " written to " : " failed to write ")
+                  << pendingCapturePath << "\n";
+        pendingCapturePath.clear();
+    }
+
+    vk::SwapchainKHR swapChains[] = {present ? swapChain.getSwapChain() : vk::SwapchainKHR{}};
     vk::PresentInfoKHR presentInfo{};
     presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
+    presentInfo.pWaitSemaphores = &signalSemaphores[1];
     presentInfo.swapchainCount = 1;
     presentInfo.pSwapchains = swapChains;
     presentInfo.pImageIndices = &imageIndex;
 
     vk::Result presentResult = vk::Result::eSuccess;
     const auto tPresent0 = now();
-    try {
-        presentResult = vulkanContext.getPresentQueue().presentKHR(presentInfo);
-    } catch (const vk::OutOfDateKHRError&) {
-        // Avoid propagating the exception: treat as a normal OutOfDate result and recreate the swapchain.
-        presentResult = vk::Result::eErrorOutOfDateKHR;
+    if (present) {
+        TRACE_SCOPE("Present");
+        try {
+            presentResult = vulkanContext.getPresentQueue().presentKHR(presentInfo);
+        } catch (const vk::OutOfDateKHRError&) {
+            // Avoid propagating the exception: treat as a normal OutOfDate result and recreate the swapchain.
+            presentResult = vk::Result::eErrorOutOfDateKHR;
+        }
     }
     lastCpuTimings.presentMs = toMs(now() - tPresent0);
 
-    if (presentResult == vk::Result::eErrorOutOfDateKHR || presentResult == vk::Result::eSuboptimalKHR || frameManager.getFramebufferResized()) {
+    if (presentResult == vk::Result::eErrorOutOfDateKHR || presentResult == vk::Result::eSuboptimalKHR || acquireSuboptimal
+        || frameManager.getFramebufferResized()) {
         frameManager.clearFramebufferResized();
-        swapchainRecreateCount++;
-        swapChain.recreate(vulkanContext, window);
-        const vk::Format hdrColorFormat = vk::Format::eR16G16B16A16Sfloat;
-        graphicsPipeline.recreate(vulkanContext, swapChain, *resourceManager.getResourceCreator(),
-                                  *vertShaderHandle.Get(), *fragShaderHandle.Get(), hdrColorFormat);
-        depthPrepassPipeline.recreate(vulkanContext, swapChain, *resourceManager.getResourceCreator(),
-                                      graphicsPipeline, *depthPrepassVertShaderHandle.Get(), *depthOnlyFragShaderHandle.Get());
-        postProcessPipeline.recreate(vulkanContext, *resourceManager.getResourceCreator(), hdrColorFormat, swapChain.getImageFormat(),
-                                     *fullscreenVertShaderHandle.Get(), *bloomExtractFragShaderHandle.Get(),
-                                     *bloomBlurFragShaderHandle.Get(), *tonemapBloomFragShaderHandle.Get());
-        rtaoComputePipeline.recreate(vulkanContext, *rtaoTraceCompShaderHandle.Get(), *rtaoAtrousCompShaderHandle.Get(), *rtaoUpsampleCompShaderHandle.Get());
-        rendergraph->Recompile(swapChain.getExtent());
-        frameManager.recreate(vulkanContext, swapChain, graphicsPipeline, *rendergraph,
-                              *resourceManager.getResourceCreator(), *modelHandle.Get(), rayTracingContext, maxDraws);
-        frameManager.createPostProcessResources(vulkanContext.getDevice(), postProcessPipeline.getDescriptorSetLayout());
-        if (iblResult.irradianceView && iblResult.prefilterView && iblResult.brdfLutView && iblResult.sampler) {
-            frameManager.setIblResources(vulkanContext.getDevice(), *iblResult.irradianceView, *iblResult.prefilterView,
-                                         *iblResult.brdfLutView, *iblResult.sampler);
-        }
-        if (AppConfig::ENABLE_IMGUI) {
-            imguiIntegration.onSwapchainRecreated(swapChain, window);
-        }
+        recreateSwapChain();
     } else if (presentResult != vk::Result::eSuccess) {
         throw std::runtime_error("failed to present swap chain image!");
     }
@@ -437,6 +593,22 @@ void Renderer::drawFrame()
                     << " blurV=" << lastRenderStats.bloomBlurVMs
                     << " tonemap=" << lastRenderStats.tonemapMs;
             }
+            out << " | cull(tested/culled)=" << lastRenderStats.cullTestedNodes << "/" << lastRenderStats.cullCulledNodes
+                << " cull_ms=" << lastRenderStats.cullMs
+                << " | gpuCull(in/visible/frustum/occluded)=" << lastRenderStats.gpuCullInputDraws << "/"
+                << lastRenderStats.gpuCullVisibleDraws << "/" << lastRenderStats.gpuCullFrustumCulled << "/"
+                << lastRenderStats.gpuCullOcclusionCulled << " gpuCull_ms=" << lastRenderStats.gpuCullMs
+                << " | occl(queries/resolved/late/hidden)=" << lastRenderStats.occlusionDrawCalls << "/"
+                << lastRenderStats.occlusionResolvedQueries << "/" << lastRenderStats.occlusionLateQueries << "/"
+                << lastRenderStats.occlusionHiddenNodes << " occl_ms=" << lastRenderStats.occlusionMs
+                << " | swOccl(tris/tested/culled)=" << lastRenderStats.swOcclusionOccluderTris << "/"
+                << lastRenderStats.swOcclusionTestedNodes << "/" << lastRenderStats.swOcclusionCulledNodes
+                << " swOccl_ms(raster/test)=" << lastRenderStats.swOcclusionRasterMs << "/"
+                << lastRenderStats.swOcclusionTestMs
+                << " | tlas(written/refit/rebuild)=" << lastRenderStats.tlasWrittenInstances << "/"
+                << lastRenderStats.tlasRefits << "/" << lastRenderStats.tlasRebuilds
+                << " | barriers(batches/images/split)=" << lastRenderStats.graphBarrierBatches << "/"
+                << lastRenderStats.graphImageBarriers << "/" << lastRenderStats.graphSplitBarriers;
             if (AppConfig::PERF_PRINT_FORWARD_DETAIL) {
                 out << " | draws(depth/fwd)=" << lastRenderStats.depthDrawCalls << "/" << lastRenderStats.forwardDrawCalls
                     << " items(opaque/trans)=" << lastRenderStats.opaqueItems << "/" << lastRenderStats.transparentItems
@@ -446,6 +618,18 @@ void Renderer::drawFrame()
                     << lastRenderStats.forwardDescriptorBinds << "/" << lastRenderStats.forwardVertexBufferBinds << "/"
                     << lastRenderStats.forwardIndexBufferBinds;
             }
+            const GpuMemoryAllocator::Stats memStats = resourceManager.getResourceCreator()->getMemoryStats();
+            constexpr double MB = 1024.0 * 1024.0;
+            out << " | gpuMem_MB(used/reserved/frag)=" << memStats.usedBytes / MB << "/" << memStats.reservedBytes / MB
+                << "/" << memStats.fragmentedBytes / MB << " blocks/dedicated/allocs=" << memStats.blockCount << "/"
+                << memStats.dedicatedCount << "/" << memStats.allocationCount;
+            if (gpuProfiler.isActive()) {
+                out << " | gpu_ms(min/avg/p99)";
+                for (const GpuProfiler::ScopeSummary& scope : gpuProfiler.getSummaries()) {
+                    out << " " << scope.name << "=" << scope.minMs << "/" << scope.avgMs << "/" << scope.p99Ms;
+                }
+                out << " gpu_late=" << gpuProfiler.getLateScopes();
+            }
             out << " swapchainRecreate=" << swapchainRecreateCount << std::endl;
         }
         accumCpuTimings = CpuTimings{};
@@ -455,6 +639,18 @@ void Renderer::drawFrame()
     frameManager.advanceFrame();
 }
 
+void Renderer::runOcclusionBenchmark(const std::vector<std::string>& cameraPathFiles)
+{
+    if (!modelHandle.IsValid()) {
+        throw std::runtime_error("occlusion benchmark: no scene model loaded");
+    }
+    Model& model = *modelHandle.Get();
+    model.updateWorldMatrices(computeSceneModelMatrix());
+    const vk::Extent2D extent = swapChain.getExtent();
+    const float aspect = extent.width / static_cast<float>(std::max(extent.height, 1u));
+    runMaskedOcclusionBenchmark(model, cameraPathFiles, aspect);
+}
+
 void Renderer::waitIdle()
 {
     if (vulkanContext.hasDevice()) {
@@ -466,16 +662,15 @@ void Renderer::recordCommandBuffer(vk::raii::CommandBuffer& commandBuffer, uint3
 {
     vk::CommandBufferBeginInfo beginInfo{};
     commandBuffer.begin(beginInfo);
+    // The slot's timeline value was waited in drawFrame: harvest its timestamps from frames-in-flight frames ago.
+    gpuProfiler.beginFrame(commandBuffer, frameManager.getCurrentFrame());
 
-    // TLAS static caching: only rebuild when model transforms change (animation, rotation, scale, etc.)
-    if (!cachedModelMatrixForTlas || *cachedModelMatrixForTlas != modelMatrix) {
-        tlasNeedsUpdate = true;
-        cachedModelMatrixForTlas = modelMatrix;
-    }
-    if (tlasNeedsUpdate) {
-        rebuildRayTracingInstances(modelMatrix);
-        rayTracingContext.updateTopLevelAS(commandBuffer, rayTracingInstances);
-        tlasNeedsUpdate = false;
+    lastRenderStats = RenderStats{};
+    // Cached world matrices: only dirty subtrees (animation) or a scene matrix change are re-propagated.
+    // TLAS static caching: only the instances of changed nodes are rewritten (nothing at all for a static scene).
+    if (modelHandle.IsValid()) {
+        modelHandle->updateWorldMatrices(modelMatrix);
+        updateRayTracingInstances(commandBuffer, modelMatrix);
     }
 
     std::unordered_map<std::string, ExternalResourceView> externalViews;
@@ -483,13 +678,66 @@ void Renderer::recordCommandBuffer(vk::raii::CommandBuffer& commandBuffer, uint3
                                           swapChain.getImages()[imageIndex],
                                           swapChain.getImageView(imageIndex),
                                       });
+    // Resolve targets and the RTAO output live in FrameManager; the rendergraph only tracks their layouts.
+    externalViews.emplace("depth_resolve", ExternalResourceView{frameManager.getDepthResolveImage(),
+                                                                frameManager.getDepthResolveImageView()});
+    externalViews.emplace("normal_resolve", ExternalResourceView{frameManager.getNormalResolveImage(),
+                                                                 frameManager.getNormalResolveImageView()});
+    externalViews.emplace("linear_depth_resolve", ExternalResourceView{frameManager.getLinearDepthResolveImage(),
+                                                                       frameManager.getLinearDepthResolveImageView()});
+    externalViews.emplace("rtao_full", ExternalResourceView{frameManager.getRtaoFullImage(), frameManager.getRtaoFullImageView()});
     if (modelHandle.IsValid()) {
-        frameManager.prepareSharedOpaqueIndirect(*modelHandle.Get(), globalMeshBuffer, modelMatrix);
+        const Model& model = *modelHandle.Get();
+        TRACE_SCOPE("Cull");
+        const auto tCull0 = std::chrono::high_resolution_clock::now();
+        glm::mat4 viewProj(1.0f);
+        if (camera) {
+            const vk::Extent2D extent = frameManager.getSwapChainExtent();
+            const float aspect = extent.width / static_cast<float>(std::max(extent.height, 1u));
+            viewProj = camera->getProjMatrix(aspect, AppConfig::CAMERA_NEAR_PLANE, AppConfig::CAMERA_FAR_PLANE)
+                * camera->getViewMatrix();
+        }
+        if (RuntimeConfig::enableFrustumCulling && camera) {
+            nodeCuller.cull(model, Frustum(viewProj));
+        } else {
+            nodeCuller.setAllVisible(model);
+        }
+        const std::vector<uint8_t>* nodeVisibility = &nodeCuller.getNodeVisibility();
+        if (RuntimeConfig::enableSoftwareOcclusionCulling && camera) {
+            softwareOcclusionCuller.cull(model, viewProj, camera->getPosition(), *nodeVisibility);
+            nodeVisibility = &softwareOcclusionCuller.getNodeVisibility();
+            const SoftwareOcclusionCuller::Stats& swStats = softwareOcclusionCuller.getStats();
+            lastRenderStats.swOcclusionOccluderTris = swStats.occluderTriangles;
+            lastRenderStats.swOcclusionTestedNodes = swStats.testedNodes;
+            lastRenderStats.swOcclusionCulledNodes = swStats.culledNodes;
+            lastRenderStats.swOcclusionRasterMs = swStats.rasterMs;
+            lastRenderStats.swOcclusionTestMs = swStats.testMs;
+        }
+        // Occlusion query results are frames-in-flight frames old and only ever remove nodes kept so far.
+        if (RuntimeConfig::enableOcclusionCulling && camera) {
+            occlusionVisibility.beginFrame(frameManager.getCurrentFrame(), model, *nodeVisibility, camera->getPosition());
+            nodeVisibility = &occlusionVisibility.getNodeVisibility();
+        } else {
+            occlusionVisibility.reset();
+        }
+        // GPU-driven: gpu_cull.comp builds the opaque commands from the persistent draw instances, the CPU only
+        // syncs moved world matrices. Otherwise the culled commands are written to the host indirect buffer.
+        if (gpuCullingPassPtr && gpuCullingPassPtr->canRun(camera)) {
+            frameManager.prepareSharedOpaqueGpuDriven(model, *nodeVisibility);
+        } else {
+            frameManager.prepareSharedOpaqueIndirect(model, globalMeshBuffer, *nodeVisibility);
+        }
+        lastRenderStats.cullMs = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - tCull0).count();
+        lastRenderStats.cullTestedNodes = nodeCuller.getStats().testedNodes;
+        lastRenderStats.cullCulledNodes = nodeCuller.getStats().culledNodes;
+        lastRenderStats.occlusionResolvedQueries = occlusionVisibility.getStats().resolvedQueries;
+        lastRenderStats.occlusionLateQueries = occlusionVisibility.getStats().lateQueries;
+        lastRenderStats.occlusionHiddenNodes = occlusionVisibility.getStats().hiddenNodes;
     }
-    lastRenderStats = RenderStats{};
-    rendergraph->Execute(commandBuffer, imageIndex, modelMatrix, externalViews, camera, &lastRenderStats);
+    rendergraph->Execute(commandBuffer, imageIndex, modelMatrix, externalViews, camera, &lastRenderStats, &gpuProfiler);
 
-    if (AppConfig::ENABLE_IMGUI) {
+    if (isUiEnabled()) {
         imguiIntegration.render(commandBuffer,
                             swapChain.getImages()[imageIndex],
                             swapChain.getImageView(imageIndex),
@@ -503,26 +751,64 @@ void Renderer::recordCommandBuffer(vk::raii::CommandBuffer& commandBuffer, uint3
 void Renderer::rebuildRayTracingInstances(const glm::mat4& modelMatrix)
 {
     rayTracingInstances.clear();
+    rayTracingInstanceNodes.clear();
     if (!modelHandle.IsValid()) {
         return;
     }
 
-    auto visit = [&](auto&& self, const std::vector<Node*>& nodes, const glm::mat4& parentWorld) -> void {
-        for (Node* node : nodes) {
-            if (!node) continue;
-            const glm::mat4 worldFromNode = parentWorld * node->getLocalMatrix();
-            for (uint32_t meshIndex : node->meshIndices) {
-                RayTracingInstanceDesc inst{};
-                inst.meshIndex = meshIndex;
-                inst.transform = worldFromNode;
-                rayTracingInstances.push_back(inst);
-            }
-            if (!node->children.empty()) {
-                self(self, node->children, worldFromNode);
+    // Linear nodes are in the same pre-order as the recursive walk, so instance order is unchanged.
+    Model& model = *modelHandle.Get();
+    model.updateWorldMatrices(modelMatrix);
+    const auto& linearNodes = model.getLinearNodes();
+    const auto& worldMatrices = model.getWorldMatrices();
+    for (size_t i = 0; i < linearNodes.size(); ++i) {
+        const Node* node = linearNodes[i];
+        for (uint32_t meshIndex : node->meshIndices) {
+            RayTracingInstanceDesc inst{};
+            inst.meshIndex = meshIndex;
+            inst.transform = worldMatrices[i];
+            rayTracingInstances.push_back(inst);
+            rayTracingInstanceNodes.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    tlasTransformVersion = model.getTransformVersion();
+}
+
+void Renderer::updateRayTracingInstances(vk::raii::CommandBuffer& commandBuffer, const glm::mat4& modelMatrix)
+{
+    if (!vulkanContext.supportsRayQuery()) {
+        return;
+    }
+    const Model& model = *modelHandle.Get();
+    const auto& nodeVersions = model.getNodeWorldVersions();
+    const auto& worldMatrices = model.getWorldMatrices();
+    if (tlasNeedsUpdate || nodeVersions.size() != worldMatrices.size()) {
+        rebuildRayTracingInstances(modelMatrix);
+        rayTracingContext.updateTopLevelAS(commandBuffer, rayTracingInstances);
+        tlasNeedsUpdate = false;
+    } else if (model.getTransformVersion() != tlasTransformVersion) {
+        // Instances are in node pre-order, so a moved subtree maps to a few contiguous instance runs.
+        tlasDirtyRanges.clear();
+        for (uint32_t i = 0; i < static_cast<uint32_t>(rayTracingInstances.size()); ++i) {
+            const uint32_t node = rayTracingInstanceNodes[i];
+            if (nodeVersions[node] <= tlasTransformVersion) continue;
+            rayTracingInstances[i].transform = worldMatrices[node];
+            if (!tlasDirtyRanges.empty() && tlasDirtyRanges.back().begin + tlasDirtyRanges.back().count == i) {
+                ++tlasDirtyRanges.back().count;
+            } else {
+                tlasDirtyRanges.push_back(RayTracingInstanceRange{i, 1});
             }
         }
-    };
+        tlasTransformVersion = model.getTransformVersion();
+        rayTracingContext.updateTopLevelAS(commandBuffer, rayTracingInstances, tlasDirtyRanges);
+    } else {
+        return;
+    }
 
-    visit(visit, modelHandle->getRootNodes(), modelMatrix);
+    const RayTracingContext::UpdateStats& tlasStats = rayTracingContext.getLastUpdateStats();
+    lastRenderStats.tlasWrittenInstances = tlasStats.writtenInstances;
+    if (tlasStats.writtenInstances > 0) {
+        (tlasStats.rebuilt ? lastRenderStats.tlasRebuilds : lastRenderStats.tlasRefits) = 1;
+    }
 }
 
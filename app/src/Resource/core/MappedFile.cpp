@@ -0,0 +1,76 @@
+#include "Resource/core/MappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+std::shared_ptr<const MappedFile> MappedFile::open(const std::string& path)
+{
+    std::shared_ptr<MappedFile> file(new MappedFile());
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    file->fileHandle = handle;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart <= 0) {
+        return nullptr;
+    }
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        return nullptr;
+    }
+    file->mappingHandle = mapping;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        return nullptr;
+    }
+    file->bytes = static_cast<const uint8_t*>(view);
+    file->length = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return nullptr;
+    }
+    file->bytes = static_cast<const uint8_t*>(view);
+    file->length = static_cast<size_t>(st.st_size);
+#endif
+    return file;
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mappingHandle) CloseHandle(static_cast<HANDLE>(mappingHandle));
+    if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+#else
+    if (bytes) ::munmap(const_cast<uint8_t*>(bytes), length);
+#endif
+}
@@ -0,0 +1,942 @@
+#include "Resource/model/MeshCache.h"
+
+// System
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+
+// Project
+#include "Engine/Jobs/JobSystem.h"
+#include "Engine/Profiling/Trace.h"
+#include "Resource/core/MappedFile.h"
+#include "Resource/model/Model.h"
+
+namespace {
+
+constexpr char kMagic[8] = {'V', 'K', 'M', 'E', 'S', 'H', '\0', '\0'};
+constexpr uint64_t kSectionAlignment = 16;
+// Inputs larger than this are hashed as independent blocks on the job system, then the block hashes are hashed.
+constexpr size_t kHashBlockSize = 4u << 20;
+
+enum class Section : uint32_t {
+    Dependencies,
+    Strings,
+    Meshes,
+    Vertices,
+    Indices,
+    Joints,
+    Weights,
+    Nodes,
+    NodeLinks,
+    Roots,
+    Materials,
+    Textures,
+    TextureData,
+    Skins,
+    SkinJoints,
+    SkinMatrices,
+    Animations,
+    Samplers,
+    Channels,
+    Floats,
+    Count,
+};
+constexpr uint32_t kSectionCount = static_cast<uint32_t>(Section::Count);
+
+struct Header {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t loaderVersion;
+    uint64_t settingsHash;
+    uint32_t vertexStride;
+    uint32_t materialStride;
+    uint32_t sectionCount;
+    uint32_t reserved;
+    uint64_t fileSize;
+    uint64_t contentHash;  // everything after the header
+};
+
+struct SectionEntry {
+    uint32_t id;
+    uint32_t elementSize;
+    uint64_t offset;
+    uint64_t count;
+};
+
+struct StringRef {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct DependencyRecord {
+    StringRef path;
+    uint64_t size;
+    uint64_t hash;
+};
+
+// Vertex/index ranges are contiguous and in mesh order, i.e. exactly GlobalMeshBuffer's MeshDrawInfo layout.
+struct MeshRecord {
+    uint32_t firstVertex;
+    uint32_t vertexCount;
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    int32_t materialIndex;
+    uint32_t hasBounds;
+    glm::vec3 boundsMin;
+    glm::vec3 boundsMax;
+    uint32_t firstJoint;
+    uint32_t jointCount;
+    uint32_t firstWeight;
+    uint32_t weightCount;
+};
+
+// Stored in glTF node order so getNodeByGltfIndex(), skins and animation channels keep their indices.
+struct NodeRecord {
+    StringRef name;
+    glm::vec3 translation;
+    glm::quat rotation;
+    glm::vec3 scale;
+    glm::mat4 matrix;
+    uint32_t hasMatrix;
+    int32_t parent;
+    uint32_t firstChild;  // into NodeLinks
+    uint32_t childCount;
+    uint32_t firstMesh;   // into NodeLinks
+    uint32_t meshCount;
+};
+
+struct TextureRecord {
+    StringRef name;
+    int32_t imageIndex;
+    int32_t samplerIndex;
+    int32_t magFilter;
+    int32_t minFilter;
+    int32_t wrapS;
+    int32_t wrapT;
+    int32_t colorIsSrgb;  // -1 = let the KTX loader decide
+    uint32_t reserved;
+    uint64_t dataOffset;  // into TextureData (raw KTX2 file bytes)
+    uint64_t dataSize;
+};
+
+struct SkinRecord {
+    StringRef name;
+    int32_t skeletonRoot;
+    uint32_t firstJoint;
+    uint32_t jointCount;
+    uint32_t firstMatrix;
+    uint32_t matrixCount;
+};
+
+struct AnimationRecord {
+    StringRef name;
+    float start;
+    float end;
+    uint32_t firstSampler;
+    uint32_t samplerCount;
+    uint32_t firstChannel;
+    uint32_t channelCount;
+};
+
+struct SamplerRecord {
+    uint32_t interpolation;
+    int32_t outputComponents;
+    uint64_t firstInput;  // into Floats
+    uint64_t inputCount;
+    uint64_t firstOutput;
+    uint64_t outputCount;
+};
+
+struct ChannelRecord {
+    int32_t samplerIndex;  // relative to the owning animation
+    int32_t targetNode;
+    uint32_t path;
+};
+
+static_assert(std::is_trivially_copyable_v<Vertex>, "Vertex is stored raw in the mesh cache");
+static_assert(std::is_trivially_copyable_v<Material>, "Material is stored raw in the mesh cache");
+static_assert(std::is_trivially_copyable_v<NodeRecord>, "NodeRecord must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<MeshRecord>, "MeshRecord must be trivially copyable");
+
+constexpr uint32_t kElementSizes[kSectionCount] = {
+    sizeof(DependencyRecord), 1, sizeof(MeshRecord), sizeof(Vertex), sizeof(uint32_t), sizeof(glm::u16vec4),
+    sizeof(glm::vec4), sizeof(NodeRecord), sizeof(uint32_t), sizeof(uint32_t), sizeof(Material), sizeof(TextureRecord),
+    1, sizeof(SkinRecord), sizeof(int32_t), sizeof(glm::mat4), sizeof(AnimationRecord), sizeof(SamplerRecord),
+    sizeof(ChannelRecord), sizeof(float),
+};
+
+constexpr uint32_t idx(Section s) { return static_cast<uint32_t>(s); }
+
+uint64_t alignUp(uint64_t v, uint64_t a) { return (v + a - 1) & ~(a - 1); }
+
+bool inRange(uint64_t first, uint64_t count, uint64_t total) { return first <= total && count <= total - first; }
+
+// ---- XXH64-style hash ----
+constexpr uint64_t P1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t P2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t P3 = 0x165667B19E3779F9ull;
+constexpr uint64_t P4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t P5 = 0x27D4EB2F165667C5ull;
+
+uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+uint64_t read64(const uint8_t* p) { uint64_t v; std::memcpy(&v, p, 8); return v; }
+uint32_t read32(const uint8_t* p) { uint32_t v; std::memcpy(&v, p, 4); return v; }
+uint64_t hashRound(uint64_t acc, uint64_t lane) { return rotl(acc + lane * P2, 31) * P1; }
+uint64_t mergeRound(uint64_t acc, uint64_t v) { return (acc ^ hashRound(0, v)) * P1 + P4; }
+
+uint64_t hashBlock(const uint8_t* p, size_t len, uint64_t seed)
+{
+    const uint8_t* const end = p + len;
+    uint64_t h = 0;
+    if (len >= 32) {
+        uint64_t v1 = seed + P1 + P2;
+        uint64_t v2 = seed + P2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - P1;
+        const uint8_t* const limit = end - 32;
+        do {
+            v1 = hashRound(v1, read64(p));
+            v2 = hashRound(v2, read64(p + 8));
+            v3 = hashRound(v3, read64(p + 16));
+            v4 = hashRound(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        h = mergeRound(h, v1);
+        h = mergeRound(h, v2);
+        h = mergeRound(h, v3);
+        h = mergeRound(h, v4);
+    } else {
+        h = seed + P5;
+    }
+    h += static_cast<uint64_t>(len);
+    for (; p + 8 <= end; p += 8) {
+        h ^= hashRound(0, read64(p));
+        h = rotl(h, 27) * P1 + P4;
+    }
+    if (p + 4 <= end) {
+        h ^= static_cast<uint64_t>(read32(p)) * P1;
+        h = rotl(h, 23) * P2 + P3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        h ^= static_cast<uint64_t>(*p) * P5;
+        h = rotl(h, 11) * P1;
+    }
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+    return h;
+}
+
+// Typed access to the sections of a mapped (already validated) cache.
+class SectionView {
+public:
+    explicit SectionView(const uint8_t* base)
+        : base(base), entries(reinterpret_cast<const SectionEntry*>(base + sizeof(Header))) {}
+
+    template <typename T>
+    const T* data(Section s) const { return reinterpret_cast<const T*>(base + entries[idx(s)].offset); }
+    uint64_t count(Section s) const { return entries[idx(s)].count; }
+
+    std::string string(const StringRef& ref) const
+    {
+        return std::string(data<char>(Section::Strings) + ref.offset, ref.length);
+    }
+
+private:
+    const uint8_t* base;
+    const SectionEntry* entries;
+};
+
+// Writer side: section sizes are known up front, so records are written straight into the final file image.
+class CacheBuilder {
+public:
+    void reserve(Section s, uint64_t count) { counts[idx(s)] = count; }
+
+    void allocate()
+    {
+        uint64_t offset = alignUp(sizeof(Header) + sizeof(SectionEntry) * kSectionCount, kSectionAlignment);
+        for (uint32_t i = 0; i < kSectionCount; ++i) {
+            offsets[i] = offset;
+            offset = alignUp(offset + counts[i] * kElementSizes[i], kSectionAlignment);
+        }
+        image.assign(static_cast<size_t>(offset), 0u);
+        SectionEntry* entries = reinterpret_cast<SectionEntry*>(image.data() + sizeof(Header));
+        for (uint32_t i = 0; i < kSectionCount; ++i) {
+            entries[i] = SectionEntry{i, kElementSizes[i], offsets[i], counts[i]};
+        }
+    }
+
+    template <typename T>
+    T* data(Section s) { return reinterpret_cast<T*>(image.data() + offsets[idx(s)]); }
+
+    std::vector<uint8_t> image;
+
+private:
+    uint64_t counts[kSectionCount] = {};
+    uint64_t offsets[kSectionCount] = {};
+};
+
+class StringPool {
+public:
+    StringRef add(const std::string& s)
+    {
+        const StringRef ref{static_cast<uint32_t>(bytes.size()), static_cast<uint32_t>(s.size())};
+        bytes += s;
+        return ref;
+    }
+    std::string bytes;
+};
+
+bool hashFile(const std::string& path, uint64_t& outSize, uint64_t& outHash)
+{
+    std::shared_ptr<const MappedFile> file = MappedFile::open(path);
+    if (!file) return false;
+    outSize = file->size();
+    outHash = MeshCache::hashBytes(file->data(), file->size());
+    return true;
+}
+
+} // namespace
+
+uint64_t MeshCache::hashBytes(const uint8_t* data, size_t size)
+{
+    if (size <= kHashBlockSize) {
+        return hashBlock(data, size, 0);
+    }
+    const uint32_t blockCount = static_cast<uint32_t>((size + kHashBlockSize - 1) / kHashBlockSize);
+    std::vector<uint64_t> blockHashes(blockCount);
+    JobSystem::get().parallelFor(blockCount, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t b = begin; b < end; ++b) {
+            const size_t offset = static_cast<size_t>(b) * kHashBlockSize;
+            blockHashes[b] = hashBlock(data + offset, std::min(kHashBlockSize, size - offset), b);
+        }
+    });
+    return hashBlock(reinterpret_cast<const uint8_t*>(blockHashes.data()), blockHashes.size() * sizeof(uint64_t), size);
+}
+
+std::string MeshCache::cachePathFor(const std::string& sourcePath)
+{
+    return sourcePath + ".vkmesh";
+}
+
+bool MeshCache::validate(const uint8_t* data, size_t size, std::string* error)
+{
+    auto fail = [&](const char* what) {
+        if (error) *error = what;
+        return false;
+    };
+
+    if (!data || size < sizeof(Header)) return fail("truncated header");
+    const Header& header = *reinterpret_cast<const Header*>(data);
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) return fail("bad magic");
+    if (header.formatVersion != FORMAT_VERSION) return fail("format version mismatch");
+    if (header.vertexStride != sizeof(Vertex)) return fail("Vertex layout changed");
+    if (header.materialStride != sizeof(Material)) return fail("Material layout changed");
+    if (header.fileSize != size) return fail("file size mismatch");
+    if (header.sectionCount != kSectionCount) return fail("section count mismatch");
+
+    const uint64_t tableEnd = sizeof(Header) + sizeof(SectionEntry) * static_cast<uint64_t>(kSectionCount);
+    if (size < tableEnd) return fail("truncated section table");
+    if (hashBytes(data + sizeof(Header), size - sizeof(Header)) != header.contentHash) return fail("content hash mismatch");
+
+    const SectionEntry* entries = reinterpret_cast<const SectionEntry*>(data + sizeof(Header));
+    for (uint32_t i = 0; i < kSectionCount; ++i) {
+        const SectionEntry& e = entries[i];
+        if (e.id != i || e.elementSize != kElementSizes[i]) return fail("section table mismatch");
+        if (e.offset < tableEnd || e.offset % kSectionAlignment != 0 || e.offset > size) return fail("section offset out of range");
+        if (e.count > (size - e.offset) / e.elementSize) return fail("section extends past end of file");
+    }
+
+    const SectionView view(data);
+    const uint64_t stringBytes = view.count(Section::Strings);
+    auto stringOk = [&](const StringRef& r) { return inRange(r.offset, r.length, stringBytes); };
+
+    // Dependencies (the source file is always first)
+    const uint64_t depCount = view.count(Section::Dependencies);
+    if (depCount == 0) return fail("no source dependency");
+    const DependencyRecord* deps = view.data<DependencyRecord>(Section::Dependencies);
+    for (uint64_t i = 0; i < depCount; ++i) {
+        if (!stringOk(deps[i].path)) return fail("dependency path out of range");
+    }
+
+    // Meshes: contiguous streams, every index inside its own mesh
+    const uint64_t meshCount = view.count(Section::Meshes);
+    const uint64_t materialCount = view.count(Section::Materials);
+    const MeshRecord* meshes = view.data<MeshRecord>(Section::Meshes);
+    uint64_t vertexCursor = 0;
+    uint64_t indexCursor = 0;
+    for (uint64_t i = 0; i < meshCount; ++i) {
+        const MeshRecord& m = meshes[i];
+        if (m.firstVertex != vertexCursor || m.firstIndex != indexCursor) return fail("mesh streams not contiguous");
+        vertexCursor += m.vertexCount;
+        indexCursor += m.indexCount;
+        if (m.materialIndex < -1) return fail("mesh material index out of range");
+        if (!inRange(m.firstJoint, m.jointCount, view.count(Section::Joints))
+            || (m.jointCount != 0 && m.jointCount != m.vertexCount)) return fail("mesh joints out of range");
+        if (!inRange(m.firstWeight, m.weightCount, view.count(Section::Weights))
+            || (m.weightCount != 0 && m.weightCount != m.vertexCount)) return fail("mesh weights out of range");
+    }
+    if (vertexCursor != view.count(Section::Vertices) || indexCursor != view.count(Section::Indices)) {
+        return fail("mesh streams do not cover vertex/index sections");
+    }
+    if (materialCount == 0) return fail("no materials");
+
+    const uint32_t* indices = view.data<uint32_t>(Section::Indices);
+    std::atomic<bool> badIndex{false};
+    JobSystem::get().parallelFor(static_cast<uint32_t>(meshCount), 16, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end && !badIndex.load(std::memory_order_relaxed); ++i) {
+            const MeshRecord& m = meshes[i];
+            const uint32_t* first = indices + m.firstIndex;
+            for (uint32_t k = 0; k < m.indexCount; ++k) {
+                if (first[k] >= m.vertexCount) {
+                    badIndex.store(true, std::memory_order_relaxed);
+                    break;
+                }
+            }
+        }
+    });
+    if (badIndex.load()) return fail("index out of mesh vertex range");
+
+    // Nodes: every child link points back at its parent and is listed once, roots are parentless.
+    // Together this means the roots span a forest, so rebuildLinearNodes() cannot loop.
+    const uint64_t nodeCount = view.count(Section::Nodes);
+    const uint64_t linkCount = view.count(Section::NodeLinks);
+    const NodeRecord* nodes = view.data<NodeRecord>(Section::Nodes);
+    const uint32_t* links = view.data<uint32_t>(Section::NodeLinks);
+    std::vector<uint8_t> listed(static_cast<size_t>(nodeCount), 0u);
+    for (uint64_t i = 0; i < nodeCount; ++i) {
+        const NodeRecord& n = nodes[i];
+        if (!stringOk(n.name)) return fail("node name out of range");
+        if (n.parent < -1 || n.parent >= static_cast<int64_t>(nodeCount)) return fail("node parent out of range");
+        if (!inRange(n.firstChild, n.childCount, linkCount) || !inRange(n.firstMesh, n.meshCount, linkCount)) {
+            return fail("node links out of range");
+        }
+        for (uint32_t c = 0; c < n.childCount; ++c) {
+            const uint32_t child = links[n.firstChild + c];
+            if (child >= nodeCount || nodes[child].parent != static_cast<int64_t>(i) || listed[child]) {
+                return fail("node hierarchy is not a tree");
+            }
+            listed[child] = 1u;
+        }
+        for (uint32_t k = 0; k < n.meshCount; ++k) {
+            if (links[n.firstMesh + k] >= meshCount) return fail("node mesh index out of range");
+        }
+    }
+    const uint32_t* roots = view.data<uint32_t>(Section::Roots);
+    for (uint64_t i = 0; i < view.count(Section::Roots); ++i) {
+        const uint32_t r = roots[i];
+        if (r >= nodeCount || nodes[r].parent != -1 || listed[r]) return fail("invalid root node");
+        listed[r] = 1u;
+    }
+
+    // Textures
+    const TextureRecord* textures = view.data<TextureRecord>(Section::Textures);
+    for (uint64_t i = 0; i < view.count(Section::Textures); ++i) {
+        const TextureRecord& t = textures[i];
+        if (!stringOk(t.name)) return fail("texture name out of range");
+        if (!inRange(t.dataOffset, t.dataSize, view.count(Section::TextureData))) return fail("texture payload out of range");
+    }
+
+    // Skins
+    const SkinRecord* skins = view.data<SkinRecord>(Section::Skins);
+    const int32_t* skinJoints = view.data<int32_t>(Section::SkinJoints);
+    for (uint64_t i = 0; i < view.count(Section::Skins); ++i) {
+        const SkinRecord& s = skins[i];
+        if (!stringOk(s.name)) return fail("skin name out of range");
+        if (!inRange(s.firstJoint, s.jointCount, view.count(Section::SkinJoints))
+            || !inRange(s.firstMatrix, s.matrixCount, view.count(Section::SkinMatrices))) {
+            return fail("skin ranges out of range");
+        }
+        for (uint32_t j = 0; j < s.jointCount; ++j) {
+            const int32_t joint = skinJoints[s.firstJoint + j];
+            if (joint < 0 || joint >= static_cast<int64_t>(nodeCount)) return fail("skin joint out of range");
+        }
+    }
+
+    // Animations
+    const uint64_t floatCount = view.count(Section::Floats);
+    const AnimationRecord* animations = view.data<AnimationRecord>(Section::Animations);
+    const SamplerRecord* samplers = view.data<SamplerRecord>(Section::Samplers);
+    const ChannelRecord* channels = view.data<ChannelRecord>(Section::Channels);
+    for (uint64_t i = 0; i < view.count(Section::Animations); ++i) {
+        const AnimationRecord& a = animations[i];
+        if (!stringOk(a.name)) return fail("animation name out of range");
+        if (!inRange(a.firstSampler, a.samplerCount, view.count(Section::Samplers))
+            || !inRange(a.firstChannel, a.channelCount, view.count(Section::Channels))) {
+            return fail("animation ranges out of range");
+        }
+        for (uint32_t s = 0; s < a.samplerCount; ++s) {
+            const SamplerRecord& sr = samplers[a.firstSampler + s];
+            if (sr.interpolation > static_cast<uint32_t>(AnimationInterpolation::CubicSpline)
+                || !inRange(sr.firstInput, sr.inputCount, floatCount)
+                || !inRange(sr.firstOutput, sr.outputCount, floatCount)) {
+                return fail("animation sampler out of range");
+            }
+        }
+        for (uint32_t c = 0; c < a.channelCount; ++c) {
+            const ChannelRecord& cr = channels[a.firstChannel + c];
+            if (cr.samplerIndex < -1 || cr.samplerIndex >= static_cast<int64_t>(a.samplerCount)
+                || cr.targetNode < -1 || cr.targetNode >= static_cast<int64_t>(nodeCount)
+                || cr.path > static_cast<uint32_t>(AnimationPath::Weights)) {
+                return fail("animation channel out of range");
+            }
+        }
+    }
+    return true;
+}
+
+bool MeshCache::read(const std::string& sourcePath, uint32_t loaderVersion, uint64_t settingsHash,
+                     Model& model, std::vector<KtxMemorySource>& outTextures, std::string* reason)
+{
+    TRACE_SCOPE("MeshCache::read");
+    auto miss = [&](std::string why) {
+        if (reason) *reason = std::move(why);
+        return false;
+    };
+
+    const std::string cachePath = cachePathFor(sourcePath);
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(cachePath, ec)) return miss("missing");
+    std::shared_ptr<const MappedFile> file = MappedFile::open(cachePath);
+    if (!file) return miss("missing");
+
+    std::string error;
+    if (!validate(file->data(), file->size(), &error)) return miss("invalid: " + error);
+    const Header& header = *reinterpret_cast<const Header*>(file->data());
+    if (header.loaderVersion != loaderVersion) return miss("stale: loader version changed");
+    if (header.settingsHash != settingsHash) return miss("stale: load settings changed");
+
+    const SectionView view(file->data());
+    const DependencyRecord* deps = view.data<DependencyRecord>(Section::Dependencies);
+    for (uint64_t i = 0; i < view.count(Section::Dependencies); ++i) {
+        const std::string path = view.string(deps[i].path);
+        uint64_t size = 0;
+        uint64_t hash = 0;
+        if (!hashFile(path, size, hash) || size != deps[i].size || hash != deps[i].hash) {
+            return miss("stale: " + path + " changed");
+        }
+    }
+
+    model.clear();
+
+    // Meshes: CPU copies are still needed (GpuMesh, BLAS builds, culling), filled straight from the mapping.
+    const uint32_t meshCount = static_cast<uint32_t>(view.count(Section::Meshes));
+    const MeshRecord* meshRecords = view.data<MeshRecord>(Section::Meshes);
+    const Vertex* vertices = view.data<Vertex>(Section::Vertices);
+    const uint32_t* indices = view.data<uint32_t>(Section::Indices);
+    const glm::u16vec4* joints = view.data<glm::u16vec4>(Section::Joints);
+    const glm::vec4* weights = view.data<glm::vec4>(Section::Weights);
+    model.meshes.resize(meshCount);
+    JobSystem::get().parallelFor(meshCount, 16, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const MeshRecord& r = meshRecords[i];
+            Mesh& mesh = model.meshes[i];
+            mesh.vertices.assign(vertices + r.firstVertex, vertices + r.firstVertex + r.vertexCount);
+            mesh.indices.assign(indices + r.firstIndex, indices + r.firstIndex + r.indexCount);
+            mesh.joints0.assign(joints + r.firstJoint, joints + r.firstJoint + r.jointCount);
+            mesh.weights0.assign(weights + r.firstWeight, weights + r.firstWeight + r.weightCount);
+            mesh.materialIndex = r.materialIndex;
+            mesh.bounds = BoundingBox(r.boundsMin, r.boundsMax);
+            mesh.hasBounds = r.hasBounds != 0u;
+        }
+    });
+
+    // Materials
+    const Material* materials = view.data<Material>(Section::Materials);
+    model.materials.assign(materials, materials + view.count(Section::Materials));
+
+    // Nodes
+    const size_t nodeCount = static_cast<size_t>(view.count(Section::Nodes));
+    const NodeRecord* nodeRecords = view.data<NodeRecord>(Section::Nodes);
+    const uint32_t* links = view.data<uint32_t>(Section::NodeLinks);
+    model.ownedNodes.resize(nodeCount);
+    for (size_t i = 0; i < nodeCount; ++i) {
+        model.ownedNodes[i] = std::make_unique<Node>();
+    }
+    for (size_t i = 0; i < nodeCount; ++i) {
+        const NodeRecord& r = nodeRecords[i];
+        Node& dst = *model.ownedNodes[i];
+        dst.name = view.string(r.name);
+        dst.parent = r.parent >= 0 ? model.ownedNodes[static_cast<size_t>(r.parent)].get() : nullptr;
+        dst.translation = r.translation;
+        dst.rotation = r.rotation;
+        dst.scale = r.scale;
+        dst.matrix = r.matrix;
+        dst.hasMatrix = r.hasMatrix != 0u;
+        dst.children.reserve(r.childCount);
+        for (uint32_t c = 0; c < r.childCount; ++c) {
+            dst.children.push_back(model.ownedNodes[links[r.firstChild + c]].get());
+        }
+        dst.meshIndices.assign(links + r.firstMesh, links + r.firstMesh + r.meshCount);
+    }
+    const uint32_t* roots = view.data<uint32_t>(Section::Roots);
+    model.nodes.reserve(static_cast<size_t>(view.count(Section::Roots)));
+    for (uint64_t i = 0; i < view.count(Section::Roots); ++i) {
+        model.nodes.push_back(model.ownedNodes[roots[i]].get());
+    }
+    model.rebuildLinearNodes();
+
+    // Textures: metadata only; the embedded KTX2 payloads stay in the mapping for the caller's batch load.
+    const size_t textureCount = static_cast<size_t>(view.count(Section::Textures));
+    const TextureRecord* textureRecords = view.data<TextureRecord>(Section::Textures);
+    const uint8_t* textureData = view.data<uint8_t>(Section::TextureData);
+    model.textures.resize(textureCount);
+    outTextures.assign(textureCount, KtxMemorySource{});
+    for (size_t i = 0; i < textureCount; ++i) {
+        const TextureRecord& r = textureRecords[i];
+        GltfTexture& t = model.textures[i];
+        t.imageIndex = r.imageIndex;
+        t.samplerIndex = r.samplerIndex;
+        t.sampler.magFilter = r.magFilter;
+        t.sampler.minFilter = r.minFilter;
+        t.sampler.wrapS = r.wrapS;
+        t.sampler.wrapT = r.wrapT;
+
+        KtxMemorySource& src = outTextures[i];
+        src.name = view.string(r.name);
+        if (r.dataSize > 0) {
+            src.data = textureData + r.dataOffset;
+            src.size = static_cast<size_t>(r.dataSize);
+        }
+        if (r.colorIsSrgb >= 0) src.colorIsSrgb = r.colorIsSrgb != 0;
+    }
+
+    // Skins
+    const SkinRecord* skinRecords = view.data<SkinRecord>(Section::Skins);
+    const int32_t* skinJoints = view.data<int32_t>(Section::SkinJoints);
+    const glm::mat4* skinMatrices = view.data<glm::mat4>(Section::SkinMatrices);
+    model.skins.resize(static_cast<size_t>(view.count(Section::Skins)));
+    for (size_t i = 0; i < model.skins.size(); ++i) {
+        const SkinRecord& r = skinRecords[i];
+        Skin& s = model.skins[i];
+        s.name = view.string(r.name);
+        s.skeletonRoot = r.skeletonRoot;
+        s.joints.assign(skinJoints + r.firstJoint, skinJoints + r.firstJoint + r.jointCount);
+        s.inverseBindMatrices.assign(skinMatrices + r.firstMatrix, skinMatrices + r.firstMatrix + r.matrixCount);
+    }
+
+    // Animations
+    const AnimationRecord* animationRecords = view.data<AnimationRecord>(Section::Animations);
+    const SamplerRecord* samplerRecords = view.data<SamplerRecord>(Section::Samplers);
+    const ChannelRecord* channelRecords = view.data<ChannelRecord>(Section::Channels);
+    const float* floats = view.data<float>(Section::Floats);
+    model.animations.resize(static_cast<size_t>(view.count(Section::Animations)));
+    for (size_t i = 0; i < model.animations.size(); ++i) {
+        const AnimationRecord& r = animationRecords[i];
+        Animation& a = model.animations[i];
+        a.name = view.string(r.name);
+        a.start = r.start;
+        a.end = r.end;
+        a.samplers.resize(r.samplerCount);
+        for (uint32_t s = 0; s < r.samplerCount; ++s) {
+            const SamplerRecord& sr = samplerRecords[r.firstSampler + s];
+            AnimationSampler& dst = a.samplers[s];
+            dst.interpolation = static_cast<AnimationInterpolation>(sr.interpolation);
+            dst.outputComponents = sr.outputComponents;
+            dst.inputs.assign(floats + sr.firstInput, floats + sr.firstInput + sr.inputCount);
+            dst.outputs.assign(floats + sr.firstOutput, floats + sr.firstOutput + sr.outputCount);
+        }
+        a.channels.resize(r.channelCount);
+        for (uint32_t c = 0; c < r.channelCount; ++c) {
+            const ChannelRecord& cr = channelRecords[r.firstChannel + c];
+            a.channels[c].samplerIndex = cr.samplerIndex;
+            a.channels[c].targetNode = cr.targetNode;
+            a.channels[c].path = static_cast<AnimationPath>(cr.path);
+        }
+    }
+
+    CookedMeshStreams cooked;
+    cooked.vertices = vertices;
+    cooked.vertexCount = static_cast<size_t>(view.count(Section::Vertices));
+    cooked.indices = indices;
+    cooked.indexCount = static_cast<size_t>(view.count(Section::Indices));
+    cooked.file = std::move(file);
+    model.cookedMeshStreams = std::move(cooked);
+    return true;
+}
+
+bool MeshCache::write(const std::string& sourcePath, uint32_t loaderVersion, uint64_t settingsHash,
+                      const Model& model, const std::vector<std::string>& dependencies,
+                      const std::vector<KtxMemorySource>& textures)
+{
+    TRACE_SCOPE("MeshCache::write");
+    if (textures.size() != model.textures.size()) return false;
+
+    StringPool strings;
+
+    // Dependencies: the source must be hashable; external files that cannot be opened are simply not tracked.
+    struct Dependency {
+        StringRef path;
+        uint64_t size = 0;
+        uint64_t hash = 0;
+    };
+    std::vector<Dependency> deps;
+    {
+        Dependency source;
+        if (!hashFile(sourcePath, source.size, source.hash)) return false;
+        source.path = strings.add(sourcePath);
+        deps.push_back(source);
+        for (const std::string& path : dependencies) {
+            Dependency d;
+            if (hashFile(path, d.size, d.hash)) {
+                d.path = strings.add(path);
+                deps.push_back(d);
+            }
+        }
+    }
+
+    std::unordered_map<const Node*, uint32_t> nodeIndex;
+    nodeIndex.reserve(model.ownedNodes.size());
+    for (size_t i = 0; i < model.ownedNodes.size(); ++i) {
+        nodeIndex.emplace(model.ownedNodes[i].get(), static_cast<uint32_t>(i));
+    }
+
+    uint64_t vertexCount = 0, indexCount = 0, jointCount = 0, weightCount = 0;
+    for (const Mesh& m : model.meshes) {
+        vertexCount += m.vertices.size();
+        indexCount += m.indices.size();
+        jointCount += m.joints0.size();
+        weightCount += m.weights0.size();
+    }
+    if (vertexCount > UINT32_MAX || indexCount > UINT32_MAX) return false;
+
+    uint64_t linkCount = 0;
+    std::vector<StringRef> nodeNames(model.ownedNodes.size());
+    for (size_t i = 0; i < model.ownedNodes.size(); ++i) {
+        const Node& n = *model.ownedNodes[i];
+        linkCount += n.children.size() + n.meshIndices.size();
+        nodeNames[i] = strings.add(n.name);
+    }
+
+    uint64_t textureBytes = 0;
+    std::vector<StringRef> textureNames(textures.size());
+    for (size_t i = 0; i < textures.size(); ++i) {
+        if (textures[i].data) textureBytes += textures[i].size;
+        textureNames[i] = strings.add(textures[i].name);
+    }
+
+    uint64_t skinJointCount = 0, skinMatrixCount = 0;
+    std::vector<StringRef> skinNames(model.skins.size());
+    for (size_t i = 0; i < model.skins.size(); ++i) {
+        skinJointCount += model.skins[i].joints.size();
+        skinMatrixCount += model.skins[i].inverseBindMatrices.size();
+        skinNames[i] = strings.add(model.skins[i].name);
+    }
+
+    uint64_t samplerCount = 0, channelCount = 0, floatCount = 0;
+    std::vector<StringRef> animationNames(model.animations.size());
+    for (size_t i = 0; i < model.animations.size(); ++i) {
+        const Animation& a = model.animations[i];
+        samplerCount += a.samplers.size();
+        channelCount += a.channels.size();
+        for (const AnimationSampler& s : a.samplers) floatCount += s.inputs.size() + s.outputs.size();
+        animationNames[i] = strings.add(a.name);
+    }
+
+    CacheBuilder builder;
+    builder.reserve(Section::Dependencies, deps.size());
+    builder.reserve(Section::Strings, strings.bytes.size());
+    builder.reserve(Section::Meshes, model.meshes.size());
+    builder.reserve(Section::Vertices, vertexCount);
+    builder.reserve(Section::Indices, indexCount);
+    builder.reserve(Section::Joints, jointCount);
+    builder.reserve(Section::Weights, weightCount);
+    builder.reserve(Section::Nodes, model.ownedNodes.size());
+    builder.reserve(Section::NodeLinks, linkCount);
+    builder.reserve(Section::Roots, model.nodes.size());
+    builder.reserve(Section::Materials, model.materials.size());
+    builder.reserve(Section::Textures, textures.size());
+    builder.reserve(Section::TextureData, textureBytes);
+    builder.reserve(Section::Skins, model.skins.size());
+    builder.reserve(Section::SkinJoints, skinJointCount);
+    builder.reserve(Section::SkinMatrices, skinMatrixCount);
+    builder.reserve(Section::Animations, model.animations.size());
+    builder.reserve(Section::Samplers, samplerCount);
+    builder.reserve(Section::Channels, channelCount);
+    builder.reserve(Section::Floats, floatCount);
+    builder.allocate();
+
+    DependencyRecord* depOut = builder.data<DependencyRecord>(Section::Dependencies);
+    for (size_t i = 0; i < deps.size(); ++i) {
+        depOut[i] = DependencyRecord{deps[i].path, deps[i].size, deps[i].hash};
+    }
+    std::memcpy(builder.data<char>(Section::Strings), strings.bytes.data(), strings.bytes.size());
+
+    // Meshes
+    MeshRecord* meshOut = builder.data<MeshRecord>(Section::Meshes);
+    Vertex* vertexOut = builder.data<Vertex>(Section::Vertices);
+    uint32_t* indexOut = builder.data<uint32_t>(Section::Indices);
+    glm::u16vec4* jointOut = builder.data<glm::u16vec4>(Section::Joints);
+    glm::vec4* weightOut = builder.data<glm::vec4>(Section::Weights);
+    uint32_t firstVertex = 0, firstIndex = 0, firstJoint = 0, firstWeight = 0;
+    for (size_t i = 0; i < model.meshes.size(); ++i) {
+        const Mesh& m = model.meshes[i];
+        MeshRecord& r = meshOut[i];
+        r.firstVertex = firstVertex;
+        r.vertexCount = static_cast<uint32_t>(m.vertices.size());
+        r.firstIndex = firstIndex;
+        r.indexCount = static_cast<uint32_t>(m.indices.size());
+        r.materialIndex = m.materialIndex;
+        r.hasBounds = m.hasBounds ? 1u : 0u;
+        r.boundsMin = m.bounds.min;
+        r.boundsMax = m.bounds.max;
+        r.firstJoint = firstJoint;
+        r.jointCount = static_cast<uint32_t>(m.joints0.size());
+        r.firstWeight = firstWeight;
+        r.weightCount = static_cast<uint32_t>(m.weights0.size());
+        std::copy(m.vertices.begin(), m.vertices.end(), vertexOut + firstVertex);
+        std::copy(m.indices.begin(), m.indices.end(), indexOut + firstIndex);
+        std::copy(m.joints0.begin(), m.joints0.end(), jointOut + firstJoint);
+        std::copy(m.weights0.begin(), m.weights0.end(), weightOut + firstWeight);
+        firstVertex += r.vertexCount;
+        firstIndex += r.indexCount;
+        firstJoint += r.jointCount;
+        firstWeight += r.weightCount;
+    }
+
+    // Nodes
+    NodeRecord* nodeOut = builder.data<NodeRecord>(Section::Nodes);
+    uint32_t* linkOut = builder.data<uint32_t>(Section::NodeLinks);
+    uint32_t linkCursor = 0;
+    for (size_t i = 0; i < model.ownedNodes.size(); ++i) {
+        const Node& n = *model.ownedNodes[i];
+        NodeRecord& r = nodeOut[i];
+        r.name = nodeNames[i];
+        r.translation = n.translation;
+        r.rotation = n.rotation;
+        r.scale = n.scale;
+        r.matrix = n.matrix;
+        r.hasMatrix = n.hasMatrix ? 1u : 0u;
+        r.parent = n.parent ? static_cast<int32_t>(nodeIndex.at(n.parent)) : -1;
+        r.firstChild = linkCursor;
+        r.childCount = static_cast<uint32_t>(n.children.size());
+        for (const Node* c : n.children) linkOut[linkCursor++] = nodeIndex.at(c);
+        r.firstMesh = linkCursor;
+        r.meshCount = static_cast<uint32_t>(n.meshIndices.size());
+        for (uint32_t m : n.meshIndices) linkOut[linkCursor++] = m;
+    }
+    uint32_t* rootOut = builder.data<uint32_t>(Section::Roots);
+    for (size_t i = 0; i < model.nodes.size(); ++i) {
+        rootOut[i] = nodeIndex.at(model.nodes[i]);
+    }
+
+    std::copy(model.materials.begin(), model.materials.end(), builder.data<Material>(Section::Materials));
+
+    // Textures
+    TextureRecord* textureOut = builder.data<TextureRecord>(Section::Textures);
+    uint8_t* textureDataOut = builder.data<uint8_t>(Section::TextureData);
+    uint64_t textureCursor = 0;
+    for (size_t i = 0; i < textures.size(); ++i) {
+        const GltfTexture& t = model.textures[i];
+        const KtxMemorySource& src = textures[i];
+        TextureRecord& r = textureOut[i];
+        r.name = textureNames[i];
+        r.imageIndex = t.imageIndex;
+        r.samplerIndex = t.samplerIndex;
+        r.magFilter = t.sampler.magFilter;
+        r.minFilter = t.sampler.minFilter;
+        r.wrapS = t.sampler.wrapS;
+        r.wrapT = t.sampler.wrapT;
+        r.colorIsSrgb = src.colorIsSrgb ? (*src.colorIsSrgb ? 1 : 0) : -1;
+        r.dataOffset = textureCursor;
+        r.dataSize = src.data ? src.size : 0u;
+        if (r.dataSize > 0) std::memcpy(textureDataOut + textureCursor, src.data, src.size);
+        textureCursor += r.dataSize;
+    }
+
+    // Skins
+    SkinRecord* skinOut = builder.data<SkinRecord>(Section::Skins);
+    int32_t* skinJointOut = builder.data<int32_t>(Section::SkinJoints);
+    glm::mat4* skinMatrixOut = builder.data<glm::mat4>(Section::SkinMatrices);
+    uint32_t skinJointCursor = 0, skinMatrixCursor = 0;
+    for (size_t i = 0; i < model.skins.size(); ++i) {
+        const Skin& s = model.skins[i];
+        SkinRecord& r = skinOut[i];
+        r.name = skinNames[i];
+        r.skeletonRoot = s.skeletonRoot;
+        r.firstJoint = skinJointCursor;
+        r.jointCount = static_cast<uint32_t>(s.joints.size());
+        r.firstMatrix = skinMatrixCursor;
+        r.matrixCount = static_cast<uint32_t>(s.inverseBindMatrices.size());
+        for (int j : s.joints) skinJointOut[skinJointCursor++] = static_cast<int32_t>(j);
+        std::copy(s.inverseBindMatrices.begin(), s.inverseBindMatrices.end(), skinMatrixOut + skinMatrixCursor);
+        skinMatrixCursor += r.matrixCount;
+    }
+
+    // Animations
+    AnimationRecord* animationOut = builder.data<AnimationRecord>(Section::Animations);
+    SamplerRecord* samplerOut = builder.data<SamplerRecord>(Section::Samplers);
+    ChannelRecord* channelOut = builder.data<ChannelRecord>(Section::Channels);
+    float* floatOut = builder.data<float>(Section::Floats);
+    uint32_t samplerCursor = 0, channelCursor = 0;
+    uint64_t floatCursor = 0;
+    for (size_t i = 0; i < model.animations.size(); ++i) {
+        const Animation& a = model.animations[i];
+        AnimationRecord& r = animationOut[i];
+        r.name = animationNames[i];
+        r.start = a.start;
+        r.end = a.end;
+        r.firstSampler = samplerCursor;
+        r.samplerCount = static_cast<uint32_t>(a.samplers.size());
+        r.firstChannel = channelCursor;
+        r.channelCount = static_cast<uint32_t>(a.channels.size());
+        for (const AnimationSampler& s : a.samplers) {
+            SamplerRecord& sr = samplerOut[samplerCursor++];
+            sr.interpolation = static_cast<uint32_t>(s.interpolation);
+            sr.outputComponents = s.outputComponents;
+            sr.firstInput = floatCursor;
+            sr.inputCount = s.inputs.size();
+            std::copy(s.inputs.begin(), s.inputs.end(), floatOut + floatCursor);
+            floatCursor += s.inputs.size();
+            sr.firstOutput = floatCursor;
+            sr.outputCount = s.outputs.size();
+            std::copy(s.outputs.begin(), s.outputs.end(), floatOut + floatCursor);
+            floatCursor += s.outputs.size();
+        }
+        for (const AnimationChannel& c : a.channels) {
+            channelOut[channelCursor++] = ChannelRecord{c.samplerIndex, c.targetNode, static_cast<uint32_t>(c.path)};
+        }
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.formatVersion = FORMAT_VERSION;
+    header.loaderVersion = loaderVersion;
+    header.settingsHash = settingsHash;
+    header.vertexStride = sizeof(Vertex);
+    header.materialStride = sizeof(Material);
+    header.sectionCount = kSectionCount;
+    header.fileSize = builder.image.size();
+    header.contentHash = hashBytes(builder.image.data() + sizeof(Header), builder.image.size() - sizeof(Header));
+    std::memcpy(builder.image.data(), &header, sizeof(Header));
+
+    // Write-then-rename so a crash or a concurrent reader never sees a half-written cache.
+    const std::string cachePath = cachePathFor(sourcePath);
+    const std::string tempPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(reinterpret_cast<const char*>(builder.image.data()), static_cast<std::streamsize>(builder.image.size()));
+        if (!out) {
+            out.close();
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
@@ -7,38 +7,15 @@
 #include <limits>
 
 // Third-party
-#include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 
 // Project
 #include "Configs/AppConfig.h"
+#include "Engine/Jobs/JobSystem.h"
 #include "Rendering/RHI/Vulkan/VulkanTypes.h"
 #include "Resource/model/loaders/GltfModelLoader.h"
 #include "Resource/model/loaders/ObjModelLoader.h"
 
-glm::mat4 Node::getLocalMatrix() const
-{
-    // glTF semantics: use either matrix OR TRS (matrix overrides TRS).
-    if (hasMatrix) {
-        return matrix;
-    }
-    // Match tutorial order: T * R * S
-    return glm::translate(glm::mat4(1.0f), translation)
-        * glm::mat4_cast(rotation)
-        * glm::scale(glm::mat4(1.0f), scale);
-}
-
-glm::mat4 Node::getGlobalMatrix() const
-{
-    glm::mat4 m = getLocalMatrix();
-    const Node* p = parent;
-    while (p) {
-        m = p->getLocalMatrix() * m;
-        p = p->parent;
-    }
-    return m;
-}
-
 Node* Model::findNode(const std::string& name) const
 {
     for (Node* n : linearNodes) {
@@ -110,6 +87,7 @@ bool Model::updateAnimation(uint32_t index, float deltaTime)
                              sampler.outputs[(i + 1) * comps + 2]);
                 node->translation = glm::mix(start, end, t);
                 node->hasMatrix = false;
+                node->transformDirty = true;
                 modified = true;
             }
             break;
@@ -128,6 +106,7 @@ bool Model::updateAnimation(uint32_t index, float deltaTime)
                               sampler.outputs[(i + 1) * quatComps + 2]);
                 node->rotation = glm::normalize(glm::slerp(start, end, t));
                 node->hasMatrix = false;
+                node->transformDirty = true;
                 modified = true;
             }
             break;
@@ -142,6 +121,7 @@ bool Model::updateAnimation(uint32_t index, float deltaTime)
                              sampler.outputs[(i + 1) * comps + 2]);
                 node->scale = glm::mix(start, end, t);
                 node->hasMatrix = false;
+                node->transformDirty = true;
                 modified = true;
             }
             break;
@@ -153,6 +133,110 @@ bool Model::updateAnimation(uint32_t index, float deltaTime)
     return modified;
 }
 
+void Model::markTransformDirty(Node* node)
+{
+    if (node) {
+        node->transformDirty = true;
+    }
+}
+
+uint32_t Model::updateWorldMatrices(const glm::mat4& sceneMatrix)
+{
+    const uint32_t count = static_cast<uint32_t>(linearNodes.size());
+    if (transformStore.size() != count) {
+        transformStore.build(linearNodes);
+    }
+    if (localMatrices.size() != count || worldMatrices.size() != count) {
+        localMatrices.assign(count, glm::mat4(1.0f));
+        worldMatrices.assign(count, glm::mat4(1.0f));
+        nodeWorldVersions.assign(count, 0u);
+        for (Node* n : linearNodes) {
+            n->transformDirty = true;
+        }
+        hasCachedSceneMatrix = false;
+    }
+
+    const bool sceneChanged = !hasCachedSceneMatrix || cachedSceneMatrix != sceneMatrix;
+    cachedSceneMatrix = sceneMatrix;
+    hasCachedSceneMatrix = true;
+
+    // linearNodes is pre-order, so a dirty node's subtree is the contiguous range [i, subtreeEnd)
+    // and every parent is finalized before its children are visited.
+    dirtyRanges.clear();
+    movedNodes.clear();
+    uint32_t updated = 0;
+    uint32_t i = 0;
+    while (i < count) {
+        Node* n = linearNodes[i];
+        if (!sceneChanged && !n->transformDirty) {
+            ++i;
+            continue;
+        }
+        const uint32_t end = std::max(std::min(n->subtreeEnd, count), i + 1);
+        bool localsDirty = false;
+        for (uint32_t j = i; j < end; ++j) {
+            Node* m = linearNodes[j];
+            if (m->transformDirty) {
+                transformStore.setLocal(j, *m);
+                m->transformDirty = false;
+                movedNodes.push_back(j);
+                localsDirty = true;
+            }
+        }
+        dirtyRanges.push_back(TransformRange{i, end, localsDirty});
+        std::fill(nodeWorldVersions.begin() + i, nodeWorldVersions.begin() + end, transformVersion + 1u);
+        updated += end - i;
+        i = end;
+    }
+
+    // SoA compose + parent multiply per range (SIMD); a pure scene change keeps locals.
+    auto processRange = [&](const TransformRange& r) {
+        if (r.composeLocals) {
+            transformStore.composeLocal(r.begin, r.end, localMatrices.data());
+        }
+        transformStore.propagate(r.begin, r.end, sceneMatrix, localMatrices.data(), worldMatrices.data());
+    };
+
+    if (updated < PARALLEL_TRANSFORM_MIN_NODES) {
+        for (const TransformRange& r : dirtyRanges) {
+            processRange(r);
+        }
+    } else {
+        // Split large subtrees: finalize the subtree root here, after which each child subtree only
+        // depends on already-written matrices and can run as an independent job.
+        parallelRanges.clear();
+        while (!dirtyRanges.empty()) {
+            const TransformRange r = dirtyRanges.back();
+            dirtyRanges.pop_back();
+            if (r.end - r.begin <= PARALLEL_TRANSFORM_GRAIN) {
+                parallelRanges.push_back(r);
+                continue;
+            }
+            processRange(TransformRange{r.begin, r.begin + 1, r.composeLocals});
+            for (const Node* c : linearNodes[r.begin]->children) {
+                if (!c) continue;
+                const uint32_t cEnd = std::max(std::min(c->subtreeEnd, r.end), c->linearIndex + 1);
+                dirtyRanges.push_back(TransformRange{c->linearIndex, cEnd, r.composeLocals});
+            }
+        }
+        JobSystem::get().parallelFor(static_cast<uint32_t>(parallelRanges.size()), 1,
+                                     [&](uint32_t begin, uint32_t end) {
+                                         for (uint32_t k = begin; k < end; ++k) {
+                                             processRange(parallelRanges[k]);
+                                         }
+                                     });
+    }
+
+    // Subtree bounds are in node space, so only local changes (not the scene matrix) invalidate them: refit the
+    // ancestors of moved nodes so culling never prunes or hides a subtree through a stale load-time box.
+    refitAncestorBounds();
+
+    if (updated > 0) {
+        ++transformVersion;
+    }
+    return updated;
+}
+
 void Model::clear()
 {
     ownedNodes.clear();
@@ -163,6 +247,12 @@ void Model::clear()
     meshes.clear();
     skins.clear();
     animations.clear();
+    cookedMeshStreams = CookedMeshStreams{};
+    transformStore.clear();
+    localMatrices.clear();
+    worldMatrices.clear();
+    nodeWorldVersions.clear();
+    hasCachedSceneMatrix = false;
 }
 
 void Model::rebuildLinearNodes()
@@ -174,14 +264,17 @@ void Model::rebuildLinearNodes()
         if (!n) return;
         linearNodes.push_back(n);
         n->linearIndex = static_cast<uint32_t>(linearNodes.size() - 1);
+        n->transformDirty = true;
         for (Node* c : n->children) {
             visit(c);
         }
+        n->subtreeEnd = static_cast<uint32_t>(linearNodes.size());
     };
 
     for (Node* root : nodes) {
         visit(root);
     }
+    transformStore.build(linearNodes);
 }
 
 namespace {
@@ -247,6 +340,42 @@ void Model::rebuildBounds()
     }
 }
 
+void Model::refitAncestorBounds()
+{
+    if (movedNodes.empty()) return;
+    const uint32_t count = static_cast<uint32_t>(linearNodes.size());
+    refitMarks.assign(count, 0u);
+    refitNodes.clear();
+    for (uint32_t j : movedNodes) {
+        for (Node* p = linearNodes[j]->parent; p && p->linearIndex < count && !refitMarks[p->linearIndex];
+             p = p->parent) {
+            refitMarks[p->linearIndex] = 1u;
+            refitNodes.push_back(p->linearIndex);
+        }
+    }
+    // Pre-order: a child's linear index is greater than its parent's, so descending order refits children first.
+    std::sort(refitNodes.begin(), refitNodes.end(), std::greater<uint32_t>());
+
+    for (uint32_t i : refitNodes) {
+        Node* n = linearNodes[i];
+        BoundingBox acc = makeEmptyBounds();
+        bool valid = false;
+        for (uint32_t meshIndex : n->meshIndices) {
+            if (meshIndex >= meshes.size()) continue;
+            const Mesh& m = meshes[meshIndex];
+            unionInto(acc, valid, m.bounds, m.hasBounds);
+        }
+        for (Node* c : n->children) {
+            if (!c || !c->hasSubtreeBounds || c->linearIndex >= count) continue;
+            BoundingBox childBox = c->subtreeBounds;
+            childBox.Transform(localMatrices[c->linearIndex]);
+            unionInto(acc, valid, childBox, true);
+        }
+        n->hasSubtreeBounds = valid;
+        n->subtreeBounds = valid ? acc : BoundingBox{};
+    }
+}
+
 bool Model::doLoad()
 {
     clear();
@@ -0,0 +1,27 @@
+#include "Resource/model/Node.h"
+
+// Third-party
+#include <glm/gtc/matrix_transform.hpp>
+
+glm::mat4 Node::getLocalMatrix() const
+{
+    // glTF semantics: use either matrix OR TRS (matrix overrides TRS).
+    if (hasMatrix) {
+        return matrix;
+    }
+    // Match tutorial order: T * R * S
+    return glm::translate(glm::mat4(1.0f), translation)
+        * glm::mat4_cast(rotation)
+        * glm::scale(glm::mat4(1.0f), scale);
+}
+
+glm::mat4 Node::getGlobalMatrix() const
+{
+    glm::mat4 m = getLocalMatrix();
+    const Node* p = parent;
+    while (p) {
+        m = p->getLocalMatrix() * m;
+        p = p->parent;
+    }
+    return m;
+}
@@ -0,0 +1,339 @@
+#include "Resource/model/TransformStore.h"
+
+// System
+#include <algorithm>
+
+// Third-party
+#include <glm/gtc/quaternion.hpp>
+
+// Project
+#include "Engine/Math/FrustumCulling.h"
+#include "Resource/model/Node.h"
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define TRANSFORM_STORE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+// MSVC allows any intrinsic in any function; the path is picked at runtime (FrustumCulling::DetectSimdLevel).
+#define TRANSFORM_STORE_TARGET_SSE41
+#define TRANSFORM_STORE_TARGET_AVX2
+#else
+#define TRANSFORM_STORE_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TRANSFORM_STORE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+
+using FrustumCulling::SimdLevel;
+
+// Nodes whose parent products are computed together per batch.
+constexpr uint32_t SSE_BATCH = 4;
+constexpr uint32_t AVX_BATCH = 8;
+
+#if defined(TRANSFORM_STORE_X86)
+// Transposes four lane-vectors (one per matrix row of a column) and writes column `col`
+// of four consecutive mat4s starting at `out`.
+TRANSFORM_STORE_TARGET_SSE41
+inline void storeColumn4(__m128 a, __m128 b, __m128 c, __m128 d, float* out, int col)
+{
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    _mm_storeu_ps(out + 0 * 16 + col * 4, a);
+    _mm_storeu_ps(out + 1 * 16 + col * 4, b);
+    _mm_storeu_ps(out + 2 * 16 + col * 4, c);
+    _mm_storeu_ps(out + 3 * 16 + col * 4, d);
+}
+
+// Same expression order as glm::mat4_cast so SIMD and scalar paths agree.
+TRANSFORM_STORE_TARGET_SSE41
+inline void composeTrs4(__m128 x, __m128 y, __m128 z, __m128 w,
+                        __m128 px, __m128 py, __m128 pz,
+                        __m128 kx, __m128 ky, __m128 kz, float* out)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    const __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+    const __m128 xz = _mm_mul_ps(x, z), xy = _mm_mul_ps(x, y), yz = _mm_mul_ps(y, z);
+    const __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+    const __m128 m00 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+    const __m128 m01 = _mm_mul_ps(two, _mm_add_ps(xy, wz));
+    const __m128 m02 = _mm_mul_ps(two, _mm_sub_ps(xz, wy));
+    const __m128 m10 = _mm_mul_ps(two, _mm_sub_ps(xy, wz));
+    const __m128 m11 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+    const __m128 m12 = _mm_mul_ps(two, _mm_add_ps(yz, wx));
+    const __m128 m20 = _mm_mul_ps(two, _mm_add_ps(xz, wy));
+    const __m128 m21 = _mm_mul_ps(two, _mm_sub_ps(yz, wx));
+    const __m128 m22 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+
+    storeColumn4(_mm_mul_ps(m00, kx), _mm_mul_ps(m01, kx), _mm_mul_ps(m02, kx), zero, out, 0);
+    storeColumn4(_mm_mul_ps(m10, ky), _mm_mul_ps(m11, ky), _mm_mul_ps(m12, ky), zero, out, 1);
+    storeColumn4(_mm_mul_ps(m20, kz), _mm_mul_ps(m21, kz), _mm_mul_ps(m22, kz), zero, out, 2);
+    storeColumn4(px, py, pz, one, out, 3);
+}
+
+TRANSFORM_STORE_TARGET_SSE41
+void composeSse41(const float* const soa[10], uint32_t begin, uint32_t end, float* out)
+{
+    for (uint32_t i = begin; i + SSE_BATCH <= end; i += SSE_BATCH) {
+        composeTrs4(_mm_loadu_ps(soa[0] + i), _mm_loadu_ps(soa[1] + i), _mm_loadu_ps(soa[2] + i), _mm_loadu_ps(soa[3] + i),
+                    _mm_loadu_ps(soa[4] + i), _mm_loadu_ps(soa[5] + i), _mm_loadu_ps(soa[6] + i),
+                    _mm_loadu_ps(soa[7] + i), _mm_loadu_ps(soa[8] + i), _mm_loadu_ps(soa[9] + i),
+                    out + i * 16);
+    }
+}
+
+// out[n] = parent[n] * local[n] for SSE_BATCH independent nodes; the node loop is innermost so the four
+// products interleave. Same multiply-add order as glm's operator*, so the result matches the scalar path.
+TRANSFORM_STORE_TARGET_SSE41
+void mulMat4BatchSse41(const float* const* parent, const float* const* local, float* const* out)
+{
+    __m128 a[SSE_BATCH][4];
+    for (uint32_t n = 0; n < SSE_BATCH; ++n) {
+        for (int k = 0; k < 4; ++k) {
+            a[n][k] = _mm_loadu_ps(parent[n] + k * 4);
+        }
+    }
+    for (int c = 0; c < 4; ++c) {
+        for (uint32_t n = 0; n < SSE_BATCH; ++n) {
+            const float* bc = local[n] + c * 4;
+            __m128 r = _mm_mul_ps(a[n][0], _mm_set1_ps(bc[0]));
+            r = _mm_add_ps(r, _mm_mul_ps(a[n][1], _mm_set1_ps(bc[1])));
+            r = _mm_add_ps(r, _mm_mul_ps(a[n][2], _mm_set1_ps(bc[2])));
+            r = _mm_add_ps(r, _mm_mul_ps(a[n][3], _mm_set1_ps(bc[3])));
+            _mm_storeu_ps(out[n] + c * 4, r);
+        }
+    }
+}
+
+TRANSFORM_STORE_TARGET_AVX2
+inline void storeColumn8(__m256 a, __m256 b, __m256 c, __m256 d, float* out, int col)
+{
+    storeColumn4(_mm256_castps256_ps128(a), _mm256_castps256_ps128(b),
+                 _mm256_castps256_ps128(c), _mm256_castps256_ps128(d), out, col);
+    storeColumn4(_mm256_extractf128_ps(a, 1), _mm256_extractf128_ps(b, 1),
+                 _mm256_extractf128_ps(c, 1), _mm256_extractf128_ps(d, 1), out + 4 * 16, col);
+}
+
+TRANSFORM_STORE_TARGET_AVX2
+inline void composeTrs8(__m256 x, __m256 y, __m256 z, __m256 w,
+                        __m256 px, __m256 py, __m256 pz,
+                        __m256 kx, __m256 ky, __m256 kz, float* out)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    const __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+    const __m256 xz = _mm256_mul_ps(x, z), xy = _mm256_mul_ps(x, y), yz = _mm256_mul_ps(y, z);
+    const __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+    const __m256 m00 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz)));
+    const __m256 m01 = _mm256_mul_ps(two, _mm256_add_ps(xy, wz));
+    const __m256 m02 = _mm256_mul_ps(two, _mm256_sub_ps(xz, wy));
+    const __m256 m10 = _mm256_mul_ps(two, _mm256_sub_ps(xy, wz));
+    const __m256 m11 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz)));
+    const __m256 m12 = _mm256_mul_ps(two, _mm256_add_ps(yz, wx));
+    const __m256 m20 = _mm256_mul_ps(two, _mm256_add_ps(xz, wy));
+    const __m256 m21 = _mm256_mul_ps(two, _mm256_sub_ps(yz, wx));
+    const __m256 m22 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy)));
+
+    storeColumn8(_mm256_mul_ps(m00, kx), _mm256_mul_ps(m01, kx), _mm256_mul_ps(m02, kx), zero, out, 0);
+    storeColumn8(_mm256_mul_ps(m10, ky), _mm256_mul_ps(m11, ky), _mm256_mul_ps(m12, ky), zero, out, 1);
+    storeColumn8(_mm256_mul_ps(m20, kz), _mm256_mul_ps(m21, kz), _mm256_mul_ps(m22, kz), zero, out, 2);
+    storeColumn8(px, py, pz, one, out, 3);
+}
+
+TRANSFORM_STORE_TARGET_AVX2
+void composeAvx2(const float* const soa[10], uint32_t begin, uint32_t end, float* out)
+{
+    for (uint32_t i = begin; i + AVX_BATCH <= end; i += AVX_BATCH) {
+        composeTrs8(_mm256_loadu_ps(soa[0] + i), _mm256_loadu_ps(soa[1] + i), _mm256_loadu_ps(soa[2] + i),
+                    _mm256_loadu_ps(soa[3] + i), _mm256_loadu_ps(soa[4] + i), _mm256_loadu_ps(soa[5] + i),
+                    _mm256_loadu_ps(soa[6] + i), _mm256_loadu_ps(soa[7] + i), _mm256_loadu_ps(soa[8] + i),
+                    _mm256_loadu_ps(soa[9] + i), out + i * 16);
+    }
+    _mm256_zeroupper();
+}
+
+TRANSFORM_STORE_TARGET_AVX2
+inline __m256 broadcastPair(float lo, float hi)
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(lo)), _mm_set1_ps(hi), 1);
+}
+
+// AVX_BATCH independent products, two nodes per register (node 2p in the low lane, 2p+1 in the high lane).
+TRANSFORM_STORE_TARGET_AVX2
+void mulMat4BatchAvx2(const float* const* parent, const float* const* local, float* const* out)
+{
+    for (uint32_t p = 0; p < AVX_BATCH; p += 2) {
+        const float* a0 = parent[p];
+        const float* a1 = parent[p + 1];
+        __m256 a[4];
+        for (int k = 0; k < 4; ++k) {
+            a[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(a0 + k * 4)), _mm_loadu_ps(a1 + k * 4), 1);
+        }
+        const float* b0 = local[p];
+        const float* b1 = local[p + 1];
+        for (int c = 0; c < 4; ++c) {
+            const float* c0 = b0 + c * 4;
+            const float* c1 = b1 + c * 4;
+            __m256 r = _mm256_mul_ps(a[0], broadcastPair(c0[0], c1[0]));
+            r = _mm256_add_ps(r, _mm256_mul_ps(a[1], broadcastPair(c0[1], c1[1])));
+            r = _mm256_add_ps(r, _mm256_mul_ps(a[2], broadcastPair(c0[2], c1[2])));
+            r = _mm256_add_ps(r, _mm256_mul_ps(a[3], broadcastPair(c0[3], c1[3])));
+            _mm_storeu_ps(out[p] + c * 4, _mm256_castps256_ps128(r));
+            _mm_storeu_ps(out[p + 1] + c * 4, _mm256_extractf128_ps(r, 1));
+        }
+    }
+    _mm256_zeroupper();
+}
+#endif
+
+glm::mat4 composeTrsScalar(const glm::vec3& t, const glm::quat& r, const glm::vec3& s)
+{
+    glm::mat4 m = glm::mat4_cast(r);
+    m[0] *= s.x;
+    m[1] *= s.y;
+    m[2] *= s.z;
+    m[3] = glm::vec4(t, 1.0f);
+    return m;
+}
+
+}  // namespace
+
+void TransformStore::build(const std::vector<Node*>& linearNodes)
+{
+    clear();
+    const size_t count = linearNodes.size();
+    for (auto* v : {&tx, &ty, &tz, &rx, &ry, &rz, &rw, &sx, &sy, &sz}) {
+        v->resize(count);
+    }
+    hasMatrix.resize(count);
+    matrices.resize(count);
+    parents.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const Node* n = linearNodes[i];
+        const int32_t parent = (n->parent && n->parent->linearIndex < i)
+            ? static_cast<int32_t>(n->parent->linearIndex)
+            : NO_PARENT;
+        parents[i] = parent;
+        setLocal(static_cast<uint32_t>(i), *n);
+    }
+}
+
+void TransformStore::clear()
+{
+    for (auto* v : {&tx, &ty, &tz, &rx, &ry, &rz, &rw, &sx, &sy, &sz}) {
+        v->clear();
+    }
+    hasMatrix.clear();
+    matrices.clear();
+    parents.clear();
+}
+
+void TransformStore::setLocal(uint32_t index, const Node& node)
+{
+    if (index >= size()) return;
+    tx[index] = node.translation.x;
+    ty[index] = node.translation.y;
+    tz[index] = node.translation.z;
+    rx[index] = node.rotation.x;
+    ry[index] = node.rotation.y;
+    rz[index] = node.rotation.z;
+    rw[index] = node.rotation.w;
+    sx[index] = node.scale.x;
+    sy[index] = node.scale.y;
+    sz[index] = node.scale.z;
+    hasMatrix[index] = node.hasMatrix ? 1u : 0u;
+    matrices[index] = node.matrix;
+}
+
+void TransformStore::composeLocal(uint32_t begin, uint32_t end, glm::mat4* outLocal) const
+{
+    end = std::min(end, size());
+    if (begin >= end) return;
+    uint32_t i = begin;
+
+#if defined(TRANSFORM_STORE_X86)
+    const float* const soa[10] = {rx.data(), ry.data(), rz.data(), rw.data(),
+                                  tx.data(), ty.data(), tz.data(),
+                                  sx.data(), sy.data(), sz.data()};
+    const SimdLevel level = FrustumCulling::DetectSimdLevel();
+    if (level == SimdLevel::Avx2) {
+        composeAvx2(soa, i, end, &outLocal[0][0][0]);
+        i += (end - i) / AVX_BATCH * AVX_BATCH;
+    }
+    if (level != SimdLevel::Scalar) {
+        composeSse41(soa, i, end, &outLocal[0][0][0]);
+        i += (end - i) / SSE_BATCH * SSE_BATCH;
+    }
+#endif
+    for (; i < end; ++i) {
+        outLocal[i] = composeTrsScalar(glm::vec3(tx[i], ty[i], tz[i]),
+                                       glm::quat(rw[i], rx[i], ry[i], rz[i]),
+                                       glm::vec3(sx[i], sy[i], sz[i]));
+    }
+
+    // glTF: matrix overrides TRS.
+    for (i = begin; i < end; ++i) {
+        if (hasMatrix[i]) {
+            outLocal[i] = matrices[i];
+        }
+    }
+}
+
+void TransformStore::propagate(uint32_t begin, uint32_t end, const glm::mat4& rootMatrix,
+                               const glm::mat4* local, glm::mat4* outWorld) const
+{
+    end = std::min(end, size());
+    auto parentWorld = [&](uint32_t i) -> const glm::mat4& {
+        const int32_t p = parents[i];
+        return (p == NO_PARENT) ? rootMatrix : outWorld[p];
+    };
+
+    uint32_t i = begin;
+#if defined(TRANSFORM_STORE_X86)
+    const SimdLevel level = FrustumCulling::DetectSimdLevel();
+    const uint32_t batch = (level == SimdLevel::Avx2) ? AVX_BATCH : SSE_BATCH;
+    if (level != SimdLevel::Scalar) {
+        const float* parentPtrs[AVX_BATCH];
+        const float* localPtrs[AVX_BATCH];
+        float* outPtrs[AVX_BATCH];
+        while (i + batch <= end) {
+            // A batch is independent when every parent precedes it (siblings under a common parent,
+            // the usual shape of glTF scenes). Otherwise advance one node and try again.
+            bool independent = true;
+            for (uint32_t n = 0; n < batch; ++n) {
+                const int32_t p = parents[i + n];
+                independent = independent && (p < static_cast<int32_t>(i));
+                parentPtrs[n] = &parentWorld(i + n)[0][0];
+                localPtrs[n] = &local[i + n][0][0];
+                outPtrs[n] = &outWorld[i + n][0][0];
+            }
+            if (!independent) {
+                outWorld[i] = parentWorld(i) * local[i];
+                ++i;
+                continue;
+            }
+            if (batch == AVX_BATCH) {
+                mulMat4BatchAvx2(parentPtrs, localPtrs, outPtrs);
+            } else {
+                mulMat4BatchSse41(parentPtrs, localPtrs, outPtrs);
+            }
+            i += batch;
+        }
+    }
+#endif
+    for (; i < end; ++i) {
+        outWorld[i] = parentWorld(i) * local[i];
+    }
+}
+
+const char* TransformStore::simdPathName()
+{
+    return FrustumCulling::GetSimdLevelName(FrustumCulling::DetectSimdLevel());
+}
@@ -5,17 +5,25 @@
 
 // System
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
 #include <vector>
 
 // Third-party
 #include <glm/gtc/quaternion.hpp>
 
 // Project
+#include "Engine/Jobs/JobSystem.h"
+#include "Engine/Profiling/Trace.h"
 #include "Rendering/RHI/Vulkan/VulkanResourceCreator.h"
 #include "Resource/core/ResourceManager.h"
 #include "Resource/model/GltfTexture.h"
+#include "Resource/model/MeshCache.h"
 #include "Resource/model/Model.h"
 #include "Resource/texture/KtxTextureLoader.h"
 
@@ -224,6 +232,239 @@ glm::u16vec4 readU16Vec4(const unsigned char* basePtr, size_t stride, size_t ind
     }
 }
 
+// Decodes one triangle primitive into `mesh`; false if it is skipped (non-triangle mode, bad accessors).
+// Only reads `model`, so primitives decode concurrently.
+bool decodePrimitive(const tinygltf::Model& model, const tinygltf::Primitive& prim, Mesh& mesh)
+{
+    const int mode = prim.mode == -1 ? TINYGLTF_MODE_TRIANGLES : prim.mode;
+    if (mode != TINYGLTF_MODE_TRIANGLES) {
+        return false;
+    }
+
+    auto posIt = prim.attributes.find("POSITION");
+    if (posIt == prim.attributes.end()) {
+        return false;
+    }
+    const int posAccessorIndex = posIt->second;
+    if (posAccessorIndex < 0 || posAccessorIndex >= static_cast<int>(model.accessors.size())) {
+        return false;
+    }
+
+    const tinygltf::Accessor& posAccessor = model.accessors[static_cast<size_t>(posAccessorIndex)];
+    if (posAccessor.type != TINYGLTF_TYPE_VEC3 || posAccessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT) {
+        return false;
+    }
+
+    const unsigned char* posData = nullptr;
+    size_t posStride = 0;
+    int posComponents = 0;
+    if (!getAccessorRawView(model, posAccessor, posData, posStride, posComponents) || posComponents < 3) {
+        return false;
+    }
+
+    const unsigned char* normalData = nullptr;
+    size_t normalStride = 0;
+    int normalComponents = 0;
+    bool hasNormal = false;
+    auto normalIt = prim.attributes.find("NORMAL");
+    if (normalIt != prim.attributes.end()
+        && normalIt->second >= 0
+        && normalIt->second < static_cast<int>(model.accessors.size())) {
+        const tinygltf::Accessor& a = model.accessors[static_cast<size_t>(normalIt->second)];
+        if (a.type == TINYGLTF_TYPE_VEC3
+            && a.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT
+            && getAccessorRawView(model, a, normalData, normalStride, normalComponents)
+            && normalComponents >= 3) {
+            hasNormal = true;
+        }
+    }
+
+    const unsigned char* uvData = nullptr;
+    size_t uvStride = 0;
+    int uvComponents = 0;
+    bool hasUv = false;
+    auto uvIt = prim.attributes.find("TEXCOORD_0");
+    if (uvIt != prim.attributes.end()
+        && uvIt->second >= 0
+        && uvIt->second < static_cast<int>(model.accessors.size())) {
+        const tinygltf::Accessor& a = model.accessors[static_cast<size_t>(uvIt->second)];
+        if (a.type == TINYGLTF_TYPE_VEC2
+            && getAccessorRawView(model, a, uvData, uvStride, uvComponents)
+            && uvComponents >= 2) {
+            hasUv = true;
+        }
+    }
+
+    const unsigned char* colorData = nullptr;
+    size_t colorStride = 0;
+    int colorComponents = 0;
+    bool hasColor = false;
+    auto colIt = prim.attributes.find("COLOR_0");
+    if (colIt != prim.attributes.end()
+        && colIt->second >= 0
+        && colIt->second < static_cast<int>(model.accessors.size())) {
+        const tinygltf::Accessor& a = model.accessors[static_cast<size_t>(colIt->second)];
+        if ((a.type == TINYGLTF_TYPE_VEC3 || a.type == TINYGLTF_TYPE_VEC4)
+            && getAccessorRawView(model, a, colorData, colorStride, colorComponents)
+            && colorComponents >= 3) {
+            hasColor = true;
+        }
+    }
+
+    const unsigned char* tangentData = nullptr;
+    size_t tangentStride = 0;
+    int tangentComponents = 0;
+    bool hasTangent = false;
+    auto tanIt = prim.attributes.find("TANGENT");
+    if (tanIt != prim.attributes.end()
+        && tanIt->second >= 0
+        && tanIt->second < static_cast<int>(model.accessors.size())) {
+        const tinygltf::Accessor& a = model.accessors[static_cast<size_t>(tanIt->second)];
+        if (a.type == TINYGLTF_TYPE_VEC4
+            && a.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT
+            && getAccessorRawView(model, a, tangentData, tangentStride, tangentComponents)
+            && tangentComponents >= 4) {
+            hasTangent = true;
+        }
+    }
+
+    const unsigned char* jointsData = nullptr;
+    size_t jointsStride = 0;
+    int jointsComponents = 0;
+    bool hasJoints = false;
+    tinygltf::Accessor jointsAccessor{};
+    auto jointsIt = prim.attributes.find("JOINTS_0");
+    if (jointsIt != prim.attributes.end()
+        && jointsIt->second >= 0
+        && jointsIt->second < static_cast<int>(model.accessors.size())) {
+        jointsAccessor = model.accessors[static_cast<size_t>(jointsIt->second)];
+        if (jointsAccessor.type == TINYGLTF_TYPE_VEC4
+            && (jointsAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE
+                || jointsAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
+            && getAccessorRawView(model, jointsAccessor, jointsData, jointsStride, jointsComponents)
+            && jointsComponents >= 4) {
+            hasJoints = true;
+        }
+    }
+
+    const unsigned char* weightsData = nullptr;
+    size_t weightsStride = 0;
+    int weightsComponents = 0;
+    bool hasWeights = false;
+    tinygltf::Accessor weightsAccessor{};
+    auto weightsIt = prim.attributes.find("WEIGHTS_0");
+    if (weightsIt != prim.attributes.end()
+        && weightsIt->second >= 0
+        && weightsIt->second < static_cast<int>(model.accessors.size())) {
+        weightsAccessor = model.accessors[static_cast<size_t>(weightsIt->second)];
+        if (weightsAccessor.type == TINYGLTF_TYPE_VEC4
+            && (weightsAccessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT
+                || weightsAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE
+                || weightsAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
+            && getAccessorRawView(model, weightsAccessor, weightsData, weightsStride, weightsComponents)
+            && weightsComponents >= 4) {
+            hasWeights = true;
+        }
+    }
+
+    mesh.materialIndex = prim.material >= 0 ? prim.material : 0;
+    mesh.vertices.reserve(posAccessor.count);
+    if (hasJoints) mesh.joints0.reserve(posAccessor.count);
+    if (hasWeights) mesh.weights0.reserve(posAccessor.count);
+
+    for (size_t v = 0; v < posAccessor.count; ++v) {
+        Vertex vert{};
+        const float* p = reinterpret_cast<const float*>(posData + v * posStride);
+        vert.pos = glm::vec3(p[0], p[1], p[2]);
+
+        if (hasNormal) {
+            const float* n = reinterpret_cast<const float*>(normalData + v * normalStride);
+            vert.normal = glm::normalize(glm::vec3(n[0], n[1], n[2]));
+        }
+        if (hasUv) {
+            const tinygltf::Accessor& uvAccessor = model.accessors[static_cast<size_t>(uvIt->second)];
+            vert.texCoord = readVec2FloatOrNormalized(uvData, uvStride, v, uvAccessor.componentType, uvAccessor.normalized);
+            // glTF 与 OpenGL 约定 V=0 在底部，Vulkan 约定 V=0 在顶部，需翻转 V 以修正纹理上下颠倒
+            vert.texCoord.y = 1.0f - vert.texCoord.y;
+        }
+        if (hasColor) {
+            const tinygltf::Accessor& colAccessor = model.accessors[static_cast<size_t>(colIt->second)];
+            if (colAccessor.type == TINYGLTF_TYPE_VEC4) {
+                const glm::vec4 c = readVec4FloatOrNormalized(colorData, colorStride, v, colAccessor.componentType, colAccessor.normalized);
+                vert.color = glm::vec3(c.x, c.y, c.z);
+            } else {
+                vert.color = readVec3FloatOrNormalized(colorData, colorStride, v, colAccessor.componentType, colAccessor.normalized);
+            }
+        }
+        if (hasTangent) {
+            const float* t = reinterpret_cast<const float*>(tangentData + v * tangentStride);
+            vert.tangent = glm::vec4(t[0], t[1], t[2], t[3]);
+        }
+
+        mesh.vertices.push_back(vert);
+        if (hasJoints) {
+            mesh.joints0.push_back(readU16Vec4(jointsData, jointsStride, v, jointsAccessor.componentType));
+        }
+        if (hasWeights) {
+            glm::vec4 w = readVec4FloatOrNormalized(weightsData, weightsStride, v, weightsAccessor.componentType, weightsAccessor.normalized);
+            const float sum = w.x + w.y + w.z + w.w;
+            if (sum > 0.0f) {
+                w /= sum;
+            }
+            mesh.weights0.push_back(w);
+        }
+    }
+
+    if (prim.indices >= 0 && prim.indices < static_cast<int>(model.accessors.size())) {
+        const tinygltf::Accessor& indexAccessor = model.accessors[static_cast<size_t>(prim.indices)];
+        const unsigned char* indexData = nullptr;
+        size_t indexStride = 0;
+        int indexComponents = 0;
+        if (!getAccessorRawView(model, indexAccessor, indexData, indexStride, indexComponents) || indexComponents != 1) {
+            return false;
+        }
+
+        mesh.indices.reserve(indexAccessor.count);
+        for (size_t ii = 0; ii < indexAccessor.count; ++ii) {
+            const unsigned char* ptr = indexData + ii * indexStride;
+            uint32_t idx = 0;
+            switch (indexAccessor.componentType) {
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+                idx = static_cast<uint32_t>(*reinterpret_cast<const uint8_t*>(ptr));
+                break;
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+                idx = static_cast<uint32_t>(*reinterpret_cast<const uint16_t*>(ptr));
+                break;
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+                idx = *reinterpret_cast<const uint32_t*>(ptr);
+                break;
+            default:
+                continue;
+            }
+            mesh.indices.push_back(idx);
+        }
+    } else {
+        mesh.indices.reserve(posAccessor.count);
+        for (size_t ii = 0; ii < posAccessor.count; ++ii) {
+            mesh.indices.push_back(static_cast<uint32_t>(ii));
+        }
+    }
+    return true;
+}
+
+void computeMeshBounds(Mesh& mesh)
+{
+    if (mesh.vertices.empty()) return;
+    glm::vec3 minPos = mesh.vertices[0].pos;
+    glm::vec3 maxPos = minPos;
+    for (const Vertex& v : mesh.vertices) {
+        minPos = glm::min(minPos, v.pos);
+        maxPos = glm::max(maxPos, v.pos);
+    }
+    mesh.bounds = BoundingBox(minPos, maxPos);
+    mesh.hasBounds = true;
+}
+
 // KTX2 file magic (first 12 bytes)
 static const unsigned char KTX2_MAGIC[12] = {
     0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
@@ -264,8 +505,70 @@ static bool loadImageDataCallback(tinygltf::Image* image,
 
 bool GltfModelLoader::loadFromFile(const std::string& filePath, Model& outModel)
 {
+    TRACE_SCOPE("GltfModelLoader::loadFromFile");
+    using Clock = std::chrono::high_resolution_clock;
+    auto msBetween = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+    const auto tParse0 = Clock::now();
     outModel.clear();
 
+    VulkanResourceCreator* resourceCreator = nullptr;
+    if (outModel.GetResourceManager()) {
+        resourceCreator = outModel.GetResourceManager()->getResourceCreator();
+    }
+
+    // KTX2 payloads (embedded or from the mesh cache) are transcoded and uploaded as one parallel batch.
+    auto loadTextures = [&](const std::vector<KtxMemorySource>& sources) {
+        std::vector<std::optional<KtxTextureResult>> ktxResults =
+            KtxTextureLoader::loadBatchFromMemory(sources, resourceCreator, nullptr);
+        uint32_t loaded = 0;
+        for (size_t i = 0; i < ktxResults.size(); ++i) {
+            std::optional<KtxTextureResult>& ktxResult = ktxResults[i];
+            if (!ktxResult) continue;
+            GltfTexture& t = outModel.textures[i];
+            t.name = ktxResult->name;
+            t.vkFormat = ktxResult->format;
+            t.width = ktxResult->width;
+            t.height = ktxResult->height;
+            t.mipLevels = ktxResult->mipLevels;
+            t.isCompressed = ktxResult->isCompressed;
+            t.wasTranscoded = ktxResult->wasTranscoded;
+            if (ktxResult->image) t.image = std::move(*ktxResult->image);
+            if (ktxResult->memory) t.memory = std::move(*ktxResult->memory);
+            if (ktxResult->imageView) t.imageView = std::move(*ktxResult->imageView);
+            if (resourceCreator && t.image && !t.vkSampler) {
+                t.vkSampler = createSamplerFromGltf(*resourceCreator, t.sampler, t.mipLevels);
+            }
+            ++loaded;
+        }
+        return loaded;
+    };
+
+    // Warm start: the cooked cache already holds decoded meshes, hierarchy, materials and KTX2 payloads.
+    // Config that is baked into the result (forced reflective materials) is part of the cache key.
+    const std::vector<uint32_t>& reflectiveIndices = AppConfig::REFLECTIVE_MATERIAL_INDICES;
+    const uint64_t cacheSettingsHash = MeshCache::hashBytes(reinterpret_cast<const uint8_t*>(reflectiveIndices.data()),
+                                                            reflectiveIndices.size() * sizeof(uint32_t));
+    const char* cacheState = "off";
+    if (AppConfig::ENABLE_MESH_CACHE) {
+        std::vector<KtxMemorySource> cachedTextures;
+        std::string missReason;
+        if (MeshCache::read(filePath, CACHE_LOADER_VERSION, cacheSettingsHash, outModel, cachedTextures, &missReason)) {
+            const auto tRead1 = Clock::now();
+            const uint32_t loadedTextureCount = loadTextures(cachedTextures);
+            const auto tTexture1 = Clock::now();
+            const CookedMeshStreams* cooked = outModel.getCookedMeshStreams();
+            std::cout << "[Perf] GltfLoad " << filePath << " cache=hit read_ms=" << msBetween(tParse0, tRead1)
+                      << " texture_ms=" << msBetween(tRead1, tTexture1) << " total_ms=" << msBetween(tParse0, Clock::now())
+                      << " textures=" << loadedTextureCount << " primitives=" << outModel.meshes.size()
+                      << " vertices=" << (cooked ? cooked->vertexCount : 0u) << "\n";
+            return !outModel.meshes.empty();
+        }
+        std::cout << "[MeshCache] " << MeshCache::cachePathFor(filePath) << " miss (" << missReason << ")\n";
+        cacheState = "miss";
+    }
+
     tinygltf::TinyGLTF loader;
     loader.SetImageLoader(loadImageDataCallback, nullptr);
 
@@ -282,11 +585,7 @@ bool GltfModelLoader::loadFromFile(const std::string& filePath, Model& outModel)
     if (!loaded) {
         return false;
     }
-
-    VulkanResourceCreator* resourceCreator = nullptr;
-    if (outModel.GetResourceManager()) {
-        resourceCreator = outModel.GetResourceManager()->getResourceCreator();
-    }
+    const auto tParse1 = Clock::now();
 
     // Decide which glTF textures should be treated as sRGB (color) vs UNORM (linear).
     // We infer this from material usage (baseColor/emissive/specGloss) to avoid gamma issues.
@@ -311,11 +610,13 @@ bool GltfModelLoader::loadFromFile(const std::string& filePath, Model& outModel)
     }
 
     // Textures (glTF textures -> embedded KTX2 via KtxTextureLoader)
+    // Metadata first; the KTX2 payloads are then transcoded and uploaded as one parallel batch.
     outModel.textures.clear();
     outModel.textures.resize(gltf.textures.size());
+    std::vector<KtxMemorySource> ktxSources(gltf.textures.size());
     for (size_t i = 0; i < gltf.textures.size(); ++i) {
         const tinygltf::Texture& srcTex = gltf.textures[i];
-        GltfTexture t{};
+        GltfTexture& t = outModel.textures[i];
         t.imageIndex = srcTex.source;
         t.samplerIndex = srcTex.sampler;
 
@@ -330,9 +631,9 @@ bool GltfModelLoader::loadFromFile(const std::string& filePath, Model& outModel)
         const int imgIdx = srcTex.source;
         if (imgIdx >= 0 && imgIdx < static_cast<int>(gltf.images.size())) {
             const tinygltf::Image& img = gltf.images[static_cast<size_t>(imgIdx)];
-            std::string name = !srcTex.name.empty() ? srcTex.name : (!img.name.empty() ? img.name : "texture_" + std::to_string(i));
-            const unsigned char* ktxData = nullptr;
-            size_t ktxSize = 0;
+            KtxMemorySource& src = ktxSources[i];
+            src.name = !srcTex.name.empty() ? srcTex.name : (!img.name.empty() ? img.name : "texture_" + std::to_string(i));
+            src.colorIsSrgb = textureIsSrgb[i];
 
             if (img.mimeType == "image/ktx2") {
                 if (img.bufferView >= 0 && img.bufferView < static_cast<int>(gltf.bufferViews.size())) {
@@ -342,43 +643,21 @@ bool GltfModelLoader::loadFromFile(const std::string& filePath, Model& outModel)
                         const size_t off = static_cast<size_t>(bv.byteOffset);
                         const size_t sz = static_cast<size_t>(bv.byteLength);
                         if (off + sz <= buf.data.size()) {
-                            ktxData = buf.data.data() + off;
-                            ktxSize = sz;
+                            src.data = buf.data.data() + off;
+                            src.size = sz;
                         }
                     }
                 } else if (!img.image.empty() && img.as_is) {
-                    ktxData = img.image.data();
-                    ktxSize = img.image.size();
-                }
-            }
-
-            if (ktxData && ktxSize > 0) {
-                auto ktxResult = KtxTextureLoader::loadFromMemory(
-                    ktxData, ktxSize,
-                    resourceCreator,
-                    nullptr,
-                    name,
-                    textureIsSrgb[i]);
-                if (ktxResult) {
-                    t.name = ktxResult->name;
-                    t.vkFormat = ktxResult->format;
-                    t.width = ktxResult->width;
-                    t.height = ktxResult->height;
-                    t.mipLevels = ktxResult->mipLevels;
-                    t.isCompressed = ktxResult->isCompressed;
-                    t.wasTranscoded = ktxResult->wasTranscoded;
-                    if (ktxResult->image) t.image = std::move(*ktxResult->image);
-                    if (ktxResult->memory) t.memory = std::move(*ktxResult->memory);
-                    if (ktxResult->imageView) t.imageView = std::move(*ktxResult->imageView);
-                    if (resourceCreator && t.image && !t.vkSampler) {
-                        t.vkSampler = createSamplerFromGltf(*resourceCreator, t.sampler, t.mipLevels);
-                    }
+                    src.data = img.image.data();
+                    src.size = img.image.size();
                 }
             }
         }
-        outModel.textures[i] = std::move(t);
     }
 
+    const uint32_t loadedTextureCount = loadTextures(ktxSources);
+    const auto tTexture1 = Clock::now();
+
     // Materials
     outModel.materials.clear();
     if (gltf.materials.empty()) {
@@ -482,6 +761,11 @@ bool GltfModelLoader::loadFromFile(const std::string& filePath, Model& outModel)
         nodePtrs[i] = outModel.ownedNodes[i].get();
     }
 
+    struct PrimitiveJob {
+        uint32_t node = 0;
+        const tinygltf::Primitive* primitive = nullptr;
+    };
+    std::vector<PrimitiveJob> primitiveJobs;
     for (size_t i = 0; i < gltf.nodes.size(); ++i) {
         const tinygltf::Node& srcNode = gltf.nodes[i];
         Node& dst = *nodePtrs[i];
@@ -492,228 +776,10 @@ bool GltfModelLoader::loadFromFile(const std::string& filePath, Model& outModel)
         dst.matrix = readNodeMatrix(srcNode);
         dst.hasMatrix = (srcNode.matrix.size() == 16);
 
-        // Mesh primitives -> multiple Mesh entries
+        // Mesh primitives -> multiple Mesh entries (decoded in parallel below, wired in this order)
         if (srcNode.mesh >= 0 && srcNode.mesh < static_cast<int>(gltf.meshes.size())) {
-            const tinygltf::Mesh& srcMesh = gltf.meshes[static_cast<size_t>(srcNode.mesh)];
-            for (const tinygltf::Primitive& prim : srcMesh.primitives) {
-                const int mode = prim.mode == -1 ? TINYGLTF_MODE_TRIANGLES : prim.mode;
-                if (mode != TINYGLTF_MODE_TRIANGLES) {
-                    continue;
-                }
-
-                auto posIt = prim.attributes.find("POSITION");
-                if (posIt == prim.attributes.end()) {
-                    continue;
-                }
-                const int posAccessorIndex = posIt->second;
-                if (posAccessorIndex < 0 || posAccessorIndex >= static_cast<int>(gltf.accessors.size())) {
-                    continue;
-                }
-
-                const tinygltf::Accessor& posAccessor = gltf.accessors[static_cast<size_t>(posAccessorIndex)];
-                if (posAccessor.type != TINYGLTF_TYPE_VEC3 || posAccessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT) {
-                    continue;
-                }
-
-                const unsigned char* posData = nullptr;
-                size_t posStride = 0;
-                int posComponents = 0;
-                if (!getAccessorRawView(gltf, posAccessor, posData, posStride, posComponents) || posComponents < 3) {
-                    continue;
-                }
-
-                const unsigned char* normalData = nullptr;
-                size_t normalStride = 0;
-                int normalComponents = 0;
-                bool hasNormal = false;
-                auto normalIt = prim.attributes.find("NORMAL");
-                if (normalIt != prim.attributes.end()
-                    && normalIt->second >= 0
-                    && normalIt->second < static_cast<int>(gltf.accessors.size())) {
-                    const tinygltf::Accessor& a = gltf.accessors[static_cast<size_t>(normalIt->second)];
-                    if (a.type == TINYGLTF_TYPE_VEC3
-                        && a.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT
-                        && getAccessorRawView(gltf, a, normalData, normalStride, normalComponents)
-                        && normalComponents >= 3) {
-                        hasNormal = true;
-                    }
-                }
-
-                const unsigned char* uvData = nullptr;
-                size_t uvStride = 0;
-                int uvComponents = 0;
-                bool hasUv = false;
-                auto uvIt = prim.attributes.find("TEXCOORD_0");
-                if (uvIt != prim.attributes.end()
-                    && uvIt->second >= 0
-                    && uvIt->second < static_cast<int>(gltf.accessors.size())) {
-                    const tinygltf::Accessor& a = gltf.accessors[static_cast<size_t>(uvIt->second)];
-                    if (a.type == TINYGLTF_TYPE_VEC2
-                        && getAccessorRawView(gltf, a, uvData, uvStride, uvComponents)
-                        && uvComponents >= 2) {
-                        hasUv = true;
-                    }
-                }
-
-                const unsigned char* colorData = nullptr;
-                size_t colorStride = 0;
-                int colorComponents = 0;
-                bool hasColor = false;
-                auto colIt = prim.attributes.find("COLOR_0");
-                if (colIt != prim.attributes.end()
-                    && colIt->second >= 0
-                    && colIt->second < static_cast<int>(gltf.accessors.size())) {
-                    const tinygltf::Accessor& a = gltf.accessors[static_cast<size_t>(colIt->second)];
-                    if ((a.type == TINYGLTF_TYPE_VEC3 || a.type == TINYGLTF_TYPE_VEC4)
-                        && getAccessorRawView(gltf, a, colorData, colorStride, colorComponents)
-                        && colorComponents >= 3) {
-                        hasColor = true;
-                    }
-                }
-
-                const unsigned char* tangentData = nullptr;
-                size_t tangentStride = 0;
-                int tangentComponents = 0;
-                bool hasTangent = false;
-                auto tanIt = prim.attributes.find("TANGENT");
-                if (tanIt != prim.attributes.end()
-                    && tanIt->second >= 0
-                    && tanIt->second < static_cast<int>(gltf.accessors.size())) {
-                    const tinygltf::Accessor& a = gltf.accessors[static_cast<size_t>(tanIt->second)];
-                    if (a.type == TINYGLTF_TYPE_VEC4
-                        && a.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT
-                        && getAccessorRawView(gltf, a, tangentData, tangentStride, tangentComponents)
-                        && tangentComponents >= 4) {
-                        hasTangent = true;
-                    }
-                }
-
-                const unsigned char* jointsData = nullptr;
-                size_t jointsStride = 0;
-                int jointsComponents = 0;
-                bool hasJoints = false;
-                tinygltf::Accessor jointsAccessor{};
-                auto jointsIt = prim.attributes.find("JOINTS_0");
-                if (jointsIt != prim.attributes.end()
-                    && jointsIt->second >= 0
-                    && jointsIt->second < static_cast<int>(gltf.accessors.size())) {
-                    jointsAccessor = gltf.accessors[static_cast<size_t>(jointsIt->second)];
-                    if (jointsAccessor.type == TINYGLTF_TYPE_VEC4
-                        && (jointsAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE
-                            || jointsAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
-                        && getAccessorRawView(gltf, jointsAccessor, jointsData, jointsStride, jointsComponents)
-                        && jointsComponents >= 4) {
-                        hasJoints = true;
-                    }
-                }
-
-                const unsigned char* weightsData = nullptr;
-                size_t weightsStride = 0;
-                int weightsComponents = 0;
-                bool hasWeights = false;
-                tinygltf::Accessor weightsAccessor{};
-                auto weightsIt = prim.attributes.find("WEIGHTS_0");
-                if (weightsIt != prim.attributes.end()
-                    && weightsIt->second >= 0
-                    && weightsIt->second < static_cast<int>(gltf.accessors.size())) {
-                    weightsAccessor = gltf.accessors[static_cast<size_t>(weightsIt->second)];
-                    if (weightsAccessor.type == TINYGLTF_TYPE_VEC4
-                        && (weightsAccessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT
-                            || weightsAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE
-                            || weightsAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
-                        && getAccessorRawView(gltf, weightsAccessor, weightsData, weightsStride, weightsComponents)
-                        && weightsComponents >= 4) {
-                        hasWeights = true;
-                    }
-                }
-
-                Mesh mesh{};
-                mesh.materialIndex = prim.material >= 0 ? prim.material : 0;
-                mesh.vertices.reserve(posAccessor.count);
-                if (hasJoints) mesh.joints0.reserve(posAccessor.count);
-                if (hasWeights) mesh.weights0.reserve(posAccessor.count);
-
-                for (size_t v = 0; v < posAccessor.count; ++v) {
-                    Vertex vert{};
-                    const float* p = reinterpret_cast<const float*>(posData + v * posStride);
-                    vert.pos = glm::vec3(p[0], p[1], p[2]);
-
-                    if (hasNormal) {
-                        const float* n = reinterpret_cast<const float*>(normalData + v * normalStride);
-                        vert.normal = glm::normalize(glm::vec3(n[0], n[1], n[2]));
-                    }
-                    if (hasUv) {
-                        const tinygltf::Accessor& uvAccessor = gltf.accessors[static_cast<size_t>(uvIt->second)];
-                        vert.texCoord = readVec2FloatOrNormalized(uvData, uvStride, v, uvAccessor.componentType, uvAccessor.normalized);
-                        // glTF 与 OpenGL 约定 V=0 在底部，Vulkan 约定 V=0 在顶部，需翻转 V 以修正纹理上下颠倒
-                        vert.texCoord.y = 1.0f - vert.texCoord.y;
-                    }
-                    if (hasColor) {
-                        const tinygltf::Accessor& colAccessor = gltf.accessors[static_cast<size_t>(colIt->second)];
-                        if (colAccessor.type == TINYGLTF_TYPE_VEC4) {
-                            const glm::vec4 c = readVec4FloatOrNormalized(colorData, colorStride, v, colAccessor.componentType, colAccessor.normalized);
-                            vert.color = glm::vec3(c.x, c.y, c.z);
-                        } else {
-                            vert.color = readVec3FloatOrNormalized(colorData, colorStride, v, colAccessor.componentType, colAccessor.normalized);
-                        }
-                    }
-                    if (hasTangent) {
-                        const float* t = reinterpret_cast<const float*>(tangentData + v * tangentStride);
-                        vert.tangent = glm::vec4(t[0], t[1], t[2], t[3]);
-                    }
-
-                    mesh.vertices.push_back(vert);
-                    if (hasJoints) {
-                        mesh.joints0.push_back(readU16Vec4(jointsData, jointsStride, v, jointsAccessor.componentType));
-                    }
-                    if (hasWeights) {
-                        glm::vec4 w = readVec4FloatOrNormalized(weightsData, weightsStride, v, weightsAccessor.componentType, weightsAccessor.normalized);
-                        const float sum = w.x + w.y + w.z + w.w;
-                        if (sum > 0.0f) {
-                            w /= sum;
-                        }
-                        mesh.weights0.push_back(w);
-                    }
-                }
-
-                if (prim.indices >= 0 && prim.indices < static_cast<int>(gltf.accessors.size())) {
-                    const tinygltf::Accessor& indexAccessor = gltf.accessors[static_cast<size_t>(prim.indices)];
-                    const unsigned char* indexData = nullptr;
-                    size_t indexStride = 0;
-                    int indexComponents = 0;
-                    if (!getAccessorRawView(gltf, indexAccessor, indexData, indexStride, indexComponents) || indexComponents != 1) {
-                        continue;
-                    }
-
-                    mesh.indices.reserve(indexAccessor.count);
-                    for (size_t ii = 0; ii < indexAccessor.count; ++ii) {
-                        const unsigned char* ptr = indexData + ii * indexStride;
-                        uint32_t idx = 0;
-                        switch (indexAccessor.componentType) {
-                        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
-                            idx = static_cast<uint32_t>(*reinterpret_cast<const uint8_t*>(ptr));
-                            break;
-                        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
-                            idx = static_cast<uint32_t>(*reinterpret_cast<const uint16_t*>(ptr));
-                            break;
-                        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
-                            idx = *reinterpret_cast<const uint32_t*>(ptr);
-                            break;
-                        default:
-                            continue;
-                        }
-                        mesh.indices.push_back(idx);
-                    }
-                } else {
-                    mesh.indices.reserve(posAccessor.count);
-                    for (size_t ii = 0; ii < posAccessor.count; ++ii) {
-                        mesh.indices.push_back(static_cast<uint32_t>(ii));
-                    }
-                }
-
-                const uint32_t meshIndex = static_cast<uint32_t>(outModel.meshes.size());
-                outModel.meshes.push_back(std::move(mesh));
-                dst.meshIndices.push_back(meshIndex);
+            for (const tinygltf::Primitive& prim : gltf.meshes[static_cast<size_t>(srcNode.mesh)].primitives) {
+                primitiveJobs.push_back(PrimitiveJob{static_cast<uint32_t>(i), &prim});
             }
         }
 
@@ -729,6 +795,53 @@ bool GltfModelLoader::loadFromFile(const std::string& filePath, Model& outModel)
         }
     }
 
+    // Decode: a primitive only reads the parsed buffers and writes its own preallocated slot.
+    // Largest first through a shared cursor, so one huge primitive does not hold up a whole chunk.
+    const auto tDecode0 = Clock::now();
+    const uint32_t primitiveCount = static_cast<uint32_t>(primitiveJobs.size());
+    std::vector<Mesh> decodedMeshes(primitiveCount);
+    std::vector<uint8_t> decodedOk(primitiveCount, 0u);
+    std::vector<size_t> decodeCost(primitiveCount, 0);
+    for (uint32_t j = 0; j < primitiveCount; ++j) {
+        const tinygltf::Primitive& prim = *primitiveJobs[j].primitive;
+        const auto posIt = prim.attributes.find("POSITION");
+        if (posIt != prim.attributes.end() && posIt->second >= 0 && posIt->second < static_cast<int>(gltf.accessors.size())) {
+            decodeCost[j] = gltf.accessors[static_cast<size_t>(posIt->second)].count;
+        }
+    }
+    std::vector<uint32_t> decodeOrder(primitiveCount);
+    std::iota(decodeOrder.begin(), decodeOrder.end(), 0u);
+    std::stable_sort(decodeOrder.begin(), decodeOrder.end(),
+                     [&](uint32_t a, uint32_t b) { return decodeCost[a] > decodeCost[b]; });
+
+    JobSystem& jobs = JobSystem::get();
+    std::atomic<uint32_t> decodeCursor{0};
+    const uint32_t decodeThreads = std::min(primitiveCount, jobs.getWorkerCount() + 1u);
+    jobs.parallelFor(decodeThreads, 1, [&](uint32_t, uint32_t) {
+        for (uint32_t k = decodeCursor.fetch_add(1u); k < primitiveCount; k = decodeCursor.fetch_add(1u)) {
+            const uint32_t j = decodeOrder[k];
+            decodedOk[j] = decodePrimitive(gltf, *primitiveJobs[j].primitive, decodedMeshes[j]) ? 1u : 0u;
+        }
+    });
+    const auto tBounds0 = Clock::now();
+
+    jobs.parallelFor(primitiveCount, 16, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t j = begin; j < end; ++j) {
+            if (decodedOk[j] != 0u) computeMeshBounds(decodedMeshes[j]);
+        }
+    });
+    const auto tBounds1 = Clock::now();
+
+    // Wiring stays serial and in node/primitive order, so mesh indices match a serial load.
+    size_t vertexCount = 0;
+    for (uint32_t j = 0; j < primitiveCount; ++j) {
+        if (decodedOk[j] == 0u) continue;
+        vertexCount += decodedMeshes[j].vertices.size();
+        const uint32_t meshIndex = static_cast<uint32_t>(outModel.meshes.size());
+        outModel.meshes.push_back(std::move(decodedMeshes[j]));
+        nodePtrs[primitiveJobs[j].node]->meshIndices.push_back(meshIndex);
+    }
+
     // Root nodes: prefer default scene if present; else all nodes without parent.
     if (!gltf.scenes.empty()) {
         int sceneIndex = gltf.defaultScene;
@@ -879,6 +992,33 @@ bool GltfModelLoader::loadFromFile(const std::string& filePath, Model& outModel)
         outModel.animations.push_back(std::move(a));
     }
 
+    // Cook for the next start while the parsed buffers (and the KTX2 payloads they own) are still alive.
+    double cacheWriteMs = 0.0;
+    if (AppConfig::ENABLE_MESH_CACHE && !outModel.meshes.empty()) {
+        const auto tWrite0 = Clock::now();
+        const std::filesystem::path baseDir = std::filesystem::path(filePath).parent_path();
+        std::vector<std::string> dependencies;
+        auto addExternal = [&](const std::string& uri) {
+            if (!uri.empty() && uri.rfind("data:", 0) != 0) {
+                dependencies.push_back((baseDir / uri).string());
+            }
+        };
+        for (const tinygltf::Buffer& b : gltf.buffers) addExternal(b.uri);
+        for (const tinygltf::Image& img : gltf.images) addExternal(img.uri);
+        if (MeshCache::write(filePath, CACHE_LOADER_VERSION, cacheSettingsHash, outModel, dependencies, ktxSources)) {
+            cacheState = "written";
+        } else {
+            std::cout << "[MeshCache] failed to write " << MeshCache::cachePathFor(filePath) << "\n";
+        }
+        cacheWriteMs = msBetween(tWrite0, Clock::now());
+    }
+
+    std::cout << "[Perf] GltfLoad " << filePath << " cache=" << cacheState << " parse_ms=" << msBetween(tParse0, tParse1)
+              << " texture_ms=" << msBetween(tParse1, tTexture1) << " decode_ms=" << msBetween(tDecode0, tBounds0)
+              << " bounds_ms=" << msBetween(tBounds0, tBounds1) << " total_ms=" << msBetween(tParse0, Clock::now())
+              << " textures=" << loadedTextureCount << " primitives=" << outModel.meshes.size() << " vertices=" << vertexCount
+              << " threads=" << (jobs.getWorkerCount() + 1u) << " cache_write_ms=" << cacheWriteMs << "\n";
+
     return !outModel.meshes.empty();
 }
 
@@ -1,7 +1,5 @@
 #include "Resource/texture/HdrTextureLoader.h"
-
-// System
-#include <cstring>
+#include "Engine/Profiling/Trace.h"
 
 // stb_image (implementation from Texture.cpp, only declarations here)
 #include <stb_image.h>
@@ -12,6 +10,7 @@ std::optional<HdrTextureResult> HdrTextureLoader::loadFromFile(
     vk::SamplerAddressMode addressModeU,
     vk::SamplerAddressMode addressModeV)
 {
+    TRACE_SCOPE("HdrTextureLoader::loadFromFile");
     if (!resourceCreator) {
         return std::nullopt;
     }
@@ -29,16 +28,6 @@ std::optional<HdrTextureResult> HdrTextureLoader::loadFromFile(
 
     const vk::DeviceSize imageSize = static_cast<vk::DeviceSize>(width) * height * 4 * sizeof(float);
 
-    BufferAllocation staging = resourceCreator->createBuffer(
-        imageSize,
-        vk::BufferUsageFlagBits::eTransferSrc,
-        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
-
-    void* mapped = staging.memory.mapMemory(0, imageSize);
-    std::memcpy(mapped, data, static_cast<size_t>(imageSize));
-    staging.memory.unmapMemory();
-    stbi_image_free(data);
-
     const uint32_t mipLevels = 1;
     ImageAllocation imgAlloc = resourceCreator->createImage(
         result.width, result.height, mipLevels,
@@ -47,18 +36,13 @@ std::optional<HdrTextureResult> HdrTextureLoader::loadFromFile(
         vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
         vk::MemoryPropertyFlagBits::eDeviceLocal);
 
-    resourceCreator->transitionImageLayout(
-        static_cast<vk::Image>(*imgAlloc.image), result.format,
-        vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, mipLevels);
-
-    resourceCreator->copyBufferToImage(
-        static_cast<vk::Buffer>(*staging.buffer),
-        static_cast<vk::Image>(*imgAlloc.image),
-        result.width, result.height);
-
-    resourceCreator->transitionImageLayout(
-        static_cast<vk::Image>(*imgAlloc.image), result.format,
-        vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal, mipLevels);
+    vk::BufferImageCopy region{};
+    region.imageSubresource = {vk::ImageAspectFlagBits::eColor, 0, 0, 1};
+    region.imageExtent = vk::Extent3D{result.width, result.height, 1};
+    // Async: the caller waits on the uploader before sampling it (Renderer::init before EquirectToCubemap).
+    resourceCreator->getUploader().uploadImage(static_cast<vk::Image>(*imgAlloc.image), result.format, data, imageSize,
+                                               {region}, mipLevels);
+    stbi_image_free(data);
 
     result.image = std::move(imgAlloc.image);
     result.memory = std::move(imgAlloc.memory);
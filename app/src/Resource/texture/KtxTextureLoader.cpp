@@ -2,10 +2,18 @@
 
 // System
 #include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <exception>
 #include <fstream>
+#include <mutex>
+#include <numeric>
 #include <vector>
 
+// Project
+#include "Engine/Jobs/JobSystem.h"
+#include "Engine/Profiling/Trace.h"
+
 // KTX-Software
 #include <ktx.h>
 #include <ktxvulkan.h>
@@ -62,6 +70,22 @@ vk::Format toLinearFormat(vk::Format f)
     }
 }
 
+// Header-only parse (no image data): true when loading this payload runs the Basis transcoder.
+bool needsBasisTranscode(const uint8_t* data, size_t size)
+{
+    ktxTexture2* ktx2 = nullptr;
+    KTX_error_code result = ktxTexture2_CreateFromMemory(
+        data, static_cast<ktx_size_t>(size),
+        KTX_TEXTURE_CREATE_NO_FLAGS,
+        &ktx2);
+    if (result != KTX_SUCCESS || !ktx2) {
+        return false;
+    }
+    const bool needsTranscode = (ktx2->isCompressed != 0) && ktxTexture2_NeedsTranscoding(ktx2);
+    ktxTexture2_Destroy(ktx2);
+    return needsTranscode;
+}
+
 bool parseKtx2FromMemory(const uint8_t* data,
                          size_t size,
                          const VulkanResourceCreator* resourceCreator,
@@ -129,16 +153,6 @@ bool uploadToGpu(VulkanResourceCreator& resourceCreator,
         return false;
     }
 
-    const vk::DeviceSize imageSize = static_cast<vk::DeviceSize>(parsed.data.size());
-    BufferAllocation staging = resourceCreator.createBuffer(
-        imageSize,
-        vk::BufferUsageFlagBits::eTransferSrc,
-        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
-
-    void* mapped = staging.memory.mapMemory(0, imageSize);
-    std::memcpy(mapped, parsed.data.data(), static_cast<size_t>(imageSize));
-    staging.memory.unmapMemory();
-
     ImageAllocation imgAlloc = resourceCreator.createImage(
         parsed.width, parsed.height, parsed.mipLevels,
         vk::SampleCountFlagBits::e1, parsed.format,
@@ -146,10 +160,6 @@ bool uploadToGpu(VulkanResourceCreator& resourceCreator,
         vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
         vk::MemoryPropertyFlagBits::eDeviceLocal);
 
-    resourceCreator.transitionImageLayout(
-        static_cast<vk::Image>(*imgAlloc.image), parsed.format,
-        vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, parsed.mipLevels);
-
     std::vector<vk::BufferImageCopy> regions;
     regions.reserve(parsed.levels.empty() ? 1u : parsed.levels.size());
     if (!parsed.levels.empty()) {
@@ -168,14 +178,10 @@ bool uploadToGpu(VulkanResourceCreator& resourceCreator,
         regions.push_back(r);
     }
 
-    resourceCreator.copyBufferToImage(
-        static_cast<vk::Buffer>(*staging.buffer),
-        static_cast<vk::Image>(*imgAlloc.image), regions);
-
-    resourceCreator.transitionImageLayout(
-        static_cast<vk::Image>(*imgAlloc.image), parsed.format,
-        vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal,
-        parsed.mipLevels);
+    // Async: model loading enqueues every texture and Renderer::init waits on the uploader once.
+    resourceCreator.getUploader().uploadImage(
+        static_cast<vk::Image>(*imgAlloc.image), parsed.format, parsed.data.data(),
+        static_cast<vk::DeviceSize>(parsed.data.size()), regions, parsed.mipLevels);
 
     out.image = std::move(imgAlloc.image);
     out.memory = std::move(imgAlloc.memory);
@@ -264,3 +270,61 @@ std::optional<KtxTextureResult> KtxTextureLoader::loadFromMemory(
 
     return parsed;
 }
+
+std::vector<std::optional<KtxTextureResult>> KtxTextureLoader::loadBatchFromMemory(
+    const std::vector<KtxMemorySource>& sources,
+    VulkanResourceCreator* resourceCreator,
+    const KtxSamplerParams* samplerParams)
+{
+    TRACE_SCOPE("KtxTextureLoader::loadBatchFromMemory");
+    const uint32_t count = static_cast<uint32_t>(sources.size());
+    std::vector<std::optional<KtxTextureResult>> results(count);
+    if (count == 0) return results;
+
+    auto loadOne = [&](uint32_t i) {
+        const KtxMemorySource& src = sources[i];
+        if (src.data && src.size > 0) {
+            results[i] = loadFromMemory(src.data, src.size, resourceCreator, samplerParams, src.name, src.colorIsSrgb);
+        }
+    };
+
+    // Largest payloads first through a shared cursor (transcode cost is roughly proportional to size).
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t a, uint32_t b) { return sources[a].size > sources[b].size; });
+
+    // libktx initializes the Basis transcoder tables lazily without locking: the first payload that actually
+    // transcodes is loaded on this thread before the workers start (payloads that need no transcoding never touch
+    // the tables, so warming up on the largest one is not enough).
+    const auto warmup = std::find_if(order.begin(), order.end(), [&](uint32_t i) {
+        return sources[i].data && sources[i].size > 0 && needsBasisTranscode(sources[i].data, sources[i].size);
+    });
+    if (warmup != order.end()) {
+        loadOne(*warmup);
+        order.erase(warmup);
+    }
+    const uint32_t remaining = static_cast<uint32_t>(order.size());
+    if (remaining == 0) return results;
+
+    JobSystem& jobs = JobSystem::get();
+    std::atomic<uint32_t> cursor{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    const uint32_t threads = std::min(remaining, jobs.getWorkerCount() + 1u);
+    jobs.parallelFor(threads, 1, [&](uint32_t, uint32_t) {
+        for (uint32_t k = cursor.fetch_add(1u); k < remaining; k = cursor.fetch_add(1u)) {
+            // Jobs must not throw: keep the first Vulkan/allocation error and rethrow it on the caller.
+            try {
+                loadOne(order[k]);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+            }
+        }
+    });
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return results;
+}
@@ -4,7 +4,6 @@
 #include "Resource/core/ResourceManager.h"
 
 #include <cmath>
-#include <cstring>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -30,22 +29,18 @@ void Texture::createVulkanImage(unsigned char* data, int width, int height, int
     (void)channels;
     uint32_t mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
 
-    BufferAllocation staging = resourceCreator->createBuffer(imageSize, vk::BufferUsageFlagBits::eTransferSrc,
-                                                            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
-
-    auto mapResult = staging.memory.mapMemory(0, imageSize);
-    void* mappedData = mapResult;
-    memcpy(mappedData, data, static_cast<size_t>(imageSize));
-    staging.memory.unmapMemory();
-
     ImageAllocation texAlloc = resourceCreator->createImage(width, height, mipLevels, vk::SampleCountFlagBits::e1,
                                                            vk::Format::eR8G8B8A8Srgb, vk::ImageTiling::eOptimal,
                                                            vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
                                                            vk::MemoryPropertyFlagBits::eDeviceLocal);
 
-    resourceCreator->transitionImageLayout(*texAlloc.image, vk::Format::eR8G8B8A8Srgb, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, mipLevels);
-    resourceCreator->copyBufferToImage(*staging.buffer, *texAlloc.image, static_cast<uint32_t>(width), static_cast<uint32_t>(height));
-    resourceCreator->generateMipmaps(*texAlloc.image, vk::Format::eR8G8B8A8Srgb, static_cast<uint32_t>(width), static_cast<uint32_t>(height), mipLevels);
+    vk::BufferImageCopy region{};
+    region.imageSubresource = {vk::ImageAspectFlagBits::eColor, 0, 0, 1};
+    region.imageExtent = vk::Extent3D{static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1};
+    // Standalone resource with no caller-side wait: block on this texture's own ticket.
+    UploadManager& uploader = resourceCreator->getUploader();
+    uploader.wait(uploader.uploadImage(*texAlloc.image, vk::Format::eR8G8B8A8Srgb, data, imageSize, {region}, mipLevels, 1,
+                                       true, vk::Extent2D{static_cast<uint32_t>(width), static_cast<uint32_t>(height)}));
 
     textureImage = std::move(texAlloc.image);
     textureImageMemory = std::move(texAlloc.memory);
@@ -0,0 +1,231 @@
+#include "Runtime/BenchmarkRunner.h"
+
+#include "Engine/Camera/Camera.h"
+#include "Engine/Profiling/Percentile.h"
+#include "Rendering/renderer/Renderer.h"
+
+// nlohmann::json, bundled with tinygltf.
+#include "json.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <unordered_map>
+
+namespace {
+void writeJsonString(std::ostream& out, const std::string& text)
+{
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+}  // namespace
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions& inOptions)
+    : options(inOptions)
+    , cameraPath(CameraPath::loadFromFile(inOptions.cameraPath))
+{
+    measuredFrames = options.measuredFrames;
+    if (measuredFrames == 0) {
+        measuredFrames = static_cast<uint32_t>(std::ceil(cameraPath.getDuration() / getTimestep())) + 1u;
+    }
+    std::cout << "[Bench] camera_path=" << options.cameraPath << " keyframes=" << cameraPath.getKeyframes().size()
+              << " duration_s=" << cameraPath.getDuration() << " warmup=" << options.warmupFrames
+              << " measured=" << measuredFrames << "\n";
+}
+
+void BenchmarkRunner::beginFrame(Camera& camera)
+{
+    const uint32_t pathFrame = frame > options.warmupFrames ? frame - options.warmupFrames : 0u;
+    cameraPath.apply(camera, static_cast<float>(pathFrame) * getTimestep());
+}
+
+void BenchmarkRunner::sample(const std::string& name, const char* unit, double value)
+{
+    auto it = std::find_if(metrics.begin(), metrics.end(), [&](const Metric& m) { return m.name == name; });
+    if (it == metrics.end()) {
+        metrics.push_back(Metric{name, unit, {}});
+        metrics.back().samples.reserve(measuredFrames);
+        it = metrics.end() - 1;
+    }
+    it->samples.push_back(value);
+}
+
+bool BenchmarkRunner::endFrame(Renderer& renderer)
+{
+    const uint32_t index = frame++;
+    const GpuProfiler& gpuProfiler = renderer.getGpuProfiler();
+    if (index < options.warmupFrames) {
+        // GPU timings of frames recorded up to here are harvested during measurement; they must not be sampled.
+        firstMeasuredGpuFrame = gpuProfiler.getRecordedFrames() + 1u;
+        return false;
+    }
+
+    const Renderer::CpuTimings& cpu = renderer.getLastCpuTimings();
+    sample("cpu.acquire", "ms", cpu.acquireMs);
+    sample("cpu.record", "ms", cpu.recordMs);
+    sample("cpu.ubo", "ms", cpu.updateUboMs);
+    sample("cpu.submit", "ms", cpu.submitMs);
+    sample("cpu.present", "ms", cpu.presentMs);
+    sample("cpu.total", "ms", cpu.totalMs);
+
+    // Per-pass CPU record times and counters (RenderStats).
+    const RenderStats& stats = renderer.getLastRenderStats();
+    sample("pass.cull", "ms", stats.cullMs);
+    sample("pass.swOcclusionRaster", "ms", stats.swOcclusionRasterMs);
+    sample("pass.swOcclusionTest", "ms", stats.swOcclusionTestMs);
+    sample("pass.gpuCull", "ms", stats.gpuCullMs);
+    sample("pass.depthPrepass", "ms", stats.depthPrepassMs);
+    sample("pass.rtao", "ms", stats.rtaoMs);
+    sample("pass.skybox", "ms", stats.skyboxMs);
+    sample("pass.forward", "ms", stats.forwardMs);
+    sample("pass.forwardCollect", "ms", stats.forwardCollectMs);
+    sample("pass.forwardSort", "ms", stats.forwardSortMs);
+    sample("pass.forwardIssue", "ms", stats.forwardIssueMs);
+    sample("pass.bloomExtract", "ms", stats.bloomExtractMs);
+    sample("pass.bloomBlurH", "ms", stats.bloomBlurHMs);
+    sample("pass.bloomBlurV", "ms", stats.bloomBlurVMs);
+    sample("pass.tonemap", "ms", stats.tonemapMs);
+    sample("pass.occlusion", "ms", stats.occlusionMs);
+    sample("draws.depth", "count", static_cast<double>(stats.depthDrawCalls));
+    sample("draws.forward", "count", static_cast<double>(stats.forwardDrawCalls));
+    sample("draws.opaqueItems", "count", static_cast<double>(stats.opaqueItems));
+    sample("draws.transparentItems", "count", static_cast<double>(stats.transparentItems));
+    sample("draws.occlusionQueries", "count", static_cast<double>(stats.occlusionDrawCalls));
+    sample("cull.culledNodes", "count", static_cast<double>(stats.cullCulledNodes));
+    sample("cull.gpuVisibleDraws", "count", static_cast<double>(stats.gpuCullVisibleDraws));
+    sample("cull.occlusionHiddenNodes", "count", static_cast<double>(stats.occlusionHiddenNodes));
+    sample("cull.swOcclusionCulledNodes", "count", static_cast<double>(stats.swOcclusionCulledNodes));
+    sample("tlas.writtenInstances", "count", static_cast<double>(stats.tlasWrittenInstances));
+    sample("graph.barrierBatches", "count", static_cast<double>(stats.graphBarrierBatches));
+    sample("graph.imageBarriers", "count", static_cast<double>(stats.graphImageBarriers));
+    sample("graph.splitBarriers", "count", static_cast<double>(stats.graphSplitBarriers));
+
+    // One sample per scope of the frame harvested this frame (frames-in-flight frames old); late scopes are skipped.
+    const GpuProfiler::HarvestedFrame& harvested = gpuProfiler.getLastHarvest();
+    if (harvested.frameNumber >= firstMeasuredGpuFrame && harvested.frameNumber > lastSampledGpuFrame) {
+        lastSampledGpuFrame = harvested.frameNumber;
+        for (const GpuProfiler::ScopeTiming& scope : harvested.scopes) {
+            sample("gpu." + gpuProfiler.getScopeName(scope.nameIndex), "ms", scope.ms);
+        }
+    }
+
+    if (index + 1 < options.warmupFrames + measuredFrames) {
+        return false;
+    }
+
+    constexpr double MB = 1024.0 * 1024.0;
+    const GpuMemoryAllocator::Stats memStats = renderer.getGpuMemoryStats();
+    sample("memory.used", "MB", static_cast<double>(memStats.usedBytes) / MB);
+    sample("memory.reserved", "MB", static_cast<double>(memStats.reservedBytes) / MB);
+    sample("memory.fragmented", "MB", static_cast<double>(memStats.fragmentedBytes) / MB);
+    sample("memory.blocks", "count", static_cast<double>(memStats.blockCount));
+    sample("memory.dedicated", "count", static_cast<double>(memStats.dedicatedCount));
+    sample("memory.allocations", "count", static_cast<double>(memStats.allocationCount));
+
+    const bool written = writeReport(renderer);
+    std::cout << "[Bench] Report " << (written ? "written to " : "failed to write ") << options.reportPath << "\n";
+    return true;
+}
+
+bool BenchmarkRunner::writeReport(Renderer& renderer) const
+{
+    std::ofstream out(options.reportPath, std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+
+    const vk::Extent2D extent = renderer.getExtent();
+    out << "{\n  \"version\": 1,\n  \"config\": {\"camera_path\": ";
+    writeJsonString(out, options.cameraPath);
+    out << ", \"headless\": " << (renderer.isHeadless() ? "true" : "false") << ", \"width\": " << extent.width
+        << ", \"height\": " << extent.height << ", \"frames_in_flight\": " << renderer.getFramesInFlight()
+        << ", \"timestep\": " << getTimestep()
+        << ", \"warmup_frames\": " << options.warmupFrames << ", \"measured_frames\": " << measuredFrames << "},\n";
+
+    out << "  \"metrics\": [";
+    std::vector<double> sorted;
+    for (size_t i = 0; i < metrics.size(); ++i) {
+        const Metric& metric = metrics[i];
+        sorted = metric.samples;
+        std::sort(sorted.begin(), sorted.end());
+        const double avg = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+        writeJsonString(out, metric.name);
+        out << ", \"unit\": \"" << metric.unit << "\", \"avg\": " << avg << ", \"min\": " << sorted.front()
+            << ", \"p50\": " << nearestRankPercentile(sorted, 50) << ", \"p95\": " << nearestRankPercentile(sorted, 95)
+            << ", \"p99\": " << nearestRankPercentile(sorted, 99) << ", \"max\": " << sorted.back()
+            << ", \"samples\": " << sorted.size() << "}";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+int compareBenchmarkReports(const std::string& basePath, const std::string& currentPath, double thresholdPercent)
+{
+    struct Entry {
+        std::string unit;
+        double avg = 0.0;
+    };
+    auto load = [](const std::string& path, std::vector<std::string>& order,
+                   std::unordered_map<std::string, Entry>& entries) -> bool {
+        std::ifstream in(path);
+        if (!in) return false;
+        const nlohmann::json report = nlohmann::json::parse(in, nullptr, false);
+        if (report.is_discarded() || !report.contains("metrics") || !report["metrics"].is_array()) return false;
+        for (const auto& metric : report["metrics"]) {
+            if (!metric.contains("name") || !metric.contains("avg")) continue;
+            const std::string name = metric["name"].get<std::string>();
+            if (entries.emplace(name, Entry{metric.value("unit", std::string()), metric["avg"].get<double>()}).second) {
+                order.push_back(name);
+            }
+        }
+        return true;
+    };
+
+    std::vector<std::string> baseOrder, currentOrder;
+    std::unordered_map<std::string, Entry> base, current;
+    if (!load(basePath, baseOrder, base)) {
+        std::cerr << "[Bench] cannot read report " << basePath << "\n";
+        return 2;
+    }
+    if (!load(currentPath, currentOrder, current)) {
+        std::cerr << "[Bench] cannot read report " << currentPath << "\n";
+        return 2;
+    }
+
+    uint32_t regressions = 0;
+    for (const std::string& name : baseOrder) {
+        const Entry& b = base.at(name);
+        auto it = current.find(name);
+        if (it == current.end()) {
+            std::cout << "[Bench] " << name << " missing in current\n";
+            continue;
+        }
+        const Entry& c = it->second;
+        const double delta = c.avg - b.avg;
+        const double percent = b.avg != 0.0 ? delta / b.avg * 100.0 : (delta != 0.0 ? 100.0 : 0.0);
+        const bool lowerIsBetter = (b.unit == "ms" || b.unit == "MB");
+        const char* status = "ok";
+        if (lowerIsBetter && std::abs(delta) > AppConfig::BENCHMARK_COMPARE_MIN_DELTA && std::abs(percent) > thresholdPercent) {
+            status = delta > 0.0 ? "REGRESSION" : "improved";
+            regressions += delta > 0.0 ? 1u : 0u;
+        } else if (!lowerIsBetter && delta != 0.0) {
+            status = "changed";
+        }
+        std::cout << "[Bench] " << name << " base=" << b.avg << " current=" << c.avg << " " << b.unit
+                  << " delta=" << percent << "% " << status << "\n";
+    }
+    for (const std::string& name : currentOrder) {
+        if (base.find(name) == base.end()) {
+            std::cout << "[Bench] " << name << " new in current\n";
+        }
+    }
+    std::cout << "[Bench] " << regressions << " regression(s) beyond " << thresholdPercent << "%\n";
+    return regressions > 0 ? 1 : 0;
+}
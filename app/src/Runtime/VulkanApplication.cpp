@@ -1,22 +1,36 @@
 #include "Runtime/VulkanApplication.h"
 #include "Configs/AppConfig.h"
+#include "Configs/RuntimeConfig.h"
 #include "Engine/Events/Events.h"
+#include "Engine/Profiling/Trace.h"
 
 #include "imgui_impl_glfw.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
 
 void VulkanApplication::run()
 {
     initWindow();
     glfwShowWindow(window);  // 确保窗口显示，避免 SwapChain 初始化时 framebuffer 尺寸为 0 导致无限阻塞
 
+    Trace::get().setThreadName("Main");
+    if (AppConfig::TRACE_STARTUP_CAPTURE_FRAMES > 0) {
+        // Started before init so the window also covers the load stages.
+        Trace::get().requestCapture(AppConfig::TRACE_STARTUP_CAPTURE_FRAMES, AppConfig::TRACE_OUTPUT_PATH);
+    }
+
     try {
         renderer.init(window);
         renderer.setCamera(&camera);
         renderer.setCullingSystem(&cullingSystem);
         cullingSystem.SetCamera(&camera);
 
+        beginBenchmark();
+
         framebufferResizeSub = eventBus.subscribe<FramebufferResizeEvent>([this](const FramebufferResizeEvent& e) {
             (void)e;
             renderer.setFramebufferResized(true);
@@ -31,6 +45,72 @@ void VulkanApplication::run()
     }
 }
 
+void VulkanApplication::runHeadless(const HeadlessOptions& options)
+{
+    Trace::get().setThreadName("Main");
+    if (AppConfig::TRACE_STARTUP_CAPTURE_FRAMES > 0) {
+        Trace::get().requestCapture(AppConfig::TRACE_STARTUP_CAPTURE_FRAMES, AppConfig::TRACE_OUTPUT_PATH);
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(options.outputDir, ec);
+
+    try {
+        renderer.initHeadless(vk::Extent2D{options.width, options.height});
+        renderer.setCamera(&camera);
+        renderer.setCullingSystem(&cullingSystem);
+        cullingSystem.SetCamera(&camera);
+        beginBenchmark();
+
+        // Fixed timestep: animation state depends only on the frame number. A benchmark decides when the run ends
+        // (the last frame is then not known in advance, so only interval captures are taken).
+        const float deltaTime = benchmark ? benchmark->getTimestep() : AppConfig::BENCHMARK_TIMESTEP;
+        const float aspect = static_cast<float>(options.width) / static_cast<float>(std::max(options.height, 1u));
+        bool done = (options.frameCount == 0 && !benchmark);
+        uint32_t frame = 0;
+        for (; !done; ++frame) {
+            {
+                TRACE_SCOPE("Frame");
+                const bool last = !benchmark && (frame + 1 == options.frameCount);
+                const bool interval = options.captureInterval > 0 && (frame + 1) % options.captureInterval == 0;
+                if (last || interval) {
+                    char fileName[32];
+                    std::snprintf(fileName, sizeof(fileName), "frame_%05u.ppm", frame);
+                    renderer.requestFrameCapture((std::filesystem::path(options.outputDir) / fileName).string());
+                }
+                if (benchmark) {
+                    benchmark->beginFrame(camera);
+                }
+                renderer.update(deltaTime);
+                cullingSystem.CullScene(scene.GetEntities(), aspect, AppConfig::CAMERA_NEAR_PLANE, AppConfig::CAMERA_FAR_PLANE);
+                renderer.drawFrame();
+                done = benchmark ? benchmark->endFrame(renderer) : last;
+            }
+            Trace::get().onFrameEnd();
+        }
+        renderer.waitIdle();
+        std::cout << "[Headless] Rendered " << frame << " frames at " << options.width << "x" << options.height << "\n";
+        cleanup();
+    } catch (...) {
+        cleanup();
+        throw;
+    }
+}
+
+void VulkanApplication::runOcclusionBenchmark(const std::vector<std::string>& cameraPathFiles,
+                                              const HeadlessOptions& options)
+{
+    Trace::get().setThreadName("Main");
+    try {
+        renderer.initHeadless(vk::Extent2D{options.width, options.height});
+        renderer.runOcclusionBenchmark(cameraPathFiles);
+        cleanup();
+    } catch (...) {
+        cleanup();
+        throw;
+    }
+}
+
 void VulkanApplication::initWindow()
 {
     glfwInit();
@@ -54,18 +134,33 @@ void VulkanApplication::mainLoop()
     auto lastTime = std::chrono::high_resolution_clock::now();
 
     while (!glfwWindowShouldClose(window)) {
-        glfwPollEvents();
+        {
+            TRACE_SCOPE("Frame");
+            {
+                TRACE_SCOPE("PollEvents");
+                glfwPollEvents();
+            }
 
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        float deltaTime = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - lastTime).count();
-        lastTime = currentTime;
+            auto currentTime = std::chrono::high_resolution_clock::now();
+            float deltaTime = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - lastTime).count();
+            lastTime = currentTime;
+            if (benchmark) {
+                deltaTime = benchmark->getTimestep();
+                benchmark->beginFrame(camera);
+            }
 
-        processInput(deltaTime);
-        renderer.update(deltaTime);
-        cullingSystem.CullScene(scene.GetEntities(), static_cast<float>(AppConfig::WIDTH) / AppConfig::HEIGHT, 0.1f, 10.0f);
-        renderer.drawFrame();
-        // End-of-frame: deliver queued events (e.g. window resize).
-        eventBus.process();
+            processInput(deltaTime);
+            renderer.update(deltaTime);
+            cullingSystem.CullScene(scene.GetEntities(), static_cast<float>(AppConfig::WIDTH) / AppConfig::HEIGHT,
+                                    AppConfig::CAMERA_NEAR_PLANE, AppConfig::CAMERA_FAR_PLANE);
+            renderer.drawFrame();
+            if (benchmark && benchmark->endFrame(renderer)) {
+                glfwSetWindowShouldClose(window, GLFW_TRUE);
+            }
+            // End-of-frame: deliver queued events (e.g. window resize).
+            eventBus.process();
+        }
+        Trace::get().onFrameEnd();
     }
 
     renderer.waitIdle();
@@ -102,6 +197,18 @@ void VulkanApplication::processInput(float deltaTime)
     }
     prevF3 = f3Pressed;
 
+    const bool f4Pressed = (glfwGetKey(window, GLFW_KEY_F4) == GLFW_PRESS);
+    if (f4Pressed && !prevF4) {
+        Trace::get().requestCapture(AppConfig::TRACE_CAPTURE_FRAMES, AppConfig::TRACE_OUTPUT_PATH);
+    }
+    prevF4 = f4Pressed;
+
+    const bool f5Pressed = (glfwGetKey(window, GLFW_KEY_F5) == GLFW_PRESS);
+    if (f5Pressed && !prevF5 && !benchmark) {
+        recordCameraKeyframe();
+    }
+    prevF5 = f5Pressed;
+
     if (canProcessCameraKeyboard()) {
         camera.processInput(deltaTime, window);
     }
@@ -171,6 +278,29 @@ void VulkanApplication::charCallback(GLFWwindow* win, unsigned int c)
 #endif
 }
 
+void VulkanApplication::beginBenchmark()
+{
+    if (!benchmark) return;
+    // Same runtime toggles for every run, whatever a previous session left in the UI.
+    RuntimeConfig::resetToDefaults();
+}
+
+void VulkanApplication::recordCameraKeyframe()
+{
+    const double now = glfwGetTime();
+    if (cameraPathRecordStart < 0.0) {
+        cameraPathRecordStart = now;
+    }
+    CameraPath::Keyframe keyframe;
+    keyframe.time = static_cast<float>(now - cameraPathRecordStart);
+    keyframe.position = camera.getPosition();
+    keyframe.yaw = camera.getYaw();
+    keyframe.pitch = camera.getPitch();
+    const bool written = CameraPath::appendKeyframe(AppConfig::CAMERA_PATH_RECORD_PATH, keyframe);
+    std::cout << "[Bench] Camera keyframe t=" << keyframe.time << (written ? " appended to " : " failed to append to ")
+              << AppConfig::CAMERA_PATH_RECORD_PATH << "\n";
+}
+
 void VulkanApplication::setInputMode(InputMode mode)
 {
     inputMode = mode;
@@ -196,6 +326,7 @@ void VulkanApplication::toggleInputMode()
 
 bool VulkanApplication::canProcessCameraKeyboard() const
 {
+    if (benchmark) return false;  // the camera path owns the camera
     if (inputMode == InputMode::UiInteraction) return false;
     if (inputMode == InputMode::CameraControl) return true;
     // Auto: UI has priority when it wants the keyboard.
@@ -205,6 +336,7 @@ bool VulkanApplication::canProcessCameraKeyboard() const
 
 bool VulkanApplication::canProcessCameraMouse() const
 {
+    if (benchmark) return false;
     if (inputMode == InputMode::UiInteraction) return false;
     if (inputMode == InputMode::CameraControl) return true;
     // Auto: UI has priority when it wants the mouse.
@@ -1,8 +1,12 @@
 #version 460
 #extension GL_ARB_separate_shader_objects : require
+// NO_RAY_QUERY builds pbr_noraytrace.frag for devices without VK_KHR_ray_query: no TLAS binding,
+// shadow rays report "visible", no ray traced reflections (RTAO is off via ubo.rtaoParams0.x).
+#ifndef NO_RAY_QUERY
 #extension GL_EXT_ray_query : require
 #extension GL_EXT_ray_tracing : require
 #extension GL_EXT_nonuniform_qualifier : require
+#endif
 
 layout(location = 0) in vec3 inWorldPos;
 layout(location = 1) in vec3 inNormal;
@@ -32,7 +36,9 @@ layout(binding = 3) uniform sampler2D normalMap;
 layout(binding = 4) uniform sampler2D occlusionMap;
 layout(binding = 5) uniform sampler2D emissiveMap;
 
+#ifndef NO_RAY_QUERY
 layout(binding = 6) uniform accelerationStructureEXT topLevelAS;
+#endif
 
 // 光追反射 bindless（教程 Task 9/10/11）
 struct InstanceLUTEntry {
@@ -152,6 +158,9 @@ mat3 buildTbn(vec3 n)
 
 float TraceAoRay(vec3 origin, vec3 dir, float tMax)
 {
+#ifdef NO_RAY_QUERY
+    return 1.0;
+#else
     rayQueryEXT rq;
     rayQueryInitializeEXT(
         rq,
@@ -164,6 +173,7 @@ float TraceAoRay(vec3 origin, vec3 dir, float tMax)
         tMax);
     while (rayQueryProceedEXT(rq)) { }
     return (rayQueryGetIntersectionTypeEXT(rq, true) == gl_RayQueryCommittedIntersectionNoneEXT) ? 1.0 : 0.0;
+#endif
 }
 
 float ComputeShadowVisibility(vec3 worldPos, vec3 geomNormal, vec3 lightPos)
@@ -180,6 +190,9 @@ float ComputeShadowVisibility(vec3 worldPos, vec3 geomNormal, vec3 lightPos)
     float tMin = 0.001;
     float tMax = max(lightDistance - bias, tMin);
 
+#ifdef NO_RAY_QUERY
+    return 1.0;
+#else
     rayQueryEXT rq;
     rayQueryInitializeEXT(
         rq,
@@ -193,6 +206,7 @@ float ComputeShadowVisibility(vec3 worldPos, vec3 geomNormal, vec3 lightPos)
 
     while (rayQueryProceedEXT(rq)) { }
     return (rayQueryGetIntersectionTypeEXT(rq, true) != gl_RayQueryCommittedIntersectionNoneEXT) ? 0.0 : 1.0;
+#endif
 }
 
 // 单条射线：方向 L 是否被遮挡
@@ -200,6 +214,9 @@ float TraceShadowRayDirectional(vec3 rayOrigin, vec3 rayDir)
 {
     float tMin = 0.001;
     float tMax = 500.0;
+#ifdef NO_RAY_QUERY
+    return 1.0;
+#else
     rayQueryEXT rq;
     rayQueryInitializeEXT(
         rq,
@@ -212,6 +229,7 @@ float TraceShadowRayDirectional(vec3 rayOrigin, vec3 rayDir)
         tMax);
     while (rayQueryProceedEXT(rq)) { }
     return (rayQueryGetIntersectionTypeEXT(rq, true) != gl_RayQueryCommittedIntersectionNoneEXT) ? 0.0 : 1.0;
+#endif
 }
 
 float ComputeShadowVisibilityDirectional(vec3 worldPos, vec3 geomNormal, vec3 L)
@@ -259,6 +277,7 @@ float ComputeShadowVisibilityDirectional(vec3 worldPos, vec3 geomNormal, vec3 L)
     return mix(0.0, 1.0, vis);
 }
 
+#ifndef NO_RAY_QUERY
 const float RAY_REFLECTION_EPSILON = 0.001;
 const float RAY_REFLECTION_TMAX = 1e4;
 const uint RAY_REFLECTION_MAX_TEXTURES = 256u;
@@ -316,6 +335,7 @@ void apply_reflection(vec3 P, vec3 N, inout vec4 baseColor) {
         baseColor.rgb = mix(baseColor.rgb, skyColor, 0.5);
     }
 }
+#endif
 
 void main()
 {
@@ -345,9 +365,11 @@ void main()
         tangent.xyz = -tangent.xyz;
     }
     // 光追反射：在应用阴影前混合镜面反射采样（教程 Task 11）
+#ifndef NO_RAY_QUERY
     if (pc.materialParams1.z > 0.0) {
         apply_reflection(inWorldPos, Ng, baseColor);
     }
+#endif
     // Start from geometric normal. Only apply normal map when tangent is valid.
     vec3 N = Ng;
     float tangentLen2 = dot(tangent.xyz, tangent.xyz);
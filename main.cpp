@@ -1,5 +1,13 @@
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
+#include "Configs/AppConfig.h"
+#include "Configs/RuntimeConfig.h"
 #include "Runtime/VulkanApplication.h"
 #include "ECS/ECS.h"
 
@@ -10,9 +18,102 @@ struct TestComponent : public Component {
     void OnInitialize() override { value = 42; }
     void Update(float dt) override { (void)dt; value += 1; }
 };
+
+struct CommandLine {
+    bool headless = false;
+    HeadlessOptions headlessOptions;
+    std::optional<BenchmarkOptions> benchmark;
+    std::vector<std::string> occlusionBenchmarkPaths;
+    std::string compareBase;
+    std::string compareCurrent;
+    double threshold = AppConfig::BENCHMARK_REGRESSION_THRESHOLD_PERCENT;
+};
+
+constexpr const char* USAGE =
+    " [--frames-in-flight=N]"
+    " [--headless [--frames=N] [--size=WxH] [--capture-every=N] [--output=DIR]]"
+    " [--benchmark=CAMERA_PATH [--warmup=N] [--bench-frames=N] [--report=FILE]]"
+    " [--occlusion-benchmark=CAMERA_PATH[,CAMERA_PATH...] [--size=WxH]]"
+    " | --compare=BASE.json,CURRENT.json [--threshold=PERCENT]";
+
+bool parseArgs(int argc, char** argv, CommandLine& cmd)
+{
+    BenchmarkOptions benchmark;
+    bool hasBenchmark = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        auto value = [arg](const char* prefix) -> const char* {
+            const size_t len = std::strlen(prefix);
+            return std::strncmp(arg, prefix, len) == 0 ? arg + len : nullptr;
+        };
+        if (const char* inFlight = value("--frames-in-flight=")) {
+            const unsigned long count = std::stoul(inFlight);
+            if (count < 1 || count > static_cast<unsigned long>(AppConfig::MAX_FRAMES_IN_FLIGHT)) return false;
+            RuntimeConfig::framesInFlight = static_cast<uint32_t>(count);
+        } else if (std::strcmp(arg, "--headless") == 0) {
+            cmd.headless = true;
+        } else if (const char* frames = value("--frames=")) {
+            cmd.headlessOptions.frameCount = static_cast<uint32_t>(std::stoul(frames));
+        } else if (const char* size = value("--size=")) {
+            unsigned width = 0, height = 0;
+            if (std::sscanf(size, "%ux%u", &width, &height) != 2 || width == 0 || height == 0) return false;
+            cmd.headlessOptions.width = width;
+            cmd.headlessOptions.height = height;
+        } else if (const char* every = value("--capture-every=")) {
+            cmd.headlessOptions.captureInterval = static_cast<uint32_t>(std::stoul(every));
+        } else if (const char* output = value("--output=")) {
+            cmd.headlessOptions.outputDir = output;
+        } else if (const char* path = value("--benchmark=")) {
+            benchmark.cameraPath = path;
+            hasBenchmark = true;
+        } else if (const char* paths = value("--occlusion-benchmark=")) {
+            for (const char* begin = paths; *begin != '\0';) {
+                const char* comma = std::strchr(begin, ',');
+                const char* end = comma ? comma : begin + std::strlen(begin);
+                if (end == begin) return false;
+                cmd.occlusionBenchmarkPaths.emplace_back(begin, end);
+                begin = comma ? comma + 1 : end;
+            }
+            if (cmd.occlusionBenchmarkPaths.empty()) return false;
+        } else if (const char* warmup = value("--warmup=")) {
+            benchmark.warmupFrames = static_cast<uint32_t>(std::stoul(warmup));
+        } else if (const char* benchFrames = value("--bench-frames=")) {
+            benchmark.measuredFrames = static_cast<uint32_t>(std::stoul(benchFrames));
+        } else if (const char* report = value("--report=")) {
+            benchmark.reportPath = report;
+        } else if (const char* compare = value("--compare=")) {
+            const char* comma = std::strchr(compare, ',');
+            if (!comma) return false;
+            cmd.compareBase.assign(compare, comma);
+            cmd.compareCurrent = comma + 1;
+        } else if (const char* threshold = value("--threshold=")) {
+            cmd.threshold = std::stod(threshold);
+        } else {
+            return false;
+        }
+    }
+    if (hasBenchmark) {
+        cmd.benchmark = benchmark;
+    }
+    return true;
+}
 }  // namespace
 
-int main() {
+int main(int argc, char** argv) {
+    CommandLine cmd;
+    try {
+        if (!parseArgs(argc, argv, cmd)) {
+            throw std::invalid_argument("unknown argument");
+        }
+    } catch (const std::exception&) {
+        std::cerr << "usage: " << argv[0] << USAGE << "\n";
+        return EXIT_FAILURE;
+    }
+    if (!cmd.compareBase.empty()) {
+        // Report comparison only: no window, no device. Exit code 1 flags regressions for CI.
+        return compareBenchmarkReports(cmd.compareBase, cmd.compareCurrent, cmd.threshold);
+    }
+
     // Verify ECS component system
     {
         Scene scene;
@@ -36,7 +137,19 @@ int main() {
     VulkanApplication app;
 
     try {
-        app.run();
+        if (!cmd.occlusionBenchmarkPaths.empty()) {
+            // Masked occlusion culling on the loaded scene along camera paths; nothing is rendered.
+            app.runOcclusionBenchmark(cmd.occlusionBenchmarkPaths, cmd.headlessOptions);
+            return EXIT_SUCCESS;
+        }
+        if (cmd.benchmark) {
+            app.setBenchmark(*cmd.benchmark);
+        }
+        if (cmd.headless) {
+            app.runHeadless(cmd.headlessOptions);
+        } else {
+            app.run();
+        }
     }
     catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
@@ -0,0 +1,799 @@
+// Headless check of gpu_cull.comp against a CPU reference culler. The shader is bound through the descriptor set and
+// pipeline layouts of the production GpuCullingPipeline and dispatched twice over random draw instances:
+// - frustum: frustum test only (Hi-Z off); survivors must match what Frustum::Intersects keeps on the CPU.
+// - hiz: frustum test off, Hi-Z on over a known depth pyramid (a wall, a closer panel and a few holes, max-reduced
+//   like hiz_build.comp); survivors and the occlusion-culled total must match a CPU mirror of the shader's Hi-Z test.
+// Both compare the per-bucket survivor counts, the culled totals and every generated indirect command. Runs on any
+// Vulkan 1.2 device; CI uses a software ICD (lavapipe / SwiftShader through VK_ICD_FILENAMES).
+//
+// Usage: GpuCullingTest <gpu_cull.comp.spv>
+// Exit codes: 0 = pass, 1 = mismatch, 77 = no Vulkan device (ctest reports the test as skipped).
+
+#include "Engine/Math/BoundingBox.h"
+#include "Engine/Math/Frustum.h"
+#include "Engine/Math/GlmConfig.h"
+#include "Rendering/culling/GpuCullData.h"
+#include "Rendering/pipeline/GpuCullingPipeline.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <vulkan/vulkan_raii.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int EXIT_SKIPPED = 77;
+constexpr uint32_t DRAW_COUNT = 5000;  // not a multiple of the group size: the tail threads must bail out
+constexpr uint32_t BUCKET_COUNT = 7;
+// Boxes closer than this to a plane are regenerated, so float differences between the CPU corner transform and
+// the shader's center/extent form cannot flip a result.
+constexpr float PLANE_MARGIN = 0.05f;
+
+// Hi-Z case: full-resolution depth size of the previous frame (the pyramid's mip0 is half of it, as in
+// GpuCullingPass) and the view distances of the occluders drawn into it.
+constexpr uint32_t DEPTH_WIDTH = 256;
+constexpr uint32_t DEPTH_HEIGHT = 128;
+constexpr float WALL_DISTANCE = 20.0f;
+constexpr float PANEL_DISTANCE = 10.0f;
+constexpr float HOLE_CHANCE = 0.005f;
+// Results this close to a pixel edge, the near-plane cutoff or a depth tie are regenerated: a last-ulp difference
+// between the CPU and the GPU transform could flip them.
+constexpr float PIXEL_EDGE_MARGIN = 1e-3f;
+constexpr float NDC_MARGIN = 1e-4f;
+constexpr float DEPTH_MARGIN = 1e-6f;
+
+struct HostBuffer {
+    std::optional<vk::raii::Buffer> buffer;
+    std::optional<vk::raii::DeviceMemory> memory;
+    void* mapped = nullptr;
+};
+
+struct Scene {
+    std::vector<GpuCull::DrawInstance> instances;
+    std::vector<glm::mat4> worldMatrices;
+    std::vector<uint32_t> bucketFirst;
+    std::vector<uint32_t> bucketSize;
+};
+
+struct Expected {
+    std::vector<uint8_t> visible;
+    std::vector<uint32_t> bucketCounts;
+    uint32_t frustumCulled = 0;
+    uint32_t occlusionCulled = 0;
+};
+
+// Hi-Z pyramid laid out like GpuCullingPass's: mip0 is half the depth resolution and every further mip keeps the
+// farthest depth of its 2x2 footprint in the previous one.
+struct HizPyramid {
+    uint32_t depthWidth = 0;
+    uint32_t depthHeight = 0;
+    std::vector<uint32_t> widths;
+    std::vector<uint32_t> heights;
+    std::vector<std::vector<float>> mips;
+
+    float at(uint32_t level, int x, int y) const { return mips[level][static_cast<size_t>(y) * widths[level] + x]; }
+};
+
+struct HizTest {
+    bool visible = true;
+    bool fragile = false;
+    int level = -1;  // mip the rectangle was tested against (-1 = accepted before the pyramid lookup)
+};
+
+uint32_t findMemoryType(const vk::raii::PhysicalDevice& physicalDevice, uint32_t typeBits, vk::MemoryPropertyFlags flags)
+{
+    const vk::PhysicalDeviceMemoryProperties props = physicalDevice.getMemoryProperties();
+    for (uint32_t i = 0; i < props.memoryTypeCount; ++i) {
+        if ((typeBits & (1u << i)) != 0u && (props.memoryTypes[i].propertyFlags & flags) == flags) {
+            return i;
+        }
+    }
+    throw std::runtime_error("no suitable memory type");
+}
+
+HostBuffer createHostBuffer(const vk::raii::Device& device, const vk::raii::PhysicalDevice& physicalDevice,
+                            vk::DeviceSize size, vk::BufferUsageFlags usage)
+{
+    HostBuffer result;
+    vk::BufferCreateInfo bufferInfo{};
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = vk::SharingMode::eExclusive;
+    result.buffer.emplace(device, bufferInfo);
+
+    const vk::MemoryRequirements requirements = result.buffer->getMemoryRequirements();
+    vk::MemoryAllocateInfo allocInfo{};
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(physicalDevice, requirements.memoryTypeBits,
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+    result.memory.emplace(device, allocInfo);
+    result.buffer->bindMemory(**result.memory, 0);
+    result.mapped = result.memory->mapMemory(0, size);
+    return result;
+}
+
+std::vector<uint32_t> readSpirv(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    const std::streamsize size = file.tellg();
+    std::vector<uint32_t> code(static_cast<size_t>(size) / sizeof(uint32_t));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(code.data()), static_cast<std::streamsize>(code.size() * sizeof(uint32_t)));
+    return code;
+}
+
+void submitAndWait(const vk::raii::Device& device, const vk::raii::Queue& queue, const vk::raii::CommandPool& commandPool,
+                   const std::function<void(vk::raii::CommandBuffer&)>& record)
+{
+    vk::CommandBufferAllocateInfo allocInfo{};
+    allocInfo.commandPool = *commandPool;
+    allocInfo.level = vk::CommandBufferLevel::ePrimary;
+    allocInfo.commandBufferCount = 1;
+    vk::raii::CommandBuffers commandBuffers(device, allocInfo);
+    vk::raii::CommandBuffer& cb = commandBuffers[0];
+
+    cb.begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+    record(cb);
+    cb.end();
+
+    vk::raii::Fence fence(device, vk::FenceCreateInfo{});
+    const vk::CommandBuffer cbHandle = *cb;
+    vk::SubmitInfo submitInfo{};
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &cbHandle;
+    queue.submit(submitInfo, *fence);
+    if (device.waitForFences({*fence}, VK_TRUE, UINT64_MAX) != vk::Result::eSuccess) {
+        throw std::runtime_error("fence wait");
+    }
+}
+
+// Smallest distance of the box's p-vertex to any plane, in units of the plane normal.
+float planeMargin(const Frustum& frustum, const BoundingBox& box)
+{
+    float margin = 1e30f;
+    for (const glm::vec4& plane : frustum.GetPlanes()) {
+        const glm::vec3 positiveVertex(plane.x >= 0.0f ? box.max.x : box.min.x,
+                                       plane.y >= 0.0f ? box.max.y : box.min.y,
+                                       plane.z >= 0.0f ? box.max.z : box.min.z);
+        const float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            margin = std::min(margin, std::abs(glm::dot(glm::vec3(plane), positiveVertex) + plane.w) / length);
+        }
+    }
+    return margin;
+}
+
+// Bucket layout and mesh draw info of DRAW_COUNT slots; bounds and world matrices are left to the caller.
+Scene createSlots(std::mt19937& rng)
+{
+    std::uniform_int_distribution<uint32_t> bucket(0u, BUCKET_COUNT - 1u);
+
+    Scene scene;
+    std::vector<uint32_t> bucketOf(DRAW_COUNT);
+    for (uint32_t& b : bucketOf) {
+        b = bucket(rng);
+    }
+    // Slots are sorted by bucket, like FrameManager's opaque slots.
+    std::sort(bucketOf.begin(), bucketOf.end());
+    scene.bucketFirst.assign(BUCKET_COUNT, 0u);
+    scene.bucketSize.assign(BUCKET_COUNT, 0u);
+    for (uint32_t i = DRAW_COUNT; i-- > 0;) {
+        scene.bucketFirst[bucketOf[i]] = i;
+        ++scene.bucketSize[bucketOf[i]];
+    }
+
+    scene.instances.resize(DRAW_COUNT);
+    scene.worldMatrices.assign(DRAW_COUNT, glm::mat4(1.0f));
+    for (uint32_t i = 0; i < DRAW_COUNT; ++i) {
+        GpuCull::DrawInstance& instance = scene.instances[i];
+        instance.indexCount = 3u * (i + 1u);
+        instance.firstIndex = 7u * i;
+        instance.vertexOffset = static_cast<int32_t>(i) * 11 - 500;
+        instance.bucketIndex = bucketOf[i];
+        instance.bucketFirstCommand = scene.bucketFirst[bucketOf[i]];
+    }
+    return scene;
+}
+
+bool hasBounds(uint32_t index)
+{
+    return (index % 16u) != 5u;  // some draws without bounds: never culled
+}
+
+Scene buildFrustumScene(const Frustum& frustum)
+{
+    std::mt19937 rng(1234u);
+    std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+    std::uniform_real_distribution<float> halfSize(0.1f, 6.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+    Scene scene = createSlots(rng);
+    for (uint32_t i = 0; i < DRAW_COUNT; ++i) {
+        GpuCull::DrawInstance& instance = scene.instances[i];
+        do {
+            const glm::vec3 center(position(rng), position(rng), position(rng));
+            const glm::vec3 extent(halfSize(rng), halfSize(rng), halfSize(rng));
+            glm::mat4 world = glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), position(rng), position(rng)));
+            world = glm::rotate(world, angle(rng), glm::normalize(glm::vec3(position(rng), position(rng), 1.0f)));
+            world = glm::scale(world, glm::vec3(scale(rng), scale(rng), scale(rng)));
+            scene.worldMatrices[i] = world;
+            instance.boundsMin = glm::vec4(center - extent, hasBounds(i) ? 1.0f : 0.0f);
+            instance.boundsMax = glm::vec4(center + extent, 0.0f);
+
+            BoundingBox box;
+            box.min = glm::vec3(instance.boundsMin);
+            box.max = glm::vec3(instance.boundsMax);
+            box.Transform(world);
+            if (!hasBounds(i) || planeMargin(frustum, box) > PLANE_MARGIN) {
+                break;
+            }
+        } while (true);
+    }
+    return scene;
+}
+
+Expected expectFrustum(const Frustum& frustum, const Scene& scene)
+{
+    Expected expected;
+    expected.visible.assign(DRAW_COUNT, 0u);
+    expected.bucketCounts.assign(BUCKET_COUNT, 0u);
+    for (uint32_t i = 0; i < DRAW_COUNT; ++i) {
+        const GpuCull::DrawInstance& instance = scene.instances[i];
+        bool visible = true;
+        if (instance.boundsMin.w > 0.5f) {
+            BoundingBox box;
+            box.min = glm::vec3(instance.boundsMin);
+            box.max = glm::vec3(instance.boundsMax);
+            box.Transform(scene.worldMatrices[i]);
+            visible = frustum.Intersects(box);
+        }
+        if (visible) {
+            expected.visible[i] = 1u;
+            ++expected.bucketCounts[instance.bucketIndex];
+        } else {
+            ++expected.frustumCulled;
+        }
+    }
+    return expected;
+}
+
+float viewDepth(const glm::mat4& viewProj, float distance)
+{
+    const glm::vec4 clip = viewProj * glm::vec4(0.0f, 0.0f, -distance, 1.0f);
+    return clip.z / clip.w;
+}
+
+// Previous-frame depth of a camera at the origin looking down -Z: a wall over the left 3/5 of the screen, a closer
+// panel inside it, sparse holes (cleared depth) through both and nothing on the right. The higher mips come out of
+// the same max reduction as hiz_build.comp, odd sizes folding the extra row/column into the last texel.
+HizPyramid buildPyramid(const glm::mat4& prevViewProj)
+{
+    HizPyramid pyramid;
+    pyramid.depthWidth = DEPTH_WIDTH;
+    pyramid.depthHeight = DEPTH_HEIGHT;
+    const uint32_t width = DEPTH_WIDTH / 2u;
+    const uint32_t height = DEPTH_HEIGHT / 2u;
+    uint32_t mipCount = 1;
+    for (uint32_t size = std::max(width, height); size > 1u; size /= 2u) {
+        ++mipCount;
+    }
+
+    const float wallDepth = viewDepth(prevViewProj, WALL_DISTANCE);
+    const float panelDepth = viewDepth(prevViewProj, PANEL_DISTANCE);
+    std::mt19937 rng(77u);
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    std::vector<float> mip0(static_cast<size_t>(width) * height, 1.0f);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width * 3u / 5u; ++x) {
+            const bool panel = x >= width / 4u && x < width / 2u && y >= height / 4u && y < height * 3u / 4u;
+            mip0[static_cast<size_t>(y) * width + x] = chance(rng) < HOLE_CHANCE ? 1.0f : (panel ? panelDepth : wallDepth);
+        }
+    }
+    pyramid.widths.push_back(width);
+    pyramid.heights.push_back(height);
+    pyramid.mips.push_back(std::move(mip0));
+
+    for (uint32_t level = 1; level < mipCount; ++level) {
+        const uint32_t srcWidth = pyramid.widths[level - 1u];
+        const uint32_t srcHeight = pyramid.heights[level - 1u];
+        const uint32_t dstWidth = std::max(1u, width >> level);
+        const uint32_t dstHeight = std::max(1u, height >> level);
+        std::vector<float> mip(static_cast<size_t>(dstWidth) * dstHeight, 0.0f);
+        for (uint32_t y = 0; y < dstHeight; ++y) {
+            const uint32_t extentY = (y == dstHeight - 1u && (srcHeight & 1u) != 0u) ? 3u : 2u;
+            for (uint32_t x = 0; x < dstWidth; ++x) {
+                const uint32_t extentX = (x == dstWidth - 1u && (srcWidth & 1u) != 0u) ? 3u : 2u;
+                float farthest = 0.0f;
+                for (uint32_t sy = 0; sy < extentY; ++sy) {
+                    for (uint32_t sx = 0; sx < extentX; ++sx) {
+                        const int px = std::min<int>(static_cast<int>(x * 2u + sx), static_cast<int>(srcWidth) - 1);
+                        const int py = std::min<int>(static_cast<int>(y * 2u + sy), static_cast<int>(srcHeight) - 1);
+                        farthest = std::max(farthest, pyramid.at(level - 1u, px, py));
+                    }
+                }
+                mip[static_cast<size_t>(y) * dstWidth + x] = farthest;
+            }
+        }
+        pyramid.widths.push_back(dstWidth);
+        pyramid.heights.push_back(dstHeight);
+        pyramid.mips.push_back(std::move(mip));
+    }
+    return pyramid;
+}
+
+// CPU mirror of occlusionVisible() in gpu_cull.comp.
+HizTest cpuHizTest(const HizPyramid& pyramid, const glm::mat4& prevViewProj, const glm::vec3& center, const glm::vec3& extent)
+{
+    HizTest result;
+    std::array<glm::vec4, 8> clips;
+    bool crossesNear = false;
+    for (int i = 0; i < 8; ++i) {
+        const glm::vec3 corner = center + extent * glm::vec3((i & 1) != 0 ? 1.0f : -1.0f,
+                                                             (i & 2) != 0 ? 1.0f : -1.0f,
+                                                             (i & 4) != 0 ? 1.0f : -1.0f);
+        clips[i] = prevViewProj * glm::vec4(corner, 1.0f);
+        crossesNear = crossesNear || clips[i].w <= 1e-5f;
+        result.fragile = result.fragile || std::abs(clips[i].w - 1e-5f) < NDC_MARGIN;
+    }
+    if (crossesNear) {
+        return result;
+    }
+
+    glm::vec2 ndcMin(1.0f);
+    glm::vec2 ndcMax(-1.0f);
+    float nearestDepth = 1.0f;
+    for (const glm::vec4& clip : clips) {
+        const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        ndcMin = glm::vec2(std::min(ndcMin.x, ndc.x), std::min(ndcMin.y, ndc.y));
+        ndcMax = glm::vec2(std::max(ndcMax.x, ndc.x), std::max(ndcMax.y, ndc.y));
+        nearestDepth = std::min(nearestDepth, ndc.z);
+    }
+    for (int axis = 0; axis < 2; ++axis) {
+        result.fragile = result.fragile || std::abs(ndcMin[axis] - 1.0f) < NDC_MARGIN
+                         || std::abs(ndcMax[axis] + 1.0f) < NDC_MARGIN;
+    }
+    if (ndcMin.x > 1.0f || ndcMin.y > 1.0f || ndcMax.x < -1.0f || ndcMax.y < -1.0f) {
+        return result;
+    }
+
+    const float depthSize[2] = {static_cast<float>(pyramid.depthWidth), static_cast<float>(pyramid.depthHeight)};
+    int pixMin[2];
+    int pixMax[2];
+    for (int axis = 0; axis < 2; ++axis) {
+        const float lo = std::clamp(ndcMin[axis] * 0.5f + 0.5f, 0.0f, 1.0f) * depthSize[axis];
+        const float hi = std::clamp(ndcMax[axis] * 0.5f + 0.5f, 0.0f, 1.0f) * depthSize[axis];
+        for (float pixel : {lo, hi}) {
+            // Edges at 0 and at the full size floor/clamp to the same pixel either way.
+            result.fragile = result.fragile || (pixel > 0.5f && pixel < depthSize[axis] - 0.5f
+                                                && std::abs(pixel - std::round(pixel)) < PIXEL_EDGE_MARGIN);
+        }
+        const int fullMax = static_cast<int>(depthSize[axis]) - 1;
+        pixMin[axis] = std::clamp(static_cast<int>(std::floor(lo)), 0, fullMax);
+        pixMax[axis] = std::clamp(static_cast<int>(std::floor(hi)), 0, fullMax);
+    }
+
+    const int mipCount = static_cast<int>(pyramid.mips.size());
+    int level = 0;
+    while (level < mipCount - 1) {
+        const int spanX = (pixMax[0] >> (level + 1)) - (pixMin[0] >> (level + 1));
+        const int spanY = (pixMax[1] >> (level + 1)) - (pixMin[1] >> (level + 1));
+        if (spanX <= 1 && spanY <= 1) {
+            break;
+        }
+        ++level;
+    }
+
+    const int mipMaxX = static_cast<int>(pyramid.widths[level]) - 1;
+    const int mipMaxY = static_cast<int>(pyramid.heights[level]) - 1;
+    const int t0x = std::clamp(pixMin[0] >> (level + 1), 0, mipMaxX);
+    const int t0y = std::clamp(pixMin[1] >> (level + 1), 0, mipMaxY);
+    const int t1x = std::clamp(pixMax[0] >> (level + 1), 0, mipMaxX);
+    const int t1y = std::clamp(pixMax[1] >> (level + 1), 0, mipMaxY);
+    const float farthest = std::max(std::max(pyramid.at(level, t0x, t0y), pyramid.at(level, t1x, t0y)),
+                                    std::max(pyramid.at(level, t0x, t1y), pyramid.at(level, t1x, t1y)));
+
+    result.level = level;
+    result.visible = nearestDepth <= farthest;
+    result.fragile = result.fragile || std::abs(nearestDepth - farthest) < DEPTH_MARGIN;
+    return result;
+}
+
+HizTest cpuHizTest(const HizPyramid& pyramid, const glm::mat4& prevViewProj, const GpuCull::DrawInstance& instance)
+{
+    // World matrices are identity in the Hi-Z scene, so the shader's center/extent equal the local ones bit for bit.
+    const glm::vec3 center = (glm::vec3(instance.boundsMin) + glm::vec3(instance.boundsMax)) * 0.5f;
+    const glm::vec3 extent = (glm::vec3(instance.boundsMax) - glm::vec3(instance.boundsMin)) * 0.5f;
+    return cpuHizTest(pyramid, prevViewProj, center, extent);
+}
+
+// Boxes spread over the previous frame's screen in front of, between and behind the occluders; every 50th one
+// straddles the camera plane (no reliable rectangle: always kept).
+Scene buildHizScene(const HizPyramid& pyramid, const glm::mat4& prevViewProj)
+{
+    std::mt19937 rng(4321u);
+    std::uniform_real_distribution<float> screen(-1.2f, 1.2f);
+    std::uniform_real_distribution<float> distance(3.0f, 45.0f);
+    std::uniform_real_distribution<float> straddle(-0.5f, 0.5f);
+    std::uniform_real_distribution<float> halfSize(0.05f, 2.5f);
+    const float tanHalfFov = std::tan(glm::radians(30.0f));
+    const float aspect = static_cast<float>(DEPTH_WIDTH) / static_cast<float>(DEPTH_HEIGHT);
+
+    Scene scene = createSlots(rng);
+    for (uint32_t i = 0; i < DRAW_COUNT; ++i) {
+        GpuCull::DrawInstance& instance = scene.instances[i];
+        do {
+            const float d = (i % 50u) == 7u ? straddle(rng) : distance(rng);
+            const glm::vec3 center(screen(rng) * tanHalfFov * aspect * d, screen(rng) * tanHalfFov * d, -d);
+            const glm::vec3 extent(halfSize(rng), halfSize(rng), halfSize(rng));
+            instance.boundsMin = glm::vec4(center - extent, hasBounds(i) ? 1.0f : 0.0f);
+            instance.boundsMax = glm::vec4(center + extent, 0.0f);
+        } while (hasBounds(i) && cpuHizTest(pyramid, prevViewProj, instance).fragile);
+    }
+    return scene;
+}
+
+Expected expectHiz(const HizPyramid& pyramid, const glm::mat4& prevViewProj, const Scene& scene, std::set<int>& levelsUsed)
+{
+    Expected expected;
+    expected.visible.assign(DRAW_COUNT, 0u);
+    expected.bucketCounts.assign(BUCKET_COUNT, 0u);
+    for (uint32_t i = 0; i < DRAW_COUNT; ++i) {
+        const GpuCull::DrawInstance& instance = scene.instances[i];
+        bool visible = true;
+        if (instance.boundsMin.w > 0.5f) {
+            const HizTest test = cpuHizTest(pyramid, prevViewProj, instance);
+            visible = test.visible;
+            if (test.level >= 0) levelsUsed.insert(test.level);
+        }
+        if (visible) {
+            expected.visible[i] = 1u;
+            ++expected.bucketCounts[instance.bucketIndex];
+        } else {
+            ++expected.occlusionCulled;
+        }
+    }
+    return expected;
+}
+
+uint32_t compareWithReference(const std::string& label, const Scene& scene, const Expected& expected,
+                              const uint32_t* counts, const vk::DrawIndexedIndirectCommand* commands)
+{
+    uint32_t failures = 0;
+    auto fail = [&](const std::string& message) {
+        if (++failures <= 20u) {
+            std::cerr << "[GpuCullingTest] FAIL (" << label << "): " << message << "\n";
+        }
+    };
+
+    uint32_t gpuVisible = 0;
+    uint32_t cpuVisible = 0;
+    std::vector<uint8_t> seen(DRAW_COUNT, 0u);
+    for (uint32_t b = 0; b < BUCKET_COUNT; ++b) {
+        gpuVisible += counts[b];
+        cpuVisible += expected.bucketCounts[b];
+        if (counts[b] != expected.bucketCounts[b]) {
+            fail("bucket " + std::to_string(b) + ": gpu=" + std::to_string(counts[b]) + " cpu=" + std::to_string(expected.bucketCounts[b]));
+        }
+        const uint32_t written = std::min(counts[b], scene.bucketSize[b]);
+        for (uint32_t k = 0; k < written; ++k) {
+            const vk::DrawIndexedIndirectCommand& cmd = commands[scene.bucketFirst[b] + k];
+            const uint32_t drawId = cmd.firstInstance;
+            if (drawId >= DRAW_COUNT || scene.instances[drawId].bucketIndex != b) {
+                fail("bucket " + std::to_string(b) + " command " + std::to_string(k) + ": bad draw id " + std::to_string(drawId));
+                continue;
+            }
+            const GpuCull::DrawInstance& instance = scene.instances[drawId];
+            if (!expected.visible[drawId]) fail("draw " + std::to_string(drawId) + " kept but culled on the CPU");
+            if (seen[drawId]++) fail("draw " + std::to_string(drawId) + " written twice");
+            if (cmd.instanceCount != 1u || cmd.indexCount != instance.indexCount || cmd.firstIndex != instance.firstIndex
+                || cmd.vertexOffset != instance.vertexOffset) {
+                fail("draw " + std::to_string(drawId) + ": command does not match its MeshDrawInfo");
+            }
+        }
+    }
+    if (counts[BUCKET_COUNT] != expected.frustumCulled) {
+        fail("frustum culled: gpu=" + std::to_string(counts[BUCKET_COUNT]) + " cpu=" + std::to_string(expected.frustumCulled));
+    }
+    if (counts[BUCKET_COUNT + 1u] != expected.occlusionCulled) {
+        fail("occlusion culled: gpu=" + std::to_string(counts[BUCKET_COUNT + 1u]) + " cpu=" + std::to_string(expected.occlusionCulled));
+    }
+
+    std::cout << "[GpuCullingTest] " << label << ": draws=" << DRAW_COUNT << " buckets=" << BUCKET_COUNT
+              << " visible(gpu/cpu)=" << gpuVisible << "/" << cpuVisible
+              << " frustumCulled(gpu/cpu)=" << counts[BUCKET_COUNT] << "/" << expected.frustumCulled
+              << " occlusionCulled(gpu/cpu)=" << counts[BUCKET_COUNT + 1u] << "/" << expected.occlusionCulled << "\n";
+    if (cpuVisible == 0u || expected.frustumCulled + expected.occlusionCulled == 0u) {
+        fail("degenerate scene: every draw is kept or every draw is culled");
+    }
+    return failures;
+}
+
+int run(const std::string& shaderPath)
+{
+    vk::raii::Context context;
+    vk::ApplicationInfo appInfo{};
+    appInfo.pApplicationName = "GpuCullingTest";
+    appInfo.apiVersion = VK_API_VERSION_1_2;
+    vk::InstanceCreateInfo instanceInfo{};
+    instanceInfo.pApplicationInfo = &appInfo;
+
+    std::optional<vk::raii::Instance> instance;
+    std::optional<vk::raii::PhysicalDevices> physicalDevices;
+    try {
+        instance.emplace(context, instanceInfo);
+        physicalDevices.emplace(*instance);
+    } catch (const vk::SystemError& e) {
+        std::cout << "[GpuCullingTest] skipped: no Vulkan instance (" << e.what() << ")\n";
+        return EXIT_SKIPPED;
+    }
+    if (physicalDevices->empty()) {
+        std::cout << "[GpuCullingTest] skipped: no Vulkan device\n";
+        return EXIT_SKIPPED;
+    }
+    const vk::raii::PhysicalDevice& physicalDevice = physicalDevices->front();
+    std::cout << "[GpuCullingTest] device: " << physicalDevice.getProperties().deviceName.data() << "\n";
+
+    const std::vector<vk::QueueFamilyProperties> families = physicalDevice.getQueueFamilyProperties();
+    uint32_t queueFamily = UINT32_MAX;
+    for (uint32_t i = 0; i < families.size(); ++i) {
+        if (families[i].queueFlags & vk::QueueFlagBits::eCompute) {
+            queueFamily = i;
+            break;
+        }
+    }
+    if (queueFamily == UINT32_MAX) {
+        std::cout << "[GpuCullingTest] skipped: no compute queue\n";
+        return EXIT_SKIPPED;
+    }
+
+    const float queuePriority = 1.0f;
+    vk::DeviceQueueCreateInfo queueInfo{};
+    queueInfo.queueFamilyIndex = queueFamily;
+    queueInfo.queueCount = 1;
+    queueInfo.pQueuePriorities = &queuePriority;
+    vk::DeviceCreateInfo deviceInfo{};
+    deviceInfo.queueCreateInfoCount = 1;
+    deviceInfo.pQueueCreateInfos = &queueInfo;
+    vk::raii::Device device(physicalDevice, deviceInfo);
+    vk::raii::Queue queue(device, queueFamily, 0);
+    vk::CommandPoolCreateInfo commandPoolInfo{};
+    commandPoolInfo.queueFamilyIndex = queueFamily;
+    vk::raii::CommandPool commandPool(device, commandPoolInfo);
+
+    // Scenes + CPU references.
+    const glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 40.0f), glm::vec3(10.0f, -5.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 viewProj = proj * view;
+    const Frustum frustum(viewProj);
+    const Scene frustumScene = buildFrustumScene(frustum);
+    const Expected frustumExpected = expectFrustum(frustum, frustumScene);
+
+    // The Hi-Z case tests against last frame's camera only; this frame's viewProj (unused with the frustum test off)
+    // is deliberately different so a shader projecting with it would not match.
+    const glm::mat4 hizProj = glm::perspective(glm::radians(60.0f), static_cast<float>(DEPTH_WIDTH) / DEPTH_HEIGHT, 0.1f, 1000.0f);
+    const glm::mat4 prevViewProj = hizProj * glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const HizPyramid pyramid = buildPyramid(prevViewProj);
+    const Scene hizScene = buildHizScene(pyramid, prevViewProj);
+    std::set<int> hizLevelsUsed;
+    const Expected hizExpected = expectHiz(pyramid, prevViewProj, hizScene, hizLevelsUsed);
+    const uint32_t mipCount = static_cast<uint32_t>(pyramid.mips.size());
+
+    // Buffers (host visible: the test reads everything back).
+    const vk::DeviceSize countsSize = static_cast<vk::DeviceSize>(BUCKET_COUNT + 2u) * sizeof(uint32_t);
+    const vk::DeviceSize commandsSize = static_cast<vk::DeviceSize>(DRAW_COUNT) * sizeof(vk::DrawIndexedIndirectCommand);
+    HostBuffer paramsBuffer = createHostBuffer(device, physicalDevice, sizeof(GpuCull::Params), vk::BufferUsageFlagBits::eUniformBuffer);
+    HostBuffer drawDataBuffer = createHostBuffer(device, physicalDevice, DRAW_COUNT * sizeof(glm::mat4),
+                                                 vk::BufferUsageFlagBits::eStorageBuffer);
+    HostBuffer instanceBuffer = createHostBuffer(device, physicalDevice, DRAW_COUNT * sizeof(GpuCull::DrawInstance),
+                                                 vk::BufferUsageFlagBits::eStorageBuffer);
+    HostBuffer commandBuffer = createHostBuffer(device, physicalDevice, commandsSize, vk::BufferUsageFlagBits::eStorageBuffer);
+    HostBuffer countBuffer = createHostBuffer(device, physicalDevice, countsSize, vk::BufferUsageFlagBits::eStorageBuffer);
+
+    // Hi-Z pyramid: every mip uploaded from the CPU copy the reference reads.
+    vk::ImageCreateInfo imageInfo{};
+    imageInfo.imageType = vk::ImageType::e2D;
+    imageInfo.format = vk::Format::eR32Sfloat;
+    imageInfo.extent = vk::Extent3D{pyramid.widths[0], pyramid.heights[0], 1};
+    imageInfo.mipLevels = mipCount;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = vk::SampleCountFlagBits::e1;
+    imageInfo.tiling = vk::ImageTiling::eOptimal;
+    imageInfo.usage = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst;
+    imageInfo.sharingMode = vk::SharingMode::eExclusive;
+    imageInfo.initialLayout = vk::ImageLayout::eUndefined;
+    vk::raii::Image hizImage(device, imageInfo);
+    const vk::MemoryRequirements imageRequirements = hizImage.getMemoryRequirements();
+    vk::MemoryAllocateInfo imageAlloc{};
+    imageAlloc.allocationSize = imageRequirements.size;
+    imageAlloc.memoryTypeIndex = findMemoryType(physicalDevice, imageRequirements.memoryTypeBits, {});
+    vk::raii::DeviceMemory hizMemory(device, imageAlloc);
+    hizImage.bindMemory(*hizMemory, 0);
+
+    vk::ImageViewCreateInfo viewInfo{};
+    viewInfo.image = *hizImage;
+    viewInfo.viewType = vk::ImageViewType::e2D;
+    viewInfo.format = vk::Format::eR32Sfloat;
+    viewInfo.subresourceRange = vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, 0, mipCount, 0, 1};
+    vk::raii::ImageView hizView(device, viewInfo);
+    vk::SamplerCreateInfo samplerInfo{};
+    samplerInfo.maxLod = static_cast<float>(mipCount);
+    vk::raii::Sampler hizSampler(device, samplerInfo);
+
+    vk::DeviceSize stagingSize = 0;
+    for (const std::vector<float>& mip : pyramid.mips) {
+        stagingSize += mip.size() * sizeof(float);
+    }
+    HostBuffer staging = createHostBuffer(device, physicalDevice, stagingSize, vk::BufferUsageFlagBits::eTransferSrc);
+    std::vector<vk::BufferImageCopy> regions(mipCount);
+    vk::DeviceSize offset = 0;
+    for (uint32_t level = 0; level < mipCount; ++level) {
+        const size_t bytes = pyramid.mips[level].size() * sizeof(float);
+        std::memcpy(static_cast<char*>(staging.mapped) + offset, pyramid.mips[level].data(), bytes);
+        regions[level].bufferOffset = offset;
+        regions[level].imageSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level, 0, 1};
+        regions[level].imageExtent = vk::Extent3D{pyramid.widths[level], pyramid.heights[level], 1};
+        offset += bytes;
+    }
+    submitAndWait(device, queue, commandPool, [&](vk::raii::CommandBuffer& cb) {
+        vk::ImageMemoryBarrier barrier{};
+        barrier.srcAccessMask = {};
+        barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+        barrier.oldLayout = vk::ImageLayout::eUndefined;
+        barrier.newLayout = vk::ImageLayout::eTransferDstOptimal;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = *hizImage;
+        barrier.subresourceRange = vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, 0, mipCount, 0, 1};
+        cb.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, barrier);
+        cb.copyBufferToImage(**staging.buffer, *hizImage, vk::ImageLayout::eTransferDstOptimal, regions);
+        barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+        barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+        barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+        cb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eComputeShader, {}, {}, {}, barrier);
+    });
+
+    // Pipeline: set + pipeline layouts from GpuCullingPipeline, so a binding change there is exercised here too.
+    GpuCullingPipeline cullingPipeline;
+    cullingPipeline.initLayouts(device);
+    const vk::DescriptorSetLayout setLayoutHandle = cullingPipeline.getCullDescriptorSetLayout();
+
+    const std::vector<uint32_t> code = readSpirv(shaderPath);
+    vk::ShaderModuleCreateInfo moduleInfo{};
+    moduleInfo.codeSize = code.size() * sizeof(uint32_t);
+    moduleInfo.pCode = code.data();
+    vk::raii::ShaderModule shaderModule(device, moduleInfo);
+
+    vk::ComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.stage.stage = vk::ShaderStageFlagBits::eCompute;
+    pipelineInfo.stage.module = *shaderModule;
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.layout = cullingPipeline.getCullPipelineLayout();
+    vk::raii::Pipeline pipeline(device, nullptr, pipelineInfo);
+
+    std::array<vk::DescriptorPoolSize, 3> poolSizes{};
+    poolSizes[0] = vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer, 1};
+    poolSizes[1] = vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, 4};
+    poolSizes[2] = vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, 1};
+    vk::DescriptorPoolCreateInfo poolInfo{};
+    poolInfo.flags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+    vk::raii::DescriptorPool descriptorPool(device, poolInfo);
+
+    vk::DescriptorSetAllocateInfo setAllocInfo{};
+    setAllocInfo.descriptorPool = *descriptorPool;
+    setAllocInfo.descriptorSetCount = 1;
+    setAllocInfo.pSetLayouts = &setLayoutHandle;
+    vk::raii::DescriptorSets descriptorSets(device, setAllocInfo);
+    const vk::DescriptorSet set = *descriptorSets[0];
+
+    const std::array<vk::DescriptorBufferInfo, 5> bufferInfos = {
+        vk::DescriptorBufferInfo{**paramsBuffer.buffer, 0, VK_WHOLE_SIZE},
+        vk::DescriptorBufferInfo{**drawDataBuffer.buffer, 0, VK_WHOLE_SIZE},
+        vk::DescriptorBufferInfo{**instanceBuffer.buffer, 0, VK_WHOLE_SIZE},
+        vk::DescriptorBufferInfo{**commandBuffer.buffer, 0, VK_WHOLE_SIZE},
+        vk::DescriptorBufferInfo{**countBuffer.buffer, 0, VK_WHOLE_SIZE},
+    };
+    const vk::DescriptorImageInfo hizInfo{*hizSampler, *hizView, vk::ImageLayout::eShaderReadOnlyOptimal};
+    std::array<vk::WriteDescriptorSet, 6> writes{};
+    for (uint32_t binding = 0; binding < writes.size(); ++binding) {
+        writes[binding].dstSet = set;
+        writes[binding].dstBinding = binding;
+        writes[binding].descriptorCount = 1;
+        if (binding < bufferInfos.size()) {
+            writes[binding].descriptorType = binding == 0 ? vk::DescriptorType::eUniformBuffer : vk::DescriptorType::eStorageBuffer;
+            writes[binding].pBufferInfo = &bufferInfos[binding];
+        } else {
+            writes[binding].descriptorType = vk::DescriptorType::eCombinedImageSampler;
+            writes[binding].pImageInfo = &hizInfo;
+        }
+    }
+    device.updateDescriptorSets(writes, nullptr);
+
+    // One dispatch per case; results are compared straight from the mapped buffers.
+    auto dispatch = [&](const GpuCull::Params& params, const Scene& scene) {
+        std::memcpy(paramsBuffer.mapped, &params, sizeof(params));
+        std::memcpy(drawDataBuffer.mapped, scene.worldMatrices.data(), DRAW_COUNT * sizeof(glm::mat4));
+        std::memcpy(instanceBuffer.mapped, scene.instances.data(), DRAW_COUNT * sizeof(GpuCull::DrawInstance));
+        std::memset(commandBuffer.mapped, 0xFF, static_cast<size_t>(commandsSize));
+        std::memset(countBuffer.mapped, 0, static_cast<size_t>(countsSize));
+        submitAndWait(device, queue, commandPool, [&](vk::raii::CommandBuffer& cb) {
+            cb.bindPipeline(vk::PipelineBindPoint::eCompute, *pipeline);
+            cb.bindDescriptorSets(vk::PipelineBindPoint::eCompute, cullingPipeline.getCullPipelineLayout(), 0, {set}, nullptr);
+            cb.dispatch((DRAW_COUNT + GpuCull::GROUP_SIZE - 1u) / GpuCull::GROUP_SIZE, 1, 1);
+            vk::MemoryBarrier hostBarrier{};
+            hostBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
+            hostBarrier.dstAccessMask = vk::AccessFlagBits::eHostRead;
+            cb.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eHost,
+                               {}, hostBarrier, {}, {});
+        });
+    };
+    const auto* counts = static_cast<const uint32_t*>(countBuffer.mapped);
+    const auto* commands = static_cast<const vk::DrawIndexedIndirectCommand*>(commandBuffer.mapped);
+    uint32_t failures = 0;
+
+    GpuCull::Params frustumParams{};
+    frustumParams.viewProj = viewProj;
+    frustumParams.prevViewProj = viewProj;
+    frustumParams.frustumPlanes = frustum.GetPlanes();
+    frustumParams.counts = glm::uvec4(DRAW_COUNT, BUCKET_COUNT, 0u, 1u);
+    dispatch(frustumParams, frustumScene);
+    failures += compareWithReference("frustum", frustumScene, frustumExpected, counts, commands);
+
+    GpuCull::Params hizParams{};
+    hizParams.viewProj = viewProj;
+    hizParams.prevViewProj = prevViewProj;
+    hizParams.frustumPlanes = frustum.GetPlanes();
+    hizParams.counts = glm::uvec4(DRAW_COUNT, BUCKET_COUNT, mipCount, 0u);
+    hizParams.hizParams = glm::vec4(static_cast<float>(pyramid.depthWidth), static_cast<float>(pyramid.depthHeight),
+                                    static_cast<float>(pyramid.widths[0]), static_cast<float>(pyramid.heights[0]));
+    dispatch(hizParams, hizScene);
+    failures += compareWithReference("hiz", hizScene, hizExpected, counts, commands);
+    // Guards the Hi-Z comparison itself: tests that all land on one mip would not cover the level selection.
+    if (hizLevelsUsed.size() < 3u) {
+        std::cerr << "[GpuCullingTest] FAIL (hiz): degenerate scene: only " << hizLevelsUsed.size() << " mip level(s) tested\n";
+        ++failures;
+    }
+
+    if (failures > 0u) {
+        std::cerr << "[GpuCullingTest] " << failures << " mismatch(es)\n";
+        return 1;
+    }
+    std::cout << "[GpuCullingTest] PASS\n";
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::cerr << "usage: GpuCullingTest <gpu_cull.comp.spv>\n";
+        return 1;
+    }
+    try {
+        return run(argv[1]);
+    } catch (const std::exception& e) {
+        std::cerr << "[GpuCullingTest] FAIL: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,186 @@
+// CPU check of MaskedOcclusionBuffer, the rasterizer/tester behind SoftwareOcclusionCuller. No GPU involved.
+// - A box fully behind a rasterized occluder is rejected; boxes in front of it or beside it stay visible.
+// - Every SIMD rasterizer level supported by the CPU produces the scalar tile depths and occludee results
+//   bit for bit, also when the tile rows are split into bands the way the culler spreads them over workers.
+//
+// Usage: MaskedOcclusionTest
+// Exit codes: 0 = pass, 1 = failure.
+
+#include "Engine/Math/BoundingBox.h"
+#include "Engine/Math/FrustumCulling.h"
+#include "Engine/Math/GlmConfig.h"
+#include "Rendering/culling/MaskedOcclusionBuffer.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t WIDTH = 320;
+constexpr uint32_t HEIGHT = 180;
+constexpr uint32_t RANDOM_TRIANGLES = 2000;
+constexpr uint32_t RANDOM_BOXES = 4000;
+constexpr uint32_t ROW_BAND = 5;  // tile rows per band in the split rasterization
+
+struct Checker {
+    int failures = 0;
+    void expect(bool condition, const std::string& what)
+    {
+        if (!condition) {
+            std::cerr << "[MaskedOcclusionTest] FAIL: " << what << "\n";
+            ++failures;
+        }
+    }
+};
+
+glm::mat4 makeViewProj()
+{
+    // Camera at the origin looking down -Z.
+    const glm::mat4 proj = glm::perspective(glm::radians(60.0f), static_cast<float>(WIDTH) / HEIGHT, 0.1f, 100.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return proj * view;
+}
+
+// Axis-aligned quad at depth z (two triangles), projected into screen triangles.
+void appendQuad(const MaskedOcclusionBuffer& buffer, const glm::mat4& viewProj, float minX, float minY, float maxX,
+                float maxY, float z, std::vector<MaskedOcclusionBuffer::ScreenTriangle>& out)
+{
+    const glm::vec4 c00 = viewProj * glm::vec4(minX, minY, z, 1.0f);
+    const glm::vec4 c10 = viewProj * glm::vec4(maxX, minY, z, 1.0f);
+    const glm::vec4 c01 = viewProj * glm::vec4(minX, maxY, z, 1.0f);
+    const glm::vec4 c11 = viewProj * glm::vec4(maxX, maxY, z, 1.0f);
+    MaskedOcclusionBuffer::ScreenTriangle tri;
+    if (buffer.projectTriangle(c00, c10, c11, tri)) out.push_back(tri);
+    if (buffer.projectTriangle(c00, c11, c01, tri)) out.push_back(tri);
+}
+
+BoundingBox boxAround(const glm::vec3& center, float halfExtent)
+{
+    return BoundingBox(center - glm::vec3(halfExtent), center + glm::vec3(halfExtent));
+}
+
+void checkOccluderRejection(Checker& check, FrustumCulling::SimdLevel level)
+{
+    const std::string name = FrustumCulling::GetSimdLevelName(level);
+    const glm::mat4 viewProj = makeViewProj();
+    MaskedOcclusionBuffer buffer;
+    buffer.resize(WIDTH, HEIGHT);
+
+    // Full-screen wall at z = -10.
+    std::vector<MaskedOcclusionBuffer::ScreenTriangle> wall;
+    appendQuad(buffer, viewProj, -50.0f, -50.0f, 50.0f, 50.0f, -10.0f, wall);
+    check.expect(wall.size() == 2, name + ": wall triangles projected");
+    buffer.rasterize(wall.data(), wall.size(), 0, buffer.getTileCountY(), level);
+
+    check.expect(!buffer.testAabb(viewProj, boxAround(glm::vec3(0.0f, 0.0f, -20.0f), 1.0f)),
+                 name + ": box behind the wall is rejected");
+    check.expect(!buffer.testAabb(viewProj, boxAround(glm::vec3(4.0f, -2.0f, -40.0f), 3.0f)),
+                 name + ": off-center box behind the wall is rejected");
+    check.expect(buffer.testAabb(viewProj, boxAround(glm::vec3(0.0f, 0.0f, -5.0f), 1.0f)),
+                 name + ": box in front of the wall is visible");
+    check.expect(buffer.testAabb(viewProj, boxAround(glm::vec3(0.0f, 0.0f, -10.0f), 1.0f)),
+                 name + ": box intersecting the wall is visible");
+    check.expect(buffer.testAabb(viewProj, BoundingBox(glm::vec3(-1.0f, -1.0f, -10.0f), glm::vec3(1.0f, 1.0f, -10.0f))),
+                 name + ": box touching the wall from behind is visible");
+
+    // Small occluder: what is hidden behind it is rejected, what peeks out beside it is not.
+    buffer.clear();
+    std::vector<MaskedOcclusionBuffer::ScreenTriangle> panel;
+    appendQuad(buffer, viewProj, -2.0f, -2.0f, 2.0f, 2.0f, -10.0f, panel);
+    buffer.rasterize(panel.data(), panel.size(), 0, buffer.getTileCountY(), level);
+    check.expect(!buffer.testAabb(viewProj, boxAround(glm::vec3(0.0f, 0.0f, -20.0f), 0.5f)),
+                 name + ": box behind the panel is rejected");
+    check.expect(buffer.testAabb(viewProj, boxAround(glm::vec3(8.0f, 0.0f, -20.0f), 0.5f)),
+                 name + ": box beside the panel is visible");
+    check.expect(buffer.testAabb(viewProj, boxAround(glm::vec3(0.0f, 0.0f, -20.0f), 6.0f)),
+                 name + ": box larger than the panel is visible");
+}
+
+struct RasterResult {
+    std::vector<float> tileDepths;
+    std::vector<uint8_t> boxVisible;
+};
+
+RasterResult rasterizeRandomScene(FrustumCulling::SimdLevel level, bool splitRows)
+{
+    const glm::mat4 viewProj = makeViewProj();
+    MaskedOcclusionBuffer buffer;
+    buffer.resize(WIDTH, HEIGHT);
+
+    // Same seed for every level: identical input triangles and boxes.
+    std::mt19937 rng(1234u);
+    std::uniform_real_distribution<float> spread(-12.0f, 12.0f);
+    std::uniform_real_distribution<float> depth(-60.0f, -2.0f);
+    std::uniform_real_distribution<float> offset(-4.0f, 4.0f);
+    std::vector<MaskedOcclusionBuffer::ScreenTriangle> triangles;
+    for (uint32_t i = 0; i < RANDOM_TRIANGLES; ++i) {
+        const glm::vec3 center(spread(rng), spread(rng), depth(rng));
+        glm::vec4 clip[3];
+        for (glm::vec4& c : clip) {
+            c = viewProj * glm::vec4(center + glm::vec3(offset(rng), offset(rng), 0.25f * offset(rng)), 1.0f);
+        }
+        MaskedOcclusionBuffer::ScreenTriangle tri;
+        if (buffer.projectTriangle(clip[0], clip[1], clip[2], tri)) triangles.push_back(tri);
+    }
+
+    if (splitRows) {
+        for (uint32_t row = 0; row < buffer.getTileCountY(); row += ROW_BAND) {
+            buffer.rasterize(triangles.data(), triangles.size(), row, row + ROW_BAND, level);
+        }
+    } else {
+        buffer.rasterize(triangles.data(), triangles.size(), 0, buffer.getTileCountY(), level);
+    }
+
+    RasterResult result;
+    result.tileDepths = buffer.getTileDepths();
+    std::uniform_real_distribution<float> extent(0.1f, 2.0f);
+    for (uint32_t i = 0; i < RANDOM_BOXES; ++i) {
+        const glm::vec3 center(spread(rng), spread(rng), depth(rng));
+        result.boxVisible.push_back(buffer.testAabb(viewProj, boxAround(center, extent(rng))) ? 1u : 0u);
+    }
+    return result;
+}
+
+}  // namespace
+
+int main()
+{
+    Checker check;
+    const FrustumCulling::SimdLevel best = FrustumCulling::DetectSimdLevel();
+    const FrustumCulling::SimdLevel levels[] = {FrustumCulling::SimdLevel::Scalar, FrustumCulling::SimdLevel::Sse41,
+                                                FrustumCulling::SimdLevel::Avx2};
+
+    const RasterResult reference = rasterizeRandomScene(FrustumCulling::SimdLevel::Scalar, false);
+    uint32_t rejected = 0;
+    for (uint8_t visible : reference.boxVisible) rejected += visible ? 0u : 1u;
+    // Guards the comparison itself: a scene that rejects nothing (or everything) would compare trivially.
+    check.expect(rejected > 0 && rejected < RANDOM_BOXES, "random scene rejects some but not all boxes");
+
+    for (FrustumCulling::SimdLevel level : levels) {
+        const std::string name = FrustumCulling::GetSimdLevelName(level);
+        if (static_cast<int>(level) > static_cast<int>(best)) {
+            std::cout << "[MaskedOcclusionTest] " << name << ": not supported by this CPU, skipped\n";
+            continue;
+        }
+        checkOccluderRejection(check, level);
+        for (bool splitRows : {false, true}) {
+            const RasterResult result = rasterizeRandomScene(level, splitRows);
+            const std::string variant = name + (splitRows ? " (row bands)" : "");
+            check.expect(result.tileDepths == reference.tileDepths, variant + ": tile depths match scalar");
+            check.expect(result.boxVisible == reference.boxVisible, variant + ": occludee results match scalar");
+        }
+        std::cout << "[MaskedOcclusionTest] " << name << ": checked\n";
+    }
+
+    if (check.failures > 0) {
+        std::cerr << "[MaskedOcclusionTest] " << check.failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "[MaskedOcclusionTest] PASS (rejected " << rejected << "/" << RANDOM_BOXES << " random boxes)\n";
+    return 0;
+}
@@ -0,0 +1,252 @@
+// CPU check of the SIMD kernels against their scalar paths. No GPU involved.
+// - FrustumCulling::CullAabbBatch: 1k..1M random boxes, every SIMD level supported by the CPU must produce the
+//   scalar result bits exactly (all planes and a side-planes-only mask, also for a count that leaves a partial
+//   tail block), and the scalar bits must match Frustum::Intersects / IntersectsMasked box by box.
+// - TransformStore: composeLocal() + propagate() over random parent-sorted hierarchies (one with a node count that
+//   leaves partial SIMD batches) must reproduce the Node::getLocalMatrix() world matrices within WORLD_EPSILON
+//   (relative to the element's magnitude); the SoA path composes TRS directly instead of multiplying T * R * S.
+// Also prints one [Perf] line per size with the scalar/SIMD timings of each kernel.
+//
+// Usage: SimdKernelTest
+// Exit codes: 0 = pass, 1 = failure.
+
+#include "Engine/Math/BoundingBox.h"
+#include "Engine/Math/Frustum.h"
+#include "Engine/Math/FrustumCulling.h"
+#include "Engine/Math/GlmConfig.h"
+#include "Resource/model/Node.h"
+#include "Resource/model/TransformStore.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+constexpr uint32_t BOX_COUNTS[] = {1000u, 1003u, 10000u, 100000u, 1000000u};  // 1003: partial tail block
+constexpr uint32_t BOXES_PER_TIMING = 2000000u;                              // boxes tested per timed level
+constexpr uint32_t SIDE_PLANES_MASK = 0x0Fu;                                 // L, R, B, T (near/far skipped)
+constexpr uint32_t NODE_COUNTS[] = {1003u, 50000u};                          // 1003: partial SIMD batches
+constexpr uint32_t TRANSFORM_ITERATIONS = 20u;
+constexpr float WORLD_EPSILON = 1e-4f;
+
+struct Checker {
+    int failures = 0;
+    void expect(bool condition, const std::string& what)
+    {
+        if (!condition) {
+            std::cerr << "[SimdKernelTest] FAIL: " << what << "\n";
+            ++failures;
+        }
+    }
+};
+
+bool supported(FrustumCulling::SimdLevel level)
+{
+    return static_cast<int>(level) <= static_cast<int>(FrustumCulling::DetectSimdLevel());
+}
+
+AabbSoA randomBoxes(uint32_t count)
+{
+    // Boxes scattered around a camera at the origin so roughly a quarter survive.
+    std::mt19937 rng(4321u + count);
+    std::uniform_real_distribution<float> pos(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> ext(0.1f, 5.0f);
+    AabbSoA boxes;
+    boxes.Reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const glm::vec3 c(pos(rng), pos(rng), pos(rng));
+        const glm::vec3 e(ext(rng), ext(rng), ext(rng));
+        boxes.PushBack(BoundingBox(c - e, c + e));
+    }
+    return boxes;
+}
+
+void checkFrustumCulling(Checker& check)
+{
+    const FrustumCulling::SimdLevel levels[] = {FrustumCulling::SimdLevel::Scalar, FrustumCulling::SimdLevel::Sse41,
+                                                FrustumCulling::SimdLevel::Avx2};
+    const glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const Frustum frustum(proj * view);
+
+    for (uint32_t count : BOX_COUNTS) {
+        const AabbSoA boxes = randomBoxes(count);
+        const uint32_t words = FrustumCulling::MaskWordCount(count);
+        const std::string size = "boxes=" + std::to_string(count);
+
+        for (uint32_t planeMask : {Frustum::ALL_PLANES_MASK, SIDE_PLANES_MASK}) {
+            const std::string variant = size + (planeMask == Frustum::ALL_PLANES_MASK ? "" : " (side planes)");
+            std::vector<uint32_t> reference(words, 0xFFFFFFFFu);
+            const uint32_t referenceVisible =
+                FrustumCulling::CullAabbBatch(frustum, boxes, reference.data(), planeMask, FrustumCulling::SimdLevel::Scalar);
+
+            uint32_t expectedVisible = 0;
+            bool matchesFrustum = true;
+            for (uint32_t i = 0; i < count; ++i) {
+                const BoundingBox box(glm::vec3(boxes.minX[i], boxes.minY[i], boxes.minZ[i]),
+                                      glm::vec3(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]));
+                uint32_t mask = planeMask;
+                const bool expected = frustum.IntersectsMasked(box, mask);
+                if (planeMask == Frustum::ALL_PLANES_MASK && expected != frustum.Intersects(box)) {
+                    matchesFrustum = false;
+                }
+                const bool bit = ((reference[i >> 5] >> (i & 31u)) & 1u) != 0u;
+                matchesFrustum = matchesFrustum && bit == expected;
+                expectedVisible += expected ? 1u : 0u;
+            }
+            check.expect(matchesFrustum, variant + ": scalar bits match Frustum::IntersectsMasked");
+            check.expect(referenceVisible == expectedVisible, variant + ": scalar visible count");
+            check.expect(referenceVisible > 0u && referenceVisible < count, variant + ": some but not all boxes survive");
+            if (count % 32u != 0u) {
+                check.expect((reference.back() >> (count % 32u)) == 0u, variant + ": tail bits cleared");
+            }
+
+            for (FrustumCulling::SimdLevel level : levels) {
+                if (level == FrustumCulling::SimdLevel::Scalar || !supported(level)) continue;
+                std::vector<uint32_t> mask(words, 0xFFFFFFFFu);
+                const uint32_t visible = FrustumCulling::CullAabbBatch(frustum, boxes, mask.data(), planeMask, level);
+                const std::string name = FrustumCulling::GetSimdLevelName(level);
+                check.expect(mask == reference, variant + ": " + name + " bits match scalar");
+                check.expect(visible == referenceVisible, variant + ": " + name + " visible count matches scalar");
+            }
+        }
+
+        std::vector<uint32_t> mask(words);
+        const uint32_t iterations = std::max(1u, BOXES_PER_TIMING / count);
+        std::cout << "[Perf] FrustumCulling " << size;
+        for (FrustumCulling::SimdLevel level : levels) {
+            if (!supported(level)) continue;
+            const auto t0 = Clock::now();
+            for (uint32_t it = 0; it < iterations; ++it) {
+                FrustumCulling::CullAabbBatch(frustum, boxes, mask.data(), Frustum::ALL_PLANES_MASK, level);
+            }
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / iterations;
+            std::cout << " " << FrustumCulling::GetSimdLevelName(level) << "_ms=" << ms;
+        }
+        std::cout << std::endl;
+    }
+}
+
+struct Hierarchy {
+    std::vector<Node> nodes;
+    std::vector<Node*> linear;
+};
+
+// Random parent-sorted hierarchy: parents within the previous 32 nodes, a new root every 64, every 16th node
+// with a matrix override.
+Hierarchy randomHierarchy(uint32_t nodeCount)
+{
+    std::mt19937 rng(1234u);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    Hierarchy hierarchy;
+    hierarchy.nodes.resize(nodeCount);
+    hierarchy.linear.resize(nodeCount);
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        Node& n = hierarchy.nodes[i];
+        n.linearIndex = i;
+        if (i > 0 && (i % 64) != 0) {
+            std::uniform_int_distribution<uint32_t> pick(i > 32 ? i - 32 : 0, i - 1);
+            n.parent = &hierarchy.nodes[pick(rng)];
+        }
+        n.translation = glm::vec3(unit(rng), unit(rng), unit(rng)) * 4.0f;
+        n.rotation = glm::normalize(glm::quat(unit(rng), unit(rng), unit(rng), unit(rng)));
+        n.scale = glm::vec3(1.0f + 0.1f * unit(rng));
+        if ((i % 16) == 0) {
+            n.hasMatrix = true;
+            n.matrix = glm::mat4(1.0f);
+            n.matrix[3] = glm::vec4(unit(rng), unit(rng), unit(rng), 1.0f);
+        }
+        hierarchy.linear[i] = &n;
+    }
+    return hierarchy;
+}
+
+void checkTransformStore(Checker& check)
+{
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+
+    for (uint32_t nodeCount : NODE_COUNTS) {
+        const Hierarchy hierarchy = randomHierarchy(nodeCount);
+        const std::string size = "nodes=" + std::to_string(nodeCount);
+
+        const glm::mat4 root = glm::mat4(1.0f);
+        std::vector<glm::mat4> refWorld(nodeCount);
+        const auto tRef0 = Clock::now();
+        for (uint32_t it = 0; it < TRANSFORM_ITERATIONS; ++it) {
+            for (uint32_t i = 0; i < nodeCount; ++i) {
+                const Node& n = hierarchy.nodes[i];
+                const glm::mat4& parentWorld = n.parent ? refWorld[n.parent->linearIndex] : root;
+                refWorld[i] = parentWorld * n.getLocalMatrix();
+            }
+        }
+        const auto tRef1 = Clock::now();
+
+        TransformStore store;
+        const auto tBuild0 = Clock::now();
+        store.build(hierarchy.linear);
+        const auto tBuild1 = Clock::now();
+
+        std::vector<glm::mat4> local(nodeCount);
+        std::vector<glm::mat4> world(nodeCount);
+        const auto tSoa0 = Clock::now();
+        for (uint32_t it = 0; it < TRANSFORM_ITERATIONS; ++it) {
+            store.composeLocal(0, nodeCount, local.data());
+            store.propagate(0, nodeCount, root, local.data(), world.data());
+        }
+        const auto tSoa1 = Clock::now();
+
+        float maxDiff = 0.0f;
+        uint32_t mismatches = 0;
+        for (uint32_t i = 0; i < nodeCount; ++i) {
+            bool match = true;
+            for (int c = 0; c < 4; ++c) {
+                for (int r = 0; r < 4; ++r) {
+                    const float diff = std::abs(world[i][c][r] - refWorld[i][c][r]);
+                    maxDiff = std::max(maxDiff, diff);
+                    // NaN-safe: a NaN difference fails the comparison.
+                    match = match && diff <= WORLD_EPSILON * std::max(1.0f, std::abs(refWorld[i][c][r]));
+                }
+            }
+            mismatches += match ? 0u : 1u;
+        }
+        check.expect(mismatches == 0u, size + ": " + std::to_string(mismatches)
+                                           + " world matrices differ from Node::getLocalMatrix beyond epsilon");
+
+        const double refMs = ms(tRef0, tRef1) / TRANSFORM_ITERATIONS;
+        const double soaMs = ms(tSoa0, tSoa1) / TRANSFORM_ITERATIONS;
+        std::cout << "[Perf] TransformStore " << size << " path=" << TransformStore::simdPathName()
+                  << " build_ms=" << ms(tBuild0, tBuild1)
+                  << " glm_ms=" << refMs << " soa_ms=" << soaMs
+                  << " speedup=" << (soaMs > 0.0 ? refMs / soaMs : 0.0)
+                  << " max_abs_diff=" << maxDiff << std::endl;
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    Checker check;
+    std::cout << "[SimdKernelTest] best level: " << FrustumCulling::GetSimdLevelName(FrustumCulling::DetectSimdLevel()) << "\n";
+    checkFrustumCulling(check);
+    checkTransformStore(check);
+
+    if (check.failures > 0) {
+        std::cerr << "[SimdKernelTest] " << check.failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "[SimdKernelTest] PASS\n";
+    return 0;
+}